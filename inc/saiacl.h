@@ -3789,6 +3789,14 @@ typedef struct _sai_acl_api_t
     sai_remove_acl_table_chain_group_fn         remove_acl_table_chain_group;
     sai_set_acl_table_chain_group_attribute_fn  set_acl_table_chain_group_attribute;
     sai_get_acl_table_chain_group_attribute_fn  get_acl_table_chain_group_attribute;
+    sai_bulk_object_create_fn                   create_acl_entries;
+    sai_bulk_object_remove_fn                   remove_acl_entries;
+    sai_bulk_object_set_attribute_fn            set_acl_entries_attribute;
+    sai_bulk_object_get_attribute_fn            get_acl_entries_attribute;
+    sai_bulk_object_create_fn                   create_acl_counters;
+    sai_bulk_object_remove_fn                   remove_acl_counters;
+    sai_bulk_object_set_attribute_fn            set_acl_counters_attribute;
+    sai_bulk_object_get_attribute_fn            get_acl_counters_attribute;
 } sai_acl_api_t;
 
 /**
@@ -714,6 +714,10 @@ typedef struct _sai_bridge_api_t
     sai_get_bridge_port_stats_fn        get_bridge_port_stats;
     sai_get_bridge_port_stats_ext_fn    get_bridge_port_stats_ext;
     sai_clear_bridge_port_stats_fn      clear_bridge_port_stats;
+    sai_bulk_object_create_fn           create_bridge_ports;
+    sai_bulk_object_remove_fn           remove_bridge_ports;
+    sai_bulk_object_set_attribute_fn    set_bridge_ports_attribute;
+    sai_bulk_object_get_attribute_fn    get_bridge_ports_attribute;
 } sai_bridge_api_t;
 
 /**
@@ -1367,6 +1367,38 @@ typedef sai_status_t (*sai_send_hostif_packet_fn)(
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list);
 
+/**
+ * @brief Hostif bulk send function
+ *
+ * Sends multiple packets through the same host interface in one call, each
+ * packet with its own attribute list.
+ *
+ * @param[in] hostif_id Host interface id.
+ *    When sending through FD channel, fill SAI_OBJECT_TYPE_HOST_INTERFACE object, of type #SAI_HOSTIF_TYPE_FD.
+ *    When sending through CB channel, fill Switch Object ID, SAI_OBJECT_TYPE_SWITCH.
+ * @param[in] object_count Number of packets to send
+ * @param[in] buffer_size List of packet sizes in bytes
+ * @param[in] buffer List of packet buffers
+ * @param[in] attr_count List of attr_count. Caller passes the number
+ *    of attribute for each packet to send.
+ * @param[in] attr_list List of attributes for every packet
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_statuses List of status for every packet. Caller needs to allocate the buffer
+ *
+ * @return #SAI_STATUS_SUCCESS on success when all packets are sent or #SAI_STATUS_FAILURE when
+ * any of the packets fails to send. When there is failure, Caller is expected to go through the
+ * list of returned statuses to find out which fails and which succeeds.
+ */
+typedef sai_status_t (*sai_send_hostif_packets_fn)(
+        _In_ sai_object_id_t hostif_id,
+        _In_ uint32_t object_count,
+        _In_ const sai_size_t *buffer_size,
+        _In_ const void **buffer,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
+
 /**
  * @brief Hostif allocate function
  *
@@ -1453,6 +1485,15 @@ typedef struct _sai_hostif_api_t
     sai_send_hostif_packet_fn                      send_hostif_packet;
     sai_allocate_hostif_packet_fn                  allocate_hostif_packet;
     sai_free_hostif_packet_fn                      free_hostif_packet;
+    sai_send_hostif_packets_fn                     send_hostif_packets;
+    sai_bulk_object_create_fn                      create_hostif_trap_groups;
+    sai_bulk_object_remove_fn                      remove_hostif_trap_groups;
+    sai_bulk_object_set_attribute_fn               set_hostif_trap_groups_attribute;
+    sai_bulk_object_get_attribute_fn               get_hostif_trap_groups_attribute;
+    sai_bulk_object_create_fn                      create_hostif_traps;
+    sai_bulk_object_remove_fn                      remove_hostif_traps;
+    sai_bulk_object_set_attribute_fn               set_hostif_traps_attribute;
+    sai_bulk_object_get_attribute_fn               get_hostif_traps_attribute;
 } sai_hostif_api_t;
 
 /**
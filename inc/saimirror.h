@@ -440,6 +440,10 @@ typedef struct _sai_mirror_api_t
     sai_remove_mirror_session_fn            remove_mirror_session;
     sai_set_mirror_session_attribute_fn     set_mirror_session_attribute;
     sai_get_mirror_session_attribute_fn     get_mirror_session_attribute;
+    sai_bulk_object_create_fn               create_mirror_sessions;
+    sai_bulk_object_remove_fn               remove_mirror_sessions;
+    sai_bulk_object_set_attribute_fn        set_mirror_sessions_attribute;
+    sai_bulk_object_get_attribute_fn        get_mirror_sessions_attribute;
 
 } sai_mirror_api_t;
 
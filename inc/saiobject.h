@@ -132,6 +132,27 @@ typedef struct _sai_object_key_t
 
 } sai_object_key_t;
 
+/**
+ * @brief Cursor for retrieval of object keys page by page
+ *
+ * Cursor content is implementation specific. Caller sets all members to
+ * zero to start iteration from the first object and passes cursor returned
+ * by previous call unchanged to get next page.
+ */
+typedef struct _sai_object_key_cursor_t
+{
+    /**
+     * @brief Implementation specific position of next object key
+     */
+    uint64_t position;
+
+    /**
+     * @brief Set by callee when there are no more object keys to return
+     */
+    bool done;
+
+} sai_object_key_cursor_t;
+
 /**
  * @brief Structure for attribute capabilities per operation
  */
@@ -199,6 +220,44 @@ sai_status_t sai_get_object_key(
         _Inout_ uint32_t *object_count,
         _Inout_ sai_object_key_t *object_list);
 
+/**
+ * @brief Get page of object keys present in SAI, optionally together with
+ * attribute values of each returned object.
+ *
+ * Allows to stream objects of single object type with bounded memory, page
+ * by page, instead of retrieving all keys with sai_get_object_key() and
+ * then all attributes with sai_bulk_get_attribute(). Objects created or
+ * removed during iteration may or may not be returned, but object which
+ * exists during whole iteration is returned exactly once.
+ *
+ * @param[in] switch_id SAI Switch object id
+ * @param[in] object_type SAI object type
+ * @param[inout] cursor Iteration cursor, see #sai_object_key_cursor_t
+ * @param[inout] object_count Caller passes the page size, which is the
+ *    number of keys allocated in object_list. Callee returns with the
+ *    number of keys filled in, which can be zero when iteration is done.
+ * @param[out] object_list List of SAI object keys
+ * @param[in] attr_count Number of attributes to get for every returned
+ *    object, zero if only keys are requested
+ * @param[inout] attr_list List of attributes for every object in page, each
+ *    with attr_count attributes. Caller fills attribute ids and allocates
+ *    lists, same as for get attribute API. Can be NULL if attr_count is zero.
+ * @param[out] object_statuses Status of attributes get for every returned
+ *    object. Can be NULL if attr_count is zero.
+ *
+ * @return #SAI_STATUS_SUCCESS on success, #SAI_STATUS_INVALID_PARAMETER if
+ * cursor is not valid for object type, failure status code on error
+ */
+sai_status_t sai_get_object_key_page(
+        _In_ sai_object_id_t switch_id,
+        _In_ sai_object_type_t object_type,
+        _Inout_ sai_object_key_cursor_t *cursor,
+        _Inout_ uint32_t *object_count,
+        _Out_ sai_object_key_t *object_list,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t **attr_list,
+        _Out_ sai_status_t *object_statuses);
+
 /**
  * @brief Get the bulk list of valid attributes for a given list of
  * object keys.
@@ -189,10 +189,14 @@ typedef sai_status_t (*sai_get_qos_map_attribute_fn)(
  */
 typedef struct _sai_qos_map_api_t
 {
-    sai_create_qos_map_fn         create_qos_map;
-    sai_remove_qos_map_fn         remove_qos_map;
-    sai_set_qos_map_attribute_fn  set_qos_map_attribute;
-    sai_get_qos_map_attribute_fn  get_qos_map_attribute;
+    sai_create_qos_map_fn            create_qos_map;
+    sai_remove_qos_map_fn            remove_qos_map;
+    sai_set_qos_map_attribute_fn     set_qos_map_attribute;
+    sai_get_qos_map_attribute_fn     get_qos_map_attribute;
+    sai_bulk_object_create_fn        create_qos_maps;
+    sai_bulk_object_remove_fn        remove_qos_maps;
+    sai_bulk_object_set_attribute_fn set_qos_maps_attribute;
+    sai_bulk_object_get_attribute_fn get_qos_maps_attribute;
 
 } sai_qos_map_api_t;
 
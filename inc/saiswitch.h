@@ -3021,6 +3021,46 @@ typedef enum _sai_switch_attr_t
      */
     SAI_SWITCH_ATTR_POE_DEVICE_LIST,
 
+    /**
+     * @brief Maximum number of events delivered in a single notification callback
+     *
+     * Applies to notifications that carry count and data array parameters,
+     * like FDB event, port state change or BFD session state change.
+     * Adapter may deliver fewer events than this value in a single callback.
+     * Value 1 disables batching.
+     *
+     * @type sai_uint32_t
+     * @flags CREATE_AND_SET
+     * @default 1
+     */
+    SAI_SWITCH_ATTR_NOTIFICATION_BATCH_MAX_SIZE,
+
+    /**
+     * @brief Maximum time in microseconds an event can be held for batching
+     *
+     * When this time elapses since the first event was queued, the batch is
+     * delivered even if it did not reach SAI_SWITCH_ATTR_NOTIFICATION_BATCH_MAX_SIZE.
+     * Zero means events are delivered without additional delay.
+     *
+     * @type sai_uint32_t
+     * @flags CREATE_AND_SET
+     * @default 0
+     */
+    SAI_SWITCH_ATTR_NOTIFICATION_BATCH_MAX_LATENCY,
+
+    /**
+     * @brief Remove superseded events from notification batch
+     *
+     * When enabled, if a batch contains multiple events for the same key
+     * (for example FDB entry or port id), only the most recent event for
+     * that key is delivered. Relative order of delivered events is preserved.
+     *
+     * @type bool
+     * @flags CREATE_AND_SET
+     * @default false
+     */
+    SAI_SWITCH_ATTR_NOTIFICATION_BATCH_DEDUP,
+
     /**
      * @brief End of attributes
      */
@@ -682,10 +682,14 @@ typedef sai_status_t (*sai_get_wred_attribute_fn)(
  */
 typedef struct _sai_wred_api_t
 {
-    sai_create_wred_fn          create_wred;
-    sai_remove_wred_fn          remove_wred;
-    sai_set_wred_attribute_fn   set_wred_attribute;
-    sai_get_wred_attribute_fn   get_wred_attribute;
+    sai_create_wred_fn               create_wred;
+    sai_remove_wred_fn               remove_wred;
+    sai_set_wred_attribute_fn        set_wred_attribute;
+    sai_get_wred_attribute_fn        get_wred_attribute;
+    sai_bulk_object_create_fn        create_wreds;
+    sai_bulk_object_remove_fn        remove_wreds;
+    sai_bulk_object_set_attribute_fn set_wreds_attribute;
+    sai_bulk_object_get_attribute_fn get_wreds_attribute;
 
 } sai_wred_api_t;
 
@@ -0,0 +1,236 @@
+#!/usr/bin/perl
+#
+# Copyright (c) 2014 Microsoft Open Technologies, Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+#    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+#    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+#    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+#    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+#
+#    See the Apache Version 2.0 License for specific language governing
+#    permissions and limitations under the License.
+#
+#    Microsoft would like to thank the following companies for their review and
+#    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+#    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+#
+# @file    apicache.pm
+#
+# @brief   This module defines SAI Metadata Attribute Cache Parser
+#
+
+package apicache;
+
+use strict;
+use warnings;
+use diagnostics;
+use Data::Dumper;
+use utils;
+use xmlutils;
+use apirecorder;
+use apiwrap;
+
+require Exporter;
+
+my @CACHE_METHODS = ();
+
+sub GetCacheMetaKey
+{
+    #
+    # returns expression of object key for meta key, entries are always passed
+    # by pointer or as array, object id is passed by pointer only to create
+    #
+
+    my ($method, $key, $idx) = @_;
+
+    return "$key\[$idx\]" if defined $idx;
+
+    return "*$key" if defined $method->{entry} or $method->{op} eq "create";
+
+    return $key;
+}
+
+sub WriteCacheMetaKey
+{
+    my ($method, $key) = @_;
+
+    my $member = defined $method->{entry} ? $method->{small} : "object_id";
+
+    WriteSource "sai_object_meta_key_t meta_key;\n";
+    WriteSource "meta_key.objecttype = $method->{ot};";
+
+    return if not defined $key;
+
+    WriteSource "meta_key.objectkey.key.$member = $key;\n";
+}
+
+sub CreateCacheWrapperBody
+{
+    my $method = shift;
+
+    my $op = $method->{op};
+    my $call = "sai_metadata_cache_orig_apis.$method->{api}_api->$method->{name}(" . join(", ", @{ $method->{args} }) . ")";
+
+    my @args = @{ $method->{args} };
+
+    if ($op eq "create")
+    {
+        my $key = shift @args;
+
+        shift @args if not defined $method->{entry} and $method->{small} ne "switch";
+
+        my ($attrCount, $attrList) = @args;
+
+        WriteSource "sai_status_t status = $call;\n";
+        WriteSource "if (status == SAI_STATUS_SUCCESS)";
+        WriteSource "{";
+        WriteCacheMetaKey($method, GetCacheMetaKey($method, $key));
+        WriteSource "sai_metadata_cache_update(&meta_key, status, $attrCount, $attrList);";
+        WriteSource "}\n";
+    }
+    elsif ($op eq "remove")
+    {
+        WriteCacheMetaKey($method, GetCacheMetaKey($method, $args[0]));
+        WriteSource "sai_status_t status = $call;\n";
+        WriteSource "sai_metadata_cache_remove(&meta_key, status);\n";
+    }
+    elsif ($op eq "set")
+    {
+        WriteCacheMetaKey($method, GetCacheMetaKey($method, $args[0]));
+        WriteSource "if (sai_metadata_cache_set_lookup(&meta_key, $args[1]))";
+        WriteSource "{";
+        WriteSource "return SAI_STATUS_SUCCESS;";
+        WriteSource "}\n";
+        WriteSource "sai_status_t status = $call;\n";
+        WriteSource "sai_metadata_cache_update(&meta_key, status, 1, $args[1]);\n";
+    }
+    elsif ($op eq "get")
+    {
+        WriteCacheMetaKey($method, GetCacheMetaKey($method, $args[0]));
+        WriteSource "if (sai_metadata_cache_get_lookup(&meta_key, $args[1], $args[2]))";
+        WriteSource "{";
+        WriteSource "return SAI_STATUS_SUCCESS;";
+        WriteSource "}\n";
+        WriteSource "sai_status_t status = $call;\n";
+        WriteSource "if (status == SAI_STATUS_SUCCESS)";
+        WriteSource "{";
+        WriteSource "sai_metadata_cache_update(&meta_key, status, $args[1], $args[2]);";
+        WriteSource "}\n";
+    }
+    else
+    {
+        my ($count, $keys, $attrCount, $attrList, $attr, $statuses);
+
+        if ($op eq "bulk_create" and not defined $method->{entry})
+        {
+            ($count, $attrCount, $attrList, $keys, $statuses) = @args[1, 2, 3, 5, 6];
+        }
+        elsif ($op eq "bulk_create")
+        {
+            ($count, $keys, $attrCount, $attrList, $statuses) = @args[0, 1, 2, 3, 5];
+        }
+        elsif ($op eq "bulk_remove")
+        {
+            ($count, $keys, $statuses) = @args[0, 1, 3];
+        }
+        else
+        {
+            ($count, $keys, $attr, $statuses) = @args[0, 1, 2, 4];
+        }
+
+        # object statuses are valid only when bulk call returned success or failure
+
+        my $condition = "(status == SAI_STATUS_SUCCESS || status == SAI_STATUS_FAILURE) && $keys != NULL && $statuses != NULL";
+
+        $condition .= " && $attrCount != NULL && $attrList != NULL" if defined $attrCount;
+
+        $condition .= " && $attr != NULL" if defined $attr;
+
+        WriteSource "sai_status_t status = $call;\n";
+        WriteSource "if (!($condition))";
+        WriteSource "{";
+        WriteSource "return status;";
+        WriteSource "}\n";
+        WriteCacheMetaKey($method, undef);
+        WriteSource "";
+        WriteSource "uint32_t idx;\n";
+        WriteSource "for (idx = 0; idx < $count; idx++)";
+        WriteSource "{";
+
+        my $member = defined $method->{entry} ? $method->{small} : "object_id";
+
+        WriteSource "meta_key.objectkey.key.$member = " . GetCacheMetaKey($method, $keys, "idx") . ";\n";
+
+        if ($op eq "bulk_create")
+        {
+            WriteSource "if ($statuses\[idx\] == SAI_STATUS_SUCCESS)";
+            WriteSource "{";
+            WriteSource "sai_metadata_cache_update(&meta_key, $statuses\[idx\], $attrCount\[idx\], $attrList\[idx\]);";
+            WriteSource "}";
+        }
+        elsif ($op eq "bulk_remove")
+        {
+            WriteSource "sai_metadata_cache_remove(&meta_key, $statuses\[idx\]);";
+        }
+        else
+        {
+            WriteSource "sai_metadata_cache_update(&meta_key, $statuses\[idx\], 1, &$attr\[idx\]);";
+        }
+
+        WriteSource "}\n";
+    }
+
+    WriteSource "return status;";
+}
+
+sub CreateCacheWrappers
+{
+    WriteSectionComment "Attribute cache wrappers";
+
+    for my $method (@CACHE_METHODS)
+    {
+        my @params = @{ $method->{params} };
+
+        WriteSource "static sai_status_t sai_metadata_cache_$method->{api}_$method->{name}(";
+
+        my $last = pop @params;
+
+        WriteSource "$_," for @params;
+        WriteSource "$last)";
+
+        WriteSource "{";
+
+        CreateCacheWrapperBody($method);
+
+        WriteSource "}";
+    }
+}
+
+sub CreateApiCacheMethods
+{
+    # bulk get is not wrapped, it does not change attributes
+
+    @CACHE_METHODS = grep { $_->{op} ne "bulk_get" } GetApiRecorderMethods();
+
+    CreateApiWrapGlobalApis("cache", "Attribute cache", \@CACHE_METHODS);
+
+    CreateCacheWrappers();
+
+    CreateApiWrapApi("cache", "Attribute cache", \@CACHE_METHODS);
+
+    CreateApiWrapApis("cache", "Attribute cache", \@CACHE_METHODS);
+}
+
+BEGIN
+{
+    our @ISA    = qw(Exporter);
+    our @EXPORT = qw/
+    CreateApiCacheMethods
+    /;
+}
+
+1;
@@ -0,0 +1,208 @@
+#!/usr/bin/perl
+#
+# Copyright (c) 2014 Microsoft Open Technologies, Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+#    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+#    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+#    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+#    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+#
+#    See the Apache Version 2.0 License for specific language governing
+#    permissions and limitations under the License.
+#
+#    Microsoft would like to thank the following companies for their review and
+#    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+#    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+#
+# @file    apilatency.pm
+#
+# @brief   This module defines SAI Metadata API Latency Instrumentation Parser
+#
+
+package apilatency;
+
+use strict;
+use warnings;
+use diagnostics;
+use Data::Dumper;
+use utils;
+use xmlutils;
+use apiwrap;
+
+require Exporter;
+
+my @API_METHODS = ();
+
+sub GetApiMethods
+{
+    my @apis = @{ $main::SAI_ENUMS{sai_api_t}{values} };
+
+    for my $Api (@apis)
+    {
+        $Api =~ /^SAI_API_(\w+)/;
+
+        my $api = lc($1);
+
+        next if $api =~ /unspecified/;
+
+        my $structName = "sai_${api}_api_t";
+
+        next if not defined $main::ALL_STRUCTS{$structName};
+
+        my %struct = ExtractStructInfoEx($structName, "struct_");
+
+        for my $member (@{ $struct{keys} })
+        {
+            my $type = $struct{membersHash}{$member}{type};
+
+            if (not defined $main::FUNCTION_DEF{$type})
+            {
+                LogError "function type $type is not defined for $api.$member";
+                next;
+            }
+
+            my $prototype = Trim($main::FUNCTION_DEF{$type});
+
+            if (not $prototype =~ /^typedef (\S+)\s*\(\* $type\) \((.+)\)$/)
+            {
+                LogError "failed to match function proto type $type for $api.$member";
+                next;
+            }
+
+            my $returnType = $1;
+            my $params = $2;
+
+            my @params = ();
+            my @args = ();
+
+            if ($params ne "void")
+            {
+                @params = split/\s*,\s*/, $params;
+
+                for my $param (@params)
+                {
+                    if (not $param =~ /^_(In|Out|Inout)_ .+?\b(\w+)$/)
+                    {
+                        LogError "failed to match param '$param' of $type for $api.$member";
+                        next;
+                    }
+
+                    push @args, $2;
+                }
+            }
+
+            my $objectCount = ($params =~ /_In_ uint32_t object_count\b/) ? "object_count" : "0";
+
+            my %method = (
+                    api         => $api,
+                    name        => $member,
+                    index       => scalar @API_METHODS,
+                    returnType  => $returnType,
+                    params      => \@params,
+                    args        => \@args,
+                    objectCount => $objectCount);
+
+            push @API_METHODS, \%method;
+        }
+    }
+}
+
+sub CreateLatencyNames
+{
+    WriteSectionComment "API latency function names";
+
+    my $count = scalar @API_METHODS;
+
+    WriteHeader "#define SAI_METADATA_LATENCY_FN_COUNT $count";
+
+    WriteHeader "extern const char* const sai_metadata_latency_fn_names[];";
+
+    WriteSource "const char* const sai_metadata_latency_fn_names[] = {";
+
+    for my $method (@API_METHODS)
+    {
+        WriteSource "\"$method->{api}.$method->{name}\",";
+    }
+
+    WriteSource "NULL";
+    WriteSource "};";
+}
+
+sub CreateLatencyWrappers
+{
+    WriteSectionComment "API latency wrappers";
+
+    for my $method (@API_METHODS)
+    {
+        my $api = $method->{api};
+        my $name = $method->{name};
+        my $returnType = $method->{returnType};
+        my $args = join(", ", @{ $method->{args} });
+
+        my @params = @{ $method->{params} };
+
+        my $call = "sai_metadata_latency_orig_apis.${api}_api->$name($args)";
+
+        if (scalar @params == 0)
+        {
+            WriteSource "static $returnType sai_metadata_latency_${api}_$name(void)";
+        }
+        else
+        {
+            WriteSource "static $returnType sai_metadata_latency_${api}_$name(";
+
+            my $last = pop @params;
+
+            WriteSource "$_," for @params;
+            WriteSource "$last)";
+        }
+
+        WriteSource "{";
+        WriteSource "uint64_t start = sai_metadata_latency_now();\n";
+
+        if ($returnType eq "void")
+        {
+            WriteSource "$call;\n";
+            WriteSource "sai_metadata_latency_record($method->{index}, start, SAI_STATUS_SUCCESS, $method->{objectCount});";
+        }
+        else
+        {
+            my $status = ($returnType eq "sai_status_t") ? "status" : "SAI_STATUS_SUCCESS";
+
+            WriteSource "$returnType status = $call;\n";
+            WriteSource "sai_metadata_latency_record($method->{index}, start, $status, $method->{objectCount});\n";
+            WriteSource "return status;";
+        }
+
+        WriteSource "}";
+    }
+}
+
+sub CreateApiLatencyMethods
+{
+    GetApiMethods();
+
+    CreateLatencyNames();
+
+    CreateApiWrapGlobalApis("latency", "API latency", \@API_METHODS);
+
+    CreateLatencyWrappers();
+
+    CreateApiWrapApi("latency", "API latency", \@API_METHODS);
+
+    CreateApiWrapApis("latency", "API latency", \@API_METHODS);
+}
+
+BEGIN
+{
+    our @ISA    = qw(Exporter);
+    our @EXPORT = qw/
+    CreateApiLatencyMethods
+    /;
+}
+
+1;
@@ -0,0 +1,320 @@
+#!/usr/bin/perl
+#
+# Copyright (c) 2014 Microsoft Open Technologies, Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+#    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+#    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+#    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+#    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+#
+#    See the Apache Version 2.0 License for specific language governing
+#    permissions and limitations under the License.
+#
+#    Microsoft would like to thank the following companies for their review and
+#    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+#    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+#
+# @file    apirecorder.pm
+#
+# @brief   This module defines SAI Metadata API Recorder Parser
+#
+
+package apirecorder;
+
+use strict;
+use warnings;
+use diagnostics;
+use Data::Dumper;
+use utils;
+use xmlutils;
+use apiwrap;
+
+require Exporter;
+
+my @RECORDER_METHODS = ();
+
+# number of arguments of each recorded function, used to validate prototypes
+
+my %ARG_COUNT = (
+        "create"        => 4,
+        "remove"        => 1,
+        "set"           => 2,
+        "get"           => 3,
+        "bulk_create"   => 7,
+        "bulk_remove"   => 4,
+        "bulk_set"      => 5,
+        "bulk_get"      => 6,
+        );
+
+sub GetFunctionArgs
+{
+    my ($type, $member) = @_;
+
+    if (not defined $main::FUNCTION_DEF{$type})
+    {
+        LogError "function type $type is not defined for $member";
+        return undef;
+    }
+
+    my $prototype = Trim($main::FUNCTION_DEF{$type});
+
+    if (not $prototype =~ /^typedef sai_status_t\s*\(\* $type\) \((.+)\)$/)
+    {
+        LogError "failed to match function proto type $type for $member";
+        return undef;
+    }
+
+    my @params = split/\s*,\s*/, $1;
+    my @args = ();
+
+    for my $param (@params)
+    {
+        if (not $param =~ /^_(In|Out|Inout)_ .+?\b(\w+)$/)
+        {
+            LogError "failed to match param '$param' of $type for $member";
+            return undef;
+        }
+
+        push @args, $2;
+    }
+
+    return (\@params, \@args);
+}
+
+sub GetRecorderMethods
+{
+    return if scalar @RECORDER_METHODS != 0;
+
+    my @objects = @{ $main::SAI_ENUMS{sai_object_type_t}{values} };
+
+    my %structs = ();
+
+    for my $ot (@objects)
+    {
+        next if not $ot =~ /^SAI_OBJECT_TYPE_(\w+)$/;
+
+        my $small = lc($1);
+
+        next if $small eq "null" or $small eq "max";
+
+        next if IsSpecialObject($ot);
+
+        my $api = $main::OBJTOAPIMAP{$ot};
+
+        next if not defined $api;
+
+        my $structName = "sai_${api}_api_t";
+
+        next if not defined $main::ALL_STRUCTS{$structName};
+
+        $structs{$structName} = { ExtractStructInfoEx($structName, "struct_") } if not defined $structs{$structName};
+
+        my %members = %{ $structs{$structName}{membersHash} };
+
+        my $entry = $main::NON_OBJECT_ID_STRUCTS{$ot};
+
+        my $plural = "${small}s";
+
+        $plural =~ s/entrys$/entries/;
+
+        my %names = (
+                "create"        => "create_${small}",
+                "remove"        => "remove_${small}",
+                "set"           => "set_${small}_attribute",
+                "get"           => "get_${small}_attribute",
+                "bulk_create"   => "create_${plural}",
+                "bulk_remove"   => "remove_${plural}",
+                "bulk_set"      => "set_${plural}_attribute",
+                "bulk_get"      => "get_${plural}_attribute",
+                );
+
+        for my $op (sort keys %names)
+        {
+            my $name = $names{$op};
+
+            next if not defined $members{$name};
+
+            my ($params, $args) = GetFunctionArgs($members{$name}{type}, "$api.$name");
+
+            next if not defined $params;
+
+            my $expected = $ARG_COUNT{$op};
+
+            $expected -= 1 if $op eq "create" and (defined $entry or $small eq "switch");
+
+            $expected -= 1 if $op eq "bulk_create" and defined $entry;
+
+            if (scalar @$args != $expected)
+            {
+                LogError "unexpected number of arguments of $api.$name, expected $expected";
+                next;
+            }
+
+            my %method = (
+                    api     => $api,
+                    name    => $name,
+                    op      => $op,
+                    ot      => $ot,
+                    small   => $small,
+                    entry   => $entry,
+                    params  => $params,
+                    args    => $args);
+
+            push @RECORDER_METHODS, \%method;
+        }
+    }
+}
+
+sub GetRecordCall
+{
+    my $method = shift;
+
+    my $op = $method->{op};
+    my $ot = $method->{ot};
+    my @args = @{ $method->{args} };
+
+    my $base = $op;
+
+    $base =~ s/^bulk_//;
+
+    my $OP = "SAI_METADATA_RECORDER_OP_" . uc($base);
+
+    if ($op =~ /^bulk_/)
+    {
+        my $keyType = defined $method->{entry} ? "sai_$method->{small}_t" : "sai_object_id_t";
+
+        my ($switchId, $count, $keys, $attrCount, $attrList, $attr, $mode, $statuses);
+
+        $switchId = "SAI_NULL_OBJECT_ID";
+        $attrCount = "NULL";
+        $attrList = "NULL";
+        $attr = "NULL";
+
+        if ($op eq "bulk_create" and not defined $method->{entry})
+        {
+            ($switchId, $count, $attrCount, $attrList, $mode, $keys, $statuses) = @args;
+        }
+        elsif ($op eq "bulk_create")
+        {
+            ($count, $keys, $attrCount, $attrList, $mode, $statuses) = @args;
+        }
+        elsif ($op eq "bulk_remove")
+        {
+            ($count, $keys, $mode, $statuses) = @args;
+        }
+        elsif ($op eq "bulk_set")
+        {
+            ($count, $keys, $attr, $mode, $statuses) = @args;
+        }
+        else
+        {
+            ($count, $keys, $attrCount, $attrList, $mode, $statuses) = @args;
+
+            # get attribute lists are not const, cast through void to satisfy -Wcast-qual
+
+            $attrList = "(const sai_attribute_t **)(void *)$attrList";
+        }
+
+        return "sai_metadata_recorder_record_bulk($OP, $ot, $switchId, $count, $keys, sizeof($keyType), " .
+            "$attrCount, $attrList, $attr, $mode, $statuses);";
+    }
+
+    my $key = shift @args;
+    my $switchId = "SAI_NULL_OBJECT_ID";
+
+    $switchId = shift @args if $op eq "create" and not defined $method->{entry} and $method->{small} ne "switch";
+
+    my $attrs = "0, NULL";
+
+    $attrs = "1, $args[0]" if $op eq "set";
+
+    $attrs = "$args[0], $args[1]" if $op eq "create" or $op eq "get";
+
+    return "sai_metadata_recorder_record($OP, &meta_key, $switchId, status, $attrs);";
+}
+
+sub CreateRecorderWrappers
+{
+    WriteSectionComment "API recorder wrappers";
+
+    for my $method (@RECORDER_METHODS)
+    {
+        my $api = $method->{api};
+        my $name = $method->{name};
+        my $op = $method->{op};
+        my $args = join(", ", @{ $method->{args} });
+
+        my @params = @{ $method->{params} };
+
+        WriteSource "static sai_status_t sai_metadata_recorder_${api}_$name(";
+
+        my $last = pop @params;
+
+        WriteSource "$_," for @params;
+        WriteSource "$last)";
+
+        WriteSource "{";
+        WriteSource "sai_status_t status = sai_metadata_recorder_orig_apis.${api}_api->$name($args);\n";
+
+        if ($op !~ /^bulk_/)
+        {
+            my $key = $method->{args}->[0];
+
+            WriteSource "sai_object_meta_key_t meta_key;\n";
+            WriteSource "meta_key.objecttype = $method->{ot};";
+
+            if (defined $method->{entry})
+            {
+                WriteSource "meta_key.objectkey.key.$method->{small} = *$key;\n";
+            }
+            elsif ($op eq "create")
+            {
+                WriteSource "meta_key.objectkey.key.object_id = (status == SAI_STATUS_SUCCESS) ? *$key : SAI_NULL_OBJECT_ID;\n";
+            }
+            else
+            {
+                WriteSource "meta_key.objectkey.key.object_id = $key;\n";
+            }
+        }
+
+        WriteSource GetRecordCall($method) . "\n";
+        WriteSource "return status;";
+        WriteSource "}";
+    }
+}
+
+sub GetApiRecorderMethods
+{
+    # wrapped methods are shared with other API wrappers, like attribute cache
+
+    GetRecorderMethods();
+
+    return @RECORDER_METHODS;
+}
+
+sub CreateApiRecorderMethods
+{
+    GetRecorderMethods();
+
+    CreateApiWrapGlobalApis("recorder", "API recorder", \@RECORDER_METHODS);
+
+    CreateRecorderWrappers();
+
+    CreateApiWrapApi("recorder", "API recorder", \@RECORDER_METHODS);
+
+    CreateApiWrapApis("recorder", "API recorder", \@RECORDER_METHODS);
+}
+
+BEGIN
+{
+    our @ISA    = qw(Exporter);
+    our @EXPORT = qw/
+    CreateApiRecorderMethods GetApiRecorderMethods
+    /;
+}
+
+1;
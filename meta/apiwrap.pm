@@ -0,0 +1,170 @@
+#!/usr/bin/perl
+#
+# Copyright (c) 2014 Microsoft Open Technologies, Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+#    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+#    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+#    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+#    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+#
+#    See the Apache Version 2.0 License for specific language governing
+#    permissions and limitations under the License.
+#
+#    Microsoft would like to thank the following companies for their review and
+#    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+#    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+#
+# @file    apiwrap.pm
+#
+# @brief   This module defines SAI Metadata API Method Table Wrap Parser
+#
+
+package apiwrap;
+
+use strict;
+use warnings;
+use diagnostics;
+use Data::Dumper;
+use utils;
+
+require Exporter;
+
+#
+# Wrap tables are shared by API wrappers like latency, recorder and cache.
+# Each of them passes its prefix, used in sai_metadata_<prefix>_* names,
+# description used in section comments, and list of wrapped methods, where
+# each method is hash with at least api and name keys. Wrapper of method is
+# expected to be named sai_metadata_<prefix>_<api>_<name>.
+#
+
+sub GetWrappedApis
+{
+    my $methods = shift;
+
+    my @apis = ();
+
+    for my $method (@{ $methods })
+    {
+        push @apis, $method->{api} if not grep { $_ eq $method->{api} } @apis;
+    }
+
+    return @apis;
+}
+
+sub CreateApiWrapGlobalApis
+{
+    my ($prefix, $description, $methods) = @_;
+
+    WriteSectionComment "$description wrapped and original APIs";
+
+    WriteSource "sai_apis_t sai_metadata_${prefix}_orig_apis = { 0 };";
+
+    for my $api (GetWrappedApis($methods))
+    {
+        WriteSource "sai_${api}_api_t sai_metadata_${prefix}_${api}_api = { 0 };";
+    }
+}
+
+sub CreateApiWrapApi
+{
+    my ($prefix, $description, $methods) = @_;
+
+    WriteSectionComment "$description wrap single API";
+
+    for my $api (GetWrappedApis($methods))
+    {
+        WriteSource "static sai_${api}_api_t* sai_metadata_${prefix}_wrap_${api}_api(";
+        WriteSource "_Inout_ sai_${api}_api_t *api)";
+        WriteSource "{";
+        WriteSource "if (api == NULL || api == &sai_metadata_${prefix}_${api}_api)";
+        WriteSource "{";
+        WriteSource "return api;";
+        WriteSource "}\n";
+        WriteSource "sai_metadata_${prefix}_orig_apis.${api}_api = api;\n";
+        WriteSource "sai_metadata_${prefix}_${api}_api = *api;\n";
+
+        for my $method (grep { $_->{api} eq $api } @{ $methods })
+        {
+            my $name = $method->{name};
+
+            WriteSource "if (api->$name != NULL)";
+            WriteSource "{";
+            WriteSource "sai_metadata_${prefix}_${api}_api.$name = sai_metadata_${prefix}_${api}_$name;";
+            WriteSource "}\n";
+        }
+
+        WriteSource "return &sai_metadata_${prefix}_${api}_api;";
+        WriteSource "}";
+    }
+
+    WriteHeader "extern sai_status_t sai_metadata_${prefix}_api_wrap(";
+    WriteHeader "_In_ sai_api_t api,";
+    WriteHeader "_Inout_ void **api_method_table);";
+
+    WriteSource "sai_status_t sai_metadata_${prefix}_api_wrap(";
+    WriteSource "_In_ sai_api_t api,";
+    WriteSource "_Inout_ void **api_method_table)";
+    WriteSource "{";
+    WriteSource "if (api_method_table == NULL)";
+    WriteSource "{";
+    WriteSource "return SAI_STATUS_INVALID_PARAMETER;";
+    WriteSource "}\n";
+    WriteSource "switch ((int)api)";
+    WriteSource "{";
+
+    for my $api (GetWrappedApis($methods))
+    {
+        my $Api = uc("SAI_API_$api");
+
+        WriteSource "case $Api:";
+        WriteSource "    *api_method_table = sai_metadata_${prefix}_wrap_${api}_api(*api_method_table);";
+        WriteSource "    return SAI_STATUS_SUCCESS;\n";
+    }
+
+    WriteSource "default:";
+    WriteSource "    SAI_META_LOG_ERROR(\"api %d is not supported\", api);";
+    WriteSource "    return SAI_STATUS_NOT_SUPPORTED;";
+    WriteSource "}";
+    WriteSource "}";
+}
+
+sub CreateApiWrapApis
+{
+    my ($prefix, $description, $methods) = @_;
+
+    WriteSectionComment "$description wrap all APIs";
+
+    WriteHeader "extern int sai_metadata_${prefix}_apis_wrap(";
+    WriteHeader "_Inout_ sai_apis_t *apis);";
+
+    WriteSource "int sai_metadata_${prefix}_apis_wrap(";
+    WriteSource "_Inout_ sai_apis_t *apis)";
+    WriteSource "{";
+    WriteSource "int count = 0;\n";
+
+    for my $api (GetWrappedApis($methods))
+    {
+        WriteSource "if (apis->${api}_api != NULL)";
+        WriteSource "{";
+        WriteSource "apis->${api}_api = sai_metadata_${prefix}_wrap_${api}_api(apis->${api}_api);";
+        WriteSource "count++;";
+        WriteSource "}\n";
+    }
+
+    WriteSource "return count; /* number of wrapped apis */";
+    WriteSource "}";
+}
+
+BEGIN
+{
+    our @ISA    = qw(Exporter);
+    our @EXPORT = qw/
+    GetWrappedApis CreateApiWrapGlobalApis CreateApiWrapApi CreateApiWrapApis
+    /;
+}
+
+1;
@@ -155,7 +155,7 @@ my %spellAcronyms = ();
 
 $spellAcronyms{$_} = 1 for @acronyms;
 
-my @exceptions = qw/ IPv4 IPv6 0xFF IPv SAIMETADATALOGGER auth objecttype saimetadatalogger sak /;
+my @exceptions = qw/ IPv4 IPv6 0xFF IPv SAIMETADATALOGGER SAIMETADATAQUEUE SAIMETADATALATENCY SAIMETADATARECORDER auth objecttype saimetadatalogger sak /;
 
 my %spellExceptions = map { $_ => $_ } @exceptions;
 
@@ -0,0 +1,772 @@
+#!/usr/bin/perl
+#
+# Copyright (c) 2014 Microsoft Open Technologies, Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+#    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+#    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+#    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+#    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+#
+#    See the Apache Version 2.0 License for specific language governing
+#    permissions and limitations under the License.
+#
+#    Microsoft would like to thank the following companies for their review and
+#    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+#    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+#
+# @file    attrvalue.pm
+#
+# @brief   This module defines SAI Metadata Attribute Value Helpers Parser
+#
+
+package attrvalue;
+
+use strict;
+use warnings;
+use diagnostics;
+use Data::Dumper;
+use utils;
+use xmlutils;
+
+require Exporter;
+
+my %TYPES_INFO = ();
+my %CREATED = ();
+
+sub GetTypeInfo
+{
+    my $type = shift;
+
+    if (not defined $TYPES_INFO{$type})
+    {
+        my $prefix = (defined $main::SAI_UNIONS{$type}) ? "union_" : "struct_";
+
+        my %typeInfoEx = ExtractStructInfoEx($type, $prefix);
+
+        $TYPES_INFO{$type} = \%typeInfoEx;
+    }
+
+    return $TYPES_INFO{$type};
+}
+
+sub GetMemberType
+{
+    my ($refTypeInfo, $member) = @_;
+
+    my $type = $refTypeInfo->{membersHash}{$member}{type};
+
+    $type =~ s/^const\s+//;
+
+    return $type;
+}
+
+sub GetTypeKind
+{
+    #
+    # scalars and fixed size arrays are compared and hashed as memory, all
+    # other types get their own equal and hash functions, so union members
+    # are compared only when they are valid and struct padding is skipped
+    #
+
+    my $type = shift;
+
+    return "string" if $type =~ /^char\[\d+\]$/;
+    return "bytes"  if $type =~ /\[\d+\]$/;
+    return "scalar" if $type =~ /^(bool|sai_size_t|sai_pointer_t|u?int\d+_t)$/;
+
+    if (defined $main::PRIMITIVE_TYPES{$type})
+    {
+        return ($main::PRIMITIVE_TYPES{$type}{isarray} == 1) ? "bytes" : "scalar";
+    }
+
+    return "scalar" if defined $main::SAI_ENUMS{$type};
+    return "union"  if defined $main::SAI_UNIONS{$type};
+    return "list"   if defined $main::ALL_STRUCTS{$type} and $type =~ /^sai_\w+_list_t$/;
+    return "struct" if defined $main::ALL_STRUCTS{$type};
+
+    LogError "type '$type' is not supported in attribute value, FIXME";
+
+    return "";
+}
+
+sub GetListElementType
+{
+    my $type = shift;
+
+    my $refTypeInfo = GetTypeInfo($type);
+
+    if (not defined $refTypeInfo->{membersHash}{count} or not defined $refTypeInfo->{membersHash}{list})
+    {
+        LogError "list $type must contain count and list members";
+        return undef;
+    }
+
+    my $elementType = GetMemberType($refTypeInfo, "list");
+
+    return $1 if $elementType =~ /^(\w+)\s*\*$/;
+
+    LogError "list member of $type is not pointer: '$elementType'";
+
+    return undef;
+}
+
+sub GetPassParams
+{
+    my ($refTypeInfo, $member, $var) = @_;
+
+    my $passparam = $refTypeInfo->{membersHash}{$member}{passparam};
+
+    return "" if not defined $passparam;
+
+    return "" if GetTypeKind(GetMemberType($refTypeInfo, $member)) ne "union";
+
+    my $params = "";
+
+    for my $param (@$passparam)
+    {
+        if (not defined $refTypeInfo->{membersHash}{$param})
+        {
+            LogError "passparam '$param' on $refTypeInfo->{name} $member is not supported in attribute value";
+            next;
+        }
+
+        $params .= "$var->$param, ";
+    }
+
+    return $params;
+}
+
+sub GetCondition
+{
+    my ($refTypeInfo, $member, $var) = @_;
+
+    my $validonly = $refTypeInfo->{membersHash}{$member}{validonly};
+
+    return undef if not defined $validonly;
+
+    my @conditions = @$validonly;
+
+    if (scalar @conditions != 1 or not $conditions[0] =~ /^(\w+) == (\w+)$/)
+    {
+        LogError "validonly '@conditions' on $refTypeInfo->{name} $member is not supported in attribute value";
+        return undef;
+    }
+
+    return "$var->$1 == $2" if defined $refTypeInfo->{membersHash}{$1};
+
+    return "$1 == $2";
+}
+
+sub GetEqualExpr
+{
+    #
+    # returns expression which is true when values are equal, or when they
+    # differ if $equal is false
+    #
+
+    my ($type, $a, $b, $params, $equal) = @_;
+
+    my $kind = GetTypeKind($type);
+
+    my $op = $equal ? "==" : "!=";
+
+    return "$a $op $b" if $kind eq "scalar";
+
+    return "memcmp($a, $b, sizeof($a)) $op 0" if $kind eq "bytes";
+
+    return "strncmp($a, $b, sizeof($a)) $op 0" if $kind eq "string";
+
+    my $base = GetTypeInfo($type)->{baseName};
+
+    my $call = "sai_metadata_equal_$base($params&$a, &$b)";
+
+    return $equal ? $call : "!$call";
+}
+
+sub GetHashExpr
+{
+    my ($type, $value, $params) = @_;
+
+    my $kind = GetTypeKind($type);
+
+    return "sai_metadata_attr_hash_bytes(hash, &$value, sizeof($value))" if $kind eq "scalar" or $kind eq "bytes";
+
+    return "sai_metadata_attr_hash_string(hash, $value, sizeof($value))" if $kind eq "string";
+
+    my $base = GetTypeInfo($type)->{baseName};
+
+    return "sai_metadata_hash_$base(hash, $params&$value)";
+}
+
+sub IsMemoryComparable
+{
+    my $kind = GetTypeKind(shift);
+
+    return ($kind eq "scalar" or $kind eq "bytes");
+}
+
+sub CreateListFunctions
+{
+    my ($refTypeInfo, $elementType) = @_;
+
+    my $name = $refTypeInfo->{name};
+    my $base = $refTypeInfo->{baseName};
+
+    WriteSource "static bool sai_metadata_equal_$base(";
+    WriteSource "_In_ const $name *a,";
+    WriteSource "_In_ const $name *b)";
+    WriteSource "{";
+    WriteSource "if (a->count != b->count)";
+    WriteSource "{";
+    WriteSource "return false;";
+    WriteSource "}\n";
+    WriteSource "if (a->count == 0 || a->list == b->list)";
+    WriteSource "{";
+    WriteSource "return true;";
+    WriteSource "}\n";
+    WriteSource "if (a->list == NULL || b->list == NULL)";
+    WriteSource "{";
+    WriteSource "return false;";
+    WriteSource "}\n";
+
+    if (IsMemoryComparable($elementType))
+    {
+        WriteSource "return memcmp(a->list, b->list, a->count * sizeof(*a->list)) == 0;";
+    }
+    else
+    {
+        my $differs = GetEqualExpr($elementType, "a->list[idx]", "b->list[idx]", "", 0);
+
+        WriteSource "uint32_t idx;\n";
+        WriteSource "for (idx = 0; idx < a->count; idx++)";
+        WriteSource "{";
+        WriteSource "if ($differs)";
+        WriteSource "{";
+        WriteSource "return false;";
+        WriteSource "}";
+        WriteSource "}\n";
+        WriteSource "return true;";
+    }
+
+    WriteSource "}\n";
+
+    WriteSource "static uint64_t sai_metadata_hash_$base(";
+    WriteSource "_In_ uint64_t hash,";
+    WriteSource "_In_ const $name *value)";
+    WriteSource "{";
+    WriteSource "hash = sai_metadata_attr_hash_bytes(hash, &value->count, sizeof(value->count));\n";
+    WriteSource "if (value->count == 0 || value->list == NULL)";
+    WriteSource "{";
+    WriteSource "return hash;";
+    WriteSource "}\n";
+
+    if (IsMemoryComparable($elementType))
+    {
+        WriteSource "return sai_metadata_attr_hash_bytes(hash, value->list, value->count * sizeof(*value->list));";
+    }
+    else
+    {
+        my $expr = GetHashExpr($elementType, "value->list[idx]", "");
+
+        WriteSource "uint32_t idx;\n";
+        WriteSource "for (idx = 0; idx < value->count; idx++)";
+        WriteSource "{";
+        WriteSource "hash = $expr;";
+        WriteSource "}\n";
+        WriteSource "return hash;";
+    }
+
+    WriteSource "}\n";
+}
+
+sub CreateStructEqual
+{
+    my $refTypeInfo = shift;
+
+    my $name = $refTypeInfo->{name};
+    my $base = $refTypeInfo->{baseName};
+
+    WriteSource "static bool sai_metadata_equal_$base(";
+    WriteSource "_In_ $_," for @{ $refTypeInfo->{extraparam} };
+    WriteSource "_In_ const $name *a,";
+    WriteSource "_In_ const $name *b)";
+    WriteSource "{";
+
+    for my $member (@{ $refTypeInfo->{keys} })
+    {
+        my $type = GetMemberType($refTypeInfo, $member);
+
+        my $params = GetPassParams($refTypeInfo, $member, "a");
+
+        my $condition = GetCondition($refTypeInfo, $member, "a");
+
+        if (defined $refTypeInfo->{union})
+        {
+            # only valid union member is compared
+
+            WriteSource "if ($condition)";
+            WriteSource "{";
+            WriteSource "return " . GetEqualExpr($type, "a->$member", "b->$member", $params, 1) . ";";
+            WriteSource "}\n";
+            next;
+        }
+
+        my $differs = GetEqualExpr($type, "a->$member", "b->$member", $params, 0);
+
+        $differs = "$condition && ($differs)" if defined $condition;
+
+        WriteSource "if ($differs)";
+        WriteSource "{";
+        WriteSource "return false;";
+        WriteSource "}\n";
+    }
+
+    WriteSource "return true;";
+    WriteSource "}\n";
+}
+
+sub CreateStructHash
+{
+    my $refTypeInfo = shift;
+
+    my $name = $refTypeInfo->{name};
+    my $base = $refTypeInfo->{baseName};
+
+    WriteSource "static uint64_t sai_metadata_hash_$base(";
+    WriteSource "_In_ uint64_t hash,";
+    WriteSource "_In_ $_," for @{ $refTypeInfo->{extraparam} };
+    WriteSource "_In_ const $name *value)";
+    WriteSource "{";
+
+    for my $member (@{ $refTypeInfo->{keys} })
+    {
+        my $type = GetMemberType($refTypeInfo, $member);
+
+        my $expr = GetHashExpr($type, "value->$member", GetPassParams($refTypeInfo, $member, "value"));
+
+        my $condition = GetCondition($refTypeInfo, $member, "value");
+
+        if (defined $refTypeInfo->{union})
+        {
+            WriteSource "if ($condition)";
+            WriteSource "{";
+            WriteSource "return $expr;";
+            WriteSource "}\n";
+        }
+        elsif (defined $condition)
+        {
+            WriteSource "if ($condition)";
+            WriteSource "{";
+            WriteSource "hash = $expr;";
+            WriteSource "}\n";
+        }
+        else
+        {
+            WriteSource "hash = $expr;\n";
+        }
+    }
+
+    WriteSource "return hash;";
+    WriteSource "}\n";
+}
+
+sub CreateTypeFunctions
+{
+    #
+    # creates equal and hash functions for struct, list or union type and all
+    # types it depends on, dependencies are created first so no forward
+    # declarations are needed
+    #
+
+    my $type = shift;
+
+    my $kind = GetTypeKind($type);
+
+    return if not $kind =~ /^(struct|list|union)$/;
+
+    return if defined $CREATED{$type};
+
+    $CREATED{$type} = 1;
+
+    my $refTypeInfo = GetTypeInfo($type);
+
+    if ($kind eq "list")
+    {
+        my $elementType = GetListElementType($type);
+
+        return if not defined $elementType;
+
+        CreateTypeFunctions($elementType);
+
+        if (scalar GetValueTypeLists($elementType, "list") != 0)
+        {
+            LogError "elements of list $type contain lists, attribute copy supports only single level lists";
+        }
+
+        CreateListFunctions($refTypeInfo, $elementType);
+
+        return;
+    }
+
+    if ($kind eq "union" and not defined $refTypeInfo->{extraparam})
+    {
+        LogError "union $type requires extraparam to be used in attribute value";
+        return;
+    }
+
+    $refTypeInfo->{extraparam} = [] if not defined $refTypeInfo->{extraparam};
+
+    for my $member (@{ $refTypeInfo->{keys} })
+    {
+        if (defined $refTypeInfo->{union} and not defined $refTypeInfo->{membersHash}{$member}{validonly})
+        {
+            LogError "union $type member $member requires validonly to be used in attribute value";
+        }
+
+        CreateTypeFunctions(GetMemberType($refTypeInfo, $member));
+    }
+
+    CreateStructEqual($refTypeInfo);
+
+    CreateStructHash($refTypeInfo);
+}
+
+sub GetUnionMembersByValueType
+{
+    #
+    # maps value type to union member, using the same naming rules as
+    # attribute value types are derived from union member types
+    #
+
+    my ($unionName, $prefix) = @_;
+
+    my %union = ExtractStructInfo($unionName, "union_");
+
+    my %types = ();
+    my %typesToVt = ();
+
+    main::ProcessValues(\%union, \%types, \%typesToVt);
+
+    my %members = ();
+
+    $members{"${prefix}BOOL"} = { member => "booldata", type => "bool" } if defined $union{booldata};
+
+    for my $type (keys %types)
+    {
+        $members{"$prefix$typesToVt{$type}"} = { member => $types{$type}, type => $type };
+    }
+
+    return (\%members, \%union);
+}
+
+sub GetValueTypes
+{
+    #
+    # each value type is described by parts of attribute value which are
+    # compared, hashed and searched for lists, acl field and action data
+    # parts are valid only when acl field or action is enabled
+    #
+
+    my ($values) = GetUnionMembersByValueType("sai_attribute_value_t", "SAI_ATTR_VALUE_TYPE_");
+    my ($fields) = GetUnionMembersByValueType("sai_acl_field_data_data_t", "SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_");
+    my ($actions) = GetUnionMembersByValueType("sai_acl_action_parameter_t", "SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_");
+
+    my (undef, $masks) = GetUnionMembersByValueType("sai_acl_field_data_mask_t", "");
+
+    $values->{SAI_ATTR_VALUE_TYPE_CHARDATA} = { member => "chardata", type => "char[32]" };
+
+    my @valueTypes = ();
+
+    for my $vt (@{ $main::SAI_ENUMS{sai_attr_value_type_t}{values} })
+    {
+        my %valueType = (name => $vt, parts => []);
+
+        if (defined $fields->{$vt})
+        {
+            my $member = $fields->{$vt}{member};
+
+            $valueType{container} = "aclfield";
+            $valueType{ctype} = "sai_acl_field_data_t";
+
+            push @{ $valueType{parts} }, { path => "mask.$member", type => $fields->{$vt}{type} } if defined $masks->{$member};
+            push @{ $valueType{parts} }, { path => "data.$member", type => $fields->{$vt}{type} };
+        }
+        elsif (defined $actions->{$vt})
+        {
+            $valueType{container} = "aclaction";
+            $valueType{ctype} = "sai_acl_action_data_t";
+
+            push @{ $valueType{parts} }, { path => "parameter.$actions->{$vt}{member}", type => $actions->{$vt}{type} };
+        }
+        elsif (defined $values->{$vt})
+        {
+            push @{ $valueType{parts} }, { path => $values->{$vt}{member}, type => $values->{$vt}{type} };
+        }
+        else
+        {
+            # value type used only in notifications or stats, not in attributes
+
+            LogDebug "attribute value type $vt has no attribute value union member";
+            next;
+        }
+
+        CreateTypeFunctions($_->{type}) for @{ $valueType{parts} };
+
+        push @valueTypes, \%valueType;
+    }
+
+    return @valueTypes;
+}
+
+sub CreateAclValueTypeFunctions
+{
+    my $refValueType = shift;
+
+    my $name = $refValueType->{ctype};
+    my $base = lc($refValueType->{name});
+
+    $base =~ s/^sai_attr_value_type_//;
+
+    $refValueType->{base} = $base;
+
+    WriteSource "static bool sai_metadata_equal_$base(";
+    WriteSource "_In_ const $name *a,";
+    WriteSource "_In_ const $name *b)";
+    WriteSource "{";
+    WriteSource "if (a->enable != b->enable)";
+    WriteSource "{";
+    WriteSource "return false;";
+    WriteSource "}\n";
+    WriteSource "if (!a->enable)";
+    WriteSource "{";
+    WriteSource "return true;";
+    WriteSource "}\n";
+
+    for my $part (@{ $refValueType->{parts} })
+    {
+        my $differs = GetEqualExpr($part->{type}, "a->$part->{path}", "b->$part->{path}", "", 0);
+
+        WriteSource "if ($differs)";
+        WriteSource "{";
+        WriteSource "return false;";
+        WriteSource "}\n";
+    }
+
+    WriteSource "return true;";
+    WriteSource "}\n";
+
+    WriteSource "static uint64_t sai_metadata_hash_$base(";
+    WriteSource "_In_ uint64_t hash,";
+    WriteSource "_In_ const $name *value)";
+    WriteSource "{";
+    WriteSource "hash = sai_metadata_attr_hash_bytes(hash, &value->enable, sizeof(value->enable));\n";
+    WriteSource "if (!value->enable)";
+    WriteSource "{";
+    WriteSource "return hash;";
+    WriteSource "}\n";
+
+    for my $part (@{ $refValueType->{parts} })
+    {
+        WriteSource "hash = " . GetHashExpr($part->{type}, "value->$part->{path}", "") . ";\n";
+    }
+
+    WriteSource "return hash;";
+    WriteSource "}\n";
+}
+
+sub CreateAttrValueEqual
+{
+    my @valueTypes = @_;
+
+    WriteHeader "extern bool sai_metadata_attr_value_equal(";
+    WriteHeader "_In_ sai_attr_value_type_t attrvaluetype,";
+    WriteHeader "_In_ const sai_attribute_value_t *a,";
+    WriteHeader "_In_ const sai_attribute_value_t *b);";
+
+    WriteSource "bool sai_metadata_attr_value_equal(";
+    WriteSource "_In_ sai_attr_value_type_t attrvaluetype,";
+    WriteSource "_In_ const sai_attribute_value_t *a,";
+    WriteSource "_In_ const sai_attribute_value_t *b)";
+    WriteSource "{";
+    WriteSource "switch (attrvaluetype)";
+    WriteSource "{";
+
+    for my $vt (@valueTypes)
+    {
+        WriteSource "case $vt->{name}:";
+
+        if (defined $vt->{container})
+        {
+            WriteSource "    return sai_metadata_equal_$vt->{base}(&a->$vt->{container}, &b->$vt->{container});\n";
+            next;
+        }
+
+        my $part = $vt->{parts}[0];
+
+        WriteSource "    return " . GetEqualExpr($part->{type}, "a->$part->{path}", "b->$part->{path}", "", 1) . ";\n";
+    }
+
+    WriteSource "default:";
+    WriteSource "    SAI_META_LOG_ERROR(\"attribute value type %d is not supported\", attrvaluetype);";
+    WriteSource "    return false;";
+    WriteSource "}";
+    WriteSource "}";
+}
+
+sub CreateAttrValueHash
+{
+    my @valueTypes = @_;
+
+    WriteHeader "extern uint64_t sai_metadata_attr_value_hash(";
+    WriteHeader "_In_ sai_attr_value_type_t attrvaluetype,";
+    WriteHeader "_In_ uint64_t hash,";
+    WriteHeader "_In_ const sai_attribute_value_t *value);";
+
+    WriteSource "uint64_t sai_metadata_attr_value_hash(";
+    WriteSource "_In_ sai_attr_value_type_t attrvaluetype,";
+    WriteSource "_In_ uint64_t hash,";
+    WriteSource "_In_ const sai_attribute_value_t *value)";
+    WriteSource "{";
+    WriteSource "switch (attrvaluetype)";
+    WriteSource "{";
+
+    for my $vt (@valueTypes)
+    {
+        WriteSource "case $vt->{name}:";
+
+        if (defined $vt->{container})
+        {
+            WriteSource "    return sai_metadata_hash_$vt->{base}(hash, &value->$vt->{container});\n";
+            next;
+        }
+
+        my $part = $vt->{parts}[0];
+
+        WriteSource "    return " . GetHashExpr($part->{type}, "value->$part->{path}", "") . ";\n";
+    }
+
+    WriteSource "default:";
+    WriteSource "    SAI_META_LOG_ERROR(\"attribute value type %d is not supported\", attrvaluetype);";
+    WriteSource "    return hash;";
+    WriteSource "}";
+    WriteSource "}";
+}
+
+sub GetValueTypeLists
+{
+    #
+    # returns paths of all lists in given part of attribute value, lists can
+    # be nested in structs (like acl capability action list), but not in list
+    # elements or unions
+    #
+
+    my ($type, $path) = @_;
+
+    my $kind = GetTypeKind($type);
+
+    return ({ path => $path, elementType => GetListElementType($type) }) if $kind eq "list";
+
+    return () if $kind ne "struct";
+
+    my $refTypeInfo = GetTypeInfo($type);
+
+    my @lists = ();
+
+    for my $member (@{ $refTypeInfo->{keys} })
+    {
+        push @lists, GetValueTypeLists(GetMemberType($refTypeInfo, $member), "$path.$member");
+    }
+
+    return @lists;
+}
+
+sub CreateAttrValueLists
+{
+    my @valueTypes = @_;
+
+    my $max = 0;
+
+    WriteSource "uint32_t sai_metadata_attr_value_lists(";
+    WriteSource "_In_ sai_attr_value_type_t attrvaluetype,";
+    WriteSource "_Out_ sai_metadata_attr_value_list_t *lists)";
+    WriteSource "{";
+    WriteSource "switch (attrvaluetype)";
+    WriteSource "{";
+
+    for my $vt (@valueTypes)
+    {
+        my $prefix = (defined $vt->{container}) ? "$vt->{container}." : "";
+
+        my @lists = ();
+
+        push @lists, GetValueTypeLists($_->{type}, "$prefix$_->{path}") for @{ $vt->{parts} };
+
+        next if scalar @lists == 0;
+
+        WriteSource "case $vt->{name}:";
+
+        my $idx = 0;
+
+        for my $list (@lists)
+        {
+            WriteSource "    lists[$idx].count_offset = offsetof(sai_attribute_value_t, $list->{path}.count);";
+            WriteSource "    lists[$idx].list_offset = offsetof(sai_attribute_value_t, $list->{path}.list);";
+            WriteSource "    lists[$idx].element_size = sizeof($list->{elementType});";
+
+            $idx++;
+        }
+
+        WriteSource "    return $idx;\n";
+
+        $max = $idx if $idx > $max;
+    }
+
+    WriteSource "default:";
+    WriteSource "    return 0;";
+    WriteSource "}";
+    WriteSource "}";
+
+    WriteHeader "#define SAI_METADATA_ATTR_VALUE_LISTS_MAX $max\n";
+
+    WriteHeader "extern uint32_t sai_metadata_attr_value_lists(";
+    WriteHeader "_In_ sai_attr_value_type_t attrvaluetype,";
+    WriteHeader "_Out_ sai_metadata_attr_value_list_t *lists);";
+}
+
+sub CreateAttrValueMethods
+{
+    WriteSourceSectionComment "Attribute value equal and hash helpers";
+
+    my @valueTypes = GetValueTypes();
+
+    for my $vt (@valueTypes)
+    {
+        CreateAclValueTypeFunctions($vt) if defined $vt->{container};
+    }
+
+    WriteSectionComment "Attribute value equal";
+
+    CreateAttrValueEqual(@valueTypes);
+
+    WriteSectionComment "Attribute value hash";
+
+    CreateAttrValueHash(@valueTypes);
+
+    WriteSectionComment "Attribute value lists";
+
+    CreateAttrValueLists(@valueTypes);
+}
+
+BEGIN
+{
+    our @ISA    = qw(Exporter);
+    our @EXPORT = qw/
+    CreateAttrValueMethods
+    /;
+}
+
+1;
@@ -67,6 +67,18 @@ const my $THRIFT_GEN_DIR => 'gen-cpp';
 const my $COUNTER        => -1;
 const my $RETVAL         => 0;
 
+# Members of attribute value, which have converters in sai_rpc_frontend.cpp.
+# List member is converted if its element type is in this set.
+const my %ATTR_VALUE_ELEMENT_TYPES => map { $_ => 1 } qw(
+  bool ARRAY=>char sai_object_id_t
+  sai_uint8_t sai_int8_t sai_uint16_t sai_int16_t
+  sai_uint32_t sai_int32_t sai_uint64_t sai_int64_t
+  uint8_t int8_t uint16_t int16_t uint32_t int32_t
+  sai_mac_t sai_ip4_t sai_ip6_t sai_ip_address_t sai_ip_prefix_t
+  sai_u32_range_t sai_s32_range_t sai_u16_range_t
+  sai_acl_resource_t sai_acl_capability_t sai_qos_map_t
+);
+
 # Keep the dbg data sorted, to make it comparable
 $Data::Dumper::Sortkeys = 1;
 
@@ -93,6 +105,7 @@ my $sai_dir = catdir( dirname($script_dir) );
     [ 'dev-utils:s',     'Generate additional development utils within the generated code. Additional options: [=log,zero]',      { default => 0 }        ],
     [ 'adapter_logger',  'Enable the logger in sai_adapter, it will log all the method invocation.',                              { default => 0}         ],
     [ 'attr-header',     'Generate additional header of attributes definitions (including object types)',                         { default => 0 }        ],
+    [ 'binary-address',  'Carry MAC and IP addresses as binary instead of strings in sai.thrift',                                 { default => 0 }        ],
     [ 'help|h',          'Print this help',                                                                                       { shortcircuit => 1 }   ],
 );
 #>>>
@@ -118,6 +131,7 @@ my $mandatory_attrs = $args->mandatory_attrs;
 my $dev_utils       = ( $args->dev_utils ne q{} ? $args->dev_utils : 1 );
 my $adapter_logger   = ( $args->adapter_logger ne q{} ? $args->adapter_logger : 1 );
 my $attr_header     = $args->attr_header;
+my $binary_address  = $args->binary_address;
 
 # Configure SAI meta
 my $sai_meta_dir = catdir( $sai_dir, 'meta' );
@@ -159,6 +173,10 @@ my $vars = {
     functions       => $data->{functions},
     methods         => $data->{methods},
     structs         => $data->{structs},
+    value_types     => get_attr_value_types( $data->{apis}, $data->{structs} ),
+    address_members => get_address_members( $data->{structs} ),
+    operations      => get_operations( $data->{apis}, $data->{methods} ),
+    binary_address  => $binary_address,
     dbg             => $dbg,
     mandatory_attrs => $mandatory_attrs,
     dev_utils       => $dev_utils,
@@ -482,6 +500,202 @@ sub assign_attr_types {
     return $apis;
 }
 
+# Attribute values are converted by functions generated for each attribute
+# value type, and RPC server picks them by attrvaluetype of attribute metadata.
+# Value type name is derived from the type of attribute value member, the same
+# way as SAI meta parse.pl does. Members of ACL field and ACL action data are
+# converted together with enable flag and mask.
+sub get_attr_value_types {
+    my $apis    = shift;
+    my $structs = shift;
+
+    my %unions = map { $_->name => $_ } @{ $apis->{common}->{structs} };
+
+    #<<<
+    my @containers = (
+        { union => 'sai_attribute_value_t',      prefix => q{},                enable => undef,              data => q{},                    mask_union => undef,                       mask => undef            },
+        { union => 'sai_acl_field_data_data_t',  prefix => 'ACL_FIELD_DATA_',  enable => 'aclfield.enable',  data => 'aclfield.data.',       mask_union => 'sai_acl_field_data_mask_t', mask => 'aclfield.mask.' },
+        { union => 'sai_acl_action_parameter_t', prefix => 'ACL_ACTION_DATA_', enable => 'aclaction.enable', data => 'aclaction.parameter.', mask_union => undef,                       mask => undef            },
+    );
+    #>>>
+
+    my @value_types;
+
+    for my $container (@containers) {
+        my $union = $unions{ $container->{union} }
+          or croak "$container->{union} not found";
+
+        my %masks;
+        if ( $container->{mask_union} ) {
+            my $mask_union = $unions{ $container->{mask_union} }
+              or croak "$container->{mask_union} not found";
+
+            $masks{ $_->name } = 1 for @{ $mask_union->members };
+        }
+
+        for my $member ( @{ $union->members } ) {
+            my $type    = $member->type;
+            my $element = $type->name;
+            my $list;
+
+            # List structs are converted element by element
+            my $struct = $structs->{ $type->thrift_name };
+            if ( $struct and not $ATTR_VALUE_ELEMENT_TYPES{$element} ) {
+                ($list) = grep { $_->name eq 'list' and $_->is_list }
+                  @{ $struct->members };
+
+                next unless $list;
+
+                $element = $list->type->subtype->name;
+            }
+
+            next unless $ATTR_VALUE_ELEMENT_TYPES{$element};
+
+            my $name = $type->name;
+            if    ( $name eq 'bool' ) { $name = 'BOOL' }
+            elsif ( $name =~ /char/ ) { $name = 'CHARDATA' }
+            elsif ( $name =~ /^sai_(\w+)_t$/ ) {
+                $name = $1;
+                $name =~ s/^s(\d+)/INT$1/;
+                $name =~ s/^u(\d+)/UINT$1/;
+                $name =~ s/^ip(\d+)/IPV$1/;
+                $name = uc $name;
+            }
+            else {
+                croak "Unknown attribute value type $name";
+            }
+
+            $name = $container->{prefix} . $name;
+
+            my @paths = ( $container->{data} );
+            push @paths, $container->{mask} if $masks{ $member->name };
+
+            my @fields;
+            push @fields,
+              { sai => $container->{enable}, thrift => $container->{enable} }
+              if $container->{enable};
+
+            for my $path (@paths) {
+                push @fields,
+                  {
+                    sai         => $path . $member->name,
+                    thrift      => $path . $member->thrift_name,
+                    thrift_list => $list ? $list->thrift_name : undef
+                  };
+            }
+
+            push @value_types,
+              {
+                name   => "SAI_ATTR_VALUE_TYPE_$name",
+                suffix => lc $name,
+                fields => \@fields
+              };
+        }
+    }
+
+    return \@value_types;
+}
+
+# With binary addresses sai_adapter converts MAC and IP address strings to
+# bytes and back, so it needs to know which members of thrift structs hold
+# addresses. Result maps struct thrift name to its members, member maps to
+# the address kind, or to undef if it is a struct (or list of structs) which
+# contains addresses itself.
+sub get_address_members {
+    my $structs = shift;
+
+    my %kinds = ( sai_mac_t => 'mac', sai_ip4_t => 'ip4', sai_ip6_t => 'ip6' );
+    my %members;
+    my $found = 1;
+
+    # Nested structs are found in any order, so repeat until nothing new
+    while ($found) {
+        $found = 0;
+
+        for my $struct ( values %{$structs} ) {
+            for my $member ( @{ $struct->members } ) {
+                my $type = $member->type;
+                $type = $type->subtype if $type->is_list;
+
+                my $kind = $kinds{ $type->name };
+
+                next
+                  unless $kind
+                  or exists $members{ $type->thrift_name };
+
+                my $struct_members = $members{ $struct->thrift_name } //= {};
+                next if exists $struct_members->{ $member->thrift_name };
+
+                $struct_members->{ $member->thrift_name } = $kind;
+                $found = 1;
+            }
+        }
+    }
+
+    # Attribute list is defined by sai.thrift template, not by SAI headers
+    $members{sai_thrift_attribute_list_t} = { attr_list => undef }
+      if exists $members{sai_thrift_attribute_t};
+
+    return \%members;
+}
+
+# Create, remove and set calls can be pipelined: sai_adapter sends them in
+# batches, and RPC server executes them through handlers generated for each
+# object type. Objects which are not object ids are keyed by entry struct of
+# the same name, e.g. route_entry.
+sub get_operations {
+    my $apis    = shift;
+    my $methods = shift;
+
+    my @operations;
+
+    for my $api ( sort keys %{$apis} ) {
+        next if $api eq 'common';
+
+        my $objects = $apis->{$api}->{objects} or next;
+        my %entries =
+          map { $_->short_name => $_ } @{ $apis->{$api}->{structs} // [] };
+        my %handlers;
+
+        for my $function ( @{ $apis->{$api}->{functions} // [] } ) {
+            my $operation = $function->operation // q{};
+
+            next unless $operation =~ /^(?:create|remove|set)$/;
+            next unless $function->name =~ /^$operation\_/;
+
+            # Bulk functions (e.g. create_route_entries) are not pipelined,
+            # their object name is not name of any object
+            my $object = $function->object;
+            next unless exists $objects->{$object};
+
+            # Switch is created without switch id, and only once
+            next if $function->name eq 'create_switch';
+
+            my $method = $methods->{ $function->name } or next;
+
+            $handlers{$object}->{$operation} = {
+                method      => $method,
+                thrift_name => $function->thrift_name
+            };
+        }
+
+        for my $object ( sort keys %handlers ) {
+            push @operations,
+              {
+                api         => $api,
+                object      => $object,
+                object_type => 'SAI_OBJECT_TYPE_' . uc $object,
+                entry       => $entries{$object}
+                ? $entries{$object}->thrift_name
+                : undef,
+                %{ $handlers{$object} }
+              };
+        }
+    }
+
+    return \@operations;
+}
+
 # Create and store the object type Enum
 sub get_object_types {
     my $api_name = shift;
@@ -97,6 +97,17 @@ sai_status_t sai_get_object_key(
     _Inout_ sai_object_key_t *object_list)
 { return SAI_STATUS_NOT_IMPLEMENTED; }
 
+sai_status_t sai_get_object_key_page(
+    _In_ sai_object_id_t switch_id,
+    _In_ sai_object_type_t object_type,
+    _Inout_ sai_object_key_cursor_t *cursor,
+    _Inout_ uint32_t *object_count,
+    _Out_ sai_object_key_t *object_list,
+    _In_ uint32_t attr_count,
+    _Inout_ sai_attribute_t **attr_list,
+    _Out_ sai_status_t *object_statuses)
+{ return SAI_STATUS_NOT_IMPLEMENTED; }
+
 sai_status_t sai_log_set(
     _In_ sai_api_t api,
     _In_ sai_log_level_t log_level)
@@ -0,0 +1,522 @@
+#!/usr/bin/perl
+#
+# Copyright (c) 2014 Microsoft Open Technologies, Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+#    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+#    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+#    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+#    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+#
+#    See the Apache Version 2.0 License for specific language governing
+#    permissions and limitations under the License.
+#
+#    Microsoft would like to thank the following companies for their review and
+#    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+#    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+#
+# @file    notificationqueue.pm
+#
+# @brief   This module defines SAI Metadata Notification Queue Parser
+#
+
+package notificationqueue;
+
+use strict;
+use warnings;
+use diagnostics;
+use Data::Dumper;
+use utils;
+use xmlutils;
+
+require Exporter;
+
+my %STRUCTS_INFO = ();
+my %DEEP_COPY = ();
+
+sub GetStructInfo
+{
+    my $type = shift;
+
+    if (not defined $STRUCTS_INFO{$type})
+    {
+        my %structInfoEx = ExtractStructInfoEx($type, "struct_");
+
+        $STRUCTS_INFO{$type} = \%structInfoEx;
+    }
+
+    return $STRUCTS_INFO{$type};
+}
+
+sub GetNonConstType
+{
+    my $type = shift;
+
+    $type =~ s/^const\s+//;
+
+    return $type;
+}
+
+sub IsPointerType
+{
+    my $type = shift;
+
+    return $type =~ /\*$/;
+}
+
+sub GetPointedType
+{
+    my $type = GetNonConstType(shift);
+
+    $type =~ s/\s*\*$//;
+
+    return $type;
+}
+
+sub FormatDeclaration
+{
+    my ($type, $name) = @_;
+
+    return "$type$name" if $type =~ /\*$/;
+
+    return "$type $name";
+}
+
+sub GetNotificationBaseName
+{
+    my $ntfName = shift;
+
+    return $1 if $ntfName =~ /^sai_(\w+)_notification_fn$/;
+
+    LogError "notification function '$ntfName' is not ending on _notification_fn";
+
+    return undef;
+}
+
+sub NeedsDeepCopy
+{
+    #
+    # type needs deep copy if it's a pointer, or if it's a struct which
+    # contains (directly or in nested structs) any pointer
+    #
+
+    my $type = GetNonConstType(shift);
+
+    return 1 if IsPointerType($type);
+
+    return 1 if $type eq "sai_attribute_t";
+
+    return 0 if not defined $main::ALL_STRUCTS{$type};
+
+    return $DEEP_COPY{$type} if defined $DEEP_COPY{$type};
+
+    # prevent infinite recursion
+
+    $DEEP_COPY{$type} = 0;
+
+    my $refStructInfoEx = GetStructInfo($type);
+
+    my $deep = 0;
+
+    for my $name (@{ $refStructInfoEx->{keys} })
+    {
+        my $memberType = $refStructInfoEx->{membersHash}{$name}{type};
+
+        next if defined $refStructInfoEx->{membersHash}{$name}{union};
+
+        $deep = 1 if NeedsDeepCopy($memberType);
+    }
+
+    $DEEP_COPY{$type} = $deep;
+
+    return $deep;
+}
+
+sub GetCopyFunctionName
+{
+    my $type = shift;
+
+    my $refStructInfoEx = GetStructInfo($type);
+
+    return "sai_metadata_notification_queue_copy_$refStructInfoEx->{baseName}";
+}
+
+sub GetObjectType
+{
+    my ($refMember, $context) = @_;
+
+    if (not defined $refMember->{objects})
+    {
+        LogError "attribute list '$refMember->{name}' on $context requires object type specified in \@objects";
+        return "SAI_OBJECT_TYPE_NULL";
+    }
+
+    my @objects = @{ $refMember->{objects} };
+
+    if (scalar @objects != 1)
+    {
+        LogError "attribute list '$refMember->{name}' on $context expected only 1 object type, but given '@objects'";
+        return "SAI_OBJECT_TYPE_NULL";
+    }
+
+    return $objects[0];
+}
+
+sub EmitCopyPointer
+{
+    #
+    # dst and src are C expressions, src points to original memory, dst will
+    # point to memory copied into slab
+    #
+
+    my ($dst, $src, $type, $count, $countType, $objectType) = @_;
+
+    my $pointedType = GetPointedType($type);
+
+    my $size = ($pointedType eq "void") ? "(size_t)($count)" : "(size_t)($count) * sizeof(*$src)";
+
+    WriteSource "$dst = sai_metadata_notification_queue_slab_dup(slab, $src, $size);";
+
+    if ($pointedType eq "sai_attribute_t")
+    {
+        WriteSource "sai_metadata_notification_queue_slab_copy_attr_list(slab, $objectType, $count, $dst);";
+        return;
+    }
+
+    return if not NeedsDeepCopy($pointedType);
+
+    my $copyFunction = GetCopyFunctionName($pointedType);
+
+    WriteSource "if ($dst != NULL)";
+    WriteSource "{";
+    WriteSource "$countType idx;\n";
+    WriteSource "for (idx = 0; idx < $count; idx++)";
+    WriteSource "{";
+    WriteSource "$copyFunction(slab, &$dst\[idx\]);";
+    WriteSource "}";
+    WriteSource "}";
+}
+
+sub EmitCopyValue
+{
+    my ($dst, $type) = @_;
+
+    $type = GetNonConstType($type);
+
+    return if not NeedsDeepCopy($type);
+
+    my $copyFunction = GetCopyFunctionName($type);
+
+    WriteSource "$copyFunction(slab, &$dst);";
+}
+
+sub CollectDeepCopyStructs
+{
+    my ($type, $refStructs) = @_;
+
+    $type = GetNonConstType($type);
+
+    $type = GetPointedType($type) if IsPointerType($type);
+
+    return if $type eq "sai_attribute_t";
+
+    return if not NeedsDeepCopy($type);
+
+    return if defined $refStructs->{$type};
+
+    $refStructs->{$type} = 1;
+
+    my $refStructInfoEx = GetStructInfo($type);
+
+    for my $name (@{ $refStructInfoEx->{keys} })
+    {
+        next if defined $refStructInfoEx->{membersHash}{$name}{union};
+
+        CollectDeepCopyStructs($refStructInfoEx->{membersHash}{$name}{type}, $refStructs);
+    }
+}
+
+sub CreateCopyStructs
+{
+    WriteSectionComment "Notification queue deep copy structs";
+
+    my %structs = ();
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        my $refNtf = $main::NOTIFICATIONS{$ntfName};
+
+        for my $name (@{ $refNtf->{keys} })
+        {
+            CollectDeepCopyStructs($refNtf->{membersHash}{$name}{type}, \%structs);
+        }
+    }
+
+    # declare all functions first, since structs can be nested
+
+    for my $type (sort keys %structs)
+    {
+        my $copyFunction = GetCopyFunctionName($type);
+
+        WriteHeader "extern void $copyFunction(";
+        WriteHeader "_Inout_ sai_metadata_notification_queue_slab_t *slab,";
+        WriteHeader "_Inout_ $type *item);";
+    }
+
+    for my $type (sort keys %structs)
+    {
+        my $refStructInfoEx = GetStructInfo($type);
+
+        my $copyFunction = GetCopyFunctionName($type);
+
+        WriteSource "void $copyFunction(";
+        WriteSource "_Inout_ sai_metadata_notification_queue_slab_t *slab,";
+        WriteSource "_Inout_ $type *item)";
+        WriteSource "{";
+
+        my $refMembersHash = $refStructInfoEx->{membersHash};
+
+        for my $name (@{ $refStructInfoEx->{keys} })
+        {
+            next if defined $refMembersHash->{$name}{union};
+
+            my $memberType = $refMembersHash->{$name}{type};
+
+            if (not IsPointerType($memberType))
+            {
+                EmitCopyValue("item->$name", $memberType);
+                next;
+            }
+
+            my $count = $refMembersHash->{$name}{count};
+
+            $count = $refStructInfoEx->{count}{$name} if not defined $count and defined $refStructInfoEx->{count};
+
+            if (not defined $count or not defined $refMembersHash->{$count})
+            {
+                LogError "count must be defined for pointer '$name' in $type";
+                next;
+            }
+
+            my $countType = $refMembersHash->{$count}{type};
+
+            my $objectType = (GetPointedType($memberType) eq "sai_attribute_t") ? GetObjectType($refMembersHash->{$name}, $type) : "";
+
+            EmitCopyPointer("item->$name", "item->$name", $memberType, "item->$count", $countType, $objectType);
+        }
+
+        WriteSource "}";
+    }
+}
+
+sub CreateNotificationParams
+{
+    WriteSectionComment "Notification queue params";
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        my $base = GetNotificationBaseName($ntfName);
+
+        next if not defined $base;
+
+        my $refNtf = $main::NOTIFICATIONS{$ntfName};
+
+        WriteHeader "typedef struct _sai_metadata_notification_queue_${base}_params_t {";
+
+        for my $name (@{ $refNtf->{keys} })
+        {
+            my $type = GetNonConstType($refNtf->{membersHash}{$name}{type});
+
+            WriteHeader FormatDeclaration($type, $name) . ";";
+        }
+
+        WriteHeader "} sai_metadata_notification_queue_${base}_params_t;";
+    }
+}
+
+sub CreateNotificationEnqueue
+{
+    WriteSectionComment "Notification queue enqueue notifications";
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        my $base = GetNotificationBaseName($ntfName);
+
+        next if not defined $base;
+
+        my $refNtf = $main::NOTIFICATIONS{$ntfName};
+
+        my $refMembersHash = $refNtf->{membersHash};
+
+        my @keys = @{ $refNtf->{keys} };
+
+        my $function = "sai_metadata_notification_queue_on_$base";
+
+        my $paramsType = "sai_metadata_notification_queue_${base}_params_t";
+
+        my $ntfType = uc("SAI_SWITCH_NOTIFICATION_TYPE_$base");
+
+        WriteHeader "extern void $function(";
+        WriteSource "void $function(";
+
+        for my $name (@keys)
+        {
+            my $end = ($keys[-1] eq $name) ? ")" : ",";
+            my $endheader = ($keys[-1] eq $name) ? ");" : ",";
+
+            my $decl = FormatDeclaration($refMembersHash->{$name}{type}, $name);
+
+            WriteHeader "_In_ $decl$endheader";
+            WriteSource "_In_ $decl$end";
+        }
+
+        WriteSource "{";
+        WriteSource "sai_metadata_notification_queue_slab_t slab_data;";
+        WriteSource "sai_metadata_notification_queue_slab_t *slab = &slab_data;\n";
+        WriteSource "if (!sai_metadata_notification_queue_reserve($ntfType, slab))";
+        WriteSource "{";
+        WriteSource "return;";
+        WriteSource "}\n";
+        WriteSource "$paramsType *params = sai_metadata_notification_queue_slab_alloc(slab, sizeof($paramsType));\n";
+        WriteSource "if (params != NULL)";
+        WriteSource "{";
+
+        for my $name (@keys)
+        {
+            my $type = $refMembersHash->{$name}{type};
+
+            if (not IsPointerType($type))
+            {
+                WriteSource "params->$name = $name;";
+
+                EmitCopyValue("params->$name", $type);
+
+                next;
+            }
+
+            my $count = $refMembersHash->{$name}{count};
+
+            if (not defined $count)
+            {
+                LogError "count must be defined for pointer '$name' in $ntfName";
+                next;
+            }
+
+            my $countType = ($count =~ /^\d+$/) ? "uint32_t" : $refMembersHash->{$count}{type};
+
+            my $objectType = (GetPointedType($type) eq "sai_attribute_t") ? GetObjectType($refMembersHash->{$name}, $ntfName) : "";
+
+            # count param can be declared after pointer, so use original param
+
+            EmitCopyPointer("params->$name", $name, $type, $count, $countType, $objectType);
+        }
+
+        WriteSource "}\n";
+        WriteSource "sai_metadata_notification_queue_commit(slab, params);";
+        WriteSource "}";
+    }
+}
+
+sub CreateNotificationGetNotifications
+{
+    WriteSectionComment "Notification queue get notifications";
+
+    WriteHeader "extern void sai_metadata_notification_queue_get_notifications(";
+    WriteHeader "_Out_ sai_switch_notifications_t *notifications);";
+
+    WriteSource "void sai_metadata_notification_queue_get_notifications(";
+    WriteSource "_Out_ sai_switch_notifications_t *notifications)";
+    WriteSource "{";
+    WriteSource "memset(notifications, 0, sizeof(sai_switch_notifications_t));\n";
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        my $base = GetNotificationBaseName($ntfName);
+
+        next if not defined $base;
+
+        WriteSource "notifications->on_$base = sai_metadata_notification_queue_on_$base;";
+    }
+
+    WriteSource "}";
+}
+
+sub CreateNotificationDispatch
+{
+    WriteSectionComment "Notification queue dispatch";
+
+    WriteHeader "extern uint32_t sai_metadata_notification_queue_dispatch(";
+    WriteHeader "_In_ const sai_switch_notifications_t *notifications,";
+    WriteHeader "_In_ uint32_t max_count);";
+
+    WriteSource "uint32_t sai_metadata_notification_queue_dispatch(";
+    WriteSource "_In_ const sai_switch_notifications_t *notifications,";
+    WriteSource "_In_ uint32_t max_count)";
+    WriteSource "{";
+    WriteSource "uint32_t dispatched = 0;";
+    WriteSource "int notification_type;";
+    WriteSource "void *params;\n";
+    WriteSource "while (dispatched < max_count && sai_metadata_notification_queue_front(&notification_type, &params))";
+    WriteSource "{";
+    WriteSource "switch (notification_type)";
+    WriteSource "{";
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        my $base = GetNotificationBaseName($ntfName);
+
+        next if not defined $base;
+
+        my $refNtf = $main::NOTIFICATIONS{$ntfName};
+
+        my $paramsType = "sai_metadata_notification_queue_${base}_params_t";
+
+        my $ntfType = uc("SAI_SWITCH_NOTIFICATION_TYPE_$base");
+
+        my $args = join(", ", map { "p->$_" } @{ $refNtf->{keys} });
+
+        WriteSource "case $ntfType:";
+        WriteSource "    if (notifications != NULL && notifications->on_$base != NULL)";
+        WriteSource "    {";
+        WriteSource "    const $paramsType *p = params;\n";
+        WriteSource "    notifications->on_$base($args);";
+        WriteSource "    }";
+        WriteSource "    break;\n";
+    }
+
+    WriteSource "default:";
+    WriteSource "    SAI_META_LOG_ERROR(\"unknown notification type %d\", notification_type);";
+    WriteSource "    break;";
+    WriteSource "}\n";
+    WriteSource "sai_metadata_notification_queue_pop();\n";
+    WriteSource "dispatched++;";
+    WriteSource "}\n";
+    WriteSource "return dispatched;";
+    WriteSource "}";
+}
+
+sub CreateNotificationQueueMethods
+{
+    CreateCopyStructs();
+
+    CreateNotificationParams();
+
+    CreateNotificationEnqueue();
+
+    CreateNotificationGetNotifications();
+
+    CreateNotificationDispatch();
+}
+
+BEGIN
+{
+    our @ISA    = qw(Exporter);
+    our @EXPORT = qw/
+    CreateNotificationQueueMethods
+    /;
+}
+
+1;
@@ -38,6 +38,11 @@ use xmlutils;
 use style;
 use test;
 use serialize;
+use notificationqueue;
+use apilatency;
+use apirecorder;
+use attrvalue;
+use apicache;
 use cap;
 
 our $XMLDIR = "xml";
@@ -69,6 +74,10 @@ our @ALL_ENUMS = ();
 our %GLOBAL_APIS = ();
 our %OBJECT_TYPE_BULK_MAP = ();
 our %SAI_ENUMS_CUSTOM_RANGES = ();
+our %ATTR_METADATA_DECLARED = ();
+our %DEFAULT_VALUE_INITIALIZERS = ();
+our @COMPACT_ATTRS = ();
+our @BUILDER_ATTRS = ();
 
 my $FLAGS = "MANDATORY_ON_CREATE|CREATE_ONLY|CREATE_AND_SET|READ_ONLY|KEY";
 my $ENUM_FLAGS_TYPES = "(none|strict|mixed|ranges|free)";
@@ -94,13 +103,14 @@ my %ATTR_TAGS = (
         );
 
 my %options = ();
-getopts("dsASl", \%options);
+getopts("dsASlc", \%options);
 
 our $optionPrintDebug        = 1 if defined $options{d};
 our $optionDisableAspell     = 1 if defined $options{A};
 our $optionUseXmlSimple      = 1 if defined $options{s};
 our $optionDisableStyleCheck = 1 if defined $options{S};
 our $optionShowLogCaller     = 1 if defined $options{l};
+our $optionCompactLayout     = 1 if defined $options{c};
 
 # LOGGING FUNCTIONS HELPERS
 
@@ -610,6 +620,8 @@ sub ProcessEnumSection
                 if ($initializer =~ /^= (SAI_\w+)$/)
                 {
                     LogError "initializer $1 not defined in $enumtypename before $enumvaluename" if not grep (/^$1$/, @arr);
+
+                    $SAI_ENUMS{$enumtypename}{ignoreinit}{$enumvaluename} = $1;
                 }
                 else
                 {
@@ -1665,37 +1677,39 @@ sub ProcessDefaultValue
 
     my $val = "const sai_attribute_value_t sai_metadata_${attr}_default_value";
 
+    my $init = undef;
+
     if ($default =~ /^(true|false)$/ and $type eq "bool")
     {
-        WriteSource "$val = { .booldata = $default };";
+        $init = "{ .booldata = $default }";
     }
     elsif ($default =~ /^SAI_NULL_OBJECT_ID$/ and $type =~ /^sai_object_id_t$/)
     {
-        WriteSource "$val = { .oid = $default };";
+        $init = "{ .oid = $default }";
     }
     elsif ($default =~ /^SAI_\w+$/ and $type =~ /^sai_\w+_t$/ and not defined $VALUE_TYPES{$type})
     {
-        WriteSource "$val = { .s32 = $default };";
+        $init = "{ .s32 = $default }";
     }
     elsif ($default =~ /^0$/ and $type =~ /^sai_acl_field_data_t (sai_u?int\d+_t)/)
     {
-        WriteSource "$val = { 0 };";
+        $init = "{ 0 }";
     }
     elsif ($default =~ /^ffff\:ffff\:ffff\:ffff\:ffff\:ffff\:ffff\:ffff$/ and $type =~ /^sai_acl_field_data_mask_t (sai_ip6_t)/)
     {
-        WriteSource "$val = { .ip6 = {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255} };";
+        $init = "{ .ip6 = {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255} }";
     }
     elsif ($default =~ /^0$/ and $type =~ /^sai_acl_action_data_t (sai_u?int\d+_t)/)
     {
-        WriteSource "$val = { 0 };";
+        $init = "{ 0 }";
     }
     elsif ($default =~ /^$NUMBER_REGEX$/ and $type =~ /^sai_u?int\d+_t/)
     {
-        WriteSource "$val = { .$VALUE_TYPES{$type} = $default };";
+        $init = "{ .$VALUE_TYPES{$type} = $default }";
     }
     elsif ($default =~ /^NULL$/ and $type =~ /^(sai_pointer_t) (sai_\w+_fn)$/)
     {
-        WriteSource "$val = { .$VALUE_TYPES{$1} = $default };";
+        $init = "{ .$VALUE_TYPES{$1} = $default }";
     }
     elsif ($default =~ /^(attrvalue|attrrange|vendor|empty|const|internal)/)
     {
@@ -1709,29 +1723,36 @@ sub ProcessDefaultValue
     {
         # ipv4 address needs to be converted to uint32 number so we support now only 0.0.0.0
 
-        WriteSource "$val = { .$VALUE_TYPES{$1} = { .addr_family = SAI_IP_ADDR_FAMILY_IPV4, .addr = { .ip4 = 0 } } };";
+        $init = "{ .$VALUE_TYPES{$1} = { .addr_family = SAI_IP_ADDR_FAMILY_IPV4, .addr = { .ip4 = 0 } } }";
     }
     elsif ($default =~ /^disabled$/ and $type =~ /^(sai_acl_action_data_t|sai_acl_field_data_t) /)
     {
-        WriteSource "$val = { .$VALUE_TYPES{$1} = { .enable = false } };";
+        $init = "{ .$VALUE_TYPES{$1} = { .enable = false } }";
     }
     elsif ($default =~ /^""$/ and $type eq "char")
     {
-        WriteSource "$val = { .chardata = { 0 } };";
+        $init = "{ .chardata = { 0 } }";
     }
     elsif ($default =~ /^0\.0\.0\.0$/ and $type =~ /^(sai_ip4_t)/)
     {
-        WriteSource "$val = { 0 };";
+        $init = "{ 0 }";
     }
     elsif ($default =~ /^00:00:00:00:00:00$/ and $type =~ /^(sai_mac_t)/)
     {
-        WriteSource "$val = { .mac = { 0, 0, 0, 0, 0, 0 } };";
+        $init = "{ .mac = { 0, 0, 0, 0, 0, 0 } }";
     }
     else
     {
         LogError "invalid default value '$default' on $attr ($type)";
     }
 
+    if (defined $init)
+    {
+        WriteSource "$val = $init;";
+
+        $DEFAULT_VALUE_INITIALIZERS{$attr} = $init;
+    }
+
     return "&sai_metadata_${attr}_default_value";
 }
 
@@ -1994,11 +2015,151 @@ sub ProcessConditionsGeneric
     return "sai_metadata_${name}s_${attr}";
 }
 
+sub ProcessConditionsFnGeneric
+{
+    my ($attr, $conditions, $name) = @_;
+
+    return "NULL" if not defined $conditions;
+
+    my @conditions = @{ $conditions };
+
+    my $ctype = shift @conditions;
+
+    return "NULL" if not $ctype =~ /^SAI_ATTR_CONDITION_TYPE_(AND|OR|MIXED)$/;
+
+    # empty list makes attribute not conditional, so predicate is never called
+
+    return "NULL" if scalar @conditions == 0;
+
+    #
+    # Conditions are compiled into single C expression, mixed conditions are
+    # in RPN, so operands of AND/OR are taken from stack. Each condition
+    # attribute is looked up only once, and if it's not on the list, its
+    # default value is used, same as in sai_metadata_is_condition_list_met.
+    #
+
+    my @stack = ();
+    my @attrids = ();
+    my %values = ();
+
+    for my $cond (@conditions)
+    {
+        if ($cond =~ /^SAI_ATTR_CONDITION_TYPE_(AND|OR)$/)
+        {
+            my $op = ($1 eq "AND") ? "&&" : "||";
+
+            if (scalar @stack < 2)
+            {
+                LogError "not enough operands for $cond in $name on $attr";
+                return "NULL";
+            }
+
+            my $right = pop @stack;
+            my $left = pop @stack;
+
+            push @stack, "($left $op $right)";
+            next;
+        }
+
+        return "NULL" if not $cond =~ /^(SAI_\w+) == (true|false|SAI_\w+|$NUMBER_REGEX)$/;
+
+        my $attrid = $1;
+        my $val = $2;
+
+        my $attrType = lc("$1t") if $attrid =~ /^(SAI_\w+_ATTR_)/;
+        my $enumTypeName = $METADATA{$attrType}{$attrid}{type};
+
+        return "NULL" if not defined $enumTypeName;
+
+        my $item = "s32";
+
+        if ($val eq "true" or $val eq "false")
+        {
+            $item = "booldata";
+        }
+        elsif ($val =~ /^$NUMBER_REGEX$/ and $enumTypeName =~ /^sai_(u?)int(\d+)_t$/)
+        {
+            $item = (($1 eq "u") ? "u" : "s") . $2;
+        }
+        elsif (not $val =~ /^SAI_/)
+        {
+            return "NULL";
+        }
+
+        if (not defined $values{$attrid})
+        {
+            $values{$attrid} = "value" . scalar(@attrids);
+            push @attrids, $attrid;
+        }
+
+        my $v = $values{$attrid};
+
+        push @stack, "($v != NULL && $v->$item == $val)";
+    }
+
+    my $expr;
+
+    if ($ctype eq "SAI_ATTR_CONDITION_TYPE_MIXED")
+    {
+        if (scalar @stack != 1)
+        {
+            LogError "$name on $attr don't evaluate to single value";
+            return "NULL";
+        }
+
+        $expr = $stack[0];
+    }
+    else
+    {
+        $expr = join(($ctype eq "SAI_ATTR_CONDITION_TYPE_AND") ? " && " : " || ", @stack);
+    }
+
+    for my $attrid (@attrids)
+    {
+        next if defined $ATTR_METADATA_DECLARED{$attrid};
+
+        WriteSource "extern const sai_attr_metadata_t sai_metadata_attr_$attrid;";
+
+        $ATTR_METADATA_DECLARED{$attrid} = 1;
+    }
+
+    my $fname = "sai_metadata_is_${name}_met_$attr";
+
+    WriteSource "bool $fname(";
+    WriteSource "_In_ uint32_t attr_count,";
+    WriteSource "_In_ const sai_attribute_t *attr_list)";
+    WriteSource "{";
+    WriteSource "const sai_attribute_t *attr;";
+
+    for my $attrid (@attrids)
+    {
+        WriteSource "const sai_attribute_value_t *$values{$attrid};";
+    }
+
+    for my $attrid (@attrids)
+    {
+        WriteSource "";
+        WriteSource "attr = sai_metadata_get_attr_by_id($attrid, attr_count, attr_list);";
+        WriteSource "$values{$attrid} = (attr != NULL) ? &attr->value : sai_metadata_attr_$attrid.defaultvalue;";
+    }
+
+    WriteSource "";
+    WriteSource "return $expr;";
+    WriteSource "}";
+
+    return $fname;
+}
+
 sub ProcessConditions
 {
     ProcessConditionsGeneric(@_, "condition");
 }
 
+sub ProcessConditionsFn
+{
+    ProcessConditionsFnGeneric(@_, "condition");
+}
+
 sub ProcessConditionsLen
 {
     my ($attr, $value) = @_;
@@ -2026,6 +2187,11 @@ sub ProcessValidOnly
     ProcessConditionsGeneric(@_, "validonly");
 }
 
+sub ProcessValidOnlyFn
+{
+    ProcessConditionsFnGeneric(@_, "validonly");
+}
+
 sub ProcessValidOnlyLen
 {
     my ($attr, $value) = @_;
@@ -2336,9 +2502,11 @@ sub ProcessSingleObjectType
         my $conditiontype   = ProcessConditionType($attr, $meta{condition});
         my $conditions      = ProcessConditions($attr, $meta{condition}, $meta{type});
         my $conditionslen   = ProcessConditionsLen($attr, $meta{condition});
+        my $conditionfn     = ProcessConditionsFn($attr, $meta{condition});
         my $validonlytype   = ProcessValidOnlyType($attr, $meta{validonly});
         my $validonly       = ProcessValidOnly($attr, $meta{validonly}, $meta{type});
         my $validonlylen    = ProcessValidOnlyLen($attr, $meta{validonly});
+        my $validonlyfn     = ProcessValidOnlyFn($attr, $meta{validonly});
         my $isvlan          = ProcessIsVlan($attr, $meta{isvlan}, $meta{type});
         my $getsave         = ProcessGetSave($attr, $meta{getsave});
         my $isaclfield      = ProcessIsAclField($attr);
@@ -2364,6 +2532,8 @@ sub ProcessSingleObjectType
 
         WriteSource "const sai_attr_metadata_t sai_metadata_attr_$attr = {";
 
+        $ATTR_METADATA_DECLARED{$attr} = 1;
+
         WriteSource ".objecttype                    = (sai_object_type_t)$objecttype,";
         WriteSource ".attrid                        = $attr,";
         WriteSource ".attridname                    = $attrname,";
@@ -2413,9 +2583,73 @@ sub ProcessSingleObjectType
         WriteSource ".isresourcetype                = $isresourcetype,";
         WriteSource ".isdeprecated                  = $isdeprecated,";
         WriteSource ".isconditionrelaxed            = $isrelaxed,";
+        WriteSource ".conditionfn                   = $conditionfn,";
+        WriteSource ".validonlyfn                   = $validonlyfn,";
 
         WriteSource "};";
 
+        if (defined $optionCompactLayout)
+        {
+            my %compact = (
+                    attrid                  => $attr,
+                    attridname              => $attr,
+                    brief                   => $brief,
+                    defaultvalueattrid      => $defvalattrid,
+                    objecttype              => $objecttype,
+                    allowedobjecttypes      => (defined $meta{objects} ? $meta{objects} : []),
+                    defaultvalue            => $DEFAULT_VALUE_INITIALIZERS{$attr},
+                    enummetadata            => $enummetadata,
+                    defaultvalueobjecttype  => $defvalot,
+                    attrvaluetype           => $type,
+                    flags                   => $flags,
+                    defaultvaluetype        => $defvaltype,
+                    notificationtype        => $ntftype,
+                    pointertype             => $ptrtype,
+                    allowrepetitiononlist   => $allowrepeat,
+                    allowmixedobjecttypes   => $allowmixed,
+                    allowemptylist          => $allowempty,
+                    allownullobjectid       => $allownull,
+                    isoidattribute          => "($objectslen > 0)",
+                    storedefaultvalue       => $storedefaultval,
+                    isenum                  => $isenum,
+                    isenumlist              => $isenumlist,
+                    isconditional           => "($conditionslen != 0)",
+                    isvalidonly             => "($validonlylen != 0)",
+                    getsave                 => $getsave,
+                    isvlan                  => $isvlan,
+                    isaclfield              => $isaclfield,
+                    isaclaction             => $isaclaction,
+                    isaclmask               => $isaclmask,
+                    ismandatoryoncreate     => $ismandatoryoncreate,
+                    iscreateonly            => $iscreateonly,
+                    iscreateandset          => $iscreateandset,
+                    isreadonly              => $isreadonly,
+                    iskey                   => $iskey,
+                    isprimitive             => $isprimitive,
+                    iscallback              => $iscallback,
+                    isextensionattr         => $isextensionattr,
+                    isresourcetype          => $isresourcetype,
+                    isdeprecated            => $isdeprecated,
+                    isconditionrelaxed      => $isrelaxed,
+                    );
+
+            push @COMPACT_ATTRS, \%compact;
+        }
+
+        # ACL field and action enums (e.g. "sai_acl_action_data_t
+        # sai_packet_action_t") are set through their data container, which
+        # is type given by value traits
+
+        my $isplainenum = ($isenum eq "true" and $meta{type} =~ /^sai_\w+_t$/);
+
+        push @BUILDER_ATTRS, {
+                attr        => $attr,
+                objecttype  => $objecttype,
+                valuetype   => $type,
+                flags       => $flags,
+                enumtype    => ($isplainenum ? $meta{type} : undef),
+                };
+
         # check enum attributes if their names are ending on enum name
 
         CheckEnumNaming($attr, $meta{type}) if $isenum eq "true" or $isenumlist eq "true";
@@ -3244,6 +3478,10 @@ sub CreateApisStruct
 
     WriteHeader "} sai_apis_t;";
 
+    # scheduler API takes apis struct, so it's included after it's defined
+
+    WriteHeader "#include \"saimetadatascheduler.h\"";
+
     my $count = scalar @apis;
 
     WriteSectionComment "Define SAI_API_EXTENSIONS_MAX";
@@ -3648,6 +3886,8 @@ sub ProcessGenericQuadBulkApi
 
             my $f = ($name =~ /set|get/) ? "${name}_${small}s_attribute" : "${name}_${small}s";
 
+            $f =~ s/entrys/entries/;
+
             my $p = ($name eq "create") ? "switch_id, object_count, attr_count, attr_list, mode, objects, object_statuses" : $params;
 
             WriteSource "status = (apis->${api}_api && apis->${api}_api->${f})";
@@ -4192,6 +4432,533 @@ sub CreateListOfAllAttributes
     WriteHeader "extern const size_t sai_metadata_attr_sorted_by_id_name_count;";
 }
 
+#
+# Hash functions below must match sai_metadata_attr_id_name_hash() and
+# sai_metadata_attr_id_name_hash_mix() in saimetadatautils.c
+#
+
+sub AttrIdNameHash
+{
+    my $name = shift;
+
+    # FNV-1a 32 bit, processing 4 bytes at a time
+
+    my @bytes = unpack("C*", $name);
+
+    my $hash = 0x811C9DC5;
+
+    my $idx = 0;
+
+    for (; $idx + 4 <= scalar @bytes; $idx += 4)
+    {
+        my $word = $bytes[$idx] | $bytes[$idx + 1] << 8 | $bytes[$idx + 2] << 16 | $bytes[$idx + 3] << 24;
+
+        $hash = (($hash ^ $word) * 0x01000193) & 0xFFFFFFFF;
+    }
+
+    for (; $idx < scalar @bytes; $idx++)
+    {
+        $hash = (($hash ^ $bytes[$idx]) * 0x01000193) & 0xFFFFFFFF;
+    }
+
+    return $hash;
+}
+
+sub AttrIdNameHashMix
+{
+    my ($hash, $seed, $range) = @_;
+
+    $hash ^= $seed;
+    $hash ^= $hash >> 16;
+    $hash = ($hash * 0x85EBCA6B) & 0xFFFFFFFF;
+    $hash ^= $hash >> 13;
+    $hash = ($hash * 0xC2B2AE35) & 0xFFFFFFFF;
+    $hash ^= $hash >> 16;
+
+    return ($hash * $range) >> 32;
+}
+
+sub CreateAttrIdNameHash
+{
+    #
+    # Minimal perfect hash of all attribute id names (hash and displace),
+    # each name is mapped to bucket, and for each bucket displacement is
+    # searched which places all bucket names into empty table slots, so
+    # lookup is single hash computation and single string compare.
+    #
+
+    WriteSectionComment "Perfect hash of all attributes id names";
+
+    my %ATTRIBUTES = GetHashOfAllAttributes();
+
+    my @keys = sort keys %ATTRIBUTES;
+
+    my $count = @keys;
+
+    if ($count >= 0x10000)
+    {
+        LogError "too many attributes $count, displacement components must fit in 16 bits";
+        return;
+    }
+
+    my $bucketcount = int(($count + 3) / 4);
+
+    $bucketcount = 1 if $bucketcount == 0;
+
+    my @buckets = map { [] } (1 .. $bucketcount);
+    my %f1 = ();
+    my %f2 = ();
+    my %hashes = ();
+
+    for my $attr (@keys)
+    {
+        my $hash = AttrIdNameHash($attr);
+
+        LogError "attributes $attr and $hashes{$hash} have the same id name hash $hash" if defined $hashes{$hash};
+
+        $hashes{$hash} = $attr;
+
+        push @{ $buckets[AttrIdNameHashMix($hash, 1, $bucketcount)] }, $attr;
+
+        $f1{$attr} = AttrIdNameHashMix($hash, 2, $count);
+        $f2{$attr} = AttrIdNameHashMix($hash, 3, $count);
+    }
+
+    my @displacements = (0) x $bucketcount;
+    my @table = ();
+
+    # place largest buckets first, when table is still mostly empty
+
+    my @order = sort { scalar(@{ $buckets[$b] }) <=> scalar(@{ $buckets[$a] }) or $a <=> $b } (0 .. $bucketcount - 1);
+
+    for my $bucket (@order)
+    {
+        my @attrs = @{ $buckets[$bucket] };
+
+        last if scalar @attrs == 0;
+
+        my @slots = ();
+
+        SEARCH: for my $d0 (0 .. $count - 1)
+        {
+            for my $d1 (0 .. $count - 1)
+            {
+                my %used = ();
+
+                @slots = ();
+
+                for my $attr (@attrs)
+                {
+                    my $slot = ($f1{$attr} + $d0 * $f2{$attr} + $d1) % $count;
+
+                    last if defined $table[$slot] or defined $used{$slot};
+
+                    $used{$slot} = 1;
+
+                    push @slots, $slot;
+                }
+
+                if (scalar @slots == scalar @attrs)
+                {
+                    $displacements[$bucket] = ($d0 << 16) | $d1;
+                    last SEARCH;
+                }
+            }
+        }
+
+        if (scalar @slots != scalar @attrs)
+        {
+            LogError "failed to find displacement for attributes @attrs";
+            return;
+        }
+
+        for my $idx (0 .. $#attrs)
+        {
+            $table[$slots[$idx]] = $attrs[$idx];
+        }
+    }
+
+    WriteHeader "extern const uint32_t sai_metadata_attr_id_name_hash_displacements[];";
+    WriteSource "const uint32_t sai_metadata_attr_id_name_hash_displacements[] = {";
+
+    for my $disp (@displacements)
+    {
+        WriteSource "$disp,";
+    }
+
+    WriteSource "};";
+
+    WriteSource "const size_t sai_metadata_attr_id_name_hash_displacements_count = $bucketcount;";
+    WriteHeader "extern const size_t sai_metadata_attr_id_name_hash_displacements_count;";
+
+    WriteHeader "extern const sai_attr_metadata_t* const sai_metadata_attr_by_id_name_hash[];";
+    WriteSource "const sai_attr_metadata_t* const sai_metadata_attr_by_id_name_hash[] = {";
+
+    for my $attr (@table)
+    {
+        WriteSource "&sai_metadata_attr_$attr,";
+    }
+
+    WriteSource "NULL";
+    WriteSource "};";
+}
+
+sub CreateListOfIgnoredAttributes
+{
+    # list will be used to find attribute metadata
+    # based on ignored attribute string name
+
+    WriteSectionComment "List of all ignored attributes";
+
+    my %ATTRIBUTES = GetHashOfAllAttributes();
+
+    my %IGNORED = ();
+
+    for my $key (sort keys %SAI_ENUMS)
+    {
+        next if not $key =~ /^(sai_(\w+)_attr_t)$/;
+
+        next if not defined $SAI_ENUMS{$key}{ignoreinit};
+
+        my %ignoreinit = %{ $SAI_ENUMS{$key}{ignoreinit} };
+
+        for my $ignored (keys %ignoreinit)
+        {
+            my $attr = $ignoreinit{$ignored};
+
+            if (not defined $ATTRIBUTES{$attr})
+            {
+                LogError "ignored attribute $ignored initializer $attr is not attribute";
+                next;
+            }
+
+            $IGNORED{$ignored} = $attr;
+        }
+    }
+
+    my @keys = sort keys %IGNORED;
+
+    WriteHeader "extern const char* const sai_metadata_ignored_attr_id_names[];";
+    WriteSource "const char* const sai_metadata_ignored_attr_id_names[] = {";
+
+    for my $ignored (@keys)
+    {
+        WriteSource "\"$ignored\",";
+    }
+
+    WriteSource "NULL";
+    WriteSource "};";
+
+    WriteHeader "extern const sai_attr_metadata_t* const sai_metadata_ignored_attr_by_id_name[];";
+    WriteSource "const sai_attr_metadata_t* const sai_metadata_ignored_attr_by_id_name[] = {";
+
+    for my $ignored (@keys)
+    {
+        WriteSource "&sai_metadata_attr_$IGNORED{$ignored},";
+    }
+
+    WriteSource "NULL";
+    WriteSource "};";
+
+    my $count = @keys;
+
+    WriteSource "const size_t sai_metadata_ignored_attr_by_id_name_count = $count;";
+    WriteHeader "extern const size_t sai_metadata_ignored_attr_by_id_name_count;";
+}
+
+sub GetCompactPoolOffset
+{
+    my ($pool, $offsets, $key, @items) = @_;
+
+    return $offsets->{$key} if defined $offsets->{$key};
+
+    $offsets->{$key} = scalar @$pool;
+
+    push @$pool, @items;
+
+    return $offsets->{$key};
+}
+
+sub GetCompactStringOffset
+{
+    my ($pool, $offsets, $size, $string) = @_;
+
+    return $offsets->{$string} if defined $offsets->{$string};
+
+    $offsets->{$string} = $$size;
+
+    $$size += length($string) + 1; # including terminating zero
+
+    push @$pool, $string;
+
+    return $offsets->{$string};
+}
+
+sub GetBuilderValueTraits
+{
+    my $vt = shift;
+
+    return ("bool", "value.booldata = data;") if $vt eq "SAI_ATTR_VALUE_TYPE_BOOL";
+
+    return ("const char*", "strncpy(value.chardata, data, sizeof(value.chardata));") if $vt eq "SAI_ATTR_VALUE_TYPE_CHARDATA";
+
+    return ("sai_acl_field_data_t", "value.aclfield = data;") if $vt =~ /^SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_/;
+
+    return ("sai_acl_action_data_t", "value.aclaction = data;") if $vt =~ /^SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_/;
+
+    for my $ctype (sort keys %VALUE_TYPES)
+    {
+        next if "SAI_ATTR_VALUE_TYPE_$VALUE_TYPES_TO_VT{$ctype}" ne $vt;
+
+        # memcpy since some types like sai_mac_t are arrays
+
+        return ($ctype, "memcpy(&value.$VALUE_TYPES{$ctype}, &data, sizeof(value.$VALUE_TYPES{$ctype}));");
+    }
+
+    LogError "no attribute value union member for $vt";
+
+    return ("void*", "");
+}
+
+sub CreateAttrBuilderTraits
+{
+    #
+    # Traits used by templates in saimetadatabuilder.h, value type of each
+    # attribute is known at compile time, so typed builder needs no runtime
+    # validation of attribute value type.
+    #
+
+    WriteBuilder "\n/* AUTOGENERATED FILE! DO NOT EDIT */\n";
+
+    WriteBuilder "#ifndef __SAIMETADATABUILDERTRAITS_H_";
+    WriteBuilder "#define __SAIMETADATABUILDERTRAITS_H_";
+
+    WriteBuilder "\n/* Attribute value types */\n";
+
+    my %vts = map { $_->{valuetype} => 1 } @BUILDER_ATTRS;
+
+    for my $vt (sort keys %vts)
+    {
+        my ($ctype, $assign) = GetBuilderValueTraits($vt);
+
+        WriteBuilder "template <>";
+        WriteBuilder "struct sai_metadata_value_traits<$vt>";
+        WriteBuilder "{";
+        WriteBuilder "typedef $ctype type;";
+        WriteBuilder "static void set(sai_attribute_value_t &value, const type &data) { $assign }";
+        WriteBuilder "};";
+        WriteBuilder "";
+    }
+
+    WriteBuilder "\n/* Attributes */\n";
+
+    for my $md (@BUILDER_ATTRS)
+    {
+        my $type = (defined $md->{enumtype}) ? $md->{enumtype} : "sai_metadata_value_traits<$md->{valuetype}>::type";
+
+        WriteBuilder "template <>";
+        WriteBuilder "struct sai_metadata_attr_traits<(sai_object_type_t)$md->{objecttype}, $md->{attr}>";
+        WriteBuilder "{";
+        WriteBuilder "typedef $type type;";
+        WriteBuilder "static constexpr sai_attr_value_type_t value_type = $md->{valuetype};";
+        WriteBuilder "static constexpr sai_attr_flags_t flags = $md->{flags};";
+        WriteBuilder "};";
+        WriteBuilder "";
+    }
+
+    WriteBuilder "\n/* Object type builders */\n";
+
+    my %objecttypes = map { $_->{objecttype} => 1 } @BUILDER_ATTRS;
+
+    for my $ot (sort keys %objecttypes)
+    {
+        next if not $ot =~ /^SAI_OBJECT_TYPE_(\w+)$/;
+
+        my $name = lc($1);
+
+        WriteBuilder "template <size_t N = SAI_METADATA_ATTR_BUILDER_DEFAULT_CAPACITY>";
+        WriteBuilder "using sai_metadata_${name}_attr_builder = sai_metadata_attr_builder<(sai_object_type_t)$ot, N>;";
+        WriteBuilder "";
+    }
+
+    WriteBuilder "#endif /* __SAIMETADATABUILDERTRAITS_H_ */";
+}
+
+sub CreateCompactMetadata
+{
+    #
+    # Compact layout of attribute metadata (see saimetadatacompact.h), all
+    # tables contain no pointers, so they are placed in read only data and
+    # require no relocations when library is loaded.
+    #
+
+    return if not defined $optionCompactLayout;
+
+    WriteCompact "\n/* AUTOGENERATED FILE! DO NOT EDIT */\n";
+
+    WriteCompact "#include <stdio.h>";
+    WriteCompact "#include <stddef.h>";
+    WriteCompact "#include \"saimetadata.h\"";
+
+    my @objects = @{ $SAI_ENUMS{sai_object_type_t}{values} };
+
+    my %attrsbyot = ();
+
+    for my $compact (@COMPACT_ATTRS)
+    {
+        push @{ $attrsbyot{$compact->{objecttype}} }, $compact;
+    }
+
+    my @attrs = ();
+    my @byot = ();
+
+    for my $ot (@objects)
+    {
+        push @byot, scalar @attrs;
+
+        push @attrs, @{ $attrsbyot{$ot} } if defined $attrsbyot{$ot};
+    }
+
+    push @byot, scalar @attrs;
+
+    if (scalar @attrs >= 0x10000)
+    {
+        LogError "too many attributes for compact layout: " . scalar @attrs;
+        return;
+    }
+
+    my %enumindex = ();
+
+    my $index = 0;
+
+    for my $key (sort keys %SAI_ENUMS)
+    {
+        $enumindex{$key} = $index++ if $key =~ /^sai_\w+_t$/;
+    }
+
+    my @strings = ();
+    my %stringoffsets = ();
+    my $stringssize = 0;
+
+    my @objecttypes = ();
+    my %objecttypeoffsets = ();
+
+    my @defaults = ("{ 0 }"); # index 0 means no default value
+    my %defaultoffsets = ();
+
+    WriteCompact "\n/* Attributes in compact layout */\n";
+
+    WriteCompact "const sai_attr_metadata_compact_t sai_metadata_compact_attrs[] = {";
+
+    for my $compact (@attrs)
+    {
+        my %c = %{ $compact };
+
+        my $brief = $c{brief};
+
+        $brief =~ s/^"(.*)"$/$1/;
+
+        my $attridname = GetCompactStringOffset(\@strings, \%stringoffsets, \$stringssize, $c{attridname});
+
+        my $briefoffset = GetCompactStringOffset(\@strings, \%stringoffsets, \$stringssize, $brief);
+
+        my @objs = @{ $c{allowedobjecttypes} };
+
+        my $objsoffset = GetCompactPoolOffset(\@objecttypes, \%objecttypeoffsets, "@objs", @objs);
+
+        my $defaultvalue = 0;
+
+        $defaultvalue = GetCompactPoolOffset(\@defaults, \%defaultoffsets, $c{defaultvalue}, $c{defaultvalue}) if defined $c{defaultvalue};
+
+        my $enummetadata = "SAI_METADATA_COMPACT_NO_INDEX";
+
+        $enummetadata = $enumindex{$1} if $c{enummetadata} =~ /^&sai_metadata_enum_(\w+)$/;
+
+        WriteCompact "{";
+        WriteCompact ".attrid                    = $c{attrid},";
+        WriteCompact ".attridname                = $attridname,";
+        WriteCompact ".brief                     = $briefoffset,";
+        WriteCompact ".defaultvalueattrid        = $c{defaultvalueattrid},";
+        WriteCompact ".objecttype                = $c{objecttype},";
+        WriteCompact ".allowedobjecttypes        = $objsoffset,";
+        WriteCompact ".defaultvalue              = $defaultvalue,";
+        WriteCompact ".enummetadata              = $enummetadata,";
+        WriteCompact ".defaultvalueobjecttype    = $c{defaultvalueobjecttype},";
+        WriteCompact ".attrvaluetype             = $c{attrvaluetype},";
+        WriteCompact ".flags                     = $c{flags},";
+        WriteCompact ".allowedobjecttypeslength  = " . scalar(@objs) . ",";
+        WriteCompact ".defaultvaluetype          = $c{defaultvaluetype},";
+        WriteCompact ".notificationtype          = $c{notificationtype},";
+        WriteCompact ".pointertype               = $c{pointertype},";
+
+        for my $field (qw/allowrepetitiononlist allowmixedobjecttypes allowemptylist allownullobjectid
+                          isoidattribute storedefaultvalue isenum isenumlist isconditional isvalidonly
+                          getsave isvlan isaclfield isaclaction isaclmask ismandatoryoncreate
+                          iscreateonly iscreateandset isreadonly iskey isprimitive iscallback
+                          isextensionattr isresourcetype isdeprecated isconditionrelaxed/)
+        {
+            WriteCompact sprintf(".%-25s = %s,", $field, $c{$field});
+        }
+
+        WriteCompact "},";
+    }
+
+    WriteCompact "};";
+
+    my $count = @attrs;
+
+    WriteCompact "const size_t sai_metadata_compact_attrs_count = $count;";
+
+    WriteCompact "\n/* Attributes by object type */\n";
+
+    WriteCompact "const uint16_t sai_metadata_compact_attrs_by_object_type[] = {";
+
+    WriteCompact "$_," for @byot;
+
+    WriteCompact "};";
+
+    $count = @objects;
+
+    WriteCompact "const size_t sai_metadata_compact_attrs_by_object_type_count = $count;";
+
+    WriteCompact "\n/* Attributes sorted by attribute id name */\n";
+
+    WriteCompact "const uint16_t sai_metadata_compact_attrs_sorted_by_id_name[] = {";
+
+    for my $idx (sort { $attrs[$a]->{attridname} cmp $attrs[$b]->{attridname} } (0 .. $#attrs))
+    {
+        WriteCompact "$idx, /* $attrs[$idx]->{attridname} */";
+    }
+
+    WriteCompact "};";
+
+    WriteCompact "\n/* String pool */\n";
+
+    WriteCompact "const char sai_metadata_compact_strings[] =";
+
+    WriteCompact "\"$_\\0\"" for @strings;
+
+    WriteCompact ";";
+
+    WriteCompact "\n/* Allowed object types pool */\n";
+
+    WriteCompact "const uint16_t sai_metadata_compact_object_types[] = {";
+
+    WriteCompact "$_," for @objecttypes;
+
+    WriteCompact "0"; # guard, pool can be empty
+
+    WriteCompact "};";
+
+    WriteCompact "\n/* Default values pool */\n";
+
+    WriteCompact "const sai_attribute_value_t sai_metadata_compact_default_values[] = {";
+
+    WriteCompact "$_," for @defaults;
+
+    WriteCompact "};";
+}
+
 sub CheckApiStructNames
 {
     #
@@ -4350,6 +5117,8 @@ sub ExtractObjectTypeBulkMap
             {
                 $name = $1;
                 $ot = $2;
+
+                $ot =~ s/entrie$/entry/; # object id entries like acl_entries
             }
             elsif ($fn =~ /^sai_bulk_(create|remove|set|get)_(\w+?)(?:_attribute)?_fn\s+(?:create|remove|set|get)_\w+?s(?:_attribute)?$/)
             {
@@ -5075,6 +5844,14 @@ sub WriteHeaderHeader
     WriteHeader "#include \"saimetadatautils.h\"";
     WriteHeader "#include \"saimetadatalogger.h\"";
     WriteHeader "#include \"saiserialize.h\"";
+    WriteHeader "#include \"saimetadataqueue.h\"";
+    WriteHeader "#include \"saimetadatalatency.h\"";
+    WriteHeader "#include \"saimetadatarecorder.h\"";
+    WriteHeader "#include \"saimetadatacompact.h\"";
+    WriteHeader "#include \"saimetadatarank.h\"";
+    WriteHeader "#include \"saimetadatarefcount.h\"";
+    WriteHeader "#include \"saimetadataattr.h\"";
+    WriteHeader "#include \"saimetadatacache.h\"";
 }
 
 sub WriteHeaderFotter
@@ -5501,10 +6278,24 @@ CreateApisQuery();
 
 CreateGlobalApisQuery();
 
+CreateApiLatencyMethods();
+
+CreateApiRecorderMethods();
+
+CreateApiCacheMethods();
+
 CreateObjectInfo();
 
 CreateListOfAllAttributes();
 
+CreateAttrIdNameHash();
+
+CreateListOfIgnoredAttributes();
+
+CreateCompactMetadata();
+
+CreateAttrBuilderTraits();
+
 CheckCapabilities();
 
 CheckApiStructNames();
@@ -5535,6 +6326,10 @@ CreateSwitchPointersAttributesList();
 
 CreateSerializeMethods();
 
+CreateNotificationQueueMethods();
+
+CreateAttrValueMethods();
+
 CreateSaiSwigGetApiHelperFunctions();
 
 CreateSaiSwigApiStructs();
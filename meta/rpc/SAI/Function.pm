@@ -134,6 +134,8 @@ m{(create|remove|set|get|clear)_         # we expect attribute only for those fu
     # Special cases
     return ( 'other', 'fdb_flush' )
       if ( $self->name =~ 'flush_fdb_entries' );
+    return ( 'other', 'hostif_packet' )
+      if ( $self->name =~ '^send_hostif_packets?$' );
     return ( q{}, 'hostif_packet' )
       if ( $self->name =~ 'hostif_packet$' );
 
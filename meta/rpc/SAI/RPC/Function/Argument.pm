@@ -161,7 +161,10 @@ sub requires_address {
 
     # RPC args are not passed by pointers, so if SAI requires an address
     # then we need to use '&' operator, unless we already declared a pointer.
-    return ( $self->type->ptr and not $self->requires_malloc );
+    # Buffers (void *) are always declared as pointers.
+    return ( $self->type->ptr
+          and not $self->requires_malloc
+          and $self->type->name !~ /void/ );
 }
 
 sub requires_declaration {
@@ -43,9 +43,10 @@ around thrift_name => sub {
     $name //= $self->name;
 
     # If we have a char array, then replace it with a string
-    $name = 'string'
-      if ( $name =~ /void/ and ( $self->is_list or $self->ptr ) )
-      or $name =~ /char/;
+    $name = 'string' if $name =~ /char/;
+
+    # Raw buffers (like packets) may contain any bytes, so use binary
+    $name = 'binary' if $name =~ /void/ and ( $self->is_list or $self->ptr );
 
     # Handle special types
     $name = 'int32_t' if $name =~ /^enum(\s|$)/;
@@ -57,7 +58,7 @@ around thrift_name => sub {
     $name = 'pointer_t' if ( $name =~ /_fn$/ );
     $name = 'i64' if $raw_name and ( $name =~ /size_t$/ or $self->ptr );
 
-    $raw_name = 1 if $name =~ /(?:string|bool|void)/;
+    $raw_name = 1 if $name =~ /(?:string|binary|bool|void)/;
 
     # Call the original function (add prefix etc)
     $name = $self->$orig( @_, $raw_name, $name );
@@ -98,7 +99,7 @@ sub python_name {
         return 'List[' . $self->subtype->thrift_name . ']';
     }
 
-    return 'str' if $self->name =~ /void/;
+    return 'bytes' if $self->name =~ /void/;
 
     return $self->thrift_name( 0, $name );
 }
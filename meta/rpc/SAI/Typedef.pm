@@ -44,13 +44,16 @@ has 'type' => (
 
 # Get Typedef definition part
 sub thrift_def {
-    my $self = shift;
+    my $self           = shift;
+    my $binary_address = shift;
 
     my $name = $self->type->thrift_name( $self->raw );
 
     # The special case - replace definition (like i64)
-    # with string - only for ip/mac addresses
-    $name = 'string' if $self->name =~ /(ip\d+|mac)_t$/;
+    # with string - only for ip/mac addresses, or with
+    # binary if addresses are sent as raw bytes
+    $name = ( $binary_address ? 'binary' : 'string' )
+      if $self->name =~ /(ip\d+|mac)_t$/;
 
     croak colored(
         'Circular type dependency '
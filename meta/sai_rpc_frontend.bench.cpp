@@ -0,0 +1,246 @@
+/**
+ * Copyright (c) 2021 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    sai_rpc_frontend.bench.cpp
+ *
+ * @brief   This module measures SAI RPC attribute conversion
+ */
+
+#include <time.h>
+
+// request arena is internal to frontend, so it is compiled in
+#include "sai_rpc_frontend.cpp"
+
+#include <map>
+#include <set>
+#include <string>
+
+std::map<std::string, std::string> gProfileMap;
+std::map<std::set<int>, std::string> gPortMap;
+
+sai_object_id_t gSwitchId;
+
+/*
+ * Attributes are converted in requests of 8 attributes, which is typical
+ * create call of PTF tests, and contain mix of scalar, address, string and
+ * list values. Attribute metadata comes from libsaimetadata, SAI API is not
+ * called.
+ */
+
+#define CONVERSION_COUNT (1024 * 1024)
+
+#define CHECK(cond)                                                         \
+    if (!(cond)) {                                                          \
+        fprintf(stderr, "FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+        exit(1);                                                            \
+    }
+
+typedef struct _bench_attr_t
+{
+    sai_object_type_t object_type;
+
+    sai_thrift_attribute_t thrift_attr;
+
+} bench_attr_t;
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void report(
+        _In_ const char *name,
+        _In_ uint64_t start,
+        _In_ uint64_t count)
+{
+    printf("%-28s %8.1f ns/op\n", name, (double)(now_ns() - start) / (double)count);
+}
+
+/*
+ * Addresses are given as text, and are packed to raw bytes when RPC server
+ * was generated with --binary-address option. Family 0 is MAC address.
+ */
+static std::string bench_address(
+        _In_ int family,
+        _In_ const char *text)
+{
+    if (!sai_thrift_binary_address)
+    {
+        return text;
+    }
+
+    unsigned char bytes[16];
+
+    if (family == 0)
+    {
+        unsigned int mac[6];
+
+        CHECK(sscanf(text, "%x:%x:%x:%x:%x:%x", &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5]) == 6);
+
+        for (int i = 0; i < 6; i++)
+        {
+            bytes[i] = (unsigned char)mac[i];
+        }
+
+        return std::string(reinterpret_cast<char *>(bytes), 6);
+    }
+
+    CHECK(inet_pton(family, text, bytes) == 1);
+
+    return std::string(reinterpret_cast<char *>(bytes), family == AF_INET ? 4 : 16);
+}
+
+static bench_attr_t make_attr(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_attr_id_t attr_id)
+{
+    bench_attr_t attr;
+
+    attr.object_type = object_type;
+    attr.thrift_attr.id = attr_id;
+
+    return attr;
+}
+
+static std::vector<bench_attr_t> make_request()
+{
+    std::vector<bench_attr_t> attrs;
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION));
+    attrs.back().thrift_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID));
+    attrs.back().thrift_attr.value.oid = 0x1234;
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_NEXT_HOP, SAI_NEXT_HOP_ATTR_IP));
+    attrs.back().thrift_attr.value.ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    attrs.back().thrift_attr.value.ipaddr.addr.ip4 = bench_address(AF_INET, "10.0.0.1");
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_NEXT_HOP, SAI_NEXT_HOP_ATTR_IP));
+    attrs.back().thrift_attr.value.ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+    attrs.back().thrift_attr.value.ipaddr.addr.ip6 = bench_address(AF_INET6, "2001:db8::1");
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_ROUTER_INTERFACE, SAI_ROUTER_INTERFACE_ATTR_SRC_MAC_ADDRESS));
+    attrs.back().thrift_attr.value.mac = bench_address(0, "00:11:22:33:44:55");
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_HOSTIF, SAI_HOSTIF_ATTR_NAME));
+    attrs.back().thrift_attr.value.chardata = "Ethernet0";
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_HW_LANE_LIST));
+    attrs.back().thrift_attr.value.u32list.count = 4;
+    attrs.back().thrift_attr.value.u32list.uint32list = { 1, 2, 3, 4 };
+
+    attrs.push_back(make_attr(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_INGRESS_MIRROR_SESSION));
+    attrs.back().thrift_attr.value.objlist.count = 8;
+    attrs.back().thrift_attr.value.objlist.idlist = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    return attrs;
+}
+
+static void bench_thrift_to_sai(
+        _In_ const std::vector<bench_attr_t> &request)
+{
+    std::vector<sai_attribute_t> attrs(request.size());
+
+    uint32_t requests = (uint32_t)(CONVERSION_COUNT / request.size());
+
+    uint64_t start = now_ns();
+
+    uint32_t idx;
+
+    for (idx = 0; idx < requests; idx++)
+    {
+        sai_thrift_arena_scope arena_scope;
+
+        for (size_t i = 0; i < request.size(); i++)
+        {
+            convert_attr_thrift_to_sai(request[i].object_type, request[i].thrift_attr, &attrs[i]);
+        }
+
+        CHECK(attrs[7].value.objlist.count == 8 && attrs[7].value.objlist.list[7] == 8);
+    }
+
+    report("thrift to sai", start, (uint64_t)requests * request.size());
+
+    CHECK(attrs[2].value.ipaddr.addr.ip4 == htonl(0x0a000001));
+    CHECK(strcmp(attrs[5].value.chardata, "Ethernet0") == 0);
+}
+
+static void bench_sai_to_thrift(
+        _In_ const std::vector<bench_attr_t> &request)
+{
+    sai_thrift_arena_scope arena_scope;
+
+    std::vector<sai_attribute_t> attrs(request.size());
+
+    for (size_t i = 0; i < request.size(); i++)
+    {
+        convert_attr_thrift_to_sai(request[i].object_type, request[i].thrift_attr, &attrs[i]);
+    }
+
+    std::vector<sai_thrift_attribute_t> thrift_attrs;
+
+    uint32_t requests = (uint32_t)(CONVERSION_COUNT / request.size());
+
+    uint64_t start = now_ns();
+
+    uint32_t idx;
+
+    for (idx = 0; idx < requests; idx++)
+    {
+        thrift_attrs.clear();
+        thrift_attrs.reserve(attrs.size());
+
+        for (size_t i = 0; i < attrs.size(); i++)
+        {
+            thrift_attrs.emplace_back();
+
+            convert_attr_sai_to_thrift(request[i].object_type, attrs[i], thrift_attrs.back());
+        }
+    }
+
+    report("sai to thrift", start, (uint64_t)requests * request.size());
+
+    CHECK(thrift_attrs[2].value.ipaddr.addr.ip4 == request[2].thrift_attr.value.ipaddr.addr.ip4);
+    CHECK(thrift_attrs[3].value.ipaddr.addr.ip6 == request[3].thrift_attr.value.ipaddr.addr.ip6);
+    CHECK(thrift_attrs[4].value.mac == request[4].thrift_attr.value.mac);
+    CHECK(thrift_attrs[5].value.chardata == "Ethernet0");
+    CHECK(thrift_attrs[6].value.u32list.uint32list == request[6].thrift_attr.value.u32list.uint32list);
+    CHECK(thrift_attrs[7].value.objlist.idlist == request[7].thrift_attr.value.objlist.idlist);
+}
+
+int main(
+        _In_ int argc,
+        _In_ char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    std::vector<bench_attr_t> request = make_request();
+
+    bench_thrift_to_sai(request);
+
+    bench_sai_to_thrift(request);
+
+    return 0;
+}
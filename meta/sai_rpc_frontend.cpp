@@ -32,20 +32,189 @@ extern "C" {
 
 #include <iostream>
 #include <cstring>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 using namespace ::sai;
 
+/**
+ * @brief Bump allocator for SAI side lists of single RPC request
+ *
+ * Lists converted from Thrift attributes are allocated from arena and are
+ * released together when outermost arena scope of request ends. Memory is
+ * kept for next request, so after warm up attribute conversion does not
+ * touch heap.
+ */
+class sai_thrift_arena
+{
+    public:
+
+        sai_thrift_arena():
+            m_size(0),
+            m_used(0),
+            m_depth(0)
+        {
+        }
+
+        void* alloc(
+                size_t size)
+        {
+            const size_t align = alignof(std::max_align_t);
+
+            size = (size + align - 1) & ~(align - 1);
+
+            if (m_used + size > m_size)
+            {
+                if (m_block)
+                {
+                    m_retired.push_back(std::move(m_block));
+                }
+
+                m_size = std::max(std::max(2 * m_size, size), (size_t)4096);
+                m_block.reset(new uint8_t[m_size]);
+                m_used = 0;
+            }
+
+            void *ptr = m_block.get() + m_used;
+
+            m_used += size;
+
+            return ptr;
+        }
+
+        void enter()
+        {
+            m_depth++;
+        }
+
+        void leave()
+        {
+            if (--m_depth != 0)
+            {
+                return;
+            }
+
+            // last block is the biggest one, it is reused by next request
+
+            m_retired.clear();
+            m_used = 0;
+        }
+
+    private:
+
+        std::unique_ptr<uint8_t[]> m_block;
+
+        std::vector<std::unique_ptr<uint8_t[]>> m_retired;
+
+        size_t m_size;
+
+        size_t m_used;
+
+        uint32_t m_depth;
+};
+
+static thread_local sai_thrift_arena sai_thrift_request_arena;
+
+/**
+ * @brief Marks lifetime of lists allocated from request arena
+ */
+class sai_thrift_arena_scope
+{
+    public:
+
+        sai_thrift_arena_scope()
+        {
+            sai_thrift_request_arena.enter();
+        }
+
+        ~sai_thrift_arena_scope()
+        {
+            sai_thrift_request_arena.leave();
+        }
+};
+
+/**
+ * @brief Allocate array of count elements from request arena
+ */
+template <typename T>
+static T* sai_thrift_arena_alloc(size_t count)
+{
+    if (count == 0)
+    {
+        return NULL;
+    }
+
+    return static_cast<T*>(sai_thrift_request_arena.alloc(sizeof(T) * count));
+}
+
+/**
+ * @brief Convert Thrift scalar to SAI scalar or enum
+ *
+ * Overloads below convert values which are not plain numbers, so converters
+ * generated for each attribute value type can call single name for any
+ * element type.
+ */
+template <typename V, typename T>
+static void sai_thrift_value_parse(
+        const V &thrift_value,
+        T &value)
+{
+    value = static_cast<T>(thrift_value);
+}
+
+/**
+ * @brief Convert SAI scalar or enum to Thrift scalar
+ */
+template <typename T, typename V>
+static void sai_value_to_thrift(
+        const T &value,
+        V &thrift_value)
+{
+    thrift_value = static_cast<V>(value);
+}
+
+/**
+ * @brief Thrift MAC and IP addresses are raw bytes instead of text
+ *
+ * Defined by generated server, true when sai.thrift was generated with
+ * --binary-address option. Bytes are in SAI order, so IPv4 address is in
+ * network byte order and no text is formatted or parsed on either side.
+ */
+extern const bool sai_thrift_binary_address;
+
+/**
+ * @brief Copy Thrift binary address to SAI address, zero fill short input
+ */
+static void sai_thrift_binary_address_parse(
+        const std::string &s,
+        void *data,
+        size_t size)
+{
+    memset(data, 0, size);
+    memcpy(data, s.data(), std::min(s.size(), size));
+}
+
 /**
  * @brief Convert Thrift MAC format to SAI MAC format
  */
-static unsigned int sai_thrift_mac_t_parse(const std::string s, void *data)
+static unsigned int sai_thrift_mac_t_parse(const std::string &s, void *data)
 {
     unsigned int i, j = 0;
     unsigned char *m = static_cast<unsigned char *>(data);
+
+    if (sai_thrift_binary_address)
+    {
+        sai_thrift_binary_address_parse(s, m, 6);
+
+        return (s.size() == 6);
+    }
+
     memset(m, 0, 6);
     for (i = 0; i < s.size(); i++)
     {
-        char let = s.c_str()[i];
+        char let = s[i];
 
         if (let >= '0' && let <= '9')
         {
@@ -70,15 +239,22 @@ static unsigned int sai_thrift_mac_t_parse(const std::string s, void *data)
 /**
  * @brief Convert Thrift IPv4 format to SAI IPv4 format
  */
-static void sai_thrift_ip4_t_parse(const std::string s, unsigned int *m)
+static void sai_thrift_ip4_t_parse(const std::string &s, unsigned int *m)
 {
     unsigned char r = 0;
     unsigned int i;
+
+    if (sai_thrift_binary_address)
+    {
+        sai_thrift_binary_address_parse(s, m, sizeof(*m));
+        return;
+    }
+
     *m = 0;
 
     for (i = 0; i < s.size(); i++)
     {
-        char let = s.c_str()[i];
+        char let = s[i];
 
         if (let >= '0' && let <= '9')
         {
@@ -98,8 +274,14 @@ static void sai_thrift_ip4_t_parse(const std::string s, unsigned int *m)
 /**
  * @brief Convert Thrift IPv6 format to SAI IPv6 format
  */
-static void sai_thrift_ip6_t_parse(const std::string s, unsigned char *v6_ip)
+static void sai_thrift_ip6_t_parse(const std::string &s, unsigned char *v6_ip)
 {
+    if (sai_thrift_binary_address)
+    {
+        sai_thrift_binary_address_parse(s, v6_ip, sizeof(sai_ip6_t));
+        return;
+    }
+
     const char *v6_str = s.c_str();
 
     inet_pton(AF_INET6, v6_str, v6_ip);
@@ -146,408 +328,15 @@ static void sai_thrift_ip_prefix_t_parse(
 }
 
 /**
- * @brief Convert attribute from Thrift to SAI format according to the type
+ * @brief Convert SAI IPv4 format to Thrift IPv4 format
  */
-void convert_attr_thrift_to_sai(
-        const sai_object_type_t ot,
-        const sai_thrift_attribute_t &thrift_attr,
-        sai_attribute_t *attr)
+static std::string sai_ip4_t_to_thrift(const sai_ip4_t ip4)
 {
-    const auto md = sai_metadata_get_attr_metadata(ot, thrift_attr.id);
-
-    attr->id = thrift_attr.id;
-
-    sai_thrift_exception e;
-
-    e.status = SAI_STATUS_NOT_SUPPORTED;
-
-    if (md == NULL)
-    {
-        SAI_META_LOG_ERROR("attr metadata not found for object type %d and attribute %d", ot, attr->id);
-        e.status = SAI_STATUS_INVALID_PARAMETER;
-        throw e;
-    }
-
-    switch (md->attrvaluetype)
+    if (sai_thrift_binary_address)
     {
-        case SAI_ATTR_VALUE_TYPE_BOOL:
-            attr->value.booldata = thrift_attr.value.booldata;
-            break;
-        case SAI_ATTR_VALUE_TYPE_CHARDATA:
-            // 32 is chardata size in sai types
-            std::memcpy(attr->value.chardata, thrift_attr.value.chardata.c_str(), 32);
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT8:
-            attr->value.u8 = thrift_attr.value.u8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT8:
-            attr->value.s8 = thrift_attr.value.s8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT16:
-            attr->value.u16 = thrift_attr.value.u16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT16:
-            attr->value.s16 = thrift_attr.value.s16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT32:
-            attr->value.u32 = thrift_attr.value.u32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT32:
-            attr->value.s32 = thrift_attr.value.s32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT64:
-            attr->value.u64 = thrift_attr.value.u64;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT64:
-            attr->value.s64 = thrift_attr.value.s64;
-            break;
-        case SAI_ATTR_VALUE_TYPE_MAC:
-            sai_thrift_mac_t_parse(thrift_attr.value.mac, &attr->value.mac);
-            break;
-        case SAI_ATTR_VALUE_TYPE_IPV4:
-            sai_thrift_ip4_t_parse(thrift_attr.value.ip4, &attr->value.ip4);
-            break;
-        case SAI_ATTR_VALUE_TYPE_IPV6:
-            sai_thrift_ip6_t_parse(thrift_attr.value.ip6, attr->value.ip6);
-            break;
-        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
-            sai_thrift_ip_address_t_parse(thrift_attr.value.ipaddr, &attr->value.ipaddr);
-            break;
-        case SAI_ATTR_VALUE_TYPE_IP_PREFIX:
-            sai_thrift_ip_prefix_t_parse(thrift_attr.value.ipprefix, &attr->value.ipprefix);
-            break;
-        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
-            attr->value.oid = thrift_attr.value.oid;
-            break;
-        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
-            {
-                attr->value.objlist.list = (sai_object_id_t *)malloc(sizeof(sai_object_id_t) * thrift_attr.value.objlist.count);
-                int i = 0;
-                for (auto obj : thrift_attr.value.objlist.idlist)
-                {
-                    attr->value.objlist.list[i++] = obj;
-                }
-                attr->value.objlist.count = thrift_attr.value.objlist.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
-            {
-                attr->value.u8list.list = (uint8_t *)malloc(sizeof(uint8_t) * thrift_attr.value.u8list.count);
-                int i = 0;
-                for (auto u8 : thrift_attr.value.u8list.uint8list)
-                {
-                    attr->value.u8list.list[i++] = u8;
-                }
-                attr->value.u8list.count = thrift_attr.value.u8list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT8_LIST:
-            {
-                attr->value.s8list.list = (int8_t *)malloc(sizeof(int8_t) * thrift_attr.value.s8list.count);
-                int i = 0;
-                for (auto s8 : thrift_attr.value.s8list.int8list)
-                {
-                    attr->value.s8list.list[i++] = s8;
-                }
-                attr->value.s8list.count = thrift_attr.value.s8list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
-            {
-                attr->value.u16list.list = (uint16_t *)malloc(sizeof(uint16_t) * thrift_attr.value.u16list.count);
-                int i = 0;
-                for (auto u16 : thrift_attr.value.u16list.uint16list)
-                {
-                    attr->value.u16list.list[i++] = u16;
-                }
-                attr->value.u16list.count = thrift_attr.value.u16list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT16_LIST:
-            {
-                attr->value.s16list.list = (int16_t *)malloc(sizeof(int16_t) * thrift_attr.value.s16list.count);
-                int i = 0;
-                for (auto s16 : thrift_attr.value.s16list.int16list)
-                {
-                    attr->value.s16list.list[i++] = s16;
-                }
-                attr->value.s16list.count = thrift_attr.value.s16list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
-            {
-                attr->value.u32list.list = (uint32_t *)malloc(sizeof(uint32_t) * thrift_attr.value.u32list.count);
-                int i = 0;
-                for (auto u32 : thrift_attr.value.u32list.uint32list)
-                {
-                    attr->value.u32list.list[i++] = u32;
-                }
-                attr->value.u32list.count = thrift_attr.value.u32list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT32_LIST:
-            {
-                attr->value.s32list.list = (int32_t *)malloc(sizeof(int32_t) * thrift_attr.value.s32list.count);
-                int i = 0;
-                for (auto s32 : thrift_attr.value.s32list.int32list)
-                {
-                    attr->value.s32list.list[i++] = s32;
-                }
-                attr->value.s32list.count = thrift_attr.value.s32list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT32_RANGE:
-            attr->value.u32range.min = thrift_attr.value.u32range.min;
-            attr->value.u32range.max = thrift_attr.value.u32range.max;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT32_RANGE:
-            attr->value.s32range.min = thrift_attr.value.s32range.min;
-            attr->value.s32range.max = thrift_attr.value.s32range.max;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT16_RANGE_LIST:
-            {
-                attr->value.u16rangelist.list = (sai_u16_range_t *)malloc(sizeof(sai_u16_range_t) * thrift_attr.value.u16rangelist.count);
-                int i = 0;
-                for (auto range : thrift_attr.value.u16rangelist.rangelist)
-                {
-                    attr->value.u16rangelist.list[i].min = range.min;
-                    attr->value.u16rangelist.list[i++].max = range.max;
-                }
-                attr->value.u16rangelist.count = thrift_attr.value.u16rangelist.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_BOOL:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.booldata = thrift_attr.value.aclfield.data.booldata;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.u8 = thrift_attr.value.aclfield.data.u8;
-            attr->value.aclfield.mask.u8 = thrift_attr.value.aclfield.mask.u8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_INT8:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.s8 = thrift_attr.value.aclfield.data.s8;
-            attr->value.aclfield.mask.s8 = thrift_attr.value.aclfield.mask.s8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT16:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.u16 = thrift_attr.value.aclfield.data.u16;
-            attr->value.aclfield.mask.u16 = thrift_attr.value.aclfield.mask.u16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_INT16:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.s16 = thrift_attr.value.aclfield.data.s16;
-            attr->value.aclfield.mask.s16 = thrift_attr.value.aclfield.mask.s16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT32:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.u32 = thrift_attr.value.aclfield.data.u32;
-            attr->value.aclfield.mask.u32 = thrift_attr.value.aclfield.mask.u32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_INT32:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.s32 = thrift_attr.value.aclfield.data.s32;
-            attr->value.aclfield.mask.s32 = thrift_attr.value.aclfield.mask.s32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_MAC:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            sai_thrift_mac_t_parse(thrift_attr.value.aclfield.data.mac, &attr->value.aclfield.data.mac);
-            sai_thrift_mac_t_parse(thrift_attr.value.aclfield.mask.mac, &attr->value.aclfield.mask.mac);
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_IPV4:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            sai_thrift_ip4_t_parse(thrift_attr.value.aclfield.data.ip4, &attr->value.aclfield.data.ip4);
-            sai_thrift_ip4_t_parse(thrift_attr.value.aclfield.mask.ip4, &attr->value.aclfield.mask.ip4);
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_IPV6:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            sai_thrift_ip6_t_parse(thrift_attr.value.aclfield.data.ip6, attr->value.aclfield.data.ip6);
-            sai_thrift_ip6_t_parse(thrift_attr.value.aclfield.mask.ip6, attr->value.aclfield.mask.ip6);
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
-            attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-            attr->value.aclfield.data.oid = thrift_attr.value.aclfield.data.oid;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
-            {
-                int i = 0;
-                attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-                attr->value.aclfield.data.objlist.list = (sai_object_id_t *)malloc(sizeof(sai_object_id_t) * thrift_attr.value.aclfield.data.objlist.count);
-                for (auto obj : thrift_attr.value.aclfield.data.objlist.idlist)
-                {
-                    attr->value.aclfield.data.objlist.list[i++] = obj;
-                }
-                attr->value.aclfield.data.objlist.count = thrift_attr.value.aclfield.data.objlist.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8_LIST:
-            {
-                int i = 0;
-                attr->value.aclfield.enable = thrift_attr.value.aclfield.enable;
-                attr->value.aclfield.data.u8list.list = (uint8_t *)malloc(sizeof(uint8_t) * thrift_attr.value.aclfield.data.u8list.count);
-                for (auto obj : thrift_attr.value.aclfield.data.u8list.uint8list)
-                {
-                    attr->value.aclfield.data.u8list.list[i++] = obj;
-                }
-                attr->value.aclfield.data.u8list.count = thrift_attr.value.aclfield.data.u8list.count;
-                i = 0;
-                attr->value.aclfield.mask.u8list.list = (uint8_t *)malloc(sizeof(uint8_t) * thrift_attr.value.aclfield.mask.u8list.count);
-                for (auto obj : thrift_attr.value.aclfield.mask.u8list.uint8list)
-                {
-                    attr->value.aclfield.mask.u8list.list[i++] = obj;
-                }
-                attr->value.aclfield.mask.u8list.count = thrift_attr.value.aclfield.mask.u8list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_BOOL:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.booldata = thrift_attr.value.aclaction.parameter.booldata;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_UINT8:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.u8 = thrift_attr.value.aclaction.parameter.u8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_INT8:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.s8 = thrift_attr.value.aclaction.parameter.s8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_UINT16:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.u16 = thrift_attr.value.aclaction.parameter.u16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_INT16:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.s16 = thrift_attr.value.aclaction.parameter.s16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_UINT32:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.u32 = thrift_attr.value.aclaction.parameter.u32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_INT32:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.s32 = thrift_attr.value.aclaction.parameter.s32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_MAC:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            sai_thrift_mac_t_parse(thrift_attr.value.aclaction.parameter.mac, &attr->value.aclaction.parameter.mac);
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_IPV4:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            sai_thrift_ip4_t_parse(thrift_attr.value.aclaction.parameter.ip4, &attr->value.aclaction.parameter.ip4);
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_IPV6:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            sai_thrift_ip6_t_parse(thrift_attr.value.aclaction.parameter.ip6, attr->value.aclaction.parameter.ip6);
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_IP_ADDRESS:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            sai_thrift_ip_address_t_parse(thrift_attr.value.aclaction.parameter.ipaddr, &attr->value.aclaction.parameter.ipaddr);
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
-            attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-            attr->value.aclaction.parameter.oid = thrift_attr.value.aclaction.parameter.oid;
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-            {
-                int i = 0;
-                attr->value.aclaction.enable = thrift_attr.value.aclaction.enable;
-                attr->value.aclaction.parameter.objlist.list = (sai_object_id_t*)malloc(sizeof(sai_object_id_t) * thrift_attr.value.aclaction.parameter.objlist.count);
-                for (auto obj : thrift_attr.value.aclaction.parameter.objlist.idlist)
-                {
-                    attr->value.aclaction.parameter.objlist.list[i++] = obj;
-                }
-                attr->value.aclaction.parameter.objlist.count = thrift_attr.value.aclaction.parameter.objlist.count;
-            }
-            break;
-
-        case SAI_ATTR_VALUE_TYPE_ACL_CAPABILITY:
-            {
-                attr->value.aclcapability.is_action_list_mandatory = thrift_attr.value.aclcapability.is_action_list_mandatory;
-                attr->value.aclcapability.action_list.list = (int32_t *)malloc(sizeof(int32_t) * thrift_attr.value.aclcapability.action_list.count);
-                int i = 0;
-                for (auto s32 : thrift_attr.value.aclcapability.action_list.int32list)
-                {
-                    attr->value.aclcapability.action_list.list[i++] = s32;
-                }
-                attr->value.aclcapability.action_list.count = thrift_attr.value.aclcapability.action_list.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_RESOURCE_LIST:
-            {
-                attr->value.aclresource.list = (sai_acl_resource_t *)malloc(sizeof(sai_acl_resource_t) * thrift_attr.value.aclresource.count);
-                int i = 0;
-                for (auto resource : thrift_attr.value.aclresource.resourcelist)
-                {
-                    attr->value.aclresource.list[i].stage = static_cast<sai_acl_stage_t>(resource.stage);
-                    attr->value.aclresource.list[i].bind_point = static_cast<sai_acl_bind_point_type_t>(resource.bind_point);
-                    attr->value.aclresource.list[i++].avail_num = resource.avail_num;
-                }
-                attr->value.aclresource.count = thrift_attr.value.aclresource.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS_LIST:
-            {
-                attr->value.ipaddrlist.list = (sai_ip_address_t *)malloc(sizeof(sai_ip_address_t) * thrift_attr.value.ipaddrlist.count);
-                int i = 0;
-                for (auto address : thrift_attr.value.ipaddrlist.addresslist)
-                {
-                    sai_thrift_ip_address_t_parse(address, &attr->value.ipaddrlist.list[i++]);
-                }
-                attr->value.ipaddrlist.count = thrift_attr.value.ipaddrlist.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_IP_PREFIX_LIST:
-            {
-                attr->value.ipprefixlist.list = (sai_ip_prefix_t *)malloc(sizeof(sai_ip_prefix_t) * thrift_attr.value.ipprefixlist.count);
-                int i = 0;
-                for (auto address : thrift_attr.value.ipprefixlist.prefixlist)
-                {
-                    sai_thrift_ip_prefix_t_parse(address, &attr->value.ipprefixlist.list[i++]);
-                }
-                attr->value.ipprefixlist.count = thrift_attr.value.ipprefixlist.count;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_QOS_MAP_LIST:
-            {
-                attr->value.qosmap.list = (sai_qos_map_t *)malloc(sizeof(sai_qos_map_t) * thrift_attr.value.qosmap.count);
-                int i = 0;
-                for (auto qosmap : thrift_attr.value.qosmap.maplist)
-                {
-                    // key
-                    attr->value.qosmap.list[i].key.tc = qosmap.key.tc;
-                    attr->value.qosmap.list[i].key.dscp = qosmap.key.dscp;
-                    attr->value.qosmap.list[i].key.dot1p = qosmap.key.dot1p;
-                    attr->value.qosmap.list[i].key.prio = qosmap.key.prio;
-                    attr->value.qosmap.list[i].key.pg = qosmap.key.pg;
-                    attr->value.qosmap.list[i].key.queue_index = qosmap.key.queue_index;
-                    attr->value.qosmap.list[i].key.color = static_cast<sai_packet_color_t>(qosmap.key.color);
-                    attr->value.qosmap.list[i].key.mpls_exp = qosmap.key.mpls_exp;
-                    // value
-                    attr->value.qosmap.list[i].value.tc = qosmap.value.tc;
-                    attr->value.qosmap.list[i].value.dscp = qosmap.value.dscp;
-                    attr->value.qosmap.list[i].value.dot1p = qosmap.value.dot1p;
-                    attr->value.qosmap.list[i].value.prio = qosmap.value.prio;
-                    attr->value.qosmap.list[i].value.pg = qosmap.value.pg;
-                    attr->value.qosmap.list[i].value.queue_index = qosmap.value.queue_index;
-                    attr->value.qosmap.list[i].value.color = static_cast<sai_packet_color_t>(qosmap.value.color);
-                    attr->value.qosmap.list[i].value.mpls_exp = qosmap.value.mpls_exp;
-                    i++;
-                }
-                attr->value.qosmap.count = thrift_attr.value.qosmap.count;
-            }
-            break;
-        default:
-            SAI_META_LOG_ERROR("attr value type not supported for %s", md->attridname);
-            throw e;
+        return std::string(reinterpret_cast<const char *>(&ip4), sizeof(ip4));
     }
-}
 
-/**
- * @brief Convert SAI IPv4 format to Thrift IPv4 format
- */
-static std::string sai_ip4_t_to_thrift(const sai_ip4_t ip4)
-{
     char str[INET_ADDRSTRLEN];
     inet_ntop(AF_INET, &(ip4), str, INET_ADDRSTRLEN);
     return str;
@@ -558,6 +347,11 @@ static std::string sai_ip4_t_to_thrift(const sai_ip4_t ip4)
  */
 static std::string sai_ip6_t_to_thrift(const sai_ip6_t ip6)
 {
+    if (sai_thrift_binary_address)
+    {
+        return std::string(reinterpret_cast<const char *>(ip6), sizeof(sai_ip6_t));
+    }
+
     char str[INET6_ADDRSTRLEN];
     inet_ntop(AF_INET6, ip6, str, INET6_ADDRSTRLEN);
     return str;
@@ -566,7 +360,7 @@ static std::string sai_ip6_t_to_thrift(const sai_ip6_t ip6)
 /**
  * @brief Convert SAI IP address format to Thrift IP address format
  */
-static void sai_ip_address_t_to_thrift(sai_thrift_ip_address_t &thrift_ip, const sai_ip_address_t ip)
+static void sai_ip_address_t_to_thrift(sai_thrift_ip_address_t &thrift_ip, const sai_ip_address_t &ip)
 {
     if (ip.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
     {
@@ -583,7 +377,7 @@ static void sai_ip_address_t_to_thrift(sai_thrift_ip_address_t &thrift_ip, const
 /**
  * @brief Convert IP address and mask from SAI to Thrift format
  */
-static void sai_ip_prefix_t_to_thrift(sai_thrift_ip_prefix_t &thrift_ip, const sai_ip_prefix_t ip)
+static void sai_ip_prefix_t_to_thrift(sai_thrift_ip_prefix_t &thrift_ip, const sai_ip_prefix_t &ip)
 {
     if (ip.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
     {
@@ -600,16 +394,424 @@ static void sai_ip_prefix_t_to_thrift(sai_thrift_ip_prefix_t &thrift_ip, const s
 }
 
 /**
- * @brief Convert attribute from SAI to Thrift format according to the type
+ * @brief Convert Thrift value of attribute value member to SAI format
  */
-void convert_attr_sai_to_thrift(
-        const sai_object_type_t ot,
-        const sai_attribute_t &attr,
-        sai_thrift_attribute_t &thrift_attr)
+static void sai_thrift_value_parse(
+        const std::string &thrift_value,
+        sai_mac_t &value)
 {
-    const auto md = sai_metadata_get_attr_metadata(ot, attr.id);
+    sai_thrift_mac_t_parse(thrift_value, value);
+}
 
-    thrift_attr.id = attr.id;
+static void sai_thrift_value_parse(
+        const std::string &thrift_value,
+        sai_ip4_t &value)
+{
+    sai_thrift_ip4_t_parse(thrift_value, &value);
+}
+
+static void sai_thrift_value_parse(
+        const std::string &thrift_value,
+        sai_ip6_t &value)
+{
+    sai_thrift_ip6_t_parse(thrift_value, value);
+}
+
+static void sai_thrift_value_parse(
+        const std::string &thrift_value,
+        char (&value)[32])
+{
+    size_t size = std::min(thrift_value.size(), sizeof(value));
+
+    std::memcpy(value, thrift_value.data(), size);
+    std::memset(value + size, 0, sizeof(value) - size);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_ip_address_t &thrift_value,
+        sai_ip_address_t &value)
+{
+    sai_thrift_ip_address_t_parse(thrift_value, &value);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_ip_prefix_t &thrift_value,
+        sai_ip_prefix_t &value)
+{
+    sai_thrift_ip_prefix_t_parse(thrift_value, &value);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_u32_range_t &thrift_value,
+        sai_u32_range_t &value)
+{
+    sai_thrift_value_parse(thrift_value.min, value.min);
+    sai_thrift_value_parse(thrift_value.max, value.max);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_s32_range_t &thrift_value,
+        sai_s32_range_t &value)
+{
+    sai_thrift_value_parse(thrift_value.min, value.min);
+    sai_thrift_value_parse(thrift_value.max, value.max);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_u16_range_t &thrift_value,
+        sai_u16_range_t &value)
+{
+    sai_thrift_value_parse(thrift_value.min, value.min);
+    sai_thrift_value_parse(thrift_value.max, value.max);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_acl_resource_t &thrift_value,
+        sai_acl_resource_t &value)
+{
+    sai_thrift_value_parse(thrift_value.stage, value.stage);
+    sai_thrift_value_parse(thrift_value.bind_point, value.bind_point);
+    sai_thrift_value_parse(thrift_value.avail_num, value.avail_num);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_qos_map_params_t &thrift_value,
+        sai_qos_map_params_t &value)
+{
+    sai_thrift_value_parse(thrift_value.tc, value.tc);
+    sai_thrift_value_parse(thrift_value.dscp, value.dscp);
+    sai_thrift_value_parse(thrift_value.dot1p, value.dot1p);
+    sai_thrift_value_parse(thrift_value.prio, value.prio);
+    sai_thrift_value_parse(thrift_value.pg, value.pg);
+    sai_thrift_value_parse(thrift_value.queue_index, value.queue_index);
+    sai_thrift_value_parse(thrift_value.color, value.color);
+    sai_thrift_value_parse(thrift_value.mpls_exp, value.mpls_exp);
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_qos_map_t &thrift_value,
+        sai_qos_map_t &value)
+{
+    sai_thrift_value_parse(thrift_value.key, value.key);
+    sai_thrift_value_parse(thrift_value.value, value.value);
+}
+
+/**
+ * @brief Convert SAI value of attribute value member to Thrift format
+ */
+static void sai_value_to_thrift(
+        const sai_mac_t &value,
+        std::string &thrift_value)
+{
+    if (sai_thrift_binary_address)
+    {
+        thrift_value.assign(reinterpret_cast<const char *>(value), sizeof(sai_mac_t));
+        return;
+    }
+
+    char mac_str[18];
+
+    snprintf(mac_str, sizeof(mac_str), "%02x:%02x:%02x:%02x:%02x:%02x",
+            value[0], value[1], value[2], value[3], value[4], value[5]);
+
+    thrift_value = mac_str;
+}
+
+static void sai_value_to_thrift(
+        const sai_ip4_t &value,
+        std::string &thrift_value)
+{
+    thrift_value = sai_ip4_t_to_thrift(value);
+}
+
+static void sai_value_to_thrift(
+        const sai_ip6_t &value,
+        std::string &thrift_value)
+{
+    thrift_value = sai_ip6_t_to_thrift(value);
+}
+
+static void sai_value_to_thrift(
+        const char (&value)[32],
+        std::string &thrift_value)
+{
+    thrift_value.assign(value, strnlen(value, sizeof(value)));
+}
+
+static void sai_value_to_thrift(
+        const sai_ip_address_t &value,
+        sai_thrift_ip_address_t &thrift_value)
+{
+    sai_ip_address_t_to_thrift(thrift_value, value);
+}
+
+static void sai_value_to_thrift(
+        const sai_ip_prefix_t &value,
+        sai_thrift_ip_prefix_t &thrift_value)
+{
+    sai_ip_prefix_t_to_thrift(thrift_value, value);
+}
+
+static void sai_value_to_thrift(
+        const sai_u32_range_t &value,
+        sai_thrift_u32_range_t &thrift_value)
+{
+    sai_value_to_thrift(value.min, thrift_value.min);
+    sai_value_to_thrift(value.max, thrift_value.max);
+}
+
+static void sai_value_to_thrift(
+        const sai_s32_range_t &value,
+        sai_thrift_s32_range_t &thrift_value)
+{
+    sai_value_to_thrift(value.min, thrift_value.min);
+    sai_value_to_thrift(value.max, thrift_value.max);
+}
+
+static void sai_value_to_thrift(
+        const sai_u16_range_t &value,
+        sai_thrift_u16_range_t &thrift_value)
+{
+    sai_value_to_thrift(value.min, thrift_value.min);
+    sai_value_to_thrift(value.max, thrift_value.max);
+}
+
+static void sai_value_to_thrift(
+        const sai_acl_resource_t &value,
+        sai_thrift_acl_resource_t &thrift_value)
+{
+    sai_value_to_thrift(value.stage, thrift_value.stage);
+    sai_value_to_thrift(value.bind_point, thrift_value.bind_point);
+    sai_value_to_thrift(value.avail_num, thrift_value.avail_num);
+}
+
+static void sai_value_to_thrift(
+        const sai_qos_map_params_t &value,
+        sai_thrift_qos_map_params_t &thrift_value)
+{
+    sai_value_to_thrift(value.tc, thrift_value.tc);
+    sai_value_to_thrift(value.dscp, thrift_value.dscp);
+    sai_value_to_thrift(value.dot1p, thrift_value.dot1p);
+    sai_value_to_thrift(value.prio, thrift_value.prio);
+    sai_value_to_thrift(value.pg, thrift_value.pg);
+    sai_value_to_thrift(value.queue_index, thrift_value.queue_index);
+    sai_value_to_thrift(value.color, thrift_value.color);
+    sai_value_to_thrift(value.mpls_exp, thrift_value.mpls_exp);
+}
+
+static void sai_value_to_thrift(
+        const sai_qos_map_t &value,
+        sai_thrift_qos_map_t &thrift_value)
+{
+    sai_value_to_thrift(value.key, thrift_value.key);
+    sai_value_to_thrift(value.value, thrift_value.value);
+}
+
+/**
+ * @brief Convert Thrift list to SAI list allocated from request arena
+ *
+ * For get, count sent by client is capacity of list, so list is allocated
+ * for the bigger of count and number of sent elements.
+ */
+template <typename T, typename V, typename F>
+static void sai_thrift_list_parse(
+        const std::vector<V> &thrift_list,
+        int64_t thrift_count,
+        T *&list,
+        uint32_t &count,
+        F convert)
+{
+    count = thrift_count > 0 ? (uint32_t)thrift_count : 0;
+
+    list = sai_thrift_arena_alloc<T>(std::max((size_t)count, thrift_list.size()));
+
+    for (size_t i = 0; i < thrift_list.size(); i++)
+    {
+        convert(thrift_list[i], list[i]);
+    }
+}
+
+template <typename T, typename V>
+static void sai_thrift_list_parse(
+        const std::vector<V> &thrift_list,
+        int64_t thrift_count,
+        T *&list,
+        uint32_t &count)
+{
+    sai_thrift_list_parse(thrift_list, thrift_count, list, count,
+            [](const V &value, T &item) { sai_thrift_value_parse(value, item); });
+}
+
+/**
+ * @brief Convert SAI list to Thrift list sized up front from list count
+ */
+template <typename T, typename V, typename F>
+static void sai_list_to_thrift(
+        const T *list,
+        uint32_t count,
+        std::vector<V> &thrift_list,
+        F convert)
+{
+    if (list == NULL)
+    {
+        count = 0;
+    }
+
+    thrift_list.resize(count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        convert(list[i], thrift_list[i]);
+    }
+}
+
+template <typename T, typename V>
+static void sai_list_to_thrift(
+        const T *list,
+        uint32_t count,
+        std::vector<V> &thrift_list)
+{
+    sai_list_to_thrift(list, count, thrift_list,
+            [](const T &item, V &value) { sai_value_to_thrift(item, value); });
+}
+
+static void sai_thrift_value_parse(
+        const sai_thrift_acl_capability_t &thrift_value,
+        sai_acl_capability_t &value)
+{
+    sai_thrift_value_parse(thrift_value.is_action_list_mandatory, value.is_action_list_mandatory);
+    sai_thrift_list_parse(thrift_value.action_list.int32list, thrift_value.action_list.count,
+            value.action_list.list, value.action_list.count);
+}
+
+static void sai_value_to_thrift(
+        const sai_acl_capability_t &value,
+        sai_thrift_acl_capability_t &thrift_value)
+{
+    sai_value_to_thrift(value.is_action_list_mandatory, thrift_value.is_action_list_mandatory);
+    sai_list_to_thrift(value.action_list.list, value.action_list.count, thrift_value.action_list.int32list);
+    thrift_value.action_list.count = value.action_list.count;
+}
+
+/**
+ * @brief Converters of single attribute value type
+ *
+ * Converters are generated by gensairpc.pl for each attribute value type,
+ * which members have element converters above, and are defined in
+ * sai_rpc_server.cpp.
+ */
+typedef struct _sai_thrift_attr_value_converter_t
+{
+    sai_attr_value_type_t value_type;
+
+    void (*parse)(const sai_thrift_attribute_value_t &thrift_value, sai_attribute_value_t &value);
+
+    void (*deparse)(const sai_attribute_value_t &value, sai_thrift_attribute_value_t &thrift_value);
+
+} sai_thrift_attr_value_converter_t;
+
+extern const sai_thrift_attr_value_converter_t sai_thrift_attr_value_converters[];
+
+extern const size_t sai_thrift_attr_value_converters_count;
+
+/**
+ * @brief Index generated table by its enum key
+ *
+ * Entries missing in table are NULL, so lookup is single vector access.
+ */
+template <typename T, typename K>
+static std::vector<const T*> sai_thrift_index_table(
+        const T *table,
+        size_t count,
+        K T::*key)
+{
+    std::vector<const T*> index;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t idx = (size_t)(table[i].*key);
+
+        if (idx >= index.size())
+        {
+            index.resize(idx + 1, NULL);
+        }
+
+        index[idx] = &table[i];
+    }
+
+    return index;
+}
+
+/**
+ * @brief Get converter of attribute value type
+ *
+ * Converters are indexed by value type on first use, so converting attribute
+ * costs single table lookup.
+ */
+static const sai_thrift_attr_value_converter_t* sai_thrift_get_attr_value_converter(
+        const sai_attr_metadata_t *md)
+{
+    static const std::vector<const sai_thrift_attr_value_converter_t*> converters =
+        sai_thrift_index_table(sai_thrift_attr_value_converters,
+                sai_thrift_attr_value_converters_count,
+                &sai_thrift_attr_value_converter_t::value_type);
+
+    if ((size_t)md->attrvaluetype >= converters.size())
+    {
+        return NULL;
+    }
+
+    return converters[md->attrvaluetype];
+}
+
+/**
+ * @brief Convert attribute from Thrift to SAI format according to the type
+ *
+ * Lists are allocated from request arena, so caller must hold
+ * sai_thrift_arena_scope for as long as converted attribute is used.
+ */
+void convert_attr_thrift_to_sai(
+        const sai_object_type_t ot,
+        const sai_thrift_attribute_t &thrift_attr,
+        sai_attribute_t *attr)
+{
+    const auto md = sai_metadata_get_attr_metadata(ot, thrift_attr.id);
+
+    attr->id = thrift_attr.id;
+
+    sai_thrift_exception e;
+
+    e.status = SAI_STATUS_NOT_SUPPORTED;
+
+    if (md == NULL)
+    {
+        SAI_META_LOG_ERROR("attr metadata not found for object type %d and attribute %d", ot, attr->id);
+        e.status = SAI_STATUS_INVALID_PARAMETER;
+        throw e;
+    }
+
+    const auto converter = sai_thrift_get_attr_value_converter(md);
+
+    if (converter == NULL)
+    {
+        SAI_META_LOG_ERROR("attr value type not supported for %s", md->attridname);
+        throw e;
+    }
+
+    converter->parse(thrift_attr.value, attr->value);
+}
+
+/**
+ * @brief Convert attribute from SAI to Thrift format according to the type
+ */
+void convert_attr_sai_to_thrift(
+        const sai_object_type_t ot,
+        const sai_attribute_t &attr,
+        sai_thrift_attribute_t &thrift_attr)
+{
+    const auto md = sai_metadata_get_attr_metadata(ot, attr.id);
+
+    thrift_attr.id = attr.id;
 
     sai_thrift_exception e;
 
@@ -622,259 +824,218 @@ void convert_attr_sai_to_thrift(
         throw e;
     }
 
-    switch (md->attrvaluetype)
+    const auto converter = sai_thrift_get_attr_value_converter(md);
+
+    if (converter == NULL)
     {
-        case SAI_ATTR_VALUE_TYPE_BOOL:
-            thrift_attr.value.booldata = attr.value.booldata;
-            break;
-        case SAI_ATTR_VALUE_TYPE_CHARDATA:
-            thrift_attr.value.chardata = attr.value.chardata;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT8:
-            thrift_attr.value.u8 = attr.value.u8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT8:
-            thrift_attr.value.s8 = attr.value.s8;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT16:
-            thrift_attr.value.u16 = attr.value.u16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT16:
-            thrift_attr.value.s16 = attr.value.s16;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT32:
-            thrift_attr.value.u32 = attr.value.u32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT32:
-            thrift_attr.value.s32 = attr.value.s32;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT64:
-            thrift_attr.value.u64 = attr.value.u64;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT64:
-            thrift_attr.value.s64 = attr.value.s64;
-            break;
-        case SAI_ATTR_VALUE_TYPE_MAC:
-            {
-                char mac_str[18];
-                snprintf(mac_str,
-                        sizeof(mac_str),
-                        "%02x:%02x:%02x:%02x:%02x:%02x",
-                        attr.value.mac[0],
-                        attr.value.mac[1],
-                        attr.value.mac[2],
-                        attr.value.mac[3],
-                        attr.value.mac[4],
-                        attr.value.mac[5]);
-                thrift_attr.value.mac = mac_str;
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_IPV4:
-            thrift_attr.value.ip4 = sai_ip4_t_to_thrift(attr.value.ip4);
-            break;
-        case SAI_ATTR_VALUE_TYPE_IPV6:
-            thrift_attr.value.ip6 = sai_ip6_t_to_thrift(attr.value.ip6);
-            break;
-        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
-            sai_ip_address_t_to_thrift(thrift_attr.value.ipaddr, attr.value.ipaddr);
-            break;
-        case SAI_ATTR_VALUE_TYPE_IP_PREFIX:
-            sai_ip_prefix_t_to_thrift(thrift_attr.value.ipprefix, attr.value.ipprefix);
-            break;
-        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
-            thrift_attr.value.oid = attr.value.oid;
-            break;
-        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.objlist.count; i++)
-                {
-                    thrift_attr.value.objlist.idlist.push_back(attr.value.objlist.list[i]);
-                }
-                thrift_attr.value.objlist.count = attr.value.objlist.count;
-                free(attr.value.objlist.list);
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.u8list.count; i++)
-                {
-                    thrift_attr.value.u8list.uint8list.push_back(attr.value.u8list.list[i]);
-                }
-                thrift_attr.value.u8list.count = attr.value.u8list.count;
-                free(attr.value.u8list.list);
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT8_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.s8list.count; i++)
-                {
-                    thrift_attr.value.s8list.int8list.push_back(attr.value.s8list.list[i]);
-                }
-                thrift_attr.value.s8list.count = attr.value.s8list.count;
-                free(attr.value.s8list.list);
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.u16list.count; i++)
-                {
-                    thrift_attr.value.u16list.uint16list.push_back(attr.value.u16list.list[i]);
-                }
-                thrift_attr.value.u16list.count = attr.value.u16list.count;
-                free(attr.value.u16list.list);
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT16_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.s16list.count; i++)
-                {
-                    thrift_attr.value.s16list.int16list.push_back(attr.value.s16list.list[i]);
-                }
-                thrift_attr.value.s16list.count = attr.value.s16list.count;
-                free(attr.value.s16list.list);
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.u32list.count; i++)
-                {
-                    thrift_attr.value.u32list.uint32list.push_back(attr.value.u32list.list[i]);
-                }
-                thrift_attr.value.u32list.count = attr.value.u32list.count;
-                free(attr.value.u32list.list);
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT32_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.s32list.count; i++)
-                {
-                    thrift_attr.value.s32list.int32list.push_back(attr.value.s32list.list[i]);
-                }
-                thrift_attr.value.s32list.count = attr.value.s32list.count;
-                free(attr.value.s32list.list);
-            }
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT32_RANGE:
-            thrift_attr.value.u32range.min = attr.value.u32range.min;
-            thrift_attr.value.u32range.max = attr.value.u32range.max;
-            break;
-        case SAI_ATTR_VALUE_TYPE_INT32_RANGE:
-            thrift_attr.value.s32range.min = attr.value.s32range.min;
-            thrift_attr.value.s32range.max = attr.value.s32range.max;
-            break;
-        case SAI_ATTR_VALUE_TYPE_UINT16_RANGE_LIST:
-            {
-                for (unsigned int i = 0; i < attr.value.u16rangelist.count; i++)
-                {
-                    sai_thrift_u16_range_t range;
-                    range.min = attr.value.u16rangelist.list[i].min;
-                    range.max = attr.value.u16rangelist.list[i].max;
-                    thrift_attr.value.u16rangelist.rangelist.push_back(range);
-                }
-                thrift_attr.value.u16rangelist.count = attr.value.u16rangelist.count;
-                free(attr.value.u16rangelist.list);
-            }
-            break;
+        SAI_META_LOG_ERROR("attr value type not supported for %s", md->attridname);
+        throw e;
+    }
+
+    converter->deparse(attr.value, thrift_attr.value);
+}
+
+/**
+ * @brief Convert Thrift NAT type to SAI NAT type
+ */
+static void sai_thrift_nat_type_t_parse(
+        const sai_thrift_nat_type_t &thrift_nat_type,
+        sai_nat_type_t *nat_type)
+{
+    *nat_type = (sai_nat_type_t)thrift_nat_type;
+}
+
+/**
+ * @brief Handlers of pipelined operations on object type
+ *
+ * Generated for each object type which has create, remove or set function,
+ * handlers of missing functions are NULL. Handlers return
+ * SAI_STATUS_NOT_IMPLEMENTED if vendor does not implement the function.
+ * parse_key is NULL for object types which are object ids.
+ */
+typedef struct _sai_thrift_operation_handler_t
+{
+    sai_object_type_t object_type;
+
+    void (*parse_key)(const sai_thrift_operation_t &thrift_operation, sai_object_meta_key_t *meta_key);
+
+    sai_meta_generic_create_fn create;
+
+    sai_meta_generic_remove_fn remove;
+
+    sai_meta_generic_set_fn set;
+
+} sai_thrift_operation_handler_t;
+
+extern const sai_thrift_operation_handler_t sai_thrift_operation_handlers[];
+
+extern const size_t sai_thrift_operation_handlers_count;
+
+/**
+ * @brief Get handlers of pipelined operations on object type
+ */
+static const sai_thrift_operation_handler_t* sai_thrift_get_operation_handler(
+        sai_object_type_t object_type)
+{
+    static const std::vector<const sai_thrift_operation_handler_t*> handlers =
+        sai_thrift_index_table(sai_thrift_operation_handlers,
+                sai_thrift_operation_handlers_count,
+                &sai_thrift_operation_handler_t::object_type);
+
+    if ((size_t)object_type >= handlers.size())
+    {
+        return NULL;
+    }
+
+    return handlers[object_type];
+}
+
+// including it here we never have to modify the generated file
+#include "sai_rpc_server.cpp"
+
+/**
+ * @brief Execute single operation of pipelined request
+ *
+ * Errors are returned as status instead of exception, so remaining
+ * operations of the request can be executed.
+ */
+static sai_status_t sai_thrift_execute_operation(
+        const sai_thrift_operation_t &thrift_operation,
+        sai_object_id_t *object_id)
+{
+    // converted attributes are released after each operation
+    sai_thrift_arena_scope arena_scope;
+
+    const sai_object_type_t object_type = (sai_object_type_t)thrift_operation.object_type;
+
+    const auto handler = sai_thrift_get_operation_handler(object_type);
+
+    if (handler == NULL)
+    {
+        SAI_META_LOG_ERROR("pipelined operations are not supported for object type %d", object_type);
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    sai_object_meta_key_t meta_key;
+
+    memset(&meta_key, 0, sizeof(meta_key));
+
+    meta_key.objecttype = object_type;
+
+    if (handler->parse_key)
+    {
+        handler->parse_key(thrift_operation, &meta_key);
+    }
+    else
+    {
+        meta_key.objectkey.key.object_id = thrift_operation.object_id;
+    }
+
+    const uint32_t attr_count = (uint32_t)thrift_operation.attr_list.size();
 
-        case SAI_ATTR_VALUE_TYPE_ACL_CAPABILITY:
+    sai_attribute_t *attr_list = sai_thrift_arena_alloc<sai_attribute_t>(attr_count);
+
+    try
+    {
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            convert_attr_thrift_to_sai(object_type, thrift_operation.attr_list[i], &attr_list[i]);
+        }
+    }
+    catch (const sai_thrift_exception &e)
+    {
+        return (sai_status_t)e.status;
+    }
+
+    sai_status_t status = SAI_STATUS_NOT_SUPPORTED;
+
+    switch (thrift_operation.operation)
+    {
+        case SAI_COMMON_API_CREATE:
+
+            if (handler->create)
             {
-                for (unsigned int i = 0; i < attr.value.aclcapability.action_list.count; i++)
-                {
-                    thrift_attr.value.aclcapability.action_list.int32list.push_back(attr.value.aclcapability.action_list.list[i]);
-                }
-                thrift_attr.value.aclcapability.action_list.count = attr.value.aclcapability.action_list.count;
-                free(attr.value.aclcapability.action_list.list);
+                status = handler->create(&meta_key, switch_id, attr_count, attr_list);
             }
-            break;
-        case SAI_ATTR_VALUE_TYPE_ACL_RESOURCE_LIST:
+
+            if (status == SAI_STATUS_SUCCESS && handler->parse_key == NULL)
             {
-                for (unsigned int i = 0; i < attr.value.aclresource.count; i++)
-                {
-                    sai_thrift_acl_resource_t resource = {};
-                    resource.stage = attr.value.aclresource.list[i].stage;
-                    resource.bind_point = attr.value.aclresource.list[i].bind_point;
-                    resource.avail_num = attr.value.aclresource.list[i].avail_num;
-                    thrift_attr.value.aclresource.resourcelist.push_back(resource);
-                }
-                thrift_attr.value.aclresource.count = attr.value.aclresource.count;
-                free(attr.value.aclresource.list);
+                *object_id = meta_key.objectkey.key.object_id;
             }
+
             break;
-        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS_LIST:
+
+        case SAI_COMMON_API_REMOVE:
+
+            if (handler->remove)
             {
-                for (unsigned int i = 0; i < attr.value.ipaddrlist.count; i++)
-                {
-                    sai_thrift_ip_address_t thrift_ip;
-                    sai_ip_address_t_to_thrift(thrift_ip, attr.value.ipaddrlist.list[i]);
-                    thrift_attr.value.ipaddrlist.addresslist.push_back(thrift_ip);
-                }
-                thrift_attr.value.ipaddrlist.count = attr.value.ipaddrlist.count;
-                free(attr.value.ipaddrlist.list);
+                status = handler->remove(&meta_key);
             }
+
             break;
-        case SAI_ATTR_VALUE_TYPE_IP_PREFIX_LIST:
+
+        case SAI_COMMON_API_SET:
+
+            if (attr_count != 1)
             {
-                for (unsigned int i = 0; i < attr.value.ipprefixlist.count; i++)
-                {
-                    sai_thrift_ip_prefix_t thrift_ip;
-                    sai_ip_prefix_t_to_thrift(thrift_ip, attr.value.ipprefix);
-                    thrift_attr.value.ipprefixlist.prefixlist.push_back(thrift_ip);
-                }
-                thrift_attr.value.ipprefixlist.count = attr.value.ipprefixlist.count;
-                free(attr.value.ipprefixlist.list);
+                return SAI_STATUS_INVALID_PARAMETER;
             }
-            break;
-        case SAI_ATTR_VALUE_TYPE_QOS_MAP_LIST:
+
+            if (handler->set)
             {
-                for (unsigned int i = 0; i < attr.value.qosmap.count; i++)
-                {
-                    sai_thrift_qos_map_t thrift_qos_map;
-                    // key
-                    thrift_qos_map.key.tc = attr.value.qosmap.list[i].key.tc;
-                    thrift_qos_map.key.dscp = attr.value.qosmap.list[i].key.dscp;
-                    thrift_qos_map.key.dot1p = attr.value.qosmap.list[i].key.dot1p;
-                    thrift_qos_map.key.prio = attr.value.qosmap.list[i].key.prio;
-                    thrift_qos_map.key.pg = attr.value.qosmap.list[i].key.pg;
-                    thrift_qos_map.key.queue_index = attr.value.qosmap.list[i].key.queue_index;
-                    thrift_qos_map.key.color = static_cast<int32_t>(attr.value.qosmap.list[i].key.color);
-                    thrift_qos_map.key.mpls_exp = attr.value.qosmap.list[i].key.mpls_exp;
-                    // value
-                    thrift_qos_map.value.tc = attr.value.qosmap.list[i].value.tc;
-                    thrift_qos_map.value.dscp = attr.value.qosmap.list[i].value.dscp;
-                    thrift_qos_map.value.dot1p = attr.value.qosmap.list[i].value.dot1p;
-                    thrift_qos_map.value.prio = attr.value.qosmap.list[i].value.prio;
-                    thrift_qos_map.value.pg = attr.value.qosmap.list[i].value.pg;
-                    thrift_qos_map.value.queue_index = attr.value.qosmap.list[i].value.queue_index;
-                    thrift_qos_map.value.color = static_cast<int32_t>(attr.value.qosmap.list[i].value.color);
-                    thrift_qos_map.value.mpls_exp = attr.value.qosmap.list[i].value.mpls_exp;
-                    thrift_attr.value.qosmap.maplist.push_back(thrift_qos_map);
-                }
-                thrift_attr.value.qosmap.count = attr.value.qosmap.count;
-                free(attr.value.qosmap.list);
+                status = handler->set(&meta_key, attr_list);
             }
+
             break;
+
         default:
-            SAI_META_LOG_ERROR("attr value type not supported for %s", md->attridname);
-            throw e;
+
+            SAI_META_LOG_ERROR("operation %d can't be pipelined", thrift_operation.operation);
+            return SAI_STATUS_INVALID_PARAMETER;
     }
-}
 
-/**
- * @brief Convert Thrift NAT type to SAI NAT type
- */
-static void sai_thrift_nat_type_t_parse(
-        const sai_thrift_nat_type_t &thrift_nat_type,
-        sai_nat_type_t *nat_type)
-{
-    *nat_type = (sai_nat_type_t)thrift_nat_type;
+    return status;
 }
 
-// including it here we never have to modify the generated file
-#include "sai_rpc_server.cpp"
-
 class sai_rpcHandlerFrontend:
     virtual public sai_rpcHandler
 {
+    /**
+     * @brief Execute pipelined create, remove and set operations in order
+     *
+     * Each operation gets its status, and object id if object was created.
+     * Operations after failed one are not executed in
+     * SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR mode.
+     */
+    void sai_thrift_execute_operations(
+            std::vector<sai_thrift_operation_result_t> &thrift_results,
+            const std::vector<sai_thrift_operation_t> &thrift_operations,
+            const int32_t mode) override
+    {
+        thrift_results.resize(thrift_operations.size());
+
+        bool stopped = false;
+
+        for (size_t i = 0; i < thrift_operations.size(); i++)
+        {
+            sai_thrift_operation_result_t &result = thrift_results[i];
+
+            sai_object_id_t object_id = SAI_NULL_OBJECT_ID;
+
+            sai_status_t status = SAI_STATUS_NOT_EXECUTED;
+
+            if (!stopped)
+            {
+                status = sai_thrift_execute_operation(thrift_operations[i], &object_id);
+            }
+
+            result.status = status;
+            result.object_id = object_id;
+
+            stopped |= (status != SAI_STATUS_SUCCESS && mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR);
+        }
+    }
+
     /**
      * @brief Thrift wrapper for sai_object_type_get_availability() SAI function
      */
@@ -25,6 +25,9 @@
 #include <iostream>
 #include <map>
 #include <set>
+#include <vector>
+#include <string>
+#include <algorithm>
 
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +46,26 @@ static bool show_switch_links = false;
 static bool show_read_only_links = false;
 static bool show_extensions = false;
 
+/*
+ * Dependency edge between object types, "from" object must exist before "to"
+ * object is created. Hard edge can't be set after create (it's mandatory on
+ * create, create only or non object id key member), so cycle of hard edges
+ * can't be resolved by any create order.
+ */
+typedef struct _dep_edge_t
+{
+    sai_object_type_t from;
+
+    sai_object_type_t to;
+
+    std::string name;
+
+    bool hard;
+
+} dep_edge_t;
+
+static std::vector<dep_edge_t> edges;
+
 static void process_object_type_attributes(
         _In_ const sai_attr_metadata_t* const* const meta_attr_list,
         _In_ sai_object_type_t current_object_type)
@@ -249,13 +272,428 @@ static void process_nonobjectid_connections()
     PRINT_NN(SWITCH, PORT, "[dir=\"none\", color=\"red\", peripheries = 2, penwidth=2.0 , style  = dashed ];\n");
 }
 
+static const char* object_type_name(
+        _In_ sai_object_type_t ot)
+{
+    return sai_metadata_all_object_type_infos[ot]->objecttypename;
+}
+
+static const char* object_type_short_name(
+        _In_ sai_object_type_t ot)
+{
+    return object_type_name(ot) + strlen("SAI_OBJECT_TYPE_");
+}
+
+static void add_edges(
+        _In_ sai_object_type_t to,
+        _In_ const sai_object_type_t* allowed,
+        _In_ size_t count,
+        _In_ const std::string& name,
+        _In_ bool hard)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (allowed[i] == SAI_OBJECT_TYPE_SWITCH)
+        {
+            // every object depends on switch, it's handled by ranks
+            continue;
+        }
+
+        dep_edge_t edge;
+
+        edge.from = allowed[i];
+        edge.to = to;
+        edge.name = name;
+        edge.hard = hard;
+
+        edges.push_back(edge);
+    }
+}
+
+static void collect_edges()
+{
+    for (size_t i = SAI_OBJECT_TYPE_NULL; i < SAI_OBJECT_TYPE_EXTENSIONS_MAX; ++i)
+    {
+        const sai_object_type_info_t* oi = sai_metadata_all_object_type_infos[i];
+
+        if (oi == NULL || oi->objecttype == SAI_OBJECT_TYPE_SWITCH)
+        {
+            // switch attributes pointing to objects can only be set after
+            // switch is created, so they are not dependencies
+            continue;
+        }
+
+        for (size_t j = 0; oi->attrmetadata[j] != NULL; ++j)
+        {
+            const sai_attr_metadata_t* meta = oi->attrmetadata[j];
+
+            if (SAI_HAS_FLAG_READ_ONLY(meta->flags))
+            {
+                continue;
+            }
+
+            bool hard = SAI_HAS_FLAG_MANDATORY_ON_CREATE(meta->flags) || SAI_HAS_FLAG_CREATE_ONLY(meta->flags);
+
+            add_edges(oi->objecttype, meta->allowedobjecttypes, meta->allowedobjecttypeslength, meta->attridname, hard);
+        }
+
+        for (size_t j = 0; oi->isnonobjectid && j < oi->structmemberscount; ++j)
+        {
+            const sai_struct_member_info_t* sm = oi->structmembers[j];
+
+            std::string name = std::string(oi->objecttypename) + "." + sm->membername;
+
+            if (sm->membervaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID)
+            {
+                add_edges(oi->objecttype, sm->allowedobjecttypes, sm->allowedobjecttypeslength, name, true);
+            }
+            else if (sm->isvlan)
+            {
+                sai_object_type_t vlan = SAI_OBJECT_TYPE_VLAN;
+
+                add_edges(oi->objecttype, &vlan, 1, name, true);
+            }
+        }
+    }
+}
+
+/*
+ * Tarjan's strongly connected components, components are returned in reverse
+ * topological order (component is returned after all components it points to).
+ */
+class scc_finder
+{
+    public:
+
+        scc_finder(
+                _In_ bool hard_only)
+        {
+            counter = 0;
+
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                const dep_edge_t& e = edges[i];
+
+                if (e.from != e.to && (e.hard || !hard_only))
+                {
+                    adj[e.from].insert(e.to);
+                }
+            }
+
+            for (size_t i = SAI_OBJECT_TYPE_NULL + 1; i < SAI_OBJECT_TYPE_EXTENSIONS_MAX; ++i)
+            {
+                if (sai_metadata_all_object_type_infos[i] != NULL && index.find((sai_object_type_t)i) == index.end())
+                {
+                    visit((sai_object_type_t)i);
+                }
+            }
+        }
+
+        std::vector<std::vector<sai_object_type_t> > components;
+
+        std::map<sai_object_type_t, size_t> component;
+
+        std::map<sai_object_type_t, std::set<sai_object_type_t> > adj;
+
+    private:
+
+        void visit(
+                _In_ sai_object_type_t ot)
+        {
+            index[ot] = lowlink[ot] = counter++;
+
+            stack.push_back(ot);
+            onstack.insert(ot);
+
+            const std::set<sai_object_type_t>& succ = adj[ot];
+
+            for (std::set<sai_object_type_t>::const_iterator it = succ.begin(); it != succ.end(); ++it)
+            {
+                sai_object_type_t to = *it;
+
+                if (index.find(to) == index.end())
+                {
+                    visit(to);
+
+                    lowlink[ot] = std::min(lowlink[ot], lowlink[to]);
+                }
+                else if (onstack.find(to) != onstack.end())
+                {
+                    lowlink[ot] = std::min(lowlink[ot], index[to]);
+                }
+            }
+
+            if (lowlink[ot] != index[ot])
+            {
+                return;
+            }
+
+            std::vector<sai_object_type_t> comp;
+
+            sai_object_type_t member;
+
+            do
+            {
+                member = stack.back();
+
+                stack.pop_back();
+                onstack.erase(member);
+
+                component[member] = components.size();
+                comp.push_back(member);
+            }
+            while (member != ot);
+
+            std::sort(comp.begin(), comp.end());
+
+            components.push_back(comp);
+        }
+
+        size_t counter;
+
+        std::map<sai_object_type_t, size_t> index;
+
+        std::map<sai_object_type_t, size_t> lowlink;
+
+        std::vector<sai_object_type_t> stack;
+
+        std::set<sai_object_type_t> onstack;
+};
+
+static std::map<sai_object_type_t, uint32_t> create_rank;
+static std::map<sai_object_type_t, uint32_t> remove_rank;
+
+static std::vector<std::vector<sai_object_type_t> > cycles;
+
+/*
+ * Object types in the same cycle get the same rank, their soft references
+ * must be set after create (or removed before remove). Switch is created
+ * first and removed last.
+ */
+static int compute_ranks()
+{
+    collect_edges();
+
+    int errors = 0;
+
+    scc_finder hard(true);
+
+    for (size_t c = 0; c < hard.components.size(); ++c)
+    {
+        if (hard.components[c].size() < 2)
+        {
+            continue;
+        }
+
+        std::cerr << "ERROR: cycle of mandatory on create or create only references:";
+
+        for (size_t i = 0; i < hard.components[c].size(); ++i)
+        {
+            std::cerr << " " << object_type_short_name(hard.components[c][i]);
+        }
+
+        std::cerr << "\n";
+
+        errors++;
+    }
+
+    scc_finder all(false);
+
+    size_t count = all.components.size();
+
+    std::vector<uint32_t> crank(count, 0);
+    std::vector<uint32_t> rrank(count, 0);
+
+    // components are in reverse topological order, so create ranks are
+    // propagated from last component and remove ranks from first one
+
+    for (size_t c = count; c-- > 0; )
+    {
+        for (size_t i = 0; i < all.components[c].size(); ++i)
+        {
+            const std::set<sai_object_type_t>& succ = all.adj[all.components[c][i]];
+
+            for (std::set<sai_object_type_t>::const_iterator it = succ.begin(); it != succ.end(); ++it)
+            {
+                size_t tc = all.component[*it];
+
+                if (tc != c)
+                {
+                    crank[tc] = std::max(crank[tc], crank[c] + 1);
+                }
+            }
+        }
+    }
+
+    for (size_t c = 0; c < count; ++c)
+    {
+        for (size_t i = 0; i < all.components[c].size(); ++i)
+        {
+            const std::set<sai_object_type_t>& succ = all.adj[all.components[c][i]];
+
+            for (std::set<sai_object_type_t>::const_iterator it = succ.begin(); it != succ.end(); ++it)
+            {
+                size_t tc = all.component[*it];
+
+                if (tc != c)
+                {
+                    rrank[c] = std::max(rrank[c], rrank[tc] + 1);
+                }
+            }
+        }
+
+        if (all.components[c].size() > 1)
+        {
+            cycles.push_back(all.components[c]);
+        }
+    }
+
+    uint32_t max = 0;
+
+    std::map<sai_object_type_t, size_t>::const_iterator it = all.component.begin();
+
+    for (; it != all.component.end(); ++it)
+    {
+        if (it->first == SAI_OBJECT_TYPE_SWITCH)
+        {
+            continue;
+        }
+
+        create_rank[it->first] = crank[it->second] + 1;
+        remove_rank[it->first] = rrank[it->second];
+
+        max = std::max(max, rrank[it->second]);
+    }
+
+    create_rank[SAI_OBJECT_TYPE_SWITCH] = 0;
+    remove_rank[SAI_OBJECT_TYPE_SWITCH] = max + 1;
+
+    return errors;
+}
+
+static void print_rank_array(
+        _In_ const char* name,
+        _In_ const std::map<sai_object_type_t, uint32_t>& rank)
+{
+    uint32_t max = 0;
+
+    std::cout << "const uint32_t " << name << "[SAI_OBJECT_TYPE_EXTENSIONS_MAX] = {\n";
+
+    std::map<sai_object_type_t, uint32_t>::const_iterator it = rank.begin();
+
+    for (; it != rank.end(); ++it)
+    {
+        std::cout << "    [" << object_type_name(it->first) << "] = " << it->second << ",\n";
+
+        max = std::max(max, it->second);
+    }
+
+    std::cout << "};\n";
+    std::cout << "const uint32_t " << name << "_max = " << max << ";\n";
+}
+
+static void print_cycle(
+        _In_ const std::vector<sai_object_type_t>& cycle,
+        _In_ const char* quote)
+{
+    for (size_t i = 0; i < cycle.size(); ++i)
+    {
+        std::cout << (i ? ", " : " ") << quote << object_type_short_name(cycle[i]) << quote;
+    }
+}
+
+static void print_rank_source()
+{
+    std::cout << "/* AUTOGENERATED FILE! DO NOT EDIT, generated by saidepgraphgen -c */\n";
+    std::cout << "#include <sai.h>\n";
+    std::cout << "#include \"saimetadata.h\"\n";
+
+    for (size_t i = 0; i < cycles.size(); ++i)
+    {
+        std::cout << "/* cycle:";
+
+        print_cycle(cycles[i], "");
+
+        std::cout << " */\n";
+    }
+
+    print_rank_array("sai_metadata_object_type_create_rank", create_rank);
+    print_rank_array("sai_metadata_object_type_remove_rank", remove_rank);
+}
+
+static void print_json()
+{
+    std::cout << "{\n";
+    std::cout << "  \"nodes\": [\n";
+
+    std::map<sai_object_type_t, uint32_t>::const_iterator it = create_rank.begin();
+
+    for (size_t i = 1; it != create_rank.end(); ++it, ++i)
+    {
+        std::cout << "    { \"name\": \"" << object_type_short_name(it->first) << "\", \"objecttype\": \"" << object_type_name(it->first) << "\"";
+        std::cout << ", \"value\": " << (int)it->first;
+        std::cout << ", \"createrank\": " << it->second << ", \"removerank\": " << remove_rank[it->first] << " }";
+        std::cout << (i == create_rank.size() ? "\n" : ",\n");
+    }
+
+    std::cout << "  ],\n";
+    std::cout << "  \"edges\": [\n";
+
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        const dep_edge_t& e = edges[i];
+
+        std::cout << "    { \"from\": \"" << object_type_short_name(e.from) << "\", \"to\": \"" << object_type_short_name(e.to) << "\"";
+        std::cout << ", \"name\": \"" << e.name << "\", \"hard\": " << (e.hard ? "true" : "false") << " }";
+        std::cout << (i + 1 == edges.size() ? "\n" : ",\n");
+    }
+
+    std::cout << "  ],\n";
+    std::cout << "  \"cycles\": [\n";
+
+    for (size_t i = 0; i < cycles.size(); ++i)
+    {
+        std::cout << "    [";
+
+        print_cycle(cycles[i], "\"");
+
+        std::cout << " ]" << (i + 1 == cycles.size() ? "\n" : ",\n");
+    }
+
+    std::cout << "  ]\n";
+    std::cout << "}\n";
+}
+
 int main(int argc, char** argv)
 {
+    bool rank_source = false;
+    bool json = false;
+
     for (int i = 1; i < argc; ++i)
     {
         show_switch_links       |= strcmp(argv[i], "-s") == 0;
         show_read_only_links    |= strcmp(argv[i], "-r") == 0;
         show_extensions         |= strcmp(argv[i], "-e") == 0;
+        rank_source             |= strcmp(argv[i], "-c") == 0;
+        json                    |= strcmp(argv[i], "-j") == 0;
+    }
+
+    if (rank_source || json)
+    {
+        // hard cycles fail the build, since no create order exists for them
+
+        int errors = compute_ranks();
+
+        if (rank_source)
+        {
+            print_rank_source();
+        }
+        else
+        {
+            print_json();
+        }
+
+        return errors ? 1 : 0;
     }
 
     std::cout << "digraph \"SAI Object Dependency Graph\" {\n";
@@ -0,0 +1,357 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadataattr.c
+ *
+ * @brief   This module defines SAI Metadata Attribute Value Helpers
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+#define SAI_METADATA_ATTR_FNV_PRIME 0x100000001B3ULL
+
+/* lists in single allocation copy are aligned, since list elements can be 64 bit */
+
+#define SAI_METADATA_ATTR_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+uint64_t sai_metadata_attr_hash_bytes(
+        _In_ uint64_t hash,
+        _In_ const void *data,
+        _In_ size_t size)
+{
+    const uint8_t *bytes = (const uint8_t*)data;
+
+    size_t idx;
+
+    for (idx = 0; idx < size; idx++)
+    {
+        hash ^= bytes[idx];
+        hash *= SAI_METADATA_ATTR_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+uint64_t sai_metadata_attr_hash_string(
+        _In_ uint64_t hash,
+        _In_ const char *str,
+        _In_ size_t max_length)
+{
+    size_t length = 0;
+
+    while (length < max_length && str[length] != 0)
+    {
+        length++;
+    }
+
+    return sai_metadata_attr_hash_bytes(hash, str, length);
+}
+
+/*
+ * List count and pointer are accessed by offset inside attribute value, they
+ * are copied by memcpy, since pointed type differs for each list.
+ */
+
+static uint32_t sai_metadata_attr_get_list(
+        _In_ const sai_attribute_value_t *value,
+        _In_ const sai_metadata_attr_value_list_t *list,
+        _Out_ const void **ptr)
+{
+    const uint8_t *base = (const uint8_t*)value;
+
+    uint32_t count;
+
+    memcpy(&count, base + list->count_offset, sizeof(count));
+    memcpy(ptr, base + list->list_offset, sizeof(*ptr));
+
+    return count;
+}
+
+static void sai_metadata_attr_set_list(
+        _Inout_ sai_attribute_value_t *value,
+        _In_ const sai_metadata_attr_value_list_t *list,
+        _In_ const void *ptr)
+{
+    memcpy((uint8_t*)value + list->list_offset, &ptr, sizeof(ptr));
+}
+
+uint32_t sai_metadata_attr_get_value_lists(
+        _In_ const sai_attr_metadata_t *md,
+        _In_ const sai_attribute_value_t *value,
+        _Out_ sai_metadata_attr_value_list_t *lists)
+{
+    if ((md->isaclfield && !value->aclfield.enable) ||
+            (md->isaclaction && !value->aclaction.enable))
+    {
+        return 0;
+    }
+
+    return sai_metadata_attr_value_lists(md->attrvaluetype, lists);
+}
+
+static const sai_attr_metadata_t* sai_metadata_attr_get_metadata(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_attr_id_t attr_id)
+{
+    const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(object_type, attr_id);
+
+    if (md == NULL)
+    {
+        SAI_META_LOG_ERROR("unable to find attribute metadata %d:%d", object_type, attr_id);
+    }
+
+    return md;
+}
+
+sai_status_t sai_metadata_attr_copy(
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *src,
+        _Inout_ sai_attribute_t *dst)
+{
+    const sai_attr_metadata_t *md = sai_metadata_attr_get_metadata(object_type, src->id);
+
+    if (md == NULL)
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_metadata_attr_value_list_t lists[SAI_METADATA_ATTR_VALUE_LISTS_MAX];
+
+    uint32_t count = sai_metadata_attr_get_value_lists(md, &src->value, lists);
+
+    *dst = *src;
+
+    uint32_t idx;
+
+    /* clear all lists first, so partial copy can be released on failure */
+
+    for (idx = 0; idx < count; idx++)
+    {
+        sai_metadata_attr_set_list(&dst->value, &lists[idx], NULL);
+    }
+
+    for (idx = 0; idx < count; idx++)
+    {
+        const void *list;
+
+        uint32_t list_count = sai_metadata_attr_get_list(&src->value, &lists[idx], &list);
+
+        if (list_count == 0 || list == NULL)
+        {
+            continue;
+        }
+
+        size_t size = (size_t)list_count * lists[idx].element_size;
+
+        void *copy = malloc(size);
+
+        if (copy == NULL)
+        {
+            SAI_META_LOG_ERROR("failed to allocate %zu bytes for %s", size, md->attridname);
+
+            sai_metadata_attr_free(object_type, dst);
+
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        memcpy(copy, list, size);
+
+        sai_metadata_attr_set_list(&dst->value, &lists[idx], copy);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_attr_free(
+        _In_ sai_object_type_t object_type,
+        _Inout_ sai_attribute_t *attr)
+{
+    const sai_attr_metadata_t *md = sai_metadata_attr_get_metadata(object_type, attr->id);
+
+    if (md == NULL)
+    {
+        return;
+    }
+
+    sai_metadata_attr_value_list_t lists[SAI_METADATA_ATTR_VALUE_LISTS_MAX];
+
+    uint32_t count = sai_metadata_attr_get_value_lists(md, &attr->value, lists);
+
+    uint32_t idx;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        const void *list;
+
+        sai_metadata_attr_get_list(&attr->value, &lists[idx], &list);
+
+        free((void*)(uintptr_t)list);
+
+        sai_metadata_attr_set_list(&attr->value, &lists[idx], NULL);
+    }
+}
+
+bool sai_metadata_attr_equal(
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *first,
+        _In_ const sai_attribute_t *second)
+{
+    if (first->id != second->id)
+    {
+        return false;
+    }
+
+    const sai_attr_metadata_t *md = sai_metadata_attr_get_metadata(object_type, first->id);
+
+    if (md == NULL)
+    {
+        return false;
+    }
+
+    return sai_metadata_attr_value_equal(md->attrvaluetype, &first->value, &second->value);
+}
+
+uint64_t sai_metadata_attr_hash(
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *attr)
+{
+    uint64_t hash = sai_metadata_attr_hash_bytes(SAI_METADATA_ATTR_HASH_INIT, &attr->id, sizeof(attr->id));
+
+    const sai_attr_metadata_t *md = sai_metadata_attr_get_metadata(object_type, attr->id);
+
+    if (md == NULL)
+    {
+        return hash;
+    }
+
+    return sai_metadata_attr_value_hash(md->attrvaluetype, hash, &attr->value);
+}
+
+sai_status_t sai_metadata_attr_list_copy(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list,
+        _Inout_ sai_attribute_t **copy)
+{
+    *copy = NULL;
+
+    if (attr_count == 0)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (attr_list == NULL)
+    {
+        SAI_META_LOG_ERROR("attribute list is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* first pass computes size of all attributes and lists */
+
+    size_t attrs_size = SAI_METADATA_ATTR_ALIGN((size_t)attr_count * sizeof(sai_attribute_t));
+
+    size_t total = attrs_size;
+
+    sai_metadata_attr_value_list_t lists[SAI_METADATA_ATTR_VALUE_LISTS_MAX];
+
+    uint32_t idx;
+    uint32_t list_idx;
+
+    for (idx = 0; idx < attr_count; idx++)
+    {
+        const sai_attr_metadata_t *md = sai_metadata_attr_get_metadata(object_type, attr_list[idx].id);
+
+        if (md == NULL)
+        {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        uint32_t count = sai_metadata_attr_get_value_lists(md, &attr_list[idx].value, lists);
+
+        for (list_idx = 0; list_idx < count; list_idx++)
+        {
+            const void *list;
+
+            uint32_t list_count = sai_metadata_attr_get_list(&attr_list[idx].value, &lists[list_idx], &list);
+
+            if (list_count != 0 && list != NULL)
+            {
+                total += SAI_METADATA_ATTR_ALIGN((size_t)list_count * lists[list_idx].element_size);
+            }
+        }
+    }
+
+    sai_attribute_t *attrs = (sai_attribute_t*)malloc(total);
+
+    if (attrs == NULL)
+    {
+        SAI_META_LOG_ERROR("failed to allocate %zu bytes for %u attributes", total, attr_count);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy(attrs, attr_list, (size_t)attr_count * sizeof(sai_attribute_t));
+
+    uint8_t *payload = (uint8_t*)attrs + attrs_size;
+
+    /* second pass moves lists behind attributes */
+
+    for (idx = 0; idx < attr_count; idx++)
+    {
+        const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+
+        uint32_t count = sai_metadata_attr_get_value_lists(md, &attr_list[idx].value, lists);
+
+        for (list_idx = 0; list_idx < count; list_idx++)
+        {
+            const void *list;
+
+            uint32_t list_count = sai_metadata_attr_get_list(&attr_list[idx].value, &lists[list_idx], &list);
+
+            if (list_count == 0 || list == NULL)
+            {
+                sai_metadata_attr_set_list(&attrs[idx].value, &lists[list_idx], NULL);
+                continue;
+            }
+
+            size_t size = (size_t)list_count * lists[list_idx].element_size;
+
+            memcpy(payload, list, size);
+
+            sai_metadata_attr_set_list(&attrs[idx].value, &lists[list_idx], payload);
+
+            payload += SAI_METADATA_ATTR_ALIGN(size);
+        }
+    }
+
+    *copy = attrs;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_attr_list_free(
+        _Inout_ sai_attribute_t *copy)
+{
+    free(copy);
+}
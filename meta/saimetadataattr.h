@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadataattr.h
+ *
+ * @brief   This module defines SAI Metadata Attribute Value Helpers
+ */
+
+#ifndef __SAIMETADATAATTR_H_
+#define __SAIMETADATAATTR_H_
+
+/**
+ * @defgroup SAIMETADATAATTR SAI - Metadata Attribute Value Helpers Definitions
+ *
+ * Copy, compare, hash and free attributes using attribute metadata. Compare
+ * and hash functions are generated by parse.pl for each attribute value type,
+ * so only valid members of unions are compared (like ip4 part of IPv4
+ * address), and ACL field and action data are compared only when enabled.
+ *
+ * Copy allocates all lists of attribute value, so copy can be kept after
+ * caller frees original attribute. Attribute list can be also copied into
+ * single allocation, which holds all attributes and all their lists, and is
+ * released by single free.
+ *
+ * @{
+ */
+
+/**
+ * @brief Initial value of attribute hash
+ */
+#define SAI_METADATA_ATTR_HASH_INIT 0xCBF29CE484222325ULL
+
+/**
+ * @brief List inside attribute value
+ */
+typedef struct _sai_metadata_attr_value_list_t
+{
+    /**
+     * @brief Offset of list count in attribute value.
+     */
+    size_t count_offset;
+
+    /**
+     * @brief Offset of list pointer in attribute value.
+     */
+    size_t list_offset;
+
+    /**
+     * @brief Size of single list element.
+     */
+    size_t element_size;
+
+} sai_metadata_attr_value_list_t;
+
+/**
+ * @brief Hash bytes using FNV-1a
+ *
+ * @param[in] hash Hash of previous data
+ * @param[in] data Data to hash
+ * @param[in] size Data size in bytes
+ *
+ * @return Hash including data
+ */
+extern uint64_t sai_metadata_attr_hash_bytes(
+        _In_ uint64_t hash,
+        _In_ const void *data,
+        _In_ size_t size);
+
+/**
+ * @brief Hash string using FNV-1a
+ *
+ * @param[in] hash Hash of previous data
+ * @param[in] str String to hash
+ * @param[in] max_length Size of string buffer
+ *
+ * @return Hash including string
+ */
+extern uint64_t sai_metadata_attr_hash_string(
+        _In_ uint64_t hash,
+        _In_ const char *str,
+        _In_ size_t max_length);
+
+/**
+ * @brief Get lists of attribute value which hold valid data
+ *
+ * Same as sai_metadata_attr_value_lists, but returns no lists for disabled
+ * ACL field or action, whose data is not specified.
+ *
+ * @param[in] md Attribute metadata
+ * @param[in] value Attribute value
+ * @param[out] lists Lists of attribute value
+ *
+ * @return Number of lists
+ */
+extern uint32_t sai_metadata_attr_get_value_lists(
+        _In_ const sai_attr_metadata_t *md,
+        _In_ const sai_attribute_value_t *value,
+        _Out_ sai_metadata_attr_value_list_t *lists);
+
+/**
+ * @brief Deep copy attribute
+ *
+ * All lists of attribute value are allocated, copy must be released by
+ * sai_metadata_attr_free.
+ *
+ * @param[in] object_type Object type of attribute
+ * @param[in] src Source attribute
+ * @param[inout] dst Destination attribute
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_attr_copy(
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *src,
+        _Inout_ sai_attribute_t *dst);
+
+/**
+ * @brief Free lists of attribute created by sai_metadata_attr_copy
+ *
+ * @param[in] object_type Object type of attribute
+ * @param[inout] attr Attribute
+ */
+extern void sai_metadata_attr_free(
+        _In_ sai_object_type_t object_type,
+        _Inout_ sai_attribute_t *attr);
+
+/**
+ * @brief Compare attributes
+ *
+ * @param[in] object_type Object type of attributes
+ * @param[in] first First attribute
+ * @param[in] second Second attribute
+ *
+ * @return True if attributes have the same id and value
+ */
+extern bool sai_metadata_attr_equal(
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *first,
+        _In_ const sai_attribute_t *second);
+
+/**
+ * @brief Hash attribute
+ *
+ * Equal attributes have equal hash.
+ *
+ * @param[in] object_type Object type of attribute
+ * @param[in] attr Attribute
+ *
+ * @return Hash of attribute id and value
+ */
+extern uint64_t sai_metadata_attr_hash(
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *attr);
+
+/**
+ * @brief Deep copy attribute list into single allocation
+ *
+ * Attributes are followed by their lists in the same memory block, copy must
+ * be released by sai_metadata_attr_list_free.
+ *
+ * @param[in] object_type Object type of attributes
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Attribute list
+ * @param[inout] copy Copied attribute list, NULL if attr_count is zero
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_attr_list_copy(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list,
+        _Inout_ sai_attribute_t **copy);
+
+/**
+ * @brief Free attribute list created by sai_metadata_attr_list_copy
+ *
+ * @param[inout] copy Copied attribute list
+ */
+extern void sai_metadata_attr_list_free(
+        _Inout_ sai_attribute_t *copy);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATAATTR_H_ */
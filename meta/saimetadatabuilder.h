@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatabuilder.h
+ *
+ * @brief   This module defines SAI Metadata C++ Attribute Builder
+ */
+
+#ifndef __SAIMETADATABUILDER_H_
+#define __SAIMETADATABUILDER_H_
+
+/**
+ * @defgroup SAIMETADATABUILDER SAI - Metadata C++ Attribute Builder Definitions
+ *
+ * Header only C++11 layer for building attribute lists. Attribute value type
+ * and flags of each attribute are generated by parse.pl into
+ * saimetadatabuildertraits.h as compile time constants, so value passed to
+ * set() is checked against attribute type by compiler, enum attributes
+ * accept only values of their enum type, and setting read only attribute or
+ * attribute of other object type does not compile.
+ *
+ * Attributes are stored in fixed capacity array inside builder, so building
+ * attribute list needs no heap allocation. Builder does not check for
+ * duplicate attributes.
+ *
+ * Example:
+ *
+ *     sai_metadata_route_entry_attr_builder<> attrs;
+ *
+ *     attrs.set<SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION>(SAI_PACKET_ACTION_FORWARD)
+ *          .set<SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID>(nhid);
+ *
+ *     route_api->create_route_entry(&route, attrs.count(), attrs.data());
+ *
+ * @{
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+extern "C" {
+#include "saimetadata.h"
+}
+
+/**
+ * @brief Default number of attributes which builder can hold
+ */
+#define SAI_METADATA_ATTR_BUILDER_DEFAULT_CAPACITY 16
+
+/**
+ * @brief C++ type and union member of attribute value type
+ *
+ * Specialized for each attribute value type in saimetadatabuildertraits.h.
+ */
+template <sai_attr_value_type_t VT>
+struct sai_metadata_value_traits;
+
+/**
+ * @brief Value type and flags of attribute
+ *
+ * Specialized for each attribute in saimetadatabuildertraits.h.
+ */
+template <sai_object_type_t OT, sai_attr_id_t ID>
+struct sai_metadata_attr_traits;
+
+/**
+ * @brief Builds attribute list of single object type
+ */
+template <sai_object_type_t OT, size_t N>
+class sai_metadata_attr_builder
+{
+    public:
+
+        sai_metadata_attr_builder():
+            m_count(0),
+            m_overflow(false)
+        {
+        }
+
+        /**
+         * @brief Append attribute
+         *
+         * Exceeding capacity is programming error and asserts, in builds
+         * with NDEBUG attribute is dropped and builder is marked as
+         * overflown.
+         */
+        template <sai_attr_id_t ID>
+        sai_metadata_attr_builder& set(
+                _In_ const typename sai_metadata_attr_traits<OT, ID>::type &value)
+        {
+            typedef sai_metadata_attr_traits<OT, ID> traits;
+
+            static_assert((traits::flags & SAI_ATTR_FLAGS_READ_ONLY) == 0, "read only attribute can't be set");
+
+            assert(m_count < N && "attribute builder capacity exceeded");
+
+            if (m_count == N)
+            {
+                m_overflow = true;
+
+                return *this;
+            }
+
+            sai_attribute_t &attr = m_attrs[m_count++];
+
+            attr.id = ID;
+
+            sai_metadata_value_traits<traits::value_type>::set(attr.value, value);
+
+            return *this;
+        }
+
+        /**
+         * @brief Number of attributes
+         */
+        uint32_t count() const
+        {
+            return m_count;
+        }
+
+        /**
+         * @brief Attribute list
+         */
+        const sai_attribute_t* data() const
+        {
+            return m_attrs;
+        }
+
+        /**
+         * @brief True if more than N attributes were set, NDEBUG builds only
+         */
+        bool overflow() const
+        {
+            return m_overflow;
+        }
+
+        /**
+         * @brief Remove all attributes
+         */
+        void clear()
+        {
+            m_count = 0;
+            m_overflow = false;
+        }
+
+    private:
+
+        sai_attribute_t m_attrs[N];
+
+        uint32_t m_count;
+
+        bool m_overflow;
+};
+
+/**
+ * @brief Make single attribute to be passed to set API
+ */
+template <sai_object_type_t OT, sai_attr_id_t ID>
+sai_attribute_t sai_metadata_make_attr(
+        _In_ const typename sai_metadata_attr_traits<OT, ID>::type &value)
+{
+    typedef sai_metadata_attr_traits<OT, ID> traits;
+
+    static_assert((traits::flags & SAI_ATTR_FLAGS_CREATE_AND_SET) != 0, "only create and set attribute can be set");
+
+    sai_attribute_t attr;
+
+    attr.id = ID;
+
+    sai_metadata_value_traits<traits::value_type>::set(attr.value, value);
+
+    return attr;
+}
+
+#include "saimetadatabuildertraits.h"
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATABUILDER_H_ */
@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatabuildertest.cpp
+ *
+ * @brief   This module defines SAI Metadata C++ Attribute Builder Test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "saimetadatabuilder.h"
+
+#define CHECK(cond)                                                         \
+    if (!(cond)) {                                                          \
+        fprintf(stderr, "FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+        exit(1);                                                            \
+    }
+
+static_assert(sai_metadata_attr_traits<SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID>::value_type == SAI_ATTR_VALUE_TYPE_OBJECT_ID,
+        "next hop id must be object id");
+
+static_assert((sai_metadata_attr_traits<SAI_OBJECT_TYPE_NEXT_HOP, SAI_NEXT_HOP_ATTR_TYPE>::flags & SAI_ATTR_FLAGS_MANDATORY_ON_CREATE) != 0,
+        "next hop type must be mandatory on create");
+
+static void test_route_entry()
+{
+    sai_metadata_route_entry_attr_builder<> attrs;
+
+    attrs.set<SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION>(SAI_PACKET_ACTION_FORWARD)
+         .set<SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID>(0x1234);
+
+    CHECK(attrs.count() == 2);
+    CHECK(!attrs.overflow());
+
+    CHECK(attrs.data()[0].id == SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION);
+    CHECK(attrs.data()[0].value.s32 == SAI_PACKET_ACTION_FORWARD);
+
+    CHECK(attrs.data()[1].id == SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID);
+    CHECK(attrs.data()[1].value.oid == 0x1234);
+
+    sai_attribute_t attr = sai_metadata_make_attr<SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID>(0x5678);
+
+    CHECK(attr.id == SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID);
+    CHECK(attr.value.oid == 0x5678);
+}
+
+static void test_value_types()
+{
+    sai_metadata_next_hop_attr_builder<> nh;
+
+    sai_ip_address_t ip;
+
+    memset(&ip, 0, sizeof(ip));
+
+    ip.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    ip.addr.ip4 = 0x0100000a;
+
+    nh.set<SAI_NEXT_HOP_ATTR_TYPE>(SAI_NEXT_HOP_TYPE_IP)
+      .set<SAI_NEXT_HOP_ATTR_IP>(ip);
+
+    CHECK(nh.count() == 2);
+    CHECK(nh.data()[1].value.ipaddr.addr.ip4 == 0x0100000a);
+
+    sai_metadata_router_interface_attr_builder<> rif;
+
+    sai_mac_t mac = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+
+    rif.set<SAI_ROUTER_INTERFACE_ATTR_SRC_MAC_ADDRESS>(mac)
+       .set<SAI_ROUTER_INTERFACE_ATTR_ADMIN_V4_STATE>(true);
+
+    CHECK(memcmp(rif.data()[0].value.mac, mac, sizeof(mac)) == 0);
+    CHECK(rif.data()[1].value.booldata == true);
+
+    sai_metadata_hostif_attr_builder<> hostif;
+
+    hostif.set<SAI_HOSTIF_ATTR_NAME>("Ethernet0");
+
+    CHECK(strcmp(hostif.data()[0].value.chardata, "Ethernet0") == 0);
+}
+
+static void test_acl()
+{
+    sai_metadata_acl_entry_attr_builder<> attrs;
+
+    sai_acl_field_data_t field;
+
+    memset(&field, 0, sizeof(field));
+
+    field.enable = true;
+    field.data.ip4 = 0x0100000a;
+    field.mask.ip4 = 0xffffffff;
+
+    sai_acl_action_data_t action;
+
+    memset(&action, 0, sizeof(action));
+
+    action.enable = true;
+    action.parameter.s32 = SAI_PACKET_ACTION_DROP;
+
+    /* ACL enum subtypes are set through their data container */
+
+    attrs.set<SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP>(field)
+         .set<SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION>(action);
+
+    CHECK(attrs.count() == 2);
+
+    CHECK(attrs.data()[0].value.aclfield.enable);
+    CHECK(attrs.data()[0].value.aclfield.data.ip4 == 0x0100000a);
+    CHECK(attrs.data()[0].value.aclfield.mask.ip4 == 0xffffffff);
+
+    CHECK(attrs.data()[1].value.aclaction.enable);
+    CHECK(attrs.data()[1].value.aclaction.parameter.s32 == SAI_PACKET_ACTION_DROP);
+}
+
+static void test_capacity()
+{
+    sai_metadata_route_entry_attr_builder<1> attrs;
+
+    attrs.set<SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION>(SAI_PACKET_ACTION_DROP);
+
+    /* setting next attribute would assert */
+
+    CHECK(attrs.count() == 1);
+    CHECK(!attrs.overflow());
+
+    attrs.clear();
+
+    CHECK(attrs.count() == 0);
+
+    attrs.set<SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID>(0x1234);
+
+    CHECK(attrs.count() == 1);
+    CHECK(attrs.data()[0].value.oid == 0x1234);
+
+    /* builder holds attributes inline */
+
+    CHECK(sizeof(attrs) >= sizeof(sai_attribute_t));
+}
+
+int main()
+{
+    test_route_entry();
+
+    test_value_types();
+
+    test_acl();
+
+    test_capacity();
+
+    return 0;
+}
@@ -0,0 +1,763 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatacache.c
+ *
+ * @brief   This module defines SAI Metadata Attribute Cache
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+#define SAI_METADATA_CACHE_NONE 0xFFFFFFFF
+
+#define SAI_METADATA_CACHE_INITIAL_SIZE 64
+
+#define SAI_METADATA_CACHE_INITIAL_ATTRS 4
+
+/*
+ * Objects are kept in dense array and open addressing hash table with 8 byte
+ * slots maps object key to object index + 1, zero marks empty slot. Cached
+ * attributes of single object are kept in small array, since objects have
+ * only few create and set attributes.
+ */
+
+typedef struct _sai_metadata_cache_slot_t
+{
+    uint32_t hash;
+
+    uint32_t index;
+
+} sai_metadata_cache_slot_t;
+
+typedef struct _sai_metadata_cache_object_t
+{
+    sai_object_meta_key_t meta_key;
+
+    uint32_t hash;
+
+    uint32_t attr_count;
+
+    uint32_t attr_size;
+
+    /* deep copies created by sai_metadata_attr_copy */
+
+    sai_attribute_t *attrs;
+
+} sai_metadata_cache_object_t;
+
+typedef struct _sai_metadata_cache_t
+{
+    pthread_mutex_t lock;
+
+    bool enabled;
+
+    bool serve_get;
+
+    sai_metadata_cache_slot_t *slots;
+
+    uint32_t mask;
+
+    sai_metadata_cache_object_t *objects;
+
+    uint32_t objects_count;
+
+    uint32_t objects_size;
+
+    sai_metadata_cache_stats_t stats;
+
+} sai_metadata_cache_t;
+
+static sai_metadata_cache_t sai_metadata_cache = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+/*
+ * Unused part of ip address union in object key can contain garbage, so ip
+ * address and ip prefix key members are hashed and compared by attribute
+ * value helpers, other key members are hashed and compared as memory.
+ */
+
+static bool sai_metadata_cache_key_member_value(
+        _In_ const sai_struct_member_info_t *m,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _Out_ sai_attribute_value_t *value)
+{
+    if (m->membervaluetype != SAI_ATTR_VALUE_TYPE_IP_ADDRESS &&
+            m->membervaluetype != SAI_ATTR_VALUE_TYPE_IP_PREFIX)
+    {
+        return false;
+    }
+
+    memset(value, 0, sizeof(sai_attribute_value_t));
+
+    memcpy(value, (const uint8_t*)&meta_key->objectkey.key + m->offset, m->size);
+
+    return true;
+}
+
+static uint32_t sai_metadata_cache_hash_key(
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *meta_key)
+{
+    uint64_t hash = SAI_METADATA_ATTR_HASH_INIT ^ (uint64_t)meta_key->objecttype;
+
+    if (info->isobjectid)
+    {
+        hash = sai_metadata_attr_hash_bytes(hash, &meta_key->objectkey.key.object_id, sizeof(sai_object_id_t));
+    }
+
+    size_t mi = 0;
+
+    for (; !info->isobjectid && mi < info->structmemberscount; mi++)
+    {
+        const sai_struct_member_info_t *m = info->structmembers[mi];
+
+        sai_attribute_value_t value;
+
+        if (sai_metadata_cache_key_member_value(m, meta_key, &value))
+        {
+            hash = sai_metadata_attr_value_hash(m->membervaluetype, hash, &value);
+        }
+        else
+        {
+            hash = sai_metadata_attr_hash_bytes(hash, (const uint8_t*)&meta_key->objectkey.key + m->offset, m->size);
+        }
+    }
+
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static bool sai_metadata_cache_key_equal(
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *a,
+        _In_ const sai_object_meta_key_t *b)
+{
+    if (a->objecttype != b->objecttype)
+    {
+        return false;
+    }
+
+    if (info->isobjectid)
+    {
+        return a->objectkey.key.object_id == b->objectkey.key.object_id;
+    }
+
+    size_t mi = 0;
+
+    for (; mi < info->structmemberscount; mi++)
+    {
+        const sai_struct_member_info_t *m = info->structmembers[mi];
+
+        sai_attribute_value_t va;
+        sai_attribute_value_t vb;
+
+        if (sai_metadata_cache_key_member_value(m, a, &va))
+        {
+            sai_metadata_cache_key_member_value(m, b, &vb);
+
+            if (!sai_metadata_attr_value_equal(m->membervaluetype, &va, &vb))
+            {
+                return false;
+            }
+        }
+        else if (memcmp((const uint8_t*)&a->objectkey.key + m->offset, (const uint8_t*)&b->objectkey.key + m->offset, m->size) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Returns slot position of object, or SAI_METADATA_CACHE_NONE.
+ */
+static uint32_t sai_metadata_cache_find_slot(
+        _In_ const sai_metadata_cache_t *cache,
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ uint32_t hash)
+{
+    if (cache->slots == NULL)
+    {
+        return SAI_METADATA_CACHE_NONE;
+    }
+
+    uint32_t pos = hash & cache->mask;
+
+    for (; cache->slots[pos].index != 0; pos = (pos + 1) & cache->mask)
+    {
+        if (cache->slots[pos].hash == hash &&
+                sai_metadata_cache_key_equal(info, &cache->objects[cache->slots[pos].index - 1].meta_key, meta_key))
+        {
+            return pos;
+        }
+    }
+
+    return SAI_METADATA_CACHE_NONE;
+}
+
+static void sai_metadata_cache_map_insert(
+        _Inout_ sai_metadata_cache_slot_t *slots,
+        _In_ uint32_t mask,
+        _In_ uint32_t hash,
+        _In_ uint32_t index)
+{
+    uint32_t pos = hash & mask;
+
+    while (slots[pos].index != 0)
+    {
+        pos = (pos + 1) & mask;
+    }
+
+    slots[pos].hash = hash;
+    slots[pos].index = index + 1;
+}
+
+/*
+ * Removes slot using backward shift, so table never contains tombstones.
+ */
+static void sai_metadata_cache_map_erase(
+        _Inout_ sai_metadata_cache_t *cache,
+        _In_ uint32_t pos)
+{
+    uint32_t mask = cache->mask;
+
+    uint32_t next = (pos + 1) & mask;
+
+    for (; cache->slots[next].index != 0; next = (next + 1) & mask)
+    {
+        uint32_t home = cache->slots[next].hash & mask;
+
+        /* slot can move back only if its home position is not in (pos, next] */
+
+        if (((next - home) & mask) >= ((next - pos) & mask))
+        {
+            cache->slots[pos] = cache->slots[next];
+            pos = next;
+        }
+    }
+
+    cache->slots[pos].hash = 0;
+    cache->slots[pos].index = 0;
+}
+
+static bool sai_metadata_cache_reserve(
+        _Inout_ sai_metadata_cache_t *cache)
+{
+    if (cache->objects_count == cache->objects_size)
+    {
+        uint32_t size = (cache->objects_size == 0) ? SAI_METADATA_CACHE_INITIAL_SIZE : 2 * cache->objects_size;
+
+        sai_metadata_cache_object_t *objects = realloc(cache->objects, (size_t)size * sizeof(sai_metadata_cache_object_t));
+
+        if (objects == NULL)
+        {
+            return false;
+        }
+
+        cache->objects = objects;
+        cache->objects_size = size;
+    }
+
+    /* hash table is kept at most half full */
+
+    if (cache->slots != NULL && 2 * ((uint64_t)cache->objects_count + 1) <= (uint64_t)cache->mask + 1)
+    {
+        return true;
+    }
+
+    uint32_t capacity = (cache->slots == NULL) ? 2 * SAI_METADATA_CACHE_INITIAL_SIZE : 2 * (cache->mask + 1);
+
+    sai_metadata_cache_slot_t *slots = calloc(capacity, sizeof(sai_metadata_cache_slot_t));
+
+    if (slots == NULL)
+    {
+        return false;
+    }
+
+    uint32_t idx = 0;
+
+    for (; idx < cache->objects_count; idx++)
+    {
+        sai_metadata_cache_map_insert(slots, capacity - 1, cache->objects[idx].hash, idx);
+    }
+
+    free(cache->slots);
+
+    cache->slots = slots;
+    cache->mask = capacity - 1;
+
+    return true;
+}
+
+static void sai_metadata_cache_release_object(
+        _Inout_ sai_metadata_cache_t *cache,
+        _Inout_ sai_metadata_cache_object_t *obj)
+{
+    uint32_t idx = 0;
+
+    for (; idx < obj->attr_count; idx++)
+    {
+        sai_metadata_attr_free(obj->meta_key.objecttype, &obj->attrs[idx]);
+    }
+
+    cache->stats.attributes -= obj->attr_count;
+
+    free(obj->attrs);
+}
+
+static void sai_metadata_cache_erase_object(
+        _Inout_ sai_metadata_cache_t *cache,
+        _In_ uint32_t pos)
+{
+    uint32_t index = cache->slots[pos].index - 1;
+
+    sai_metadata_cache_release_object(cache, &cache->objects[index]);
+
+    sai_metadata_cache_map_erase(cache, pos);
+
+    uint32_t last = --cache->objects_count;
+
+    if (index == last)
+    {
+        return;
+    }
+
+    /* move last object into the hole and fix its slot */
+
+    cache->objects[index] = cache->objects[last];
+
+    pos = cache->objects[index].hash & cache->mask;
+
+    while (cache->slots[pos].index != last + 1)
+    {
+        pos = (pos + 1) & cache->mask;
+    }
+
+    cache->slots[pos].index = index + 1;
+}
+
+static bool sai_metadata_cache_is_cached_attr(
+        _In_ const sai_attr_metadata_t *md)
+{
+    if (md == NULL || !md->iscreateandset)
+    {
+        return false;
+    }
+
+    /*
+     * Set of switch attribute can trigger action each time it is called
+     * (switch shell, warm restart, pre shutdown, firmware download execute),
+     * and notification pointers are also registered in application, so
+     * repeated set of these must always reach vendor.
+     */
+
+    if (md->objecttype == SAI_OBJECT_TYPE_SWITCH || md->attrvaluetype == SAI_ATTR_VALUE_TYPE_POINTER)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static sai_attribute_t* sai_metadata_cache_find_attr(
+        _In_ const sai_metadata_cache_object_t *obj,
+        _In_ sai_attr_id_t attr_id)
+{
+    uint32_t idx = 0;
+
+    for (; idx < obj->attr_count; idx++)
+    {
+        if (obj->attrs[idx].id == attr_id)
+        {
+            return &obj->attrs[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static void sai_metadata_cache_forget_attr(
+        _Inout_ sai_metadata_cache_t *cache,
+        _In_ uint32_t pos,
+        _In_ sai_attr_id_t attr_id)
+{
+    sai_metadata_cache_object_t *obj = &cache->objects[cache->slots[pos].index - 1];
+
+    sai_attribute_t *attr = sai_metadata_cache_find_attr(obj, attr_id);
+
+    if (attr == NULL)
+    {
+        return;
+    }
+
+    sai_metadata_attr_free(obj->meta_key.objecttype, attr);
+
+    *attr = obj->attrs[--obj->attr_count];
+
+    cache->stats.attributes--;
+
+    if (obj->attr_count == 0)
+    {
+        sai_metadata_cache_erase_object(cache, pos);
+    }
+}
+
+static void sai_metadata_cache_store_attr(
+        _Inout_ sai_metadata_cache_t *cache,
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ uint32_t hash,
+        _In_ const sai_attribute_t *attr)
+{
+    uint32_t pos = sai_metadata_cache_find_slot(cache, info, meta_key, hash);
+
+    if (pos == SAI_METADATA_CACHE_NONE)
+    {
+        if (!sai_metadata_cache_reserve(cache))
+        {
+            SAI_META_LOG_WARN("failed to allocate memory for cached object");
+            return;
+        }
+
+        sai_metadata_cache_object_t *obj = &cache->objects[cache->objects_count];
+
+        memset(obj, 0, sizeof(sai_metadata_cache_object_t));
+
+        obj->meta_key = *meta_key;
+        obj->hash = hash;
+
+        sai_metadata_cache_map_insert(cache->slots, cache->mask, hash, cache->objects_count++);
+
+        pos = sai_metadata_cache_find_slot(cache, info, meta_key, hash);
+    }
+
+    sai_metadata_cache_object_t *obj = &cache->objects[cache->slots[pos].index - 1];
+
+    sai_attribute_t *cached = sai_metadata_cache_find_attr(obj, attr->id);
+
+    if (cached != NULL)
+    {
+        sai_metadata_attr_free(meta_key->objecttype, cached);
+    }
+    else
+    {
+        if (obj->attr_count == obj->attr_size)
+        {
+            uint32_t size = (obj->attr_size == 0) ? SAI_METADATA_CACHE_INITIAL_ATTRS : 2 * obj->attr_size;
+
+            sai_attribute_t *attrs = realloc(obj->attrs, (size_t)size * sizeof(sai_attribute_t));
+
+            if (attrs == NULL)
+            {
+                SAI_META_LOG_WARN("failed to allocate memory for cached attribute");
+
+                if (obj->attr_count == 0)
+                {
+                    sai_metadata_cache_erase_object(cache, pos);
+                }
+
+                return;
+            }
+
+            obj->attrs = attrs;
+            obj->attr_size = size;
+        }
+
+        cached = &obj->attrs[obj->attr_count++];
+
+        cache->stats.attributes++;
+    }
+
+    if (sai_metadata_attr_copy(meta_key->objecttype, attr, cached) != SAI_STATUS_SUCCESS)
+    {
+        /* failed copy has no lists to free, just drop the slot */
+
+        *cached = obj->attrs[--obj->attr_count];
+
+        cache->stats.attributes--;
+
+        if (obj->attr_count == 0)
+        {
+            sai_metadata_cache_erase_object(cache, pos);
+        }
+    }
+}
+
+static void sai_metadata_cache_release(
+        _Inout_ sai_metadata_cache_t *cache)
+{
+    uint32_t idx = 0;
+
+    for (; idx < cache->objects_count; idx++)
+    {
+        sai_metadata_cache_release_object(cache, &cache->objects[idx]);
+    }
+
+    free(cache->objects);
+    free(cache->slots);
+
+    cache->objects = NULL;
+    cache->slots = NULL;
+    cache->mask = 0;
+    cache->objects_count = 0;
+    cache->objects_size = 0;
+
+    memset(&cache->stats, 0, sizeof(cache->stats));
+}
+
+sai_status_t sai_metadata_cache_enable(
+        _In_ bool serve_get)
+{
+    pthread_mutex_lock(&sai_metadata_cache.lock);
+
+    if (!sai_metadata_cache.enabled)
+    {
+        /* statistics start from zero */
+
+        sai_metadata_cache_release(&sai_metadata_cache);
+    }
+
+    sai_metadata_cache.enabled = true;
+    sai_metadata_cache.serve_get = serve_get;
+
+    pthread_mutex_unlock(&sai_metadata_cache.lock);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_cache_disable(void)
+{
+    pthread_mutex_lock(&sai_metadata_cache.lock);
+
+    sai_metadata_cache_release(&sai_metadata_cache);
+
+    sai_metadata_cache.enabled = false;
+    sai_metadata_cache.serve_get = false;
+
+    pthread_mutex_unlock(&sai_metadata_cache.lock);
+}
+
+bool sai_metadata_cache_set_lookup(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ const sai_attribute_t *attr)
+{
+    sai_metadata_cache_t *cache = &sai_metadata_cache;
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL || attr == NULL)
+    {
+        return false;
+    }
+
+    if (!sai_metadata_cache_is_cached_attr(sai_metadata_get_attr_metadata(meta_key->objecttype, attr->id)))
+    {
+        return false;
+    }
+
+    bool hit = false;
+
+    pthread_mutex_lock(&cache->lock);
+
+    if (cache->enabled)
+    {
+        uint32_t pos = sai_metadata_cache_find_slot(cache, info, meta_key, sai_metadata_cache_hash_key(info, meta_key));
+
+        if (pos != SAI_METADATA_CACHE_NONE)
+        {
+            const sai_attribute_t *cached = sai_metadata_cache_find_attr(&cache->objects[cache->slots[pos].index - 1], attr->id);
+
+            hit = (cached != NULL && sai_metadata_attr_equal(meta_key->objecttype, cached, attr));
+        }
+
+        if (hit)
+        {
+            cache->stats.set_hits++;
+        }
+        else
+        {
+            cache->stats.set_misses++;
+        }
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    return hit;
+}
+
+bool sai_metadata_cache_get_lookup(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+{
+    sai_metadata_cache_t *cache = &sai_metadata_cache;
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL || attr_count == 0 || attr_list == NULL)
+    {
+        return false;
+    }
+
+    bool hit = false;
+
+    pthread_mutex_lock(&cache->lock);
+
+    if (cache->enabled && cache->serve_get)
+    {
+        uint32_t pos = sai_metadata_cache_find_slot(cache, info, meta_key, sai_metadata_cache_hash_key(info, meta_key));
+
+        const sai_metadata_cache_object_t *obj = (pos == SAI_METADATA_CACHE_NONE) ? NULL : &cache->objects[cache->slots[pos].index - 1];
+
+        uint32_t idx = 0;
+
+        /* lists are never served, since caller buffer may be too small */
+
+        for (hit = (obj != NULL); hit && idx < attr_count; idx++)
+        {
+            const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(meta_key->objecttype, attr_list[idx].id);
+
+            sai_metadata_attr_value_list_t lists[SAI_METADATA_ATTR_VALUE_LISTS_MAX];
+
+            hit = (md != NULL && sai_metadata_cache_find_attr(obj, attr_list[idx].id) != NULL &&
+                    sai_metadata_attr_value_lists(md->attrvaluetype, lists) == 0);
+        }
+
+        for (idx = 0; hit && idx < attr_count; idx++)
+        {
+            attr_list[idx].value = sai_metadata_cache_find_attr(obj, attr_list[idx].id)->value;
+        }
+
+        if (hit)
+        {
+            cache->stats.get_hits++;
+        }
+        else
+        {
+            cache->stats.get_misses++;
+        }
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    return hit;
+}
+
+void sai_metadata_cache_update(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ sai_status_t status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    sai_metadata_cache_t *cache = &sai_metadata_cache;
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL || attr_list == NULL)
+    {
+        return;
+    }
+
+    uint32_t hash = sai_metadata_cache_hash_key(info, meta_key);
+
+    pthread_mutex_lock(&cache->lock);
+
+    uint32_t idx = 0;
+
+    for (; cache->enabled && idx < attr_count; idx++)
+    {
+        const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(meta_key->objecttype, attr_list[idx].id);
+
+        if (!sai_metadata_cache_is_cached_attr(md))
+        {
+            continue;
+        }
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            sai_metadata_cache_store_attr(cache, info, meta_key, hash, &attr_list[idx]);
+            continue;
+        }
+
+        /* value programmed by failed call is not known */
+
+        uint32_t pos = sai_metadata_cache_find_slot(cache, info, meta_key, hash);
+
+        if (pos != SAI_METADATA_CACHE_NONE)
+        {
+            sai_metadata_cache_forget_attr(cache, pos, attr_list[idx].id);
+        }
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void sai_metadata_cache_remove(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ sai_status_t status)
+{
+    sai_metadata_cache_t *cache = &sai_metadata_cache;
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL || status != SAI_STATUS_SUCCESS)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+
+    if (cache->enabled)
+    {
+        uint32_t pos = sai_metadata_cache_find_slot(cache, info, meta_key, sai_metadata_cache_hash_key(info, meta_key));
+
+        if (pos != SAI_METADATA_CACHE_NONE)
+        {
+            sai_metadata_cache_erase_object(cache, pos);
+        }
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+sai_status_t sai_metadata_cache_get_stats(
+        _Out_ sai_metadata_cache_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        SAI_META_LOG_ERROR("stats parameter is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&sai_metadata_cache.lock);
+
+    *stats = sai_metadata_cache.stats;
+
+    stats->objects = sai_metadata_cache.objects_count;
+
+    pthread_mutex_unlock(&sai_metadata_cache.lock);
+
+    return SAI_STATUS_SUCCESS;
+}
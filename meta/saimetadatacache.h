@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatacache.h
+ *
+ * @brief   This module defines SAI Metadata Attribute Cache
+ */
+
+#ifndef __SAIMETADATACACHE_H_
+#define __SAIMETADATACACHE_H_
+
+/**
+ * @defgroup SAIMETADATACACHE SAI - Metadata Attribute Cache Definitions
+ *
+ * Auto generated sai_metadata_cache_apis_wrap() and
+ * sai_metadata_cache_api_wrap() replace API method tables obtained from
+ * sai_api_query() with tables of wrappers, which keep last programmed value
+ * of each create and set attribute of each object.
+ *
+ * Set of attribute to value which is already programmed returns success
+ * without calling vendor function. Values are compared using attribute
+ * metadata, so for example unused part of IPv4 address or data of disabled
+ * ACL field don't make values different. When enabled, get of attributes
+ * which are all cached and have no lists is also served from cache.
+ *
+ * Cache learns values from successful create, set and get calls (including
+ * bulk create and set), forgets value when set fails and forgets object when
+ * it is removed. Read only and create only attributes are never cached. Bulk
+ * set is always passed to vendor. Switch attributes and pointer attributes
+ * (notifications) are never cached either, since their set may trigger action
+ * (like switch shell or warm restart) and must reach vendor each time.
+ *
+ * Cache must see all calls which change attributes, objects changed by other
+ * means (like warm boot) require cache to be disabled and enabled again.
+ *
+ * Cache is protected by single mutex, so wrappers can be called from
+ * multiple threads.
+ *
+ * @{
+ */
+
+/**
+ * @brief Attribute cache statistics
+ */
+typedef struct _sai_metadata_cache_stats_t
+{
+    /**
+     * @brief Number of set calls not passed to vendor since value was already programmed.
+     */
+    uint64_t set_hits;
+
+    /**
+     * @brief Number of set calls passed to vendor.
+     */
+    uint64_t set_misses;
+
+    /**
+     * @brief Number of get calls served from cache.
+     */
+    uint64_t get_hits;
+
+    /**
+     * @brief Number of get calls passed to vendor.
+     */
+    uint64_t get_misses;
+
+    /**
+     * @brief Number of objects with cached attributes.
+     */
+    uint64_t objects;
+
+    /**
+     * @brief Number of cached attribute values.
+     */
+    uint64_t attributes;
+
+} sai_metadata_cache_stats_t;
+
+/**
+ * @brief Start caching attribute values
+ *
+ * @param[in] serve_get Serve get calls from cache
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_cache_enable(
+        _In_ bool serve_get);
+
+/**
+ * @brief Stop caching and release all cached values
+ */
+extern void sai_metadata_cache_disable(void);
+
+/**
+ * @brief Check whether set would program value which is already programmed
+ *
+ * Used by auto generated wrappers, counts set hit or miss.
+ *
+ * @param[in] meta_key Object type and key
+ * @param[in] attr Attribute to set
+ *
+ * @return True if cached value is equal to attribute value
+ */
+extern bool sai_metadata_cache_set_lookup(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ const sai_attribute_t *attr);
+
+/**
+ * @brief Serve get from cache
+ *
+ * Used by auto generated wrappers, attribute values are filled only if all
+ * attributes are cached and get serving is enabled.
+ *
+ * @param[in] meta_key Object type and key
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Attributes to get
+ *
+ * @return True if attribute values were filled from cache
+ */
+extern bool sai_metadata_cache_get_lookup(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list);
+
+/**
+ * @brief Update cache after create, set or get
+ *
+ * Used by auto generated wrappers, on success attribute values are cached,
+ * otherwise cached values of attributes are forgotten.
+ *
+ * @param[in] meta_key Object type and key
+ * @param[in] status Status returned by vendor function
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Attributes
+ */
+extern void sai_metadata_cache_update(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ sai_status_t status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
+/**
+ * @brief Update cache after remove
+ *
+ * Used by auto generated wrappers, on success all cached values of object
+ * are forgotten.
+ *
+ * @param[in] meta_key Object type and key
+ * @param[in] status Status returned by vendor function
+ */
+extern void sai_metadata_cache_remove(
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ sai_status_t status);
+
+/**
+ * @brief Get attribute cache statistics
+ *
+ * @param[out] stats Attribute cache statistics
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_cache_get_stats(
+        _Out_ sai_metadata_cache_stats_t *stats);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATACACHE_H_ */
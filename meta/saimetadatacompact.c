@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatacompact.c
+ *
+ * @brief   This module defines SAI Metadata Compact Layout
+ */
+
+#include <string.h>
+#include <sai.h>
+#include "saimetadatatypes.h"
+#include "saimetadatacompact.h"
+#include "saiserialize.h"
+
+/*
+ * This module depends only on generated saimetadatacompactdata.c, so tools
+ * which don't need full metadata can link only those two modules.
+ */
+
+const sai_attr_metadata_compact_t* sai_metadata_compact_get_attr_metadata(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_attr_id_t attr_id)
+{
+    if ((size_t)object_type >= sai_metadata_compact_attrs_by_object_type_count)
+    {
+        return NULL;
+    }
+
+    size_t first = sai_metadata_compact_attrs_by_object_type[object_type];
+    size_t last = sai_metadata_compact_attrs_by_object_type[object_type + 1];
+
+    /*
+     * Most object attributes are not flags, so we can try direct index to
+     * find attribute metadata first.
+     */
+
+    if (attr_id < last - first && sai_metadata_compact_attrs[first + attr_id].attrid == attr_id)
+    {
+        return &sai_metadata_compact_attrs[first + attr_id];
+    }
+
+    /* otherwise search one by one */
+
+    for (; first < last; first++)
+    {
+        if (sai_metadata_compact_attrs[first].attrid == attr_id)
+        {
+            return &sai_metadata_compact_attrs[first];
+        }
+    }
+
+    return NULL;
+}
+
+static const sai_attr_metadata_compact_t* sai_metadata_compact_get_attr_metadata_by_attr_id_name_length(
+        _In_ const char *attr_id_name,
+        _In_ size_t length)
+{
+    /* use binary search */
+
+    size_t first = 0;
+    size_t last = sai_metadata_compact_attrs_count;
+
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+
+        const sai_attr_metadata_compact_t *md = &sai_metadata_compact_attrs[sai_metadata_compact_attrs_sorted_by_id_name[middle]];
+
+        const char *name = sai_metadata_compact_strings + md->attridname;
+
+        int res = strncmp(attr_id_name, name, length);
+
+        if (res == 0 && name[length] != 0)
+        {
+            /* searched name is prefix of this one, so it is ordered before */
+
+            res = -1;
+        }
+
+        if (res > 0)
+        {
+            first = middle + 1;
+        }
+        else if (res < 0)
+        {
+            last = middle;
+        }
+        else
+        {
+            return md;
+        }
+    }
+
+    return NULL;
+}
+
+const sai_attr_metadata_compact_t* sai_metadata_compact_get_attr_metadata_by_attr_id_name(
+        _In_ const char *attr_id_name)
+{
+    if (attr_id_name == NULL)
+    {
+        return NULL;
+    }
+
+    return sai_metadata_compact_get_attr_metadata_by_attr_id_name_length(attr_id_name, strlen(attr_id_name));
+}
+
+const char* sai_metadata_compact_get_attr_id_name(
+        _In_ const sai_attr_metadata_compact_t *metadata)
+{
+    if (metadata == NULL)
+    {
+        return NULL;
+    }
+
+    return sai_metadata_compact_strings + metadata->attridname;
+}
+
+const char* sai_metadata_compact_get_brief(
+        _In_ const sai_attr_metadata_compact_t *metadata)
+{
+    if (metadata == NULL)
+    {
+        return NULL;
+    }
+
+    return sai_metadata_compact_strings + metadata->brief;
+}
+
+sai_object_type_t sai_metadata_compact_get_allowed_object_type(
+        _In_ const sai_attr_metadata_compact_t *metadata,
+        _In_ size_t index)
+{
+    if (metadata == NULL || index >= metadata->allowedobjecttypeslength)
+    {
+        return SAI_OBJECT_TYPE_NULL;
+    }
+
+    return (sai_object_type_t)sai_metadata_compact_object_types[metadata->allowedobjecttypes + index];
+}
+
+bool sai_metadata_compact_is_allowed_object_type(
+        _In_ const sai_attr_metadata_compact_t *metadata,
+        _In_ sai_object_type_t object_type)
+{
+    if (metadata == NULL)
+    {
+        return false;
+    }
+
+    size_t idx = 0;
+
+    for (; idx < metadata->allowedobjecttypeslength; idx++)
+    {
+        if (sai_metadata_compact_object_types[metadata->allowedobjecttypes + idx] == (uint16_t)object_type)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const sai_attribute_value_t* sai_metadata_compact_get_default_value(
+        _In_ const sai_attr_metadata_compact_t *metadata)
+{
+    if (metadata == NULL || metadata->defaultvalue == 0)
+    {
+        return NULL;
+    }
+
+    return &sai_metadata_compact_default_values[metadata->defaultvalue];
+}
+
+int sai_serialize_compact_attr_id(
+        _Out_ char *buffer,
+        _In_ const sai_attr_metadata_compact_t *meta)
+{
+    if (meta == NULL)
+    {
+        return SAI_SERIALIZE_ERROR;
+    }
+
+    const char *attr_id_name = sai_metadata_compact_strings + meta->attridname;
+
+    strcpy(buffer, attr_id_name);
+
+    return (int)strlen(attr_id_name);
+}
+
+int sai_deserialize_compact_attr_id(
+        _In_ const char *buffer,
+        _Out_ size_t *index)
+{
+    /*
+     * Attribute id name ends on first character which can't be part of it,
+     * like quote in serialized attribute.
+     */
+
+    size_t length = 0;
+
+    for (; buffer[length] != 0; length++)
+    {
+        char c = buffer[length];
+
+        if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_'))
+        {
+            break;
+        }
+    }
+
+    const sai_attr_metadata_compact_t *meta = sai_metadata_compact_get_attr_metadata_by_attr_id_name_length(buffer, length);
+
+    if (meta == NULL)
+    {
+        return SAI_SERIALIZE_ERROR;
+    }
+
+    *index = (size_t)(meta - sai_metadata_compact_attrs);
+
+    return (int)length;
+}
@@ -0,0 +1,416 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatacompact.h
+ *
+ * @brief   This module defines SAI Metadata Compact Layout
+ */
+
+#ifndef __SAIMETADATACOMPACT_H_
+#define __SAIMETADATACOMPACT_H_
+
+/**
+ * @defgroup SAIMETADATACOMPACT SAI - Metadata Compact Layout Definitions
+ *
+ * When parse.pl is executed with -c option, it additionally generates
+ * saimetadatacompactdata.c, which contains attribute metadata in compact
+ * layout. Compact layout contains no pointers, names and descriptions are
+ * offsets into single string pool, allowed object types and default values
+ * are indices into shared pools, and boolean properties are bit fields. All
+ * tables are read only data which require no relocations at load time.
+ *
+ * Compact layout contains attribute properties needed for serialization and
+ * basic validation. Conditions, valid only lists and capabilities are only
+ * present in full metadata. Attribute ids can be serialized using compact
+ * layout only, see sai_serialize_compact_attr_id() and
+ * sai_deserialize_compact_attr_id().
+ *
+ * @{
+ */
+
+/**
+ * @brief Index value used when compact attribute has no enum metadata
+ */
+#define SAI_METADATA_COMPACT_NO_INDEX 0xFFFF
+
+/**
+ * @brief Defines attribute metadata in compact layout.
+ */
+typedef struct _sai_attr_metadata_compact_t
+{
+    /**
+     * @brief Specifies valid attribute id for this object type.
+     */
+    uint32_t                attrid;
+
+    /**
+     * @brief Offset of attribute id name in string pool.
+     */
+    uint32_t                attridname;
+
+    /**
+     * @brief Offset of attribute brief description in string pool.
+     */
+    uint32_t                brief;
+
+    /**
+     * @brief Specifies default value attribute id.
+     */
+    uint32_t                defaultvalueattrid;
+
+    /**
+     * @brief Specifies valid SAI object type.
+     */
+    uint16_t                objecttype;
+
+    /**
+     * @brief Offset of allowed object types in object types pool.
+     */
+    uint16_t                allowedobjecttypes;
+
+    /**
+     * @brief Index of default value in default values pool, zero if attribute has no const default value.
+     */
+    uint16_t                defaultvalue;
+
+    /**
+     * @brief Index of enum metadata in sai_metadata_all_enums, SAI_METADATA_COMPACT_NO_INDEX if attribute is not enum.
+     */
+    uint16_t                enummetadata;
+
+    /**
+     * @brief Specifies default value object type.
+     */
+    uint16_t                defaultvalueobjecttype;
+
+    /**
+     * @brief Specifies attribute value type, sai_attr_value_type_t.
+     */
+    uint8_t                 attrvaluetype;
+
+    /**
+     * @brief Specifies flags for this attribute, sai_attr_flags_t.
+     */
+    uint8_t                 flags;
+
+    /**
+     * @brief Length of allowed object types.
+     */
+    uint8_t                 allowedobjecttypeslength;
+
+    /**
+     * @brief Specifies default value type, sai_default_value_type_t.
+     */
+    uint8_t                 defaultvaluetype;
+
+    /**
+     * @brief Notification type, -1 if attribute is not notification.
+     */
+    int8_t                  notificationtype;
+
+    /**
+     * @brief Pointer type, -1 if attribute is not pointer.
+     */
+    int8_t                  pointertype;
+
+    /**
+     * @brief Specifies whether attribute is allowed to have repeated values on list.
+     */
+    bool                    allowrepetitiononlist:1;
+
+    /**
+     * @brief Specifies whether attribute list can contain mixed object types.
+     */
+    bool                    allowmixedobjecttypes:1;
+
+    /**
+     * @brief Specifies whether attribute list can be empty.
+     */
+    bool                    allowemptylist:1;
+
+    /**
+     * @brief Specifies whether attribute object id can be NULL.
+     */
+    bool                    allownullobjectid:1;
+
+    /**
+     * @brief Determines whether attribute contains OIDs.
+     */
+    bool                    isoidattribute:1;
+
+    /**
+     * @brief Indicates whether default value needs to be saved.
+     */
+    bool                    storedefaultvalue:1;
+
+    /**
+     * @brief Indicates whether attribute is enum value.
+     */
+    bool                    isenum:1;
+
+    /**
+     * @brief Indicates whether attribute is enum list value.
+     */
+    bool                    isenumlist:1;
+
+    /**
+     * @brief Indicates whether attribute is conditional.
+     */
+    bool                    isconditional:1;
+
+    /**
+     * @brief Indicates whether attribute is valid only.
+     */
+    bool                    isvalidonly:1;
+
+    /**
+     * @brief When calling GET API result will be put in local db.
+     */
+    bool                    getsave:1;
+
+    /**
+     * @brief Determines whether value is vlan.
+     */
+    bool                    isvlan:1;
+
+    /**
+     * @brief Determines whether attribute is ACL field.
+     */
+    bool                    isaclfield:1;
+
+    /**
+     * @brief Determines whether attribute is ACL action.
+     */
+    bool                    isaclaction:1;
+
+    /**
+     * @brief Determines whether attribute is ACL mask.
+     */
+    bool                    isaclmask:1;
+
+    /**
+     * @brief Determines whether attribute is mandatory on create.
+     */
+    bool                    ismandatoryoncreate:1;
+
+    /**
+     * @brief Determines whether attribute is create only.
+     */
+    bool                    iscreateonly:1;
+
+    /**
+     * @brief Determines whether attribute is create and set.
+     */
+    bool                    iscreateandset:1;
+
+    /**
+     * @brief Determines whether attribute is read only.
+     */
+    bool                    isreadonly:1;
+
+    /**
+     * @brief Determines whether attribute is key.
+     */
+    bool                    iskey:1;
+
+    /**
+     * @brief Determines whether attribute value is primitive.
+     */
+    bool                    isprimitive:1;
+
+    /**
+     * @brief Indicates whether attribute is callback.
+     */
+    bool                    iscallback:1;
+
+    /**
+     * @brief Indicates whether attribute is extension attribute.
+     */
+    bool                    isextensionattr:1;
+
+    /**
+     * @brief Indicates whether attribute is resource type.
+     */
+    bool                    isresourcetype:1;
+
+    /**
+     * @brief Indicates whether attribute is deprecated.
+     */
+    bool                    isdeprecated:1;
+
+    /**
+     * @brief Indicates whether attribute condition is relaxed.
+     */
+    bool                    isconditionrelaxed:1;
+
+} sai_attr_metadata_compact_t;
+
+/**
+ * @brief String pool of attribute id names and brief descriptions
+ */
+extern const char sai_metadata_compact_strings[];
+
+/**
+ * @brief Pool of allowed object types
+ */
+extern const uint16_t sai_metadata_compact_object_types[];
+
+/**
+ * @brief Pool of const default values, first entry is unused
+ */
+extern const sai_attribute_value_t sai_metadata_compact_default_values[];
+
+/**
+ * @brief All attributes in compact layout, ordered by object type
+ */
+extern const sai_attr_metadata_compact_t sai_metadata_compact_attrs[];
+
+/**
+ * @brief Number of attributes in compact layout
+ */
+extern const size_t sai_metadata_compact_attrs_count;
+
+/**
+ * @brief Index of first attribute of each object type
+ *
+ * Attributes of object type are in range [by_object_type[ot], by_object_type[ot + 1]).
+ */
+extern const uint16_t sai_metadata_compact_attrs_by_object_type[];
+
+/**
+ * @brief Number of object types in compact layout, by object type index has one more entry
+ */
+extern const size_t sai_metadata_compact_attrs_by_object_type_count;
+
+/**
+ * @brief Indices of attributes sorted by attribute id name
+ */
+extern const uint16_t sai_metadata_compact_attrs_sorted_by_id_name[];
+
+/**
+ * @brief Gets compact attribute metadata based on object type and attribute id
+ *
+ * @param[in] object_type Object type
+ * @param[in] attr_id Attribute id
+ *
+ * @return Pointer to compact attribute metadata or NULL in case of failure
+ */
+extern const sai_attr_metadata_compact_t* sai_metadata_compact_get_attr_metadata(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_attr_id_t attr_id);
+
+/**
+ * @brief Gets compact attribute metadata based on attribute id name
+ *
+ * @param[in] attr_id_name Attribute id name
+ *
+ * @return Pointer to compact attribute metadata or NULL in case of failure
+ */
+extern const sai_attr_metadata_compact_t* sai_metadata_compact_get_attr_metadata_by_attr_id_name(
+        _In_ const char *attr_id_name);
+
+/**
+ * @brief Gets attribute id name
+ *
+ * @param[in] metadata Compact attribute metadata
+ *
+ * @return Attribute id name
+ */
+extern const char* sai_metadata_compact_get_attr_id_name(
+        _In_ const sai_attr_metadata_compact_t *metadata);
+
+/**
+ * @brief Gets attribute brief description
+ *
+ * @param[in] metadata Compact attribute metadata
+ *
+ * @return Attribute brief description
+ */
+extern const char* sai_metadata_compact_get_brief(
+        _In_ const sai_attr_metadata_compact_t *metadata);
+
+/**
+ * @brief Gets allowed object type
+ *
+ * @param[in] metadata Compact attribute metadata
+ * @param[in] index Index of allowed object type, less than allowedobjecttypeslength
+ *
+ * @return Allowed object type or SAI_OBJECT_TYPE_NULL if index is out of range
+ */
+extern sai_object_type_t sai_metadata_compact_get_allowed_object_type(
+        _In_ const sai_attr_metadata_compact_t *metadata,
+        _In_ size_t index);
+
+/**
+ * @brief Checks whether object type is allowed on attribute
+ *
+ * @param[in] metadata Compact attribute metadata
+ * @param[in] object_type Object type
+ *
+ * @return True if object type is allowed, false otherwise
+ */
+extern bool sai_metadata_compact_is_allowed_object_type(
+        _In_ const sai_attr_metadata_compact_t *metadata,
+        _In_ sai_object_type_t object_type);
+
+/**
+ * @brief Gets const default value
+ *
+ * @param[in] metadata Compact attribute metadata
+ *
+ * @return Default value or NULL if attribute has no const default value
+ */
+extern const sai_attribute_value_t* sai_metadata_compact_get_default_value(
+        _In_ const sai_attr_metadata_compact_t *metadata);
+
+/**
+ * @brief Serialize attribute id using compact layout
+ *
+ * Output is the same as of sai_serialize_attr_id().
+ *
+ * @param[out] buffer Output buffer for serialized value
+ * @param[in] meta Compact attribute metadata
+ *
+ * @return Number of characters written to buffer excluding '\0',
+ * or #SAI_SERIALIZE_ERROR on error
+ */
+extern int sai_serialize_compact_attr_id(
+        _Out_ char *buffer,
+        _In_ const sai_attr_metadata_compact_t *meta);
+
+/**
+ * @brief Deserialize attribute id using compact layout
+ *
+ * Attribute id name ends on first character which is not letter, digit or
+ * underscore, so it can be deserialized from inside of serialized attribute.
+ *
+ * @param[in] buffer Input buffer to be examined
+ * @param[out] index Index of deserialized attribute in sai_metadata_compact_attrs
+ *
+ * @return Number of characters consumed from buffer,
+ * or #SAI_SERIALIZE_ERROR on error
+ */
+extern int sai_deserialize_compact_attr_id(
+        _In_ const char *buffer,
+        _Out_ size_t *index);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATACOMPACT_H_ */
@@ -0,0 +1,307 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatacompactbench.c
+ *
+ * @brief   This module compares full and compact metadata layout
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime, fork */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+#define LOOKUP_ITERATIONS 200
+#define LOAD_ITERATIONS 200
+
+#define CHECK(md, cond)                                                     \
+    if (!(cond)) {                                                          \
+        fprintf(stderr, "FAIL: %s: %s\n", (md)->attridname, #cond);         \
+        exit(1);                                                            \
+    }
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void check_compact_attr(
+        _In_ const sai_attr_metadata_t *md)
+{
+    const sai_attr_metadata_compact_t *cmd = sai_metadata_compact_get_attr_metadata(md->objecttype, md->attrid);
+
+    CHECK(md, cmd != NULL);
+    CHECK(md, cmd == sai_metadata_compact_get_attr_metadata_by_attr_id_name(md->attridname));
+
+    CHECK(md, cmd->attrid == md->attrid);
+    CHECK(md, cmd->objecttype == md->objecttype);
+    CHECK(md, strcmp(sai_metadata_compact_get_attr_id_name(cmd), md->attridname) == 0);
+    CHECK(md, strcmp(sai_metadata_compact_get_brief(cmd), md->brief) == 0);
+    CHECK(md, cmd->attrvaluetype == md->attrvaluetype);
+    CHECK(md, cmd->flags == md->flags);
+    CHECK(md, cmd->allowedobjecttypeslength == md->allowedobjecttypeslength);
+
+    size_t idx = 0;
+
+    for (; idx < md->allowedobjecttypeslength; idx++)
+    {
+        CHECK(md, sai_metadata_compact_get_allowed_object_type(cmd, idx) == md->allowedobjecttypes[idx]);
+        CHECK(md, sai_metadata_compact_is_allowed_object_type(cmd, md->allowedobjecttypes[idx]));
+    }
+
+    CHECK(md, cmd->defaultvaluetype == md->defaultvaluetype);
+    CHECK(md, cmd->defaultvalueobjecttype == md->defaultvalueobjecttype);
+    CHECK(md, cmd->defaultvalueattrid == md->defaultvalueattrid);
+
+    const sai_attribute_value_t *defval = sai_metadata_compact_get_default_value(cmd);
+
+    CHECK(md, (defval == NULL) == (md->defaultvalue == NULL));
+    CHECK(md, defval == NULL || memcmp(defval, md->defaultvalue, sizeof(sai_attribute_value_t)) == 0);
+
+    if (md->enummetadata == NULL)
+    {
+        CHECK(md, cmd->enummetadata == SAI_METADATA_COMPACT_NO_INDEX);
+    }
+    else
+    {
+        CHECK(md, sai_metadata_all_enums[cmd->enummetadata] == md->enummetadata);
+    }
+
+    CHECK(md, cmd->notificationtype == md->notificationtype);
+    CHECK(md, cmd->pointertype == md->pointertype);
+
+    CHECK(md, cmd->allowrepetitiononlist == md->allowrepetitiononlist);
+    CHECK(md, cmd->allowmixedobjecttypes == md->allowmixedobjecttypes);
+    CHECK(md, cmd->allowemptylist == md->allowemptylist);
+    CHECK(md, cmd->allownullobjectid == md->allownullobjectid);
+    CHECK(md, cmd->isoidattribute == md->isoidattribute);
+    CHECK(md, cmd->storedefaultvalue == md->storedefaultvalue);
+    CHECK(md, cmd->isenum == md->isenum);
+    CHECK(md, cmd->isenumlist == md->isenumlist);
+    CHECK(md, cmd->isconditional == md->isconditional);
+    CHECK(md, cmd->isvalidonly == md->isvalidonly);
+    CHECK(md, cmd->getsave == md->getsave);
+    CHECK(md, cmd->isvlan == md->isvlan);
+    CHECK(md, cmd->isaclfield == md->isaclfield);
+    CHECK(md, cmd->isaclaction == md->isaclaction);
+    CHECK(md, cmd->isaclmask == md->isaclmask);
+    CHECK(md, cmd->ismandatoryoncreate == md->ismandatoryoncreate);
+    CHECK(md, cmd->iscreateonly == md->iscreateonly);
+    CHECK(md, cmd->iscreateandset == md->iscreateandset);
+    CHECK(md, cmd->isreadonly == md->isreadonly);
+    CHECK(md, cmd->iskey == md->iskey);
+    CHECK(md, cmd->isprimitive == md->isprimitive);
+    CHECK(md, cmd->iscallback == md->iscallback);
+    CHECK(md, cmd->isextensionattr == md->isextensionattr);
+    CHECK(md, cmd->isresourcetype == md->isresourcetype);
+    CHECK(md, cmd->isdeprecated == md->isdeprecated);
+    CHECK(md, cmd->isconditionrelaxed == md->isconditionrelaxed);
+
+    char full[256];
+    char compact[256];
+
+    int len = sai_serialize_attr_id(full, md, md->attrid);
+
+    CHECK(md, sai_serialize_compact_attr_id(compact, cmd) == len);
+    CHECK(md, strcmp(full, compact) == 0);
+
+    /* attribute id is followed by quote in serialized attribute */
+
+    strcat(compact, "\"");
+
+    size_t index = sai_metadata_compact_attrs_count;
+
+    CHECK(md, sai_deserialize_compact_attr_id(compact, &index) == len);
+    CHECK(md, &sai_metadata_compact_attrs[index] == cmd);
+}
+
+static void check_compact_layout(void)
+{
+    size_t idx = 0;
+
+    for (; idx < sai_metadata_attr_sorted_by_id_name_count; idx++)
+    {
+        check_compact_attr(sai_metadata_attr_sorted_by_id_name[idx]);
+    }
+
+    if (sai_metadata_compact_attrs_count != sai_metadata_attr_sorted_by_id_name_count)
+    {
+        fprintf(stderr, "FAIL: compact attributes count %zu, expected %zu\n",
+                sai_metadata_compact_attrs_count, sai_metadata_attr_sorted_by_id_name_count);
+        exit(1);
+    }
+
+    printf("compact layout matches full layout for %zu attributes\n", sai_metadata_compact_attrs_count);
+
+    printf("attribute metadata size: full %zu bytes, compact %zu bytes\n",
+            sizeof(sai_attr_metadata_t), sizeof(sai_attr_metadata_compact_t));
+}
+
+static void bench_lookup(void)
+{
+    size_t count = sai_metadata_attr_sorted_by_id_name_count;
+
+    size_t found = 0;
+    size_t iter;
+    size_t idx;
+
+    uint64_t start = now_ns();
+
+    for (iter = 0; iter < LOOKUP_ITERATIONS; iter++)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            const sai_attr_metadata_t *md = sai_metadata_attr_sorted_by_id_name[idx];
+
+            found += sai_metadata_get_attr_metadata(md->objecttype, md->attrid) != NULL;
+        }
+    }
+
+    uint64_t full = now_ns() - start;
+
+    start = now_ns();
+
+    for (iter = 0; iter < LOOKUP_ITERATIONS; iter++)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            const sai_attr_metadata_t *md = sai_metadata_attr_sorted_by_id_name[idx];
+
+            found += sai_metadata_compact_get_attr_metadata(md->objecttype, md->attrid) != NULL;
+        }
+    }
+
+    uint64_t compact = now_ns() - start;
+
+    printf("lookup by attribute id: full %.1f ns, compact %.1f ns (%zu found)\n",
+            (double)full / (double)(LOOKUP_ITERATIONS * count),
+            (double)compact / (double)(LOOKUP_ITERATIONS * count), found);
+}
+
+static void bench_deserialize(void)
+{
+    size_t count = sai_metadata_attr_sorted_by_id_name_count;
+
+    size_t found = 0;
+    size_t iter;
+    size_t idx;
+
+    uint64_t start = now_ns();
+
+    for (iter = 0; iter < LOOKUP_ITERATIONS; iter++)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            sai_attr_id_t attr_id;
+
+            found += sai_deserialize_attr_id(sai_metadata_attr_sorted_by_id_name[idx]->attridname, &attr_id) > 0;
+        }
+    }
+
+    uint64_t full = now_ns() - start;
+
+    start = now_ns();
+
+    for (iter = 0; iter < LOOKUP_ITERATIONS; iter++)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            size_t index;
+
+            found += sai_deserialize_compact_attr_id(sai_metadata_attr_sorted_by_id_name[idx]->attridname, &index) > 0;
+        }
+    }
+
+    uint64_t compact = now_ns() - start;
+
+    printf("deserialize attribute id: full %.1f ns, compact %.1f ns (%zu found)\n",
+            (double)full / (double)(LOOKUP_ITERATIONS * count),
+            (double)compact / (double)(LOOKUP_ITERATIONS * count), found);
+}
+
+static void bench_load(
+        _In_ const char *path)
+{
+    struct stat st;
+
+    if (stat(path, &st) != 0)
+    {
+        printf("%s: not found, skipping load benchmark\n", path);
+        return;
+    }
+
+    /* each load is done in fresh process, so relocations and page faults are not cached */
+
+    uint64_t start = now_ns();
+
+    int i = 0;
+
+    for (; i < LOAD_ITERATIONS; i++)
+    {
+        pid_t pid = fork();
+
+        if (pid == 0)
+        {
+            _exit(dlopen(path, RTLD_NOW) == NULL);
+        }
+
+        int status = 0;
+
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || status != 0)
+        {
+            printf("%s: failed to load\n", path);
+            return;
+        }
+    }
+
+    printf("%s: file size %ld bytes, fork and load %.1f us\n",
+            path, (long)st.st_size, (double)(now_ns() - start) / (double)LOAD_ITERATIONS / 1000.0);
+}
+
+int main(
+        _In_ int argc,
+        _In_ char **argv)
+{
+    check_compact_layout();
+
+    bench_lookup();
+
+    bench_deserialize();
+
+    int i = 1;
+
+    for (; i < argc; i++)
+    {
+        bench_load(argv[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,547 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatalatency.c
+ *
+ * @brief   This module defines SAI Metadata API Latency Instrumentation
+ */
+
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sai.h>
+#include "saimetadatalatency.h"
+#include "saimetadata.h"
+
+/*
+ * Each thread gets its own shard on first recorded call, and shard holds
+ * separate statistics for each function, allocated on first call of that
+ * function. Shards are never freed, when thread exits its shard is released
+ * and reused by next new thread, so number of shards is bounded by maximum
+ * number of concurrently recording threads. Counters are still updated with
+ * relaxed atomics, since statistics can be cleared from any thread, but
+ * cache lines of shard are written only by its owner thread.
+ */
+
+#define SAI_METADATA_LATENCY_SUB_BUCKETS (1 << SAI_METADATA_LATENCY_HISTOGRAM_SUB_BITS)
+
+typedef struct _sai_metadata_latency_fn_stats_t
+{
+    uint64_t count;
+
+    uint64_t errors;
+
+    uint64_t total;
+
+    uint64_t min;
+
+    uint64_t max;
+
+    uint64_t bulk_objects;
+
+    uint64_t bulk_max;
+
+    uint64_t batch[SAI_METADATA_LATENCY_BATCH_BUCKETS];
+
+    uint64_t histogram[SAI_METADATA_LATENCY_HISTOGRAM_BUCKETS];
+
+} sai_metadata_latency_fn_stats_t;
+
+typedef struct _sai_metadata_latency_shard_t
+{
+    struct _sai_metadata_latency_shard_t *next;
+
+    bool in_use;
+
+    sai_metadata_latency_fn_stats_t *stats[SAI_METADATA_LATENCY_FN_COUNT];
+
+} sai_metadata_latency_shard_t;
+
+sai_metadata_latency_shard_t *sai_metadata_latency_shards = NULL;
+
+pthread_key_t sai_metadata_latency_shard_key;
+
+pthread_once_t sai_metadata_latency_shard_key_once = PTHREAD_ONCE_INIT;
+
+__thread sai_metadata_latency_shard_t *sai_metadata_latency_thread_shard = NULL;
+
+#define SAI_METADATA_LATENCY_ADD(s, counter, value) \
+    __atomic_fetch_add(&(s)->counter, (value), __ATOMIC_RELAXED)
+
+#define SAI_METADATA_LATENCY_LOAD(s, counter) \
+    __atomic_load_n(&(s)->counter, __ATOMIC_RELAXED)
+
+static uint32_t sai_metadata_latency_get_histogram_bucket(
+        _In_ uint64_t value)
+{
+    if (value < SAI_METADATA_LATENCY_SUB_BUCKETS)
+    {
+        return (uint32_t)value;
+    }
+
+    uint32_t msb = (uint32_t)(63 - __builtin_clzll(value));
+
+    uint32_t shift = msb - SAI_METADATA_LATENCY_HISTOGRAM_SUB_BITS;
+
+    return ((shift + 1) << SAI_METADATA_LATENCY_HISTOGRAM_SUB_BITS) + (uint32_t)((value >> shift) & (SAI_METADATA_LATENCY_SUB_BUCKETS - 1));
+}
+
+static uint64_t sai_metadata_latency_get_histogram_value(
+        _In_ uint32_t bucket)
+{
+    /* highest value which falls into bucket */
+
+    if (bucket < SAI_METADATA_LATENCY_SUB_BUCKETS)
+    {
+        return bucket;
+    }
+
+    uint32_t shift = (bucket >> SAI_METADATA_LATENCY_HISTOGRAM_SUB_BITS) - 1;
+
+    uint64_t sub = SAI_METADATA_LATENCY_SUB_BUCKETS + (bucket & (SAI_METADATA_LATENCY_SUB_BUCKETS - 1));
+
+    return (sub << shift) + ((UINT64_C(1) << shift) - 1);
+}
+
+static uint32_t sai_metadata_latency_get_batch_bucket(
+        _In_ uint32_t object_count)
+{
+    return (uint32_t)(31 - __builtin_clz(object_count));
+}
+
+static void sai_metadata_latency_update_min(
+        _Inout_ uint64_t *min,
+        _In_ uint64_t value)
+{
+    uint64_t current = __atomic_load_n(min, __ATOMIC_RELAXED);
+
+    while (value < current &&
+            !__atomic_compare_exchange_n(min, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        /* current was updated by compare exchange */
+    }
+}
+
+static void sai_metadata_latency_update_max(
+        _Inout_ uint64_t *max,
+        _In_ uint64_t value)
+{
+    uint64_t current = __atomic_load_n(max, __ATOMIC_RELAXED);
+
+    while (value > current &&
+            !__atomic_compare_exchange_n(max, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        /* current was updated by compare exchange */
+    }
+}
+
+static void sai_metadata_latency_release_shard(
+        _In_ void *shard)
+{
+    __atomic_store_n(&((sai_metadata_latency_shard_t*)shard)->in_use, false, __ATOMIC_RELEASE);
+}
+
+static void sai_metadata_latency_create_shard_key(void)
+{
+    if (pthread_key_create(&sai_metadata_latency_shard_key, sai_metadata_latency_release_shard) != 0)
+    {
+        SAI_META_LOG_WARN("failed to create shard key, shards of exited threads will not be reused");
+    }
+}
+
+static sai_metadata_latency_shard_t* sai_metadata_latency_get_shard(void)
+{
+    sai_metadata_latency_shard_t *shard = sai_metadata_latency_thread_shard;
+
+    if (shard != NULL)
+    {
+        return shard;
+    }
+
+    pthread_once(&sai_metadata_latency_shard_key_once, sai_metadata_latency_create_shard_key);
+
+    for (shard = __atomic_load_n(&sai_metadata_latency_shards, __ATOMIC_ACQUIRE); shard != NULL; shard = shard->next)
+    {
+        bool in_use = false;
+
+        if (__atomic_compare_exchange_n(&shard->in_use, &in_use, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+
+    if (shard == NULL)
+    {
+        shard = calloc(1, sizeof(sai_metadata_latency_shard_t));
+
+        if (shard == NULL)
+        {
+            return NULL;
+        }
+
+        shard->in_use = true;
+        shard->next = __atomic_load_n(&sai_metadata_latency_shards, __ATOMIC_RELAXED);
+
+        while (!__atomic_compare_exchange_n(&sai_metadata_latency_shards, &shard->next, shard, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+            /* shard->next was updated by compare exchange */
+        }
+    }
+
+    pthread_setspecific(sai_metadata_latency_shard_key, shard);
+
+    sai_metadata_latency_thread_shard = shard;
+
+    return shard;
+}
+
+static sai_metadata_latency_fn_stats_t* sai_metadata_latency_get_fn_stats(
+        _In_ size_t fn_index)
+{
+    sai_metadata_latency_shard_t *shard = sai_metadata_latency_get_shard();
+
+    if (shard == NULL)
+    {
+        return NULL;
+    }
+
+    sai_metadata_latency_fn_stats_t *stats = shard->stats[fn_index];
+
+    if (stats != NULL)
+    {
+        return stats;
+    }
+
+    /* only owner thread installs statistics into its shard */
+
+    stats = calloc(1, sizeof(sai_metadata_latency_fn_stats_t));
+
+    if (stats == NULL)
+    {
+        return NULL;
+    }
+
+    stats->min = UINT64_MAX;
+
+    __atomic_store_n(&shard->stats[fn_index], stats, __ATOMIC_RELEASE);
+
+    return stats;
+}
+
+uint64_t sai_metadata_latency_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+void sai_metadata_latency_record(
+        _In_ size_t fn_index,
+        _In_ uint64_t start,
+        _In_ sai_status_t status,
+        _In_ uint32_t object_count)
+{
+    uint64_t end = sai_metadata_latency_now();
+
+    uint64_t latency = (end > start) ? (end - start) : 0;
+
+    if (fn_index >= SAI_METADATA_LATENCY_FN_COUNT)
+    {
+        return;
+    }
+
+    sai_metadata_latency_fn_stats_t *stats = sai_metadata_latency_get_fn_stats(fn_index);
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    SAI_METADATA_LATENCY_ADD(stats, count, 1);
+    SAI_METADATA_LATENCY_ADD(stats, total, latency);
+    SAI_METADATA_LATENCY_ADD(stats, histogram[sai_metadata_latency_get_histogram_bucket(latency)], 1);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SAI_METADATA_LATENCY_ADD(stats, errors, 1);
+    }
+
+    sai_metadata_latency_update_min(&stats->min, latency);
+    sai_metadata_latency_update_max(&stats->max, latency);
+
+    if (object_count != 0)
+    {
+        SAI_METADATA_LATENCY_ADD(stats, bulk_objects, object_count);
+        SAI_METADATA_LATENCY_ADD(stats, batch[sai_metadata_latency_get_batch_bucket(object_count)], 1);
+
+        sai_metadata_latency_update_max(&stats->bulk_max, object_count);
+    }
+}
+
+static uint64_t sai_metadata_latency_get_percentile(
+        _In_ const uint64_t *histogram,
+        _In_ uint64_t count,
+        _In_ uint64_t max,
+        _In_ uint32_t permille)
+{
+    uint64_t target = (count * permille + 999) / 1000;
+    uint64_t sum = 0;
+    uint32_t bucket;
+
+    for (bucket = 0; bucket < SAI_METADATA_LATENCY_HISTOGRAM_BUCKETS; bucket++)
+    {
+        sum += histogram[bucket];
+
+        if (sum >= target && sum != 0)
+        {
+            uint64_t value = sai_metadata_latency_get_histogram_value(bucket);
+
+            return (value < max) ? value : max;
+        }
+    }
+
+    return max;
+}
+
+sai_status_t sai_metadata_latency_get_stats(
+        _In_ size_t fn_index,
+        _Out_ sai_metadata_latency_stats_t *stats)
+{
+    uint64_t histogram[SAI_METADATA_LATENCY_HISTOGRAM_BUCKETS];
+    uint64_t count = 0;
+    const sai_metadata_latency_shard_t *shard;
+    uint32_t idx;
+
+    if (fn_index >= SAI_METADATA_LATENCY_FN_COUNT || stats == NULL)
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(stats, 0, sizeof(sai_metadata_latency_stats_t));
+    memset(histogram, 0, sizeof(histogram));
+
+    stats->min = UINT64_MAX;
+
+    for (shard = __atomic_load_n(&sai_metadata_latency_shards, __ATOMIC_ACQUIRE); shard != NULL; shard = shard->next)
+    {
+        const sai_metadata_latency_fn_stats_t *s = __atomic_load_n(&shard->stats[fn_index], __ATOMIC_ACQUIRE);
+
+        if (s == NULL)
+        {
+            continue;
+        }
+
+        uint64_t min = SAI_METADATA_LATENCY_LOAD(s, min);
+        uint64_t max = SAI_METADATA_LATENCY_LOAD(s, max);
+        uint64_t bulk_max = SAI_METADATA_LATENCY_LOAD(s, bulk_max);
+
+        stats->count += SAI_METADATA_LATENCY_LOAD(s, count);
+        stats->errors += SAI_METADATA_LATENCY_LOAD(s, errors);
+        stats->total += SAI_METADATA_LATENCY_LOAD(s, total);
+        stats->bulk_objects += SAI_METADATA_LATENCY_LOAD(s, bulk_objects);
+
+        stats->min = (min < stats->min) ? min : stats->min;
+        stats->max = (max > stats->max) ? max : stats->max;
+        stats->bulk_max = (bulk_max > stats->bulk_max) ? bulk_max : stats->bulk_max;
+
+        for (idx = 0; idx < SAI_METADATA_LATENCY_BATCH_BUCKETS; idx++)
+        {
+            stats->batch[idx] += SAI_METADATA_LATENCY_LOAD(s, batch[idx]);
+        }
+
+        for (idx = 0; idx < SAI_METADATA_LATENCY_HISTOGRAM_BUCKETS; idx++)
+        {
+            uint64_t value = SAI_METADATA_LATENCY_LOAD(s, histogram[idx]);
+
+            histogram[idx] += value;
+
+            count += value;
+        }
+    }
+
+    if (stats->count == 0)
+    {
+        stats->min = 0;
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /*
+     * Histogram count is used for percentiles, since while reading shards
+     * other threads can record calls and counters may be slightly off.
+     */
+
+    stats->p50 = sai_metadata_latency_get_percentile(histogram, count, stats->max, 500);
+    stats->p90 = sai_metadata_latency_get_percentile(histogram, count, stats->max, 900);
+    stats->p99 = sai_metadata_latency_get_percentile(histogram, count, stats->max, 990);
+    stats->p999 = sai_metadata_latency_get_percentile(histogram, count, stats->max, 999);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_latency_clear_stats(void)
+{
+    sai_metadata_latency_shard_t *shard;
+    size_t fn_index;
+    uint32_t idx;
+
+    for (shard = __atomic_load_n(&sai_metadata_latency_shards, __ATOMIC_ACQUIRE); shard != NULL; shard = shard->next)
+    {
+        for (fn_index = 0; fn_index < SAI_METADATA_LATENCY_FN_COUNT; fn_index++)
+        {
+            sai_metadata_latency_fn_stats_t *s = __atomic_load_n(&shard->stats[fn_index], __ATOMIC_ACQUIRE);
+
+            if (s == NULL)
+            {
+                continue;
+            }
+
+            /* statistics are not freed, since other thread may be recording call */
+
+            __atomic_store_n(&s->count, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&s->errors, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&s->total, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&s->min, UINT64_MAX, __ATOMIC_RELAXED);
+            __atomic_store_n(&s->max, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&s->bulk_objects, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&s->bulk_max, 0, __ATOMIC_RELAXED);
+
+            for (idx = 0; idx < SAI_METADATA_LATENCY_BATCH_BUCKETS; idx++)
+            {
+                __atomic_store_n(&s->batch[idx], 0, __ATOMIC_RELAXED);
+            }
+
+            for (idx = 0; idx < SAI_METADATA_LATENCY_HISTOGRAM_BUCKETS; idx++)
+            {
+                __atomic_store_n(&s->histogram[idx], 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+static void sai_metadata_latency_dump_text(
+        _Inout_ FILE *stream)
+{
+    size_t fn_index;
+
+    fprintf(stream, "%-64s %12s %8s %10s %10s %10s %10s %10s %10s %12s %8s\n",
+            "function", "count", "errors", "avg_ns", "p50_ns", "p90_ns", "p99_ns", "p999_ns", "max_ns", "bulk_objects", "bulk_max");
+
+    for (fn_index = 0; fn_index < SAI_METADATA_LATENCY_FN_COUNT; fn_index++)
+    {
+        sai_metadata_latency_stats_t stats;
+
+        if (sai_metadata_latency_get_stats(fn_index, &stats) != SAI_STATUS_SUCCESS || stats.count == 0)
+        {
+            continue;
+        }
+
+        fprintf(stream, "%-64s %12"PRIu64" %8"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64" %12"PRIu64" %8"PRIu64"\n",
+                sai_metadata_latency_fn_names[fn_index],
+                stats.count,
+                stats.errors,
+                stats.total / stats.count,
+                stats.p50,
+                stats.p90,
+                stats.p99,
+                stats.p999,
+                stats.max,
+                stats.bulk_objects,
+                stats.bulk_max);
+    }
+}
+
+static void sai_metadata_latency_dump_json(
+        _Inout_ FILE *stream)
+{
+    size_t fn_index;
+    uint32_t idx;
+    const char *separator = "";
+
+    fprintf(stream, "{\"unit\":\"ns\",\"functions\":[");
+
+    for (fn_index = 0; fn_index < SAI_METADATA_LATENCY_FN_COUNT; fn_index++)
+    {
+        sai_metadata_latency_stats_t stats;
+
+        if (sai_metadata_latency_get_stats(fn_index, &stats) != SAI_STATUS_SUCCESS || stats.count == 0)
+        {
+            continue;
+        }
+
+        fprintf(stream, "%s{\"name\":\"%s\",\"count\":%"PRIu64",\"errors\":%"PRIu64",\"total\":%"PRIu64
+                ",\"min\":%"PRIu64",\"max\":%"PRIu64",\"p50\":%"PRIu64",\"p90\":%"PRIu64",\"p99\":%"PRIu64",\"p999\":%"PRIu64,
+                separator,
+                sai_metadata_latency_fn_names[fn_index],
+                stats.count,
+                stats.errors,
+                stats.total,
+                stats.min,
+                stats.max,
+                stats.p50,
+                stats.p90,
+                stats.p99,
+                stats.p999);
+
+        if (stats.bulk_objects != 0)
+        {
+            fprintf(stream, ",\"bulk_objects\":%"PRIu64",\"bulk_max\":%"PRIu64",\"batch\":[", stats.bulk_objects, stats.bulk_max);
+
+            for (idx = 0; idx < SAI_METADATA_LATENCY_BATCH_BUCKETS; idx++)
+            {
+                fprintf(stream, "%s%"PRIu64, (idx == 0) ? "" : ",", stats.batch[idx]);
+            }
+
+            fprintf(stream, "]");
+        }
+
+        fprintf(stream, "}");
+
+        separator = ",";
+    }
+
+    fprintf(stream, "]}\n");
+}
+
+void sai_metadata_latency_dump(
+        _In_ sai_metadata_latency_dump_format_t format,
+        _Inout_ FILE *stream)
+{
+    switch (format)
+    {
+        case SAI_METADATA_LATENCY_DUMP_FORMAT_TEXT:
+            sai_metadata_latency_dump_text(stream);
+            break;
+
+        case SAI_METADATA_LATENCY_DUMP_FORMAT_JSON:
+            sai_metadata_latency_dump_json(stream);
+            break;
+
+        default:
+            SAI_META_LOG_ERROR("unknown dump format %d", format);
+            break;
+    }
+}
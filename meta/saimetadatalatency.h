@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatalatency.h
+ *
+ * @brief   This module defines SAI Metadata API Latency Instrumentation
+ */
+
+#ifndef __SAIMETADATALATENCY_H_
+#define __SAIMETADATALATENCY_H_
+
+#include <stdio.h>
+
+/**
+ * @defgroup SAIMETADATALATENCY SAI - Metadata API Latency Instrumentation Definitions
+ *
+ * Auto generated sai_metadata_latency_apis_wrap() and
+ * sai_metadata_latency_api_wrap() replace API method tables obtained from
+ * sai_api_query() with tables of wrappers. Each wrapper measures time spent
+ * in vendor function and records call count, error count, latency histogram
+ * and for bulk functions batch size histogram.
+ *
+ * Statistics are recorded without locks into per thread shards and are
+ * aggregated only when queried or dumped. Instrumentation is optional, when
+ * API tables are not wrapped there is no overhead.
+ *
+ * @{
+ */
+
+/**
+ * @brief Number of significant bits of latency histogram bucket
+ *
+ * Each power of 2 range is divided into 2^bits sub buckets, so recorded
+ * latency has relative error less than 1 / 2^bits.
+ */
+#define SAI_METADATA_LATENCY_HISTOGRAM_SUB_BITS 3
+
+/**
+ * @brief Number of latency histogram buckets
+ */
+#define SAI_METADATA_LATENCY_HISTOGRAM_BUCKETS ((64 - SAI_METADATA_LATENCY_HISTOGRAM_SUB_BITS + 1) << SAI_METADATA_LATENCY_HISTOGRAM_SUB_BITS)
+
+/**
+ * @brief Number of batch size histogram buckets, one for each power of 2
+ */
+#define SAI_METADATA_LATENCY_BATCH_BUCKETS 32
+
+/**
+ * @brief Latency statistics dump format
+ */
+typedef enum _sai_metadata_latency_dump_format_t
+{
+    /**
+     * @brief Human readable table
+     */
+    SAI_METADATA_LATENCY_DUMP_FORMAT_TEXT,
+
+    /**
+     * @brief JSON document
+     */
+    SAI_METADATA_LATENCY_DUMP_FORMAT_JSON,
+
+} sai_metadata_latency_dump_format_t;
+
+/**
+ * @brief Aggregated latency statistics of single API function
+ *
+ * All latencies are in nanoseconds.
+ */
+typedef struct _sai_metadata_latency_stats_t
+{
+    /**
+     * @brief Number of calls.
+     */
+    uint64_t count;
+
+    /**
+     * @brief Number of calls which returned status other than success.
+     */
+    uint64_t errors;
+
+    /**
+     * @brief Sum of latencies of all calls.
+     */
+    uint64_t total;
+
+    /**
+     * @brief Minimum latency.
+     */
+    uint64_t min;
+
+    /**
+     * @brief Maximum latency.
+     */
+    uint64_t max;
+
+    /**
+     * @brief Median latency.
+     */
+    uint64_t p50;
+
+    /**
+     * @brief Latency at percentile 90.
+     */
+    uint64_t p90;
+
+    /**
+     * @brief Latency at percentile 99.
+     */
+    uint64_t p99;
+
+    /**
+     * @brief Latency at percentile 99.9.
+     */
+    uint64_t p999;
+
+    /**
+     * @brief Number of objects passed to bulk function in all calls.
+     */
+    uint64_t bulk_objects;
+
+    /**
+     * @brief Maximum number of objects passed to bulk function in single call.
+     */
+    uint64_t bulk_max;
+
+    /**
+     * @brief Batch size histogram, bucket N counts bulk calls with object count in range [2^N, 2^(N+1)).
+     */
+    uint64_t batch[SAI_METADATA_LATENCY_BATCH_BUCKETS];
+
+} sai_metadata_latency_stats_t;
+
+/**
+ * @brief Get current monotonic time
+ *
+ * Used by auto generated wrappers.
+ *
+ * @return Current time in nanoseconds
+ */
+extern uint64_t sai_metadata_latency_now(void);
+
+/**
+ * @brief Record single API function call
+ *
+ * Used by auto generated wrappers, can be called concurrently from multiple
+ * threads.
+ *
+ * @param[in] fn_index Function index, less than SAI_METADATA_LATENCY_FN_COUNT
+ * @param[in] start Time when call started, obtained by sai_metadata_latency_now()
+ * @param[in] status Status returned by function
+ * @param[in] object_count Number of objects passed to bulk function, zero for other functions
+ */
+extern void sai_metadata_latency_record(
+        _In_ size_t fn_index,
+        _In_ uint64_t start,
+        _In_ sai_status_t status,
+        _In_ uint32_t object_count);
+
+/**
+ * @brief Get aggregated statistics of API function
+ *
+ * @param[in] fn_index Function index, less than SAI_METADATA_LATENCY_FN_COUNT
+ * @param[out] stats Aggregated statistics
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_latency_get_stats(
+        _In_ size_t fn_index,
+        _Out_ sai_metadata_latency_stats_t *stats);
+
+/**
+ * @brief Clear statistics of all API functions
+ */
+extern void sai_metadata_latency_clear_stats(void);
+
+/**
+ * @brief Dump statistics of all called API functions
+ *
+ * @param[in] format Dump format
+ * @param[inout] stream Output stream
+ */
+extern void sai_metadata_latency_dump(
+        _In_ sai_metadata_latency_dump_format_t format,
+        _Inout_ FILE *stream);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATALATENCY_H_ */
@@ -0,0 +1,495 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadataqueue.c
+ *
+ * @brief   This module defines SAI Metadata Notification Queue
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sai.h>
+#include "saimetadataqueue.h"
+#include "saimetadata.h"
+
+/*
+ * Queue is bounded array of slots, where each slot owns fixed size part of
+ * preallocated slab. Producers claim slots by atomic increment of enqueue
+ * position, and each slot sequence number tells whether slot is free for
+ * producer or ready for consumer, so no locks are needed.
+ */
+
+#define SAI_METADATA_NOTIFICATION_QUEUE_ALIGN       (sizeof(uint64_t))
+#define SAI_METADATA_NOTIFICATION_QUEUE_CACHE_LINE  64
+
+typedef struct _sai_metadata_notification_queue_slot_t
+{
+    uint64_t sequence;
+
+    int notification_type;
+
+    bool valid;
+
+    void *params;
+
+} sai_metadata_notification_queue_slot_t;
+
+typedef struct _sai_metadata_notification_queue_t
+{
+    /* producers and consumer positions are on separate cache lines */
+
+    uint64_t enqueue_position;
+
+    char padding[SAI_METADATA_NOTIFICATION_QUEUE_CACHE_LINE - sizeof(uint64_t)];
+
+    uint64_t dequeue_position;
+
+    uint64_t mask;
+
+    size_t slot_size;
+
+    sai_metadata_notification_queue_slot_t *slots;
+
+    char *slab;
+
+    sai_metadata_notification_queue_stats_t stats[SAI_METADATA_SWITCH_NOTIFY_ATTR_COUNT];
+
+} sai_metadata_notification_queue_t;
+
+sai_metadata_notification_queue_t *sai_metadata_notification_queue_instance = NULL;
+
+#define SAI_METADATA_NOTIFICATION_QUEUE_INC(q, type, counter) \
+    __atomic_fetch_add(&(q)->stats[(type)].counter, 1, __ATOMIC_RELAXED)
+
+static bool sai_metadata_notification_queue_is_type_valid(
+        _In_ int notification_type)
+{
+    return notification_type >= 0 && notification_type < SAI_METADATA_SWITCH_NOTIFY_ATTR_COUNT;
+}
+
+sai_status_t sai_metadata_notification_queue_init(
+        _In_ size_t slot_count,
+        _In_ size_t slot_size)
+{
+    if (slot_count < 2 || (slot_count & (slot_count - 1)) != 0)
+    {
+        SAI_META_LOG_ERROR("slot count %zu must be power of 2", slot_count);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (slot_size == 0)
+    {
+        SAI_META_LOG_ERROR("slot size must be non zero");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (__atomic_load_n(&sai_metadata_notification_queue_instance, __ATOMIC_ACQUIRE) != NULL)
+    {
+        SAI_META_LOG_ERROR("notification queue is already initialized");
+        return SAI_STATUS_FAILURE;
+    }
+
+    slot_size = (slot_size + SAI_METADATA_NOTIFICATION_QUEUE_ALIGN - 1) & ~(SAI_METADATA_NOTIFICATION_QUEUE_ALIGN - 1);
+
+    sai_metadata_notification_queue_t *q = calloc(1, sizeof(sai_metadata_notification_queue_t));
+
+    if (q == NULL)
+    {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    q->slots = calloc(slot_count, sizeof(sai_metadata_notification_queue_slot_t));
+    q->slab = malloc(slot_size * slot_count);
+
+    if (q->slots == NULL || q->slab == NULL)
+    {
+        free(q->slots);
+        free(q->slab);
+        free(q);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    q->mask = slot_count - 1;
+    q->slot_size = slot_size;
+
+    size_t idx = 0;
+
+    for (; idx < slot_count; idx++)
+    {
+        q->slots[idx].sequence = idx;
+    }
+
+    __atomic_store_n(&sai_metadata_notification_queue_instance, q, __ATOMIC_RELEASE);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_notification_queue_uninit(void)
+{
+    sai_metadata_notification_queue_t *q = __atomic_exchange_n(&sai_metadata_notification_queue_instance, NULL, __ATOMIC_ACQ_REL);
+
+    if (q == NULL)
+    {
+        return;
+    }
+
+    free(q->slots);
+    free(q->slab);
+    free(q);
+}
+
+sai_status_t sai_metadata_notification_queue_get_stats(
+        _In_ int notification_type,
+        _Out_ sai_metadata_notification_queue_stats_t *stats)
+{
+    sai_metadata_notification_queue_t *q = __atomic_load_n(&sai_metadata_notification_queue_instance, __ATOMIC_ACQUIRE);
+
+    if (q == NULL)
+    {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    if (stats == NULL || !sai_metadata_notification_queue_is_type_valid(notification_type))
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    const sai_metadata_notification_queue_stats_t *s = &q->stats[notification_type];
+
+    stats->enqueued = __atomic_load_n(&s->enqueued, __ATOMIC_RELAXED);
+    stats->dispatched = __atomic_load_n(&s->dispatched, __ATOMIC_RELAXED);
+    stats->dropped_full = __atomic_load_n(&s->dropped_full, __ATOMIC_RELAXED);
+    stats->dropped_size = __atomic_load_n(&s->dropped_size, __ATOMIC_RELAXED);
+    stats->dropped_unsupported = __atomic_load_n(&s->dropped_unsupported, __ATOMIC_RELAXED);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_notification_queue_clear_stats(void)
+{
+    sai_metadata_notification_queue_t *q = __atomic_load_n(&sai_metadata_notification_queue_instance, __ATOMIC_ACQUIRE);
+
+    if (q == NULL)
+    {
+        return;
+    }
+
+    int idx = 0;
+
+    for (; idx < SAI_METADATA_SWITCH_NOTIFY_ATTR_COUNT; idx++)
+    {
+        sai_metadata_notification_queue_stats_t *s = &q->stats[idx];
+
+        __atomic_store_n(&s->enqueued, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->dispatched, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->dropped_full, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->dropped_size, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->dropped_unsupported, 0, __ATOMIC_RELAXED);
+    }
+}
+
+bool sai_metadata_notification_queue_reserve(
+        _In_ int notification_type,
+        _Out_ sai_metadata_notification_queue_slab_t *slab)
+{
+    sai_metadata_notification_queue_t *q = __atomic_load_n(&sai_metadata_notification_queue_instance, __ATOMIC_ACQUIRE);
+
+    if (q == NULL || slab == NULL || !sai_metadata_notification_queue_is_type_valid(notification_type))
+    {
+        return false;
+    }
+
+    uint64_t pos = __atomic_load_n(&q->enqueue_position, __ATOMIC_RELAXED);
+
+    while (true)
+    {
+        sai_metadata_notification_queue_slot_t *slot = &q->slots[pos & q->mask];
+
+        uint64_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+
+        int64_t diff = (int64_t)(seq - pos);
+
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&q->enqueue_position, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* consumer didn't release this slot yet, queue is full */
+
+            SAI_METADATA_NOTIFICATION_QUEUE_INC(q, notification_type, dropped_full);
+
+            return false;
+        }
+        else
+        {
+            pos = __atomic_load_n(&q->enqueue_position, __ATOMIC_RELAXED);
+        }
+    }
+
+    slab->notification_type = notification_type;
+    slab->position = pos;
+    slab->buffer = q->slab + (pos & q->mask) * q->slot_size;
+    slab->size = q->slot_size;
+    slab->used = 0;
+    slab->overflow = false;
+    slab->unsupported = false;
+
+    return true;
+}
+
+void* sai_metadata_notification_queue_slab_alloc(
+        _Inout_ sai_metadata_notification_queue_slab_t *slab,
+        _In_ size_t size)
+{
+    if (size == 0)
+    {
+        return NULL;
+    }
+
+    size = (size + SAI_METADATA_NOTIFICATION_QUEUE_ALIGN - 1) & ~(SAI_METADATA_NOTIFICATION_QUEUE_ALIGN - 1);
+
+    if (size > slab->size - slab->used)
+    {
+        slab->overflow = true;
+        return NULL;
+    }
+
+    void *ptr = slab->buffer + slab->used;
+
+    slab->used += size;
+
+    return ptr;
+}
+
+void* sai_metadata_notification_queue_slab_dup(
+        _Inout_ sai_metadata_notification_queue_slab_t *slab,
+        _In_ const void *source,
+        _In_ size_t size)
+{
+    if (source == NULL)
+    {
+        return NULL;
+    }
+
+    void *ptr = sai_metadata_notification_queue_slab_alloc(slab, size);
+
+    if (ptr != NULL)
+    {
+        memcpy(ptr, source, size);
+    }
+
+    return ptr;
+}
+
+static void sai_metadata_notification_queue_slab_copy_attr_value(
+        _Inout_ sai_metadata_notification_queue_slab_t *slab,
+        _In_ const sai_attr_metadata_t *md,
+        _Inout_ sai_attribute_value_t *value)
+{
+    /*
+     * All list elements which can be used as attribute values are flat
+     * structures, so copy of single level is enough. Lists of each attribute
+     * value type are generated from metadata.
+     */
+
+    sai_metadata_attr_value_list_t lists[SAI_METADATA_ATTR_VALUE_LISTS_MAX];
+
+    uint32_t count = sai_metadata_attr_get_value_lists(md, value, lists);
+
+    uint32_t idx;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        uint8_t *base = (uint8_t*)value;
+
+        uint32_t list_count;
+        const void *list;
+
+        memcpy(&list_count, base + lists[idx].count_offset, sizeof(list_count));
+        memcpy(&list, base + lists[idx].list_offset, sizeof(list));
+
+        void *copy = sai_metadata_notification_queue_slab_dup(slab, list, (size_t)list_count * lists[idx].element_size);
+
+        if (copy == NULL)
+        {
+            list_count = 0;
+
+            memcpy(base + lists[idx].count_offset, &list_count, sizeof(list_count));
+        }
+
+        memcpy(base + lists[idx].list_offset, &copy, sizeof(copy));
+    }
+}
+
+void sai_metadata_notification_queue_slab_copy_attr_list(
+        _Inout_ sai_metadata_notification_queue_slab_t *slab,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+{
+    if (attr_list == NULL)
+    {
+        return;
+    }
+
+    uint32_t idx = 0;
+
+    for (; idx < attr_count; idx++)
+    {
+        const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+
+        if (md == NULL)
+        {
+            SAI_META_LOG_WARN("failed to find metadata for attribute 0x%x on object type %d", attr_list[idx].id, object_type);
+
+            slab->unsupported = true;
+            continue;
+        }
+
+        if (md->isprimitive)
+        {
+            continue;
+        }
+
+        sai_metadata_notification_queue_slab_copy_attr_value(slab, md, &attr_list[idx].value);
+    }
+}
+
+void sai_metadata_notification_queue_commit(
+        _In_ const sai_metadata_notification_queue_slab_t *slab,
+        _Inout_ void *params)
+{
+    sai_metadata_notification_queue_t *q = __atomic_load_n(&sai_metadata_notification_queue_instance, __ATOMIC_ACQUIRE);
+
+    if (q == NULL || slab == NULL)
+    {
+        return;
+    }
+
+    int type = slab->notification_type;
+
+    sai_metadata_notification_queue_slot_t *slot = &q->slots[slab->position & q->mask];
+
+    slot->notification_type = type;
+    slot->params = params;
+    slot->valid = false;
+
+    if (slab->overflow || params == NULL)
+    {
+        SAI_METADATA_NOTIFICATION_QUEUE_INC(q, type, dropped_size);
+    }
+    else if (slab->unsupported)
+    {
+        SAI_METADATA_NOTIFICATION_QUEUE_INC(q, type, dropped_unsupported);
+    }
+    else
+    {
+        slot->valid = true;
+
+        SAI_METADATA_NOTIFICATION_QUEUE_INC(q, type, enqueued);
+    }
+
+    /*
+     * Slot must be published even if notification was dropped, since
+     * position was already claimed and consumer is waiting for it.
+     */
+
+    __atomic_store_n(&slot->sequence, slab->position + 1, __ATOMIC_RELEASE);
+}
+
+static bool sai_metadata_notification_queue_peek(
+        _In_ sai_metadata_notification_queue_t *q,
+        _Out_ sai_metadata_notification_queue_slot_t **slot)
+{
+    uint64_t pos = q->dequeue_position;
+
+    *slot = &q->slots[pos & q->mask];
+
+    return __atomic_load_n(&(*slot)->sequence, __ATOMIC_ACQUIRE) == pos + 1;
+}
+
+static void sai_metadata_notification_queue_release(
+        _In_ sai_metadata_notification_queue_t *q,
+        _In_ sai_metadata_notification_queue_slot_t *slot)
+{
+    uint64_t pos = q->dequeue_position;
+
+    q->dequeue_position = pos + 1;
+
+    __atomic_store_n(&slot->sequence, pos + q->mask + 1, __ATOMIC_RELEASE);
+}
+
+bool sai_metadata_notification_queue_front(
+        _Out_ int *notification_type,
+        _Out_ void **params)
+{
+    sai_metadata_notification_queue_t *q = __atomic_load_n(&sai_metadata_notification_queue_instance, __ATOMIC_ACQUIRE);
+
+    if (q == NULL || notification_type == NULL || params == NULL)
+    {
+        return false;
+    }
+
+    sai_metadata_notification_queue_slot_t *slot;
+
+    while (sai_metadata_notification_queue_peek(q, &slot))
+    {
+        if (slot->valid)
+        {
+            *notification_type = slot->notification_type;
+            *params = slot->params;
+
+            return true;
+        }
+
+        /* dropped notification, already accounted by producer */
+
+        sai_metadata_notification_queue_release(q, slot);
+    }
+
+    return false;
+}
+
+void sai_metadata_notification_queue_pop(void)
+{
+    sai_metadata_notification_queue_t *q = __atomic_load_n(&sai_metadata_notification_queue_instance, __ATOMIC_ACQUIRE);
+
+    if (q == NULL)
+    {
+        return;
+    }
+
+    sai_metadata_notification_queue_slot_t *slot;
+
+    if (!sai_metadata_notification_queue_peek(q, &slot))
+    {
+        SAI_META_LOG_ERROR("notification queue is empty");
+        return;
+    }
+
+    SAI_METADATA_NOTIFICATION_QUEUE_INC(q, slot->notification_type, dispatched);
+
+    sai_metadata_notification_queue_release(q, slot);
+}
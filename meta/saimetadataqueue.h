@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadataqueue.h
+ *
+ * @brief   This module defines SAI Metadata Notification Queue
+ */
+
+#ifndef __SAIMETADATAQUEUE_H_
+#define __SAIMETADATAQUEUE_H_
+
+/**
+ * @defgroup SAIMETADATAQUEUE SAI - Metadata Notification Queue Definitions
+ *
+ * Notification queue allows to hand off notifications from adapter threads to
+ * application threads. Each notification payload is deep copied into
+ * preallocated slot of bounded lock-free multiple producer single consumer
+ * queue, so notification callback never blocks and never allocates memory.
+ *
+ * Auto generated sai_metadata_notification_queue_get_notifications() returns
+ * set of notification callbacks which enqueue notifications, and auto
+ * generated sai_metadata_notification_queue_dispatch() calls user provided
+ * notification callbacks on consumer thread.
+ *
+ * @{
+ */
+
+/**
+ * @brief Notification queue statistics for single notification type
+ */
+typedef struct _sai_metadata_notification_queue_stats_t
+{
+    /**
+     * @brief Number of notifications enqueued.
+     */
+    uint64_t enqueued;
+
+    /**
+     * @brief Number of notifications dispatched.
+     */
+    uint64_t dispatched;
+
+    /**
+     * @brief Number of notifications dropped since queue was full.
+     */
+    uint64_t dropped_full;
+
+    /**
+     * @brief Number of notifications dropped since payload was larger than slot size.
+     */
+    uint64_t dropped_size;
+
+    /**
+     * @brief Number of notifications dropped since payload could not be copied.
+     */
+    uint64_t dropped_unsupported;
+
+} sai_metadata_notification_queue_stats_t;
+
+/**
+ * @brief Notification queue slot slab
+ *
+ * Used by auto generated code to deep copy notification payload into reserved
+ * queue slot.
+ */
+typedef struct _sai_metadata_notification_queue_slab_t
+{
+    /**
+     * @brief Notification type, value of sai_switch_notification_type_t.
+     */
+    int notification_type;
+
+    /**
+     * @brief Reserved queue position.
+     */
+    uint64_t position;
+
+    /**
+     * @brief Slot buffer.
+     */
+    char *buffer;
+
+    /**
+     * @brief Slot buffer size.
+     */
+    size_t size;
+
+    /**
+     * @brief Number of bytes already used in buffer.
+     */
+    size_t used;
+
+    /**
+     * @brief Set to true if payload was larger than slot size.
+     */
+    bool overflow;
+
+    /**
+     * @brief Set to true if payload could not be copied.
+     */
+    bool unsupported;
+
+} sai_metadata_notification_queue_slab_t;
+
+/**
+ * @brief Initialize notification queue
+ *
+ * @param[in] slot_count Number of queue slots, must be power of 2
+ * @param[in] slot_size Size of single slot in bytes, it limits maximum notification payload size
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_notification_queue_init(
+        _In_ size_t slot_count,
+        _In_ size_t slot_size);
+
+/**
+ * @brief Uninitialize notification queue
+ *
+ * Must be called when no more notifications can arrive from adapter and
+ * consumer thread stopped dispatching. All pending notifications are dropped.
+ */
+extern void sai_metadata_notification_queue_uninit(void);
+
+/**
+ * @brief Get notification queue statistics
+ *
+ * @param[in] notification_type Notification type, value of sai_switch_notification_type_t
+ * @param[out] stats Statistics
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_notification_queue_get_stats(
+        _In_ int notification_type,
+        _Out_ sai_metadata_notification_queue_stats_t *stats);
+
+/**
+ * @brief Clear notification queue statistics for all notification types
+ */
+extern void sai_metadata_notification_queue_clear_stats(void);
+
+/**
+ * @brief Reserve queue slot for notification
+ *
+ * Can be called concurrently from multiple threads. Each successful reserve
+ * must be followed by sai_metadata_notification_queue_commit().
+ *
+ * @param[in] notification_type Notification type, value of sai_switch_notification_type_t
+ * @param[out] slab Slab describing reserved slot
+ *
+ * @return True if slot was reserved, false if queue is not initialized or full
+ */
+extern bool sai_metadata_notification_queue_reserve(
+        _In_ int notification_type,
+        _Out_ sai_metadata_notification_queue_slab_t *slab);
+
+/**
+ * @brief Allocate memory from reserved slot
+ *
+ * @param[inout] slab Slab describing reserved slot
+ * @param[in] size Number of bytes to allocate
+ *
+ * @return Pointer to allocated memory, NULL when size is zero or slot is too small
+ */
+extern void* sai_metadata_notification_queue_slab_alloc(
+        _Inout_ sai_metadata_notification_queue_slab_t *slab,
+        _In_ size_t size);
+
+/**
+ * @brief Copy memory into reserved slot
+ *
+ * @param[inout] slab Slab describing reserved slot
+ * @param[in] source Source buffer, can be NULL
+ * @param[in] size Number of bytes to copy
+ *
+ * @return Pointer to copied memory, NULL when source is NULL, size is zero or slot is too small
+ */
+extern void* sai_metadata_notification_queue_slab_dup(
+        _Inout_ sai_metadata_notification_queue_slab_t *slab,
+        _In_ const void *source,
+        _In_ size_t size);
+
+/**
+ * @brief Deep copy attribute list values into reserved slot
+ *
+ * Attribute list itself must be already copied into slot, and list values
+ * will be updated in place to point to slot memory.
+ *
+ * @param[inout] slab Slab describing reserved slot
+ * @param[in] object_type Object type of attributes
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Attribute list
+ */
+extern void sai_metadata_notification_queue_slab_copy_attr_list(
+        _Inout_ sai_metadata_notification_queue_slab_t *slab,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list);
+
+/**
+ * @brief Commit reserved slot
+ *
+ * If slab overflow or unsupported flag is set, notification is accounted as
+ * dropped and will be skipped by consumer.
+ *
+ * @param[in] slab Slab describing reserved slot
+ * @param[inout] params Notification parameters allocated in slot
+ */
+extern void sai_metadata_notification_queue_commit(
+        _In_ const sai_metadata_notification_queue_slab_t *slab,
+        _Inout_ void *params);
+
+/**
+ * @brief Get notification from queue head
+ *
+ * Must be called only from single consumer thread.
+ *
+ * @param[out] notification_type Notification type, value of sai_switch_notification_type_t
+ * @param[out] params Notification parameters
+ *
+ * @return True if notification is available, false if queue is empty
+ */
+extern bool sai_metadata_notification_queue_front(
+        _Out_ int *notification_type,
+        _Out_ void **params);
+
+/**
+ * @brief Release notification from queue head
+ *
+ * Must be called only from single consumer thread after notification
+ * obtained by sai_metadata_notification_queue_front() was processed.
+ */
+extern void sai_metadata_notification_queue_pop(void);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATAQUEUE_H_ */
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatarank.h
+ *
+ * @brief   This module defines SAI Metadata Object Type Ranks
+ */
+
+#ifndef __SAIMETADATARANK_H_
+#define __SAIMETADATARANK_H_
+
+/**
+ * @defgroup SAIMETADATARANK SAI - Metadata Object Type Rank Definitions
+ *
+ * Ranks are generated by saidepgraphgen -c into saimetadatarankdata.c from
+ * object type dependency graph, which is built from non read only object id
+ * attributes and object id members of non object id structs.
+ *
+ * Objects sorted by create rank can be created in that order, objects of the
+ * same rank don't depend on each other. Objects sorted by remove rank can be
+ * removed in that order. Switch has create rank 0 and the highest remove
+ * rank. Object types which form dependency cycle have the same rank, and
+ * references between them must be set after create (or cleared before
+ * remove). Cycles of mandatory on create or create only references fail
+ * generation.
+ *
+ * saidepgraphgen -j prints the same graph, ranks and cycles as JSON.
+ *
+ * @{
+ */
+
+/**
+ * @brief Create rank of each object type, indexed by object type
+ */
+extern const uint32_t sai_metadata_object_type_create_rank[];
+
+/**
+ * @brief Highest create rank
+ */
+extern const uint32_t sai_metadata_object_type_create_rank_max;
+
+/**
+ * @brief Remove rank of each object type, indexed by object type
+ */
+extern const uint32_t sai_metadata_object_type_remove_rank[];
+
+/**
+ * @brief Highest remove rank
+ */
+extern const uint32_t sai_metadata_object_type_remove_rank_max;
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATARANK_H_ */
@@ -0,0 +1,1234 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatarecorder.c
+ *
+ * @brief   This module defines SAI Metadata API Recorder
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime, ftruncate, pread */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+/*
+ * Log file starts with file header followed by records. Each record starts
+ * with record header followed by object key and attributes, all parts are
+ * aligned to 8 bytes, so record can be decoded directly from mapped memory.
+ *
+ * Writer reserves space for whole record (or all records of bulk call) by
+ * atomic increment of used size, and writes record size as last field, so
+ * zero record size marks end of log.
+ */
+
+#define SAI_METADATA_RECORDER_VERSION 1
+
+#define SAI_METADATA_RECORDER_ALIGN 8
+
+#define SAI_METADATA_RECORDER_ALIGN_SIZE(size) \
+    (((size) + SAI_METADATA_RECORDER_ALIGN - 1) & ~((size_t)SAI_METADATA_RECORDER_ALIGN - 1))
+
+#define SAI_METADATA_RECORDER_READER_BLOCK_SIZE 4096
+
+typedef struct _sai_metadata_recorder_file_header_t
+{
+    uint64_t magic;
+
+    uint32_t version;
+
+    uint32_t header_size;
+
+} sai_metadata_recorder_file_header_t;
+
+typedef struct _sai_metadata_recorder_record_header_t
+{
+    uint32_t size;
+
+    uint8_t op;
+
+    uint8_t bulk_mode;
+
+    uint16_t key_size;
+
+    int32_t object_type;
+
+    int32_t status;
+
+    uint32_t attr_count;
+
+    uint32_t bulk_count;
+
+    uint64_t timestamp;
+
+    uint64_t switch_id;
+
+} sai_metadata_recorder_record_header_t;
+
+typedef struct _sai_metadata_recorder_attr_header_t
+{
+    uint32_t id;
+
+    /*
+     * Size of encoded value including lists, zero when value was not
+     * recorded, for example for get which failed.
+     */
+
+    uint32_t size;
+
+} sai_metadata_recorder_attr_header_t;
+
+typedef struct _sai_metadata_recorder_t
+{
+    int fd;
+
+    uint8_t *data;
+
+    size_t capacity;
+
+    size_t header_size;
+
+    uint64_t used;
+
+    uint64_t records;
+
+    uint64_t dropped;
+
+} sai_metadata_recorder_t;
+
+typedef enum _sai_metadata_recorder_mode_t
+{
+    SAI_METADATA_RECORDER_MODE_SIZE,
+
+    SAI_METADATA_RECORDER_MODE_ENCODE,
+
+    SAI_METADATA_RECORDER_MODE_DECODE,
+
+} sai_metadata_recorder_mode_t;
+
+/*
+ * Same code path is used to calculate record size and to encode record, so
+ * both always agree on record layout.
+ */
+
+typedef struct _sai_metadata_recorder_buffer_t
+{
+    sai_metadata_recorder_mode_t mode;
+
+    uint8_t *data;
+
+    size_t size;
+
+    size_t used;
+
+    bool error;
+
+} sai_metadata_recorder_buffer_t;
+
+sai_metadata_recorder_t *sai_metadata_recorder_instance = NULL;
+
+static uint64_t sai_metadata_recorder_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void* sai_metadata_recorder_put(
+        _Inout_ sai_metadata_recorder_buffer_t *buffer,
+        _In_ const void *source,
+        _In_ size_t size)
+{
+    size_t aligned = SAI_METADATA_RECORDER_ALIGN_SIZE(size);
+
+    void *ptr = NULL;
+
+    if (buffer->mode == SAI_METADATA_RECORDER_MODE_ENCODE)
+    {
+        ptr = buffer->data + buffer->used;
+
+        memcpy(ptr, source, size);
+        memset((uint8_t*)ptr + size, 0, aligned - size);
+    }
+
+    buffer->used += aligned;
+
+    return ptr;
+}
+
+static void* sai_metadata_recorder_list(
+        _Inout_ sai_metadata_recorder_buffer_t *buffer,
+        _In_ void *list,
+        _In_ size_t size)
+{
+    /*
+     * Encoded value keeps original list pointer, so decoder knows whether
+     * list was NULL, and list elements follow value.
+     */
+
+    if (list == NULL)
+    {
+        return NULL;
+    }
+
+    if (buffer->mode != SAI_METADATA_RECORDER_MODE_DECODE)
+    {
+        sai_metadata_recorder_put(buffer, list, size);
+
+        return list;
+    }
+
+    size_t aligned = SAI_METADATA_RECORDER_ALIGN_SIZE(size);
+
+    if (size > buffer->size || aligned > buffer->size - buffer->used)
+    {
+        buffer->error = true;
+        return NULL;
+    }
+
+    void *ptr = buffer->data + buffer->used;
+
+    buffer->used += aligned;
+
+    return ptr;
+}
+
+#define SAI_METADATA_RECORDER_LIST(buffer, lst) \
+    (lst).list = sai_metadata_recorder_list((buffer), (lst).list, (size_t)(lst).count * sizeof(*(lst).list))
+
+static bool sai_metadata_recorder_lists(
+        _Inout_ sai_metadata_recorder_buffer_t *buffer,
+        _In_ const sai_attr_metadata_t *md,
+        _Inout_ sai_attribute_value_t *value)
+{
+    switch (md->attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->objlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->u8list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_INT8_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->s8list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->u16list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_INT16_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->s16list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->u32list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_INT32_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->s32list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_UINT16_RANGE_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->u16rangelist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_VLAN_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->vlanlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_QOS_MAP_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->qosmap);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_MAP_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->maplist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_RESOURCE_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->aclresource);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_TLV_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->tlvlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_SEGMENT_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->segmentlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->ipaddrlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_IP_PREFIX_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->ipprefixlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_PORT_EYE_VALUES_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->porteyevalues);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_SYSTEM_PORT_CONFIG_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->sysportconfiglist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_PORT_ERR_STATUS_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->porterror);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_PORT_LANE_LATCH_STATUS_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->portlanelatchstatuslist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_CHAIN_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->aclchainlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_PORT_FREQUENCY_OFFSET_PPM_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->portfrequencyoffsetppmlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_PORT_SNR_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->portsnrlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_JSON:
+            SAI_METADATA_RECORDER_LIST(buffer, value->json.json);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_CAPABILITY:
+            SAI_METADATA_RECORDER_LIST(buffer, value->aclcapability.action_list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->aclfield.data.objlist);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->aclfield.mask.u8list);
+            SAI_METADATA_RECORDER_LIST(buffer, value->aclfield.data.u8list);
+            return true;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            SAI_METADATA_RECORDER_LIST(buffer, value->aclaction.parameter.objlist);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static size_t sai_metadata_recorder_value_size(
+        _In_ const sai_attr_metadata_t *md,
+        _In_ const sai_attribute_value_t *value)
+{
+    /*
+     * Union members start at value beginning, so primitive values of common
+     * types are stored using only size of their member.
+     */
+
+    switch (md->attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_BOOL:
+            return sizeof(value->booldata);
+
+        case SAI_ATTR_VALUE_TYPE_CHARDATA:
+            return sizeof(value->chardata);
+
+        case SAI_ATTR_VALUE_TYPE_UINT8:
+        case SAI_ATTR_VALUE_TYPE_INT8:
+            return sizeof(value->u8);
+
+        case SAI_ATTR_VALUE_TYPE_UINT16:
+        case SAI_ATTR_VALUE_TYPE_INT16:
+            return sizeof(value->u16);
+
+        case SAI_ATTR_VALUE_TYPE_UINT32:
+        case SAI_ATTR_VALUE_TYPE_INT32:
+            return sizeof(value->u32);
+
+        case SAI_ATTR_VALUE_TYPE_UINT64:
+        case SAI_ATTR_VALUE_TYPE_INT64:
+            return sizeof(value->u64);
+
+        case SAI_ATTR_VALUE_TYPE_POINTER:
+            return sizeof(value->ptr);
+
+        case SAI_ATTR_VALUE_TYPE_MAC:
+            return sizeof(value->mac);
+
+        case SAI_ATTR_VALUE_TYPE_IPV4:
+            return sizeof(value->ip4);
+
+        case SAI_ATTR_VALUE_TYPE_IPV6:
+            return sizeof(value->ip6);
+
+        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
+            return sizeof(value->ipaddr);
+
+        case SAI_ATTR_VALUE_TYPE_IP_PREFIX:
+            return sizeof(value->ipprefix);
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+            return sizeof(value->oid);
+
+        case SAI_ATTR_VALUE_TYPE_UINT32_RANGE:
+        case SAI_ATTR_VALUE_TYPE_INT32_RANGE:
+            return sizeof(value->u32range);
+
+        default:
+            return sizeof(*value);
+    }
+}
+
+static size_t sai_metadata_recorder_key_size(
+        _In_ const sai_object_type_info_t *info)
+{
+    if (info->isobjectid)
+    {
+        return sizeof(sai_object_id_t);
+    }
+
+    size_t size = 0;
+    size_t idx = 0;
+
+    for (; idx < info->structmemberscount; idx++)
+    {
+        const sai_struct_member_info_t *m = info->structmembers[idx];
+
+        if (m->offset + m->size > size)
+        {
+            size = m->offset + m->size;
+        }
+    }
+
+    return size;
+}
+
+static void sai_metadata_recorder_encode_value(
+        _Inout_ sai_metadata_recorder_buffer_t *buffer,
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *attr)
+{
+    const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(object_type, attr->id);
+
+    if (md == NULL)
+    {
+        return;
+    }
+
+    if (md->isprimitive)
+    {
+        sai_metadata_recorder_put(buffer, &attr->value, sai_metadata_recorder_value_size(md, &attr->value));
+        return;
+    }
+
+    sai_attribute_value_t value = attr->value;
+
+    sai_metadata_recorder_buffer_t probe;
+
+    memset(&probe, 0, sizeof(probe));
+
+    probe.mode = SAI_METADATA_RECORDER_MODE_SIZE;
+
+    if (!sai_metadata_recorder_lists(&probe, md, &value))
+    {
+        /* value can't be encoded, record only attribute id */
+        return;
+    }
+
+    if (buffer->mode == SAI_METADATA_RECORDER_MODE_SIZE)
+    {
+        buffer->used += SAI_METADATA_RECORDER_ALIGN_SIZE(sizeof(value)) + probe.used;
+        return;
+    }
+
+    sai_metadata_recorder_put(buffer, &attr->value, sizeof(value));
+
+    sai_metadata_recorder_lists(buffer, md, &value);
+}
+
+static void sai_metadata_recorder_encode(
+        _Inout_ sai_metadata_recorder_buffer_t *buffer,
+        _In_ const sai_metadata_recorder_record_header_t *header,
+        _In_ const void *key,
+        _In_ const sai_attribute_t *attr_list)
+{
+    size_t start = buffer->used;
+
+    sai_metadata_recorder_record_header_t *rh = sai_metadata_recorder_put(buffer, header, sizeof(*header));
+
+    sai_metadata_recorder_put(buffer, key, header->key_size);
+
+    bool values = header->op != SAI_METADATA_RECORDER_OP_GET || header->status == SAI_STATUS_SUCCESS;
+
+    uint32_t idx = 0;
+
+    for (; idx < header->attr_count; idx++)
+    {
+        sai_metadata_recorder_attr_header_t ah;
+
+        ah.id = attr_list[idx].id;
+        ah.size = 0;
+
+        sai_metadata_recorder_attr_header_t *pah = sai_metadata_recorder_put(buffer, &ah, sizeof(ah));
+
+        size_t value_start = buffer->used;
+
+        if (values)
+        {
+            sai_metadata_recorder_encode_value(buffer, header->object_type, &attr_list[idx]);
+        }
+
+        if (pah != NULL)
+        {
+            pah->size = (uint32_t)(buffer->used - value_start);
+        }
+    }
+
+    if (rh != NULL)
+    {
+        __atomic_store_n(&rh->size, (uint32_t)(buffer->used - start), __ATOMIC_RELEASE);
+    }
+}
+
+static uint8_t* sai_metadata_recorder_reserve(
+        _Inout_ sai_metadata_recorder_t *rec,
+        _In_ size_t size,
+        _In_ uint32_t object_count)
+{
+    if (size > UINT32_MAX)
+    {
+        __atomic_fetch_add(&rec->dropped, object_count, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    uint64_t offset = __atomic_fetch_add(&rec->used, size, __ATOMIC_RELAXED);
+
+    if (offset + size > rec->capacity)
+    {
+        __atomic_fetch_add(&rec->dropped, object_count, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    __atomic_fetch_add(&rec->records, object_count, __ATOMIC_RELAXED);
+
+    return rec->data + offset;
+}
+
+void sai_metadata_recorder_record(
+        _In_ sai_metadata_recorder_op_t op,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ sai_object_id_t switch_id,
+        _In_ sai_status_t status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    sai_metadata_recorder_t *rec = __atomic_load_n(&sai_metadata_recorder_instance, __ATOMIC_ACQUIRE);
+
+    if (rec == NULL || meta_key == NULL)
+    {
+        return;
+    }
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL)
+    {
+        return;
+    }
+
+    sai_metadata_recorder_record_header_t header;
+
+    memset(&header, 0, sizeof(header));
+
+    header.op = (uint8_t)op;
+    header.key_size = (uint16_t)sai_metadata_recorder_key_size(info);
+    header.object_type = meta_key->objecttype;
+    header.status = status;
+    header.attr_count = (attr_list == NULL) ? 0 : attr_count;
+    header.timestamp = sai_metadata_recorder_now();
+    header.switch_id = switch_id;
+
+    sai_metadata_recorder_buffer_t buffer;
+
+    memset(&buffer, 0, sizeof(buffer));
+
+    buffer.mode = SAI_METADATA_RECORDER_MODE_SIZE;
+
+    sai_metadata_recorder_encode(&buffer, &header, &meta_key->objectkey.key, attr_list);
+
+    buffer.data = sai_metadata_recorder_reserve(rec, buffer.used, 1);
+
+    if (buffer.data == NULL)
+    {
+        return;
+    }
+
+    buffer.mode = SAI_METADATA_RECORDER_MODE_ENCODE;
+    buffer.size = buffer.used;
+    buffer.used = 0;
+
+    sai_metadata_recorder_encode(&buffer, &header, &meta_key->objectkey.key, attr_list);
+}
+
+static void sai_metadata_recorder_encode_bulk(
+        _Inout_ sai_metadata_recorder_buffer_t *buffer,
+        _Inout_ sai_metadata_recorder_record_header_t *header,
+        _In_ const uint8_t *object_key,
+        _In_ size_t key_size,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ const sai_attribute_t *attr,
+        _In_ const sai_status_t *object_statuses)
+{
+    uint32_t idx = 0;
+
+    for (; idx < header->bulk_count; idx++)
+    {
+        const sai_attribute_t *list = NULL;
+
+        header->status = object_statuses[idx];
+        header->attr_count = 0;
+
+        if (attr != NULL)
+        {
+            list = &attr[idx];
+            header->attr_count = 1;
+        }
+        else if (attr_count != NULL && attr_list != NULL && attr_list[idx] != NULL)
+        {
+            list = attr_list[idx];
+            header->attr_count = attr_count[idx];
+        }
+
+        sai_metadata_recorder_encode(buffer, header, object_key + idx * key_size, list);
+    }
+}
+
+void sai_metadata_recorder_record_bulk(
+        _In_ sai_metadata_recorder_op_t op,
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const void *object_key,
+        _In_ size_t key_size,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ const sai_attribute_t *attr,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _In_ const sai_status_t *object_statuses)
+{
+    sai_metadata_recorder_t *rec = __atomic_load_n(&sai_metadata_recorder_instance, __ATOMIC_ACQUIRE);
+
+    if (rec == NULL || object_count == 0 || object_key == NULL || object_statuses == NULL)
+    {
+        return;
+    }
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(object_type);
+
+    if (info == NULL)
+    {
+        return;
+    }
+
+    size_t encoded_key_size = sai_metadata_recorder_key_size(info);
+
+    sai_metadata_recorder_record_header_t header;
+
+    memset(&header, 0, sizeof(header));
+
+    header.op = (uint8_t)op;
+    header.bulk_mode = (uint8_t)mode;
+    header.key_size = (uint16_t)(encoded_key_size < key_size ? encoded_key_size : key_size);
+    header.object_type = object_type;
+    header.bulk_count = object_count;
+    header.timestamp = sai_metadata_recorder_now();
+    header.switch_id = switch_id;
+
+    sai_metadata_recorder_buffer_t buffer;
+
+    memset(&buffer, 0, sizeof(buffer));
+
+    buffer.mode = SAI_METADATA_RECORDER_MODE_SIZE;
+
+    sai_metadata_recorder_encode_bulk(&buffer, &header, object_key, key_size, attr_count, attr_list, attr, object_statuses);
+
+    buffer.data = sai_metadata_recorder_reserve(rec, buffer.used, object_count);
+
+    if (buffer.data == NULL)
+    {
+        return;
+    }
+
+    buffer.mode = SAI_METADATA_RECORDER_MODE_ENCODE;
+    buffer.size = buffer.used;
+    buffer.used = 0;
+
+    sai_metadata_recorder_encode_bulk(&buffer, &header, object_key, key_size, attr_count, attr_list, attr, object_statuses);
+}
+
+static bool sai_metadata_recorder_check_file_header(
+        _In_ const sai_metadata_recorder_file_header_t *fh,
+        _In_ size_t size)
+{
+    return fh->magic == SAI_METADATA_RECORDER_MAGIC &&
+        fh->version == SAI_METADATA_RECORDER_VERSION &&
+        fh->header_size >= sizeof(*fh) &&
+        fh->header_size <= size &&
+        fh->header_size % SAI_METADATA_RECORDER_ALIGN == 0;
+}
+
+static size_t sai_metadata_recorder_find_end(
+        _In_ const uint8_t *data,
+        _In_ size_t size,
+        _In_ size_t offset)
+{
+    while (offset + sizeof(sai_metadata_recorder_record_header_t) <= size)
+    {
+        const sai_metadata_recorder_record_header_t *rh = (const sai_metadata_recorder_record_header_t*)(data + offset);
+
+        if (rh->size < sizeof(*rh) || rh->size % SAI_METADATA_RECORDER_ALIGN || rh->size > size - offset)
+        {
+            break;
+        }
+
+        offset += rh->size;
+    }
+
+    return offset;
+}
+
+sai_status_t sai_metadata_recorder_open(
+        _In_ const char *path,
+        _In_ size_t capacity)
+{
+    sai_metadata_recorder_file_header_t fh;
+
+    if (path == NULL || capacity < sizeof(fh))
+    {
+        SAI_META_LOG_ERROR("invalid parameter");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (__atomic_load_n(&sai_metadata_recorder_instance, __ATOMIC_ACQUIRE) != NULL)
+    {
+        SAI_META_LOG_ERROR("recorder is already open");
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0)
+    {
+        SAI_META_LOG_ERROR("failed to open %s: %s", path, strerror(errno));
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0)
+    {
+        SAI_META_LOG_ERROR("failed to stat %s: %s", path, strerror(errno));
+
+        close(fd);
+        return SAI_STATUS_FAILURE;
+    }
+
+    size_t existing = (size_t)st.st_size;
+
+    if (existing != 0)
+    {
+        /* check header before file is resized, so other files are not damaged */
+
+        if (existing < sizeof(fh) ||
+                pread(fd, &fh, sizeof(fh), 0) != (ssize_t)sizeof(fh) ||
+                !sai_metadata_recorder_check_file_header(&fh, existing))
+        {
+            SAI_META_LOG_ERROR("file %s is not recorder log", path);
+
+            close(fd);
+            return SAI_STATUS_FAILURE;
+        }
+    }
+    else
+    {
+        fh.magic = SAI_METADATA_RECORDER_MAGIC;
+        fh.version = SAI_METADATA_RECORDER_VERSION;
+        fh.header_size = (uint32_t)sizeof(fh);
+    }
+
+    if (capacity < existing)
+    {
+        capacity = existing;
+    }
+
+    if (ftruncate(fd, (off_t)capacity) != 0)
+    {
+        SAI_META_LOG_ERROR("failed to resize %s: %s", path, strerror(errno));
+
+        close(fd);
+        return SAI_STATUS_FAILURE;
+    }
+
+    void *data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    sai_metadata_recorder_t *rec = calloc(1, sizeof(sai_metadata_recorder_t));
+
+    if (data == MAP_FAILED || rec == NULL)
+    {
+        SAI_META_LOG_ERROR("failed to map %s: %s", path, strerror(errno));
+
+        if (data != MAP_FAILED)
+        {
+            munmap(data, capacity);
+        }
+
+        free(rec);
+
+        if (ftruncate(fd, (off_t)existing) != 0)
+        {
+            SAI_META_LOG_WARN("failed to restore size of %s", path);
+        }
+
+        close(fd);
+        return SAI_STATUS_FAILURE;
+    }
+
+    rec->fd = fd;
+    rec->data = data;
+    rec->capacity = capacity;
+    rec->header_size = fh.header_size;
+
+    if (existing == 0)
+    {
+        memcpy(rec->data, &fh, sizeof(fh));
+
+        rec->used = fh.header_size;
+    }
+    else
+    {
+        rec->used = sai_metadata_recorder_find_end(rec->data, existing, fh.header_size);
+    }
+
+    __atomic_store_n(&sai_metadata_recorder_instance, rec, __ATOMIC_RELEASE);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_metadata_recorder_close(void)
+{
+    sai_metadata_recorder_t *rec = __atomic_exchange_n(&sai_metadata_recorder_instance, NULL, __ATOMIC_ACQ_REL);
+
+    if (rec == NULL)
+    {
+        SAI_META_LOG_ERROR("recorder is not open");
+
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    size_t size = (rec->used <= rec->capacity)
+        ? (size_t)rec->used
+        : sai_metadata_recorder_find_end(rec->data, rec->capacity, rec->header_size);
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    if (msync(rec->data, size, MS_SYNC) != 0)
+    {
+        SAI_META_LOG_ERROR("failed to sync log: %s", strerror(errno));
+
+        status = SAI_STATUS_FAILURE;
+    }
+
+    munmap(rec->data, rec->capacity);
+
+    if (ftruncate(rec->fd, (off_t)size) != 0)
+    {
+        SAI_META_LOG_ERROR("failed to truncate log: %s", strerror(errno));
+
+        status = SAI_STATUS_FAILURE;
+    }
+
+    close(rec->fd);
+
+    free(rec);
+
+    return status;
+}
+
+sai_status_t sai_metadata_recorder_get_stats(
+        _Out_ sai_metadata_recorder_stats_t *stats)
+{
+    sai_metadata_recorder_t *rec = __atomic_load_n(&sai_metadata_recorder_instance, __ATOMIC_ACQUIRE);
+
+    if (stats == NULL)
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (rec == NULL)
+    {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    uint64_t used = __atomic_load_n(&rec->used, __ATOMIC_RELAXED);
+
+    stats->records = __atomic_load_n(&rec->records, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&rec->dropped, __ATOMIC_RELAXED);
+    stats->bytes = (used < rec->capacity) ? used : rec->capacity;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_metadata_recorder_reader_open(
+        _In_ const char *path,
+        _Out_ sai_metadata_recorder_reader_t *reader)
+{
+    if (path == NULL || reader == NULL)
+    {
+        SAI_META_LOG_ERROR("invalid parameter");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(reader, 0, sizeof(sai_metadata_recorder_reader_t));
+
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        SAI_META_LOG_ERROR("failed to open %s: %s", path, strerror(errno));
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(sai_metadata_recorder_file_header_t))
+    {
+        SAI_META_LOG_ERROR("file %s is not recorder log", path);
+
+        close(fd);
+        return SAI_STATUS_FAILURE;
+    }
+
+    size_t size = (size_t)st.st_size;
+
+    /*
+     * Private writable mapping allows decoded lists to be used as output
+     * buffers, for example when get is replayed, without modifying file.
+     */
+
+    void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        SAI_META_LOG_ERROR("failed to map %s: %s", path, strerror(errno));
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    const sai_metadata_recorder_file_header_t *fh = data;
+
+    if (!sai_metadata_recorder_check_file_header(fh, size))
+    {
+        SAI_META_LOG_ERROR("file %s is not recorder log", path);
+
+        munmap(data, size);
+        return SAI_STATUS_FAILURE;
+    }
+
+    reader->data = data;
+    reader->size = size;
+    reader->offset = fh->header_size;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_attribute_t* sai_metadata_recorder_reader_alloc(
+        _Inout_ sai_metadata_recorder_reader_t *reader,
+        _In_ size_t count)
+{
+    if (count > reader->attrs_size - reader->attrs_used)
+    {
+        size_t size = (count > SAI_METADATA_RECORDER_READER_BLOCK_SIZE) ? count : SAI_METADATA_RECORDER_READER_BLOCK_SIZE;
+
+        sai_attribute_t *attrs = calloc(size, sizeof(sai_attribute_t));
+
+        if (attrs == NULL)
+        {
+            return NULL;
+        }
+
+        if (reader->attrs != NULL)
+        {
+            /* previous block may still be referenced by decoded records */
+
+            sai_attribute_t **blocks = realloc(reader->blocks, (reader->block_count + 1) * sizeof(sai_attribute_t*));
+
+            if (blocks == NULL)
+            {
+                free(attrs);
+                return NULL;
+            }
+
+            blocks[reader->block_count++] = reader->attrs;
+
+            reader->blocks = blocks;
+        }
+
+        reader->attrs = attrs;
+        reader->attrs_size = size;
+        reader->attrs_used = 0;
+    }
+
+    sai_attribute_t *ptr = reader->attrs + reader->attrs_used;
+
+    reader->attrs_used += count;
+
+    return ptr;
+}
+
+static bool sai_metadata_recorder_decode_value(
+        _In_ sai_object_type_t object_type,
+        _In_ uint8_t *data,
+        _In_ size_t size,
+        _Inout_ sai_attribute_t *attr)
+{
+    memset(&attr->value, 0, sizeof(attr->value));
+
+    if (size == 0)
+    {
+        return true;
+    }
+
+    const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(object_type, attr->id);
+
+    if (md == NULL)
+    {
+        return false;
+    }
+
+    if (md->isprimitive)
+    {
+        size_t value_size = sai_metadata_recorder_value_size(md, &attr->value);
+
+        if (value_size > size)
+        {
+            return false;
+        }
+
+        memcpy(&attr->value, data, value_size);
+
+        return true;
+    }
+
+    if (sizeof(attr->value) > size)
+    {
+        return false;
+    }
+
+    memcpy(&attr->value, data, sizeof(attr->value));
+
+    sai_metadata_recorder_buffer_t buffer;
+
+    buffer.mode = SAI_METADATA_RECORDER_MODE_DECODE;
+    buffer.data = data;
+    buffer.size = size;
+    buffer.used = SAI_METADATA_RECORDER_ALIGN_SIZE(sizeof(attr->value));
+    buffer.error = false;
+
+    return sai_metadata_recorder_lists(&buffer, md, &attr->value) && !buffer.error;
+}
+
+static bool sai_metadata_recorder_decode(
+        _Inout_ sai_metadata_recorder_reader_t *reader,
+        _In_ uint8_t *data,
+        _In_ size_t size,
+        _Out_ sai_metadata_recorder_record_t *record)
+{
+    const sai_metadata_recorder_record_header_t *rh = (const sai_metadata_recorder_record_header_t*)data;
+
+    size_t pos = SAI_METADATA_RECORDER_ALIGN_SIZE(sizeof(*rh));
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(rh->object_type);
+
+    if (size < pos || size % SAI_METADATA_RECORDER_ALIGN || size != rh->size ||
+            info == NULL || rh->key_size > sizeof(record->meta_key.objectkey.key) ||
+            SAI_METADATA_RECORDER_ALIGN_SIZE((size_t)rh->key_size) > size - pos ||
+            rh->attr_count > (size - pos) / sizeof(sai_metadata_recorder_attr_header_t))
+    {
+        return false;
+    }
+
+    memset(record, 0, sizeof(sai_metadata_recorder_record_t));
+
+    record->op = (sai_metadata_recorder_op_t)rh->op;
+    record->status = rh->status;
+    record->timestamp = rh->timestamp;
+    record->switch_id = rh->switch_id;
+    record->meta_key.objecttype = info->objecttype;
+    record->bulk_count = rh->bulk_count;
+    record->bulk_mode = (sai_bulk_op_error_mode_t)rh->bulk_mode;
+    record->attr_count = rh->attr_count;
+
+    memcpy(&record->meta_key.objectkey.key, data + pos, rh->key_size);
+
+    pos += SAI_METADATA_RECORDER_ALIGN_SIZE((size_t)rh->key_size);
+
+    if (rh->attr_count != 0)
+    {
+        record->attr_list = sai_metadata_recorder_reader_alloc(reader, rh->attr_count);
+
+        if (record->attr_list == NULL)
+        {
+            SAI_META_LOG_ERROR("failed to allocate %u attributes", rh->attr_count);
+
+            return false;
+        }
+    }
+
+    uint32_t idx = 0;
+
+    for (; idx < rh->attr_count; idx++)
+    {
+        if (sizeof(sai_metadata_recorder_attr_header_t) > size - pos)
+        {
+            return false;
+        }
+
+        const sai_metadata_recorder_attr_header_t *ah = (const sai_metadata_recorder_attr_header_t*)(data + pos);
+
+        pos += sizeof(*ah);
+
+        if (SAI_METADATA_RECORDER_ALIGN_SIZE((size_t)ah->size) > size - pos)
+        {
+            return false;
+        }
+
+        record->attr_list[idx].id = ah->id;
+
+        if (!sai_metadata_recorder_decode_value(info->objecttype, data + pos, ah->size, &record->attr_list[idx]))
+        {
+            return false;
+        }
+
+        pos += SAI_METADATA_RECORDER_ALIGN_SIZE((size_t)ah->size);
+    }
+
+    return true;
+}
+
+sai_status_t sai_metadata_recorder_reader_next(
+        _Inout_ sai_metadata_recorder_reader_t *reader,
+        _Out_ sai_metadata_recorder_record_t *record)
+{
+    if (reader == NULL || reader->data == NULL || record == NULL)
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (sizeof(sai_metadata_recorder_record_header_t) > reader->size - reader->offset)
+    {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    uint8_t *data = reader->data + reader->offset;
+
+    size_t size = ((const sai_metadata_recorder_record_header_t*)data)->size;
+
+    if (size == 0)
+    {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if (size > reader->size - reader->offset ||
+            !sai_metadata_recorder_decode(reader, data, size, record))
+    {
+        SAI_META_LOG_ERROR("corrupted record at offset %" PRIu64, (uint64_t)reader->offset);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    reader->offset += size;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_recorder_reader_release(
+        _Inout_ sai_metadata_recorder_reader_t *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+
+    size_t idx = 0;
+
+    for (; idx < reader->block_count; idx++)
+    {
+        free(reader->blocks[idx]);
+    }
+
+    free(reader->blocks);
+
+    reader->blocks = NULL;
+    reader->block_count = 0;
+    reader->attrs_used = 0;
+}
+
+void sai_metadata_recorder_reader_close(
+        _Inout_ sai_metadata_recorder_reader_t *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+
+    sai_metadata_recorder_reader_release(reader);
+
+    free(reader->attrs);
+
+    if (reader->data != NULL)
+    {
+        munmap(reader->data, reader->size);
+    }
+
+    memset(reader, 0, sizeof(sai_metadata_recorder_reader_t));
+}
@@ -0,0 +1,345 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatarecorder.h
+ *
+ * @brief   This module defines SAI Metadata API Recorder
+ */
+
+#ifndef __SAIMETADATARECORDER_H_
+#define __SAIMETADATARECORDER_H_
+
+/**
+ * @defgroup SAIMETADATARECORDER SAI - Metadata API Recorder Definitions
+ *
+ * Auto generated sai_metadata_recorder_apis_wrap() and
+ * sai_metadata_recorder_api_wrap() replace API method tables obtained from
+ * sai_api_query() with tables of wrappers. Each wrapper calls vendor
+ * function and appends record of the call (operation, object type, object
+ * key, attributes, status and time stamp) to binary log file.
+ *
+ * Log file is memory mapped and records are appended without locks, so
+ * calls can be recorded concurrently from multiple threads. Attribute values
+ * are encoded using attribute metadata, primitive values take only size of
+ * their type and lists are stored inline after the value.
+ *
+ * Bulk calls are recorded as consecutive records, one for each object.
+ *
+ * Only create, remove, set and get functions of objects and their bulk
+ * variants are wrapped. Other members of API tables, like get and clear
+ * stats, flush FDB entries or send host interface packet, call vendor
+ * directly and are not recorded, so log holds object state changes and
+ * queries, not complete sequence of calls made by application.
+ *
+ * @{
+ */
+
+/**
+ * @brief Log file magic, "SAIREC" followed by format version
+ */
+#define SAI_METADATA_RECORDER_MAGIC 0x3130434552494153ULL
+
+/**
+ * @brief Default log file capacity in bytes
+ *
+ * File is created as sparse file, so only used part takes disk space.
+ */
+#define SAI_METADATA_RECORDER_DEFAULT_CAPACITY (1ULL << 32)
+
+/**
+ * @brief Recorded operation
+ */
+typedef enum _sai_metadata_recorder_op_t
+{
+    /**
+     * @brief Create object
+     */
+    SAI_METADATA_RECORDER_OP_CREATE,
+
+    /**
+     * @brief Remove object
+     */
+    SAI_METADATA_RECORDER_OP_REMOVE,
+
+    /**
+     * @brief Set object attribute
+     */
+    SAI_METADATA_RECORDER_OP_SET,
+
+    /**
+     * @brief Get object attributes
+     */
+    SAI_METADATA_RECORDER_OP_GET,
+
+} sai_metadata_recorder_op_t;
+
+/**
+ * @brief Recorder statistics
+ */
+typedef struct _sai_metadata_recorder_stats_t
+{
+    /**
+     * @brief Number of recorded calls.
+     */
+    uint64_t records;
+
+    /**
+     * @brief Number of calls not recorded since log file was full.
+     */
+    uint64_t dropped;
+
+    /**
+     * @brief Number of bytes used in log file.
+     */
+    uint64_t bytes;
+
+} sai_metadata_recorder_stats_t;
+
+/**
+ * @brief Decoded log record
+ */
+typedef struct _sai_metadata_recorder_record_t
+{
+    /**
+     * @brief Recorded operation.
+     */
+    sai_metadata_recorder_op_t op;
+
+    /**
+     * @brief Status returned by vendor function.
+     */
+    sai_status_t status;
+
+    /**
+     * @brief Wall clock time of the call in nanoseconds.
+     */
+    uint64_t timestamp;
+
+    /**
+     * @brief Switch id passed to create, SAI_NULL_OBJECT_ID for other operations.
+     */
+    sai_object_id_t switch_id;
+
+    /**
+     * @brief Object type and key, for create of object id object this is created object id.
+     */
+    sai_object_meta_key_t meta_key;
+
+    /**
+     * @brief Number of objects in bulk call, zero if call was not bulk.
+     */
+    uint32_t bulk_count;
+
+    /**
+     * @brief Bulk operation error mode, valid if bulk count is not zero.
+     */
+    sai_bulk_op_error_mode_t bulk_mode;
+
+    /**
+     * @brief Number of attributes.
+     */
+    uint32_t attr_count;
+
+    /**
+     * @brief Attributes, for get these are values returned by vendor if status was success.
+     */
+    sai_attribute_t *attr_list;
+
+} sai_metadata_recorder_record_t;
+
+/**
+ * @brief Log file reader
+ *
+ * Decoded attributes point into reader memory and are valid until
+ * sai_metadata_recorder_reader_release() or sai_metadata_recorder_reader_close()
+ * is called, so multiple records can be decoded and kept at the same time.
+ */
+typedef struct _sai_metadata_recorder_reader_t
+{
+    /**
+     * @brief Mapped log file.
+     */
+    uint8_t *data;
+
+    /**
+     * @brief Size of mapped log file.
+     */
+    size_t size;
+
+    /**
+     * @brief Offset of next record.
+     */
+    size_t offset;
+
+    /**
+     * @brief Current block of decoded attributes.
+     */
+    sai_attribute_t *attrs;
+
+    /**
+     * @brief Capacity of current block of decoded attributes.
+     */
+    size_t attrs_size;
+
+    /**
+     * @brief Number of used attributes in current block.
+     */
+    size_t attrs_used;
+
+    /**
+     * @brief Previous blocks of decoded attributes, freed on release.
+     */
+    sai_attribute_t **blocks;
+
+    /**
+     * @brief Number of previous blocks.
+     */
+    size_t block_count;
+
+} sai_metadata_recorder_reader_t;
+
+/**
+ * @brief Open log file and start recording
+ *
+ * If file already contains records, new records are appended after them.
+ *
+ * @param[in] path Log file path
+ * @param[in] capacity Maximum size of log file in bytes
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_recorder_open(
+        _In_ const char *path,
+        _In_ size_t capacity);
+
+/**
+ * @brief Stop recording and close log file
+ *
+ * Must not be called while recorded API calls are in progress.
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_recorder_close(void);
+
+/**
+ * @brief Record single API call
+ *
+ * Used by auto generated wrappers, does nothing when recorder is not open.
+ *
+ * @param[in] op Operation
+ * @param[in] meta_key Object type and key
+ * @param[in] switch_id Switch id passed to create
+ * @param[in] status Status returned by vendor function
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Attributes
+ */
+extern void sai_metadata_recorder_record(
+        _In_ sai_metadata_recorder_op_t op,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ sai_object_id_t switch_id,
+        _In_ sai_status_t status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
+/**
+ * @brief Record bulk API call
+ *
+ * Used by auto generated wrappers, does nothing when recorder is not open.
+ * Records of all objects are appended to log as single block.
+ *
+ * @param[in] op Operation
+ * @param[in] object_type Object type
+ * @param[in] switch_id Switch id passed to create
+ * @param[in] object_count Number of objects
+ * @param[in] object_key Array of object ids or entries of object type
+ * @param[in] key_size Size of single element of object key array
+ * @param[in] attr_count Number of attributes of each object, NULL for remove and set
+ * @param[in] attr_list Attributes of each object, NULL for remove and set
+ * @param[in] attr Attribute of each object for set, NULL otherwise
+ * @param[in] mode Bulk operation error mode
+ * @param[in] object_statuses Status of each object returned by vendor function
+ */
+extern void sai_metadata_recorder_record_bulk(
+        _In_ sai_metadata_recorder_op_t op,
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const void *object_key,
+        _In_ size_t key_size,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ const sai_attribute_t *attr,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _In_ const sai_status_t *object_statuses);
+
+/**
+ * @brief Get recorder statistics
+ *
+ * @param[out] stats Recorder statistics
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_recorder_get_stats(
+        _Out_ sai_metadata_recorder_stats_t *stats);
+
+/**
+ * @brief Open log file for reading
+ *
+ * @param[in] path Log file path
+ * @param[out] reader Log file reader
+ *
+ * @return #SAI_STATUS_SUCCESS on success, failure status code on error
+ */
+extern sai_status_t sai_metadata_recorder_reader_open(
+        _In_ const char *path,
+        _Out_ sai_metadata_recorder_reader_t *reader);
+
+/**
+ * @brief Decode next record from log file
+ *
+ * @param[inout] reader Log file reader
+ * @param[out] record Decoded record
+ *
+ * @return #SAI_STATUS_SUCCESS on success, #SAI_STATUS_ITEM_NOT_FOUND at end
+ * of log, failure status code if log is corrupted
+ */
+extern sai_status_t sai_metadata_recorder_reader_next(
+        _Inout_ sai_metadata_recorder_reader_t *reader,
+        _Out_ sai_metadata_recorder_record_t *record);
+
+/**
+ * @brief Release attributes of all decoded records
+ *
+ * @param[inout] reader Log file reader
+ */
+extern void sai_metadata_recorder_reader_release(
+        _Inout_ sai_metadata_recorder_reader_t *reader);
+
+/**
+ * @brief Close log file
+ *
+ * @param[inout] reader Log file reader
+ */
+extern void sai_metadata_recorder_reader_close(
+        _Inout_ sai_metadata_recorder_reader_t *reader);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATARECORDER_H_ */
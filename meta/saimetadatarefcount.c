@@ -0,0 +1,1068 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatarefcount.c
+ *
+ * @brief   This module defines SAI Metadata Reference Tracker
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+#define SAI_METADATA_REFCOUNT_NONE 0xFFFFFFFF
+
+#define SAI_METADATA_REFCOUNT_INITIAL_SIZE 64
+
+/*
+ * References of single operation are enumerated twice, first to count them,
+ * so all memory can be reserved up front and update never fails half way,
+ * and then to add them.
+ */
+
+typedef struct _sai_metadata_refcount_ctx_t
+{
+    sai_metadata_refcount_t *tracker;
+
+    /* referencing object, SAI_METADATA_REFCOUNT_NONE when only counting */
+
+    uint32_t from;
+
+    sai_object_id_t self;
+
+    uint32_t count;
+
+} sai_metadata_refcount_ctx_t;
+
+/*
+ * Unused part of ip address union can contain garbage, so ip address and ip
+ * prefix key members are copied and unused bytes are cleared before they are
+ * hashed or compared.
+ */
+
+typedef union _sai_metadata_refcount_ip_t
+{
+    sai_ip_address_t address;
+
+    sai_ip_prefix_t prefix;
+
+} sai_metadata_refcount_ip_t;
+
+static uint32_t sai_metadata_refcount_hash_oid(
+        _In_ sai_object_id_t oid)
+{
+    return (uint32_t)((oid * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static uint64_t sai_metadata_refcount_hash_bytes(
+        _In_ uint64_t hash,
+        _In_ const uint8_t *data,
+        _In_ size_t size)
+{
+    size_t idx = 0;
+
+    for (; idx < size; idx++)
+    {
+        hash ^= data[idx];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+static void sai_metadata_refcount_clear_ip_address(
+        _Inout_ sai_ip_address_t *address)
+{
+    if (address->addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        memset((uint8_t*)&address->addr + sizeof(sai_ip4_t), 0, sizeof(address->addr) - sizeof(sai_ip4_t));
+    }
+}
+
+static const uint8_t* sai_metadata_refcount_member(
+        _In_ const sai_struct_member_info_t *m,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _Out_ sai_metadata_refcount_ip_t *ip,
+        _Out_ size_t *size)
+{
+    const uint8_t *data = (const uint8_t*)&meta_key->objectkey.key + m->offset;
+
+    switch (m->membervaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
+
+            memcpy(&ip->address, data, sizeof(sai_ip_address_t));
+
+            sai_metadata_refcount_clear_ip_address(&ip->address);
+
+            *size = sizeof(sai_ip_address_t);
+
+            return (const uint8_t*)ip;
+
+        case SAI_ATTR_VALUE_TYPE_IP_PREFIX:
+
+            memcpy(&ip->prefix, data, sizeof(sai_ip_prefix_t));
+
+            if (ip->prefix.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                memset((uint8_t*)&ip->prefix.addr + sizeof(sai_ip4_t), 0, sizeof(ip->prefix.addr) - sizeof(sai_ip4_t));
+                memset((uint8_t*)&ip->prefix.mask + sizeof(sai_ip4_t), 0, sizeof(ip->prefix.mask) - sizeof(sai_ip4_t));
+            }
+
+            *size = sizeof(sai_ip_prefix_t);
+
+            return (const uint8_t*)ip;
+
+        default:
+
+            *size = m->size;
+
+            return data;
+    }
+}
+
+static uint32_t sai_metadata_refcount_hash_key(
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *meta_key)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL ^ (uint64_t)meta_key->objecttype;
+
+    size_t mi = 0;
+
+    for (; mi < info->structmemberscount; mi++)
+    {
+        sai_metadata_refcount_ip_t ip;
+
+        size_t size;
+
+        const uint8_t *data = sai_metadata_refcount_member(info->structmembers[mi], meta_key, &ip, &size);
+
+        hash = sai_metadata_refcount_hash_bytes(hash, data, size);
+    }
+
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static bool sai_metadata_refcount_key_equal(
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *a,
+        _In_ const sai_object_meta_key_t *b)
+{
+    if (a->objecttype != b->objecttype)
+    {
+        return false;
+    }
+
+    size_t mi = 0;
+
+    for (; mi < info->structmemberscount; mi++)
+    {
+        sai_metadata_refcount_ip_t ipa;
+        sai_metadata_refcount_ip_t ipb;
+
+        size_t size;
+
+        const uint8_t *da = sai_metadata_refcount_member(info->structmembers[mi], a, &ipa, &size);
+        const uint8_t *db = sai_metadata_refcount_member(info->structmembers[mi], b, &ipb, &size);
+
+        if (memcmp(da, db, size) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Returns slot position of object, or SAI_METADATA_REFCOUNT_NONE. Object id
+ * objects are matched by object id only, since object type of implicitly
+ * tracked object may not be known.
+ */
+static uint32_t sai_metadata_refcount_find_slot(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ uint32_t hash,
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ sai_object_id_t oid)
+{
+    uint32_t pos = hash & tracker->mask;
+
+    for (; tracker->slots[pos].index != 0; pos = (pos + 1) & tracker->mask)
+    {
+        if (tracker->slots[pos].hash != hash)
+        {
+            continue;
+        }
+
+        const sai_metadata_refcount_object_t *obj = &tracker->objects[tracker->slots[pos].index - 1];
+
+        if (info == NULL)
+        {
+            if (obj->key == SAI_METADATA_REFCOUNT_NONE && obj->object_id == oid)
+            {
+                return pos;
+            }
+        }
+        else if (obj->key != SAI_METADATA_REFCOUNT_NONE &&
+                sai_metadata_refcount_key_equal(info, &tracker->keys[obj->key], meta_key))
+        {
+            return pos;
+        }
+    }
+
+    return SAI_METADATA_REFCOUNT_NONE;
+}
+
+static uint32_t sai_metadata_refcount_find_oid(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ sai_object_id_t oid)
+{
+    uint32_t pos = sai_metadata_refcount_find_slot(tracker, sai_metadata_refcount_hash_oid(oid), NULL, NULL, oid);
+
+    return (pos == SAI_METADATA_REFCOUNT_NONE) ? pos : tracker->slots[pos].index - 1;
+}
+
+static uint32_t sai_metadata_refcount_find(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *meta_key)
+{
+    if (info->isobjectid)
+    {
+        return sai_metadata_refcount_find_oid(tracker, meta_key->objectkey.key.object_id);
+    }
+
+    uint32_t pos = sai_metadata_refcount_find_slot(tracker,
+            sai_metadata_refcount_hash_key(info, meta_key), info, meta_key, SAI_NULL_OBJECT_ID);
+
+    return (pos == SAI_METADATA_REFCOUNT_NONE) ? pos : tracker->slots[pos].index - 1;
+}
+
+static void sai_metadata_refcount_map_insert(
+        _Inout_ sai_metadata_refcount_slot_t *slots,
+        _In_ uint32_t mask,
+        _In_ uint32_t hash,
+        _In_ uint32_t index)
+{
+    uint32_t pos = hash & mask;
+
+    while (slots[pos].index != 0)
+    {
+        pos = (pos + 1) & mask;
+    }
+
+    slots[pos].hash = hash;
+    slots[pos].index = index + 1;
+}
+
+/*
+ * Removes slot using backward shift, so table never contains tombstones and
+ * lookups don't slow down after many removes.
+ */
+static void sai_metadata_refcount_map_erase(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ uint32_t pos)
+{
+    uint32_t mask = tracker->mask;
+
+    uint32_t next = (pos + 1) & mask;
+
+    for (; tracker->slots[next].index != 0; next = (next + 1) & mask)
+    {
+        uint32_t home = tracker->slots[next].hash & mask;
+
+        /* slot can move back only if its home position is not in (pos, next] */
+
+        if (((next - home) & mask) >= ((next - pos) & mask))
+        {
+            tracker->slots[pos] = tracker->slots[next];
+            pos = next;
+        }
+    }
+
+    tracker->slots[pos].hash = 0;
+    tracker->slots[pos].index = 0;
+}
+
+static uint32_t sai_metadata_refcount_capacity(
+        _In_ uint32_t size,
+        _In_ uint64_t needed)
+{
+    uint64_t capacity = (size < SAI_METADATA_REFCOUNT_INITIAL_SIZE) ? SAI_METADATA_REFCOUNT_INITIAL_SIZE : size;
+
+    while (capacity < needed)
+    {
+        capacity *= 2;
+    }
+
+    return (capacity >= SAI_METADATA_REFCOUNT_NONE) ? 0 : (uint32_t)capacity;
+}
+
+static bool sai_metadata_refcount_reserve(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ uint32_t objects,
+        _In_ uint32_t edges,
+        _In_ uint32_t keys)
+{
+    uint64_t needed = (uint64_t)tracker->objects_count + objects;
+
+    if (needed > tracker->objects_size)
+    {
+        uint32_t size = sai_metadata_refcount_capacity(tracker->objects_size, needed);
+
+        sai_metadata_refcount_object_t *array = size ? realloc(tracker->objects, size * sizeof(sai_metadata_refcount_object_t)) : NULL;
+
+        if (array == NULL)
+        {
+            return false;
+        }
+
+        tracker->objects = array;
+        tracker->objects_size = size;
+    }
+
+    needed = (uint64_t)tracker->edges_count + edges;
+
+    if (needed > tracker->edges_size)
+    {
+        uint32_t size = sai_metadata_refcount_capacity(tracker->edges_size, needed);
+
+        sai_metadata_refcount_edge_t *array = size ? realloc(tracker->edges, size * sizeof(sai_metadata_refcount_edge_t)) : NULL;
+
+        if (array == NULL)
+        {
+            return false;
+        }
+
+        tracker->edges = array;
+        tracker->edges_size = size;
+    }
+
+    needed = (uint64_t)tracker->keys_count + keys;
+
+    if (needed > tracker->keys_size)
+    {
+        uint32_t size = sai_metadata_refcount_capacity(tracker->keys_size, needed);
+
+        sai_object_meta_key_t *array = size ? realloc(tracker->keys, size * sizeof(sai_object_meta_key_t)) : NULL;
+
+        if (array == NULL)
+        {
+            return false;
+        }
+
+        tracker->keys = array;
+
+        uint32_t *owner = realloc(tracker->keys_owner, size * sizeof(uint32_t));
+
+        if (owner == NULL)
+        {
+            return false;
+        }
+
+        tracker->keys_owner = owner;
+        tracker->keys_size = size;
+    }
+
+    /* keep load factor of hash table at most 3/4 */
+
+    needed = (uint64_t)tracker->tracked + objects;
+
+    uint64_t slots = (uint64_t)tracker->mask + 1;
+
+    if (4 * needed <= 3 * slots)
+    {
+        return true;
+    }
+
+    while (4 * needed > 3 * slots)
+    {
+        slots *= 2;
+    }
+
+    if (slots > ((uint64_t)1 << 31))
+    {
+        return false;
+    }
+
+    sai_metadata_refcount_slot_t *array = calloc((size_t)slots, sizeof(sai_metadata_refcount_slot_t));
+
+    if (array == NULL)
+    {
+        return false;
+    }
+
+    uint32_t mask = (uint32_t)(slots - 1);
+
+    uint32_t pos = 0;
+
+    for (; pos <= tracker->mask; pos++)
+    {
+        if (tracker->slots[pos].index != 0)
+        {
+            sai_metadata_refcount_map_insert(array, mask, tracker->slots[pos].hash, tracker->slots[pos].index - 1);
+        }
+    }
+
+    free(tracker->slots);
+
+    tracker->slots = array;
+    tracker->mask = mask;
+
+    return true;
+}
+
+static uint32_t sai_metadata_refcount_alloc_object(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ sai_object_id_t oid,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t hash)
+{
+    uint32_t index = tracker->objects_free;
+
+    if (index != SAI_METADATA_REFCOUNT_NONE)
+    {
+        tracker->objects_free = tracker->objects[index].key;
+    }
+    else
+    {
+        index = tracker->objects_count++;
+    }
+
+    sai_metadata_refcount_object_t *obj = &tracker->objects[index];
+
+    obj->object_id = oid;
+    obj->object_type = object_type;
+    obj->refcount = 0;
+    obj->key = SAI_METADATA_REFCOUNT_NONE;
+    obj->in_head = SAI_METADATA_REFCOUNT_NONE;
+    obj->out_head = SAI_METADATA_REFCOUNT_NONE;
+    obj->created = 0;
+
+    sai_metadata_refcount_map_insert(tracker->slots, tracker->mask, hash, index);
+
+    tracker->tracked++;
+
+    return index;
+}
+
+static void sai_metadata_refcount_free_object(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ uint32_t index)
+{
+    sai_metadata_refcount_object_t *obj = &tracker->objects[index];
+
+    uint32_t pos;
+
+    if (obj->key == SAI_METADATA_REFCOUNT_NONE)
+    {
+        pos = sai_metadata_refcount_find_slot(tracker,
+                sai_metadata_refcount_hash_oid(obj->object_id), NULL, NULL, obj->object_id);
+    }
+    else
+    {
+        const sai_object_meta_key_t *meta_key = &tracker->keys[obj->key];
+
+        const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+        pos = sai_metadata_refcount_find_slot(tracker,
+                sai_metadata_refcount_hash_key(info, meta_key), info, meta_key, SAI_NULL_OBJECT_ID);
+
+        /* move last key into the hole */
+
+        uint32_t last = --tracker->keys_count;
+
+        if (obj->key != last)
+        {
+            tracker->keys[obj->key] = tracker->keys[last];
+            tracker->keys_owner[obj->key] = tracker->keys_owner[last];
+            tracker->objects[tracker->keys_owner[obj->key]].key = obj->key;
+        }
+    }
+
+    sai_metadata_refcount_map_erase(tracker, pos);
+
+    obj->object_id = SAI_NULL_OBJECT_ID;
+    obj->object_type = SAI_OBJECT_TYPE_NULL;
+    obj->key = tracker->objects_free;
+
+    tracker->objects_free = index;
+
+    tracker->tracked--;
+}
+
+static void sai_metadata_refcount_add_edge(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ uint32_t from,
+        _In_ uint32_t to,
+        _In_ sai_attr_id_t attr_id)
+{
+    uint32_t index = tracker->edges_free;
+
+    if (index != SAI_METADATA_REFCOUNT_NONE)
+    {
+        tracker->edges_free = tracker->edges[index].out_next;
+    }
+    else
+    {
+        index = tracker->edges_count++;
+    }
+
+    sai_metadata_refcount_edge_t *edge = &tracker->edges[index];
+
+    sai_metadata_refcount_object_t *src = &tracker->objects[from];
+    sai_metadata_refcount_object_t *dst = &tracker->objects[to];
+
+    edge->from = from;
+    edge->to = to;
+    edge->attr_id = attr_id;
+
+    edge->in_prev = SAI_METADATA_REFCOUNT_NONE;
+    edge->in_next = dst->in_head;
+
+    if (dst->in_head != SAI_METADATA_REFCOUNT_NONE)
+    {
+        tracker->edges[dst->in_head].in_prev = index;
+    }
+
+    dst->in_head = index;
+    dst->refcount++;
+
+    edge->out_next = src->out_head;
+    src->out_head = index;
+
+    tracker->references++;
+}
+
+/*
+ * Drops references from object, all of them or only ones held by given
+ * attribute. Implicitly tracked objects which are no longer referenced are
+ * released.
+ */
+static void sai_metadata_refcount_drop_edges(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ uint32_t from,
+        _In_ bool all,
+        _In_ sai_attr_id_t attr_id)
+{
+    uint32_t *link = &tracker->objects[from].out_head;
+
+    while (*link != SAI_METADATA_REFCOUNT_NONE)
+    {
+        uint32_t index = *link;
+
+        sai_metadata_refcount_edge_t *edge = &tracker->edges[index];
+
+        if (!all && edge->attr_id != attr_id)
+        {
+            link = &edge->out_next;
+            continue;
+        }
+
+        *link = edge->out_next;
+
+        sai_metadata_refcount_object_t *dst = &tracker->objects[edge->to];
+
+        if (edge->in_prev != SAI_METADATA_REFCOUNT_NONE)
+        {
+            tracker->edges[edge->in_prev].in_next = edge->in_next;
+        }
+        else
+        {
+            dst->in_head = edge->in_next;
+        }
+
+        if (edge->in_next != SAI_METADATA_REFCOUNT_NONE)
+        {
+            tracker->edges[edge->in_next].in_prev = edge->in_prev;
+        }
+
+        dst->refcount--;
+
+        tracker->references--;
+
+        edge->out_next = tracker->edges_free;
+        tracker->edges_free = index;
+
+        if (dst->refcount == 0 && !dst->created && dst->out_head == SAI_METADATA_REFCOUNT_NONE)
+        {
+            sai_metadata_refcount_free_object(tracker, edge->to);
+        }
+    }
+}
+
+static void sai_metadata_refcount_reference(
+        _Inout_ sai_metadata_refcount_ctx_t *ctx,
+        _In_ sai_attr_id_t attr_id,
+        _In_ const sai_object_type_t *allowedobjecttypes,
+        _In_ size_t allowedobjecttypeslength,
+        _In_ sai_object_id_t oid)
+{
+    if (oid == SAI_NULL_OBJECT_ID || oid == ctx->self)
+    {
+        return;
+    }
+
+    if (allowedobjecttypeslength == 1 && allowedobjecttypes[0] == SAI_OBJECT_TYPE_SWITCH)
+    {
+        return;
+    }
+
+    if (ctx->from == SAI_METADATA_REFCOUNT_NONE)
+    {
+        ctx->count++;
+        return;
+    }
+
+    sai_metadata_refcount_t *tracker = ctx->tracker;
+
+    uint32_t to = sai_metadata_refcount_find_oid(tracker, oid);
+
+    if (to == SAI_METADATA_REFCOUNT_NONE)
+    {
+        sai_object_type_t object_type = (allowedobjecttypeslength == 1) ? allowedobjecttypes[0] : SAI_OBJECT_TYPE_NULL;
+
+        to = sai_metadata_refcount_alloc_object(tracker, oid, object_type, sai_metadata_refcount_hash_oid(oid));
+    }
+    else if (tracker->objects[to].object_type == SAI_OBJECT_TYPE_SWITCH)
+    {
+        return;
+    }
+
+    sai_metadata_refcount_add_edge(tracker, ctx->from, to, attr_id);
+}
+
+static void sai_metadata_refcount_reference_list(
+        _Inout_ sai_metadata_refcount_ctx_t *ctx,
+        _In_ const sai_attr_metadata_t *md,
+        _In_ const sai_object_list_t *list)
+{
+    uint32_t idx = 0;
+
+    for (; list->list != NULL && idx < list->count; idx++)
+    {
+        sai_metadata_refcount_reference(ctx, md->attrid, md->allowedobjecttypes, md->allowedobjecttypeslength, list->list[idx]);
+    }
+}
+
+static void sai_metadata_refcount_attr_references(
+        _Inout_ sai_metadata_refcount_ctx_t *ctx,
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t *attr)
+{
+    const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(object_type, attr->id);
+
+    if (md == NULL || !md->isoidattribute)
+    {
+        return;
+    }
+
+    const sai_attribute_value_t *value = &attr->value;
+
+    switch (md->attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+            sai_metadata_refcount_reference(ctx, md->attrid, md->allowedobjecttypes, md->allowedobjecttypeslength, value->oid);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+            sai_metadata_refcount_reference_list(ctx, md, &value->objlist);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+
+            if (value->aclfield.enable)
+            {
+                sai_metadata_refcount_reference(ctx, md->attrid, md->allowedobjecttypes, md->allowedobjecttypeslength, value->aclfield.data.oid);
+            }
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+
+            if (value->aclfield.enable)
+            {
+                sai_metadata_refcount_reference_list(ctx, md, &value->aclfield.data.objlist);
+            }
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+
+            if (value->aclaction.enable)
+            {
+                sai_metadata_refcount_reference(ctx, md->attrid, md->allowedobjecttypes, md->allowedobjecttypeslength, value->aclaction.parameter.oid);
+            }
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+
+            if (value->aclaction.enable)
+            {
+                sai_metadata_refcount_reference_list(ctx, md, &value->aclaction.parameter.objlist);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void sai_metadata_refcount_references(
+        _Inout_ sai_metadata_refcount_ctx_t *ctx,
+        _In_ const sai_object_type_info_t *info,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    size_t mi = 0;
+
+    for (; info->isnonobjectid && mi < info->structmemberscount; mi++)
+    {
+        const sai_struct_member_info_t *m = info->structmembers[mi];
+
+        if (m->getoid != NULL)
+        {
+            sai_metadata_refcount_reference(ctx, SAI_METADATA_REFCOUNT_KEY_MEMBER,
+                    m->allowedobjecttypes, m->allowedobjecttypeslength, m->getoid(meta_key));
+        }
+    }
+
+    uint32_t idx = 0;
+
+    for (; attr_list != NULL && idx < attr_count; idx++)
+    {
+        sai_metadata_refcount_attr_references(ctx, meta_key->objecttype, &attr_list[idx]);
+    }
+}
+
+sai_status_t sai_metadata_refcount_init(
+        _Out_ sai_metadata_refcount_t *tracker)
+{
+    if (tracker == NULL)
+    {
+        SAI_META_LOG_ERROR("tracker parameter is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(tracker, 0, sizeof(sai_metadata_refcount_t));
+
+    tracker->objects_free = SAI_METADATA_REFCOUNT_NONE;
+    tracker->edges_free = SAI_METADATA_REFCOUNT_NONE;
+
+    tracker->slots = calloc(SAI_METADATA_REFCOUNT_INITIAL_SIZE, sizeof(sai_metadata_refcount_slot_t));
+    tracker->mask = SAI_METADATA_REFCOUNT_INITIAL_SIZE - 1;
+
+    tracker->objects_size = SAI_METADATA_REFCOUNT_INITIAL_SIZE;
+    tracker->objects = malloc(tracker->objects_size * sizeof(sai_metadata_refcount_object_t));
+
+    tracker->edges_size = SAI_METADATA_REFCOUNT_INITIAL_SIZE;
+    tracker->edges = malloc(tracker->edges_size * sizeof(sai_metadata_refcount_edge_t));
+
+    if (tracker->slots == NULL || tracker->objects == NULL || tracker->edges == NULL)
+    {
+        sai_metadata_refcount_release(tracker);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_metadata_refcount_release(
+        _Inout_ sai_metadata_refcount_t *tracker)
+{
+    if (tracker == NULL)
+    {
+        return;
+    }
+
+    free(tracker->slots);
+    free(tracker->objects);
+    free(tracker->keys);
+    free(tracker->keys_owner);
+    free(tracker->edges);
+
+    memset(tracker, 0, sizeof(sai_metadata_refcount_t));
+}
+
+sai_status_t sai_metadata_refcount_create(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    if (tracker == NULL || tracker->slots == NULL || meta_key == NULL)
+    {
+        SAI_META_LOG_ERROR("invalid parameter");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL || (info->isobjectid && meta_key->objectkey.key.object_id == SAI_NULL_OBJECT_ID))
+    {
+        SAI_META_LOG_ERROR("invalid object type %d or object id", meta_key->objecttype);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_metadata_refcount_ctx_t ctx;
+
+    ctx.tracker = tracker;
+    ctx.from = SAI_METADATA_REFCOUNT_NONE;
+    ctx.self = info->isobjectid ? meta_key->objectkey.key.object_id : SAI_NULL_OBJECT_ID;
+    ctx.count = 0;
+
+    sai_metadata_refcount_references(&ctx, info, meta_key, attr_count, attr_list);
+
+    if (!sai_metadata_refcount_reserve(tracker, ctx.count + 1, ctx.count, info->isnonobjectid ? 1 : 0))
+    {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    uint32_t index = sai_metadata_refcount_find(tracker, info, meta_key);
+
+    if (index != SAI_METADATA_REFCOUNT_NONE)
+    {
+        if (tracker->objects[index].created)
+        {
+            return SAI_STATUS_ITEM_ALREADY_EXISTS;
+        }
+
+        tracker->objects[index].object_type = meta_key->objecttype;
+    }
+    else if (info->isobjectid)
+    {
+        sai_object_id_t oid = meta_key->objectkey.key.object_id;
+
+        index = sai_metadata_refcount_alloc_object(tracker, oid, meta_key->objecttype, sai_metadata_refcount_hash_oid(oid));
+    }
+    else
+    {
+        index = sai_metadata_refcount_alloc_object(tracker, SAI_NULL_OBJECT_ID, meta_key->objecttype,
+                sai_metadata_refcount_hash_key(info, meta_key));
+
+        tracker->objects[index].key = tracker->keys_count;
+
+        tracker->keys[tracker->keys_count] = *meta_key;
+        tracker->keys_owner[tracker->keys_count] = index;
+
+        tracker->keys_count++;
+    }
+
+    tracker->objects[index].created = 1;
+
+    ctx.from = index;
+
+    sai_metadata_refcount_references(&ctx, info, meta_key, attr_count, attr_list);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_metadata_refcount_set(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ const sai_attribute_t *attr)
+{
+    if (tracker == NULL || tracker->slots == NULL || meta_key == NULL || attr == NULL)
+    {
+        SAI_META_LOG_ERROR("invalid parameter");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL)
+    {
+        SAI_META_LOG_ERROR("invalid object type %d", meta_key->objecttype);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    uint32_t index = sai_metadata_refcount_find(tracker, info, meta_key);
+
+    if (index == SAI_METADATA_REFCOUNT_NONE || !tracker->objects[index].created)
+    {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(meta_key->objecttype, attr->id);
+
+    if (md == NULL || !md->isoidattribute)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_metadata_refcount_ctx_t ctx;
+
+    ctx.tracker = tracker;
+    ctx.from = SAI_METADATA_REFCOUNT_NONE;
+    ctx.self = info->isobjectid ? meta_key->objectkey.key.object_id : SAI_NULL_OBJECT_ID;
+    ctx.count = 0;
+
+    sai_metadata_refcount_attr_references(&ctx, meta_key->objecttype, attr);
+
+    if (!sai_metadata_refcount_reserve(tracker, ctx.count, ctx.count, 0))
+    {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_metadata_refcount_drop_edges(tracker, index, false, attr->id);
+
+    ctx.from = index;
+
+    sai_metadata_refcount_attr_references(&ctx, meta_key->objecttype, attr);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_metadata_refcount_remove(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key)
+{
+    if (tracker == NULL || tracker->slots == NULL || meta_key == NULL)
+    {
+        SAI_META_LOG_ERROR("invalid parameter");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL)
+    {
+        SAI_META_LOG_ERROR("invalid object type %d", meta_key->objecttype);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    uint32_t index = sai_metadata_refcount_find(tracker, info, meta_key);
+
+    if (index == SAI_METADATA_REFCOUNT_NONE || !tracker->objects[index].created)
+    {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if (tracker->objects[index].refcount != 0)
+    {
+        return SAI_STATUS_OBJECT_IN_USE;
+    }
+
+    sai_metadata_refcount_drop_edges(tracker, index, true, 0);
+
+    sai_metadata_refcount_free_object(tracker, index);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+uint32_t sai_metadata_refcount_get(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ sai_object_id_t object_id)
+{
+    if (tracker == NULL || tracker->slots == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t index = sai_metadata_refcount_find_oid(tracker, object_id);
+
+    return (index == SAI_METADATA_REFCOUNT_NONE) ? 0 : tracker->objects[index].refcount;
+}
+
+bool sai_metadata_refcount_can_remove(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key)
+{
+    if (tracker == NULL || tracker->slots == NULL || meta_key == NULL)
+    {
+        return false;
+    }
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info == NULL)
+    {
+        return false;
+    }
+
+    uint32_t index = sai_metadata_refcount_find(tracker, info, meta_key);
+
+    return index == SAI_METADATA_REFCOUNT_NONE || tracker->objects[index].refcount == 0;
+}
+
+sai_status_t sai_metadata_refcount_get_dependents(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ sai_object_id_t object_id,
+        _Inout_ uint32_t *count,
+        _Out_ sai_metadata_refcount_dependent_t *dependents)
+{
+    if (tracker == NULL || tracker->slots == NULL || count == NULL)
+    {
+        SAI_META_LOG_ERROR("invalid parameter");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    uint32_t index = sai_metadata_refcount_find_oid(tracker, object_id);
+
+    uint32_t refcount = (index == SAI_METADATA_REFCOUNT_NONE) ? 0 : tracker->objects[index].refcount;
+
+    if (refcount > *count || (refcount != 0 && dependents == NULL))
+    {
+        *count = refcount;
+
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    *count = refcount;
+
+    if (refcount == 0)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    uint32_t edge = tracker->objects[index].in_head;
+
+    uint32_t idx = 0;
+
+    for (; edge != SAI_METADATA_REFCOUNT_NONE; edge = tracker->edges[edge].in_next, idx++)
+    {
+        const sai_metadata_refcount_object_t *src = &tracker->objects[tracker->edges[edge].from];
+
+        if (src->key != SAI_METADATA_REFCOUNT_NONE)
+        {
+            dependents[idx].meta_key = tracker->keys[src->key];
+        }
+        else
+        {
+            dependents[idx].meta_key.objecttype = src->object_type;
+            dependents[idx].meta_key.objectkey.key.object_id = src->object_id;
+        }
+
+        dependents[idx].attr_id = tracker->edges[edge].attr_id;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
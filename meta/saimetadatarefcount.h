@@ -0,0 +1,371 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatarefcount.h
+ *
+ * @brief   This module defines SAI Metadata Reference Tracker
+ */
+
+#ifndef __SAIMETADATAREFCOUNT_H_
+#define __SAIMETADATAREFCOUNT_H_
+
+/**
+ * @defgroup SAIMETADATAREFCOUNT SAI - Metadata Reference Tracker Definitions
+ *
+ * Reference tracker counts how many times each object id is referenced by
+ * other objects. References are found using attribute metadata: object id
+ * values of attributes marked as object id attributes, and object id members
+ * of non object id keys (for example virtual router id of route entry).
+ * References to switch object are not counted, since every object belongs to
+ * switch anyway.
+ *
+ * Tracker is updated after successful create, set and remove API calls.
+ * Objects are kept in open addressing hash table with 8 byte slots, and each
+ * reference is kept on two intrusive lists, list of references of referencing
+ * object and list of dependents of referenced object. Checking whether object
+ * can be removed takes constant time, and listing object dependents takes
+ * time proportional to the number of dependents.
+ *
+ * Object ids referenced before they were created by tracked API call (like
+ * ports created by switch) are tracked implicitly while they are referenced.
+ *
+ * Tracker is not thread safe.
+ *
+ * @{
+ */
+
+/**
+ * @brief Attribute id of dependent which references object in non object id key
+ */
+#define SAI_METADATA_REFCOUNT_KEY_MEMBER 0xFFFFFFFF
+
+/**
+ * @brief Hash table slot
+ */
+typedef struct _sai_metadata_refcount_slot_t
+{
+    /**
+     * @brief Hash of object key.
+     */
+    uint32_t hash;
+
+    /**
+     * @brief Object index + 1, zero marks empty slot.
+     */
+    uint32_t index;
+
+} sai_metadata_refcount_slot_t;
+
+/**
+ * @brief Tracked object
+ */
+typedef struct _sai_metadata_refcount_object_t
+{
+    /**
+     * @brief Object id, SAI_NULL_OBJECT_ID for non object id object.
+     */
+    sai_object_id_t object_id;
+
+    /**
+     * @brief Object type, SAI_OBJECT_TYPE_NULL if object is tracked implicitly and type is not known.
+     */
+    sai_object_type_t object_type;
+
+    /**
+     * @brief Number of references to this object.
+     */
+    uint32_t refcount;
+
+    /**
+     * @brief Index of non object id key in keys, or next free object if object is not used.
+     */
+    uint32_t key;
+
+    /**
+     * @brief First reference to this object.
+     */
+    uint32_t in_head;
+
+    /**
+     * @brief First reference from this object.
+     */
+    uint32_t out_head;
+
+    /**
+     * @brief Indicates whether object was created by tracked API call.
+     */
+    uint32_t created;
+
+} sai_metadata_refcount_object_t;
+
+/**
+ * @brief Single reference
+ */
+typedef struct _sai_metadata_refcount_edge_t
+{
+    /**
+     * @brief Index of referencing object.
+     */
+    uint32_t from;
+
+    /**
+     * @brief Index of referenced object.
+     */
+    uint32_t to;
+
+    /**
+     * @brief Attribute id which holds reference, or #SAI_METADATA_REFCOUNT_KEY_MEMBER.
+     */
+    sai_attr_id_t attr_id;
+
+    /**
+     * @brief Previous reference to the same object.
+     */
+    uint32_t in_prev;
+
+    /**
+     * @brief Next reference to the same object.
+     */
+    uint32_t in_next;
+
+    /**
+     * @brief Next reference from the same object, or next free reference if reference is not used.
+     */
+    uint32_t out_next;
+
+} sai_metadata_refcount_edge_t;
+
+/**
+ * @brief Reference tracker
+ */
+typedef struct _sai_metadata_refcount_t
+{
+    /**
+     * @brief Hash table slots.
+     */
+    sai_metadata_refcount_slot_t *slots;
+
+    /**
+     * @brief Number of hash table slots - 1.
+     */
+    uint32_t mask;
+
+    /**
+     * @brief Tracked objects.
+     */
+    sai_metadata_refcount_object_t *objects;
+
+    /**
+     * @brief Number of used entries of objects, including free ones.
+     */
+    uint32_t objects_count;
+
+    /**
+     * @brief Capacity of objects.
+     */
+    uint32_t objects_size;
+
+    /**
+     * @brief First free object.
+     */
+    uint32_t objects_free;
+
+    /**
+     * @brief Keys of non object id objects.
+     */
+    sai_object_meta_key_t *keys;
+
+    /**
+     * @brief Object index of each key.
+     */
+    uint32_t *keys_owner;
+
+    /**
+     * @brief Number of keys.
+     */
+    uint32_t keys_count;
+
+    /**
+     * @brief Capacity of keys.
+     */
+    uint32_t keys_size;
+
+    /**
+     * @brief References.
+     */
+    sai_metadata_refcount_edge_t *edges;
+
+    /**
+     * @brief Number of used entries of edges, including free ones.
+     */
+    uint32_t edges_count;
+
+    /**
+     * @brief Capacity of edges.
+     */
+    uint32_t edges_size;
+
+    /**
+     * @brief First free reference.
+     */
+    uint32_t edges_free;
+
+    /**
+     * @brief Number of tracked objects.
+     */
+    uint32_t tracked;
+
+    /**
+     * @brief Number of references.
+     */
+    uint32_t references;
+
+} sai_metadata_refcount_t;
+
+/**
+ * @brief Object which references other object
+ */
+typedef struct _sai_metadata_refcount_dependent_t
+{
+    /**
+     * @brief Object type and key of referencing object.
+     */
+    sai_object_meta_key_t meta_key;
+
+    /**
+     * @brief Attribute id which holds reference, or #SAI_METADATA_REFCOUNT_KEY_MEMBER.
+     */
+    sai_attr_id_t attr_id;
+
+} sai_metadata_refcount_dependent_t;
+
+/**
+ * @brief Initialize reference tracker
+ *
+ * @param[out] tracker Reference tracker
+ *
+ * @return #SAI_STATUS_SUCCESS on success, #SAI_STATUS_NO_MEMORY otherwise
+ */
+extern sai_status_t sai_metadata_refcount_init(
+        _Out_ sai_metadata_refcount_t *tracker);
+
+/**
+ * @brief Release all memory used by reference tracker
+ *
+ * @param[inout] tracker Reference tracker
+ */
+extern void sai_metadata_refcount_release(
+        _Inout_ sai_metadata_refcount_t *tracker);
+
+/**
+ * @brief Track created object
+ *
+ * @param[inout] tracker Reference tracker
+ * @param[in] meta_key Object type and key, for object id object this is created object id
+ * @param[in] attr_count Number of attributes passed to create
+ * @param[in] attr_list Attributes passed to create
+ *
+ * @return #SAI_STATUS_SUCCESS on success, #SAI_STATUS_ITEM_ALREADY_EXISTS if
+ * object is already tracked as created, failure status code on error
+ */
+extern sai_status_t sai_metadata_refcount_create(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
+/**
+ * @brief Update references of object after set attribute
+ *
+ * References held by previous value of attribute are dropped.
+ *
+ * @param[inout] tracker Reference tracker
+ * @param[in] meta_key Object type and key
+ * @param[in] attr Attribute passed to set
+ *
+ * @return #SAI_STATUS_SUCCESS on success, #SAI_STATUS_ITEM_NOT_FOUND if object
+ * is not tracked, failure status code on error
+ */
+extern sai_status_t sai_metadata_refcount_set(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key,
+        _In_ const sai_attribute_t *attr);
+
+/**
+ * @brief Stop tracking removed object and drop its references
+ *
+ * @param[inout] tracker Reference tracker
+ * @param[in] meta_key Object type and key
+ *
+ * @return #SAI_STATUS_SUCCESS on success, #SAI_STATUS_OBJECT_IN_USE if object
+ * is still referenced (tracker is not modified then),
+ * #SAI_STATUS_ITEM_NOT_FOUND if object is not tracked
+ */
+extern sai_status_t sai_metadata_refcount_remove(
+        _Inout_ sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key);
+
+/**
+ * @brief Get number of references to object
+ *
+ * @param[in] tracker Reference tracker
+ * @param[in] object_id Object id
+ *
+ * @return Number of references, zero if object is not tracked
+ */
+extern uint32_t sai_metadata_refcount_get(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ sai_object_id_t object_id);
+
+/**
+ * @brief Check whether object can be removed
+ *
+ * @param[in] tracker Reference tracker
+ * @param[in] meta_key Object type and key
+ *
+ * @return True if object is not referenced by any tracked object
+ */
+extern bool sai_metadata_refcount_can_remove(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ const sai_object_meta_key_t *meta_key);
+
+/**
+ * @brief Get objects which reference object
+ *
+ * Object referenced multiple times by the same object is listed once for
+ * each reference.
+ *
+ * @param[in] tracker Reference tracker
+ * @param[in] object_id Object id
+ * @param[inout] count Capacity of dependents on input, number of dependents on output
+ * @param[out] dependents Dependents
+ *
+ * @return #SAI_STATUS_SUCCESS on success, #SAI_STATUS_BUFFER_OVERFLOW if
+ * capacity is too small
+ */
+extern sai_status_t sai_metadata_refcount_get_dependents(
+        _In_ const sai_metadata_refcount_t *tracker,
+        _In_ sai_object_id_t object_id,
+        _Inout_ uint32_t *count,
+        _Out_ sai_metadata_refcount_dependent_t *dependents);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATAREFCOUNT_H_ */
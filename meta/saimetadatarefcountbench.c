@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatarefcountbench.c
+ *
+ * @brief   This module measures SAI Metadata Reference Tracker
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+/*
+ * Topology has 1 virtual router, 1024 router interfaces and next hop groups,
+ * and 1M next hops and next hop group members, which is over 2M tracked
+ * object ids. Object ids are synthetic, tracker never calls SAI API.
+ */
+
+#define RIF_COUNT 1024
+#define GROUP_COUNT 1024
+#define NEXT_HOP_COUNT (1024 * 1024)
+
+#define OID(ot, idx) (((sai_object_id_t)(ot) << 48) | (sai_object_id_t)(idx) | 0x1000000)
+
+/* visits all next hops in scattered order, stride is coprime with NEXT_HOP_COUNT */
+
+#define SCATTER(i) (((uint32_t)(i) * 40503u) & (NEXT_HOP_COUNT - 1))
+
+#define CHECK(cond)                                                         \
+    if (!(cond)) {                                                          \
+        fprintf(stderr, "FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+        exit(1);                                                            \
+    }
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static sai_object_meta_key_t meta_key(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t idx)
+{
+    sai_object_meta_key_t mk;
+
+    memset(&mk, 0, sizeof(mk));
+
+    mk.objecttype = object_type;
+    mk.objectkey.key.object_id = OID(object_type, idx);
+
+    return mk;
+}
+
+static void report(
+        _In_ const char *name,
+        _In_ uint64_t start,
+        _In_ uint64_t count)
+{
+    printf("%-28s %8.1f ns/op\n", name, (double)(now_ns() - start) / (double)count);
+}
+
+static void bench_create(
+        _Inout_ sai_metadata_refcount_t *tracker)
+{
+    sai_object_meta_key_t mk = meta_key(SAI_OBJECT_TYPE_VIRTUAL_ROUTER, 0);
+
+    CHECK(sai_metadata_refcount_create(tracker, &mk, 0, NULL) == SAI_STATUS_SUCCESS);
+
+    sai_attribute_t attrs[2];
+
+    uint32_t idx;
+
+    for (idx = 0; idx < RIF_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_ROUTER_INTERFACE, idx);
+
+        attrs[0].id = SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID;
+        attrs[0].value.oid = OID(SAI_OBJECT_TYPE_VIRTUAL_ROUTER, 0);
+
+        CHECK(sai_metadata_refcount_create(tracker, &mk, 1, attrs) == SAI_STATUS_SUCCESS);
+    }
+
+    for (idx = 0; idx < GROUP_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP_GROUP, idx);
+
+        CHECK(sai_metadata_refcount_create(tracker, &mk, 0, NULL) == SAI_STATUS_SUCCESS);
+    }
+
+    uint64_t start = now_ns();
+
+    for (idx = 0; idx < NEXT_HOP_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP, idx);
+
+        attrs[0].id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+        attrs[0].value.oid = OID(SAI_OBJECT_TYPE_ROUTER_INTERFACE, idx % RIF_COUNT);
+
+        CHECK(sai_metadata_refcount_create(tracker, &mk, 1, attrs) == SAI_STATUS_SUCCESS);
+    }
+
+    for (idx = 0; idx < NEXT_HOP_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, idx);
+
+        attrs[0].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        attrs[0].value.oid = OID(SAI_OBJECT_TYPE_NEXT_HOP_GROUP, idx % GROUP_COUNT);
+        attrs[1].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        attrs[1].value.oid = OID(SAI_OBJECT_TYPE_NEXT_HOP, SCATTER(idx));
+
+        CHECK(sai_metadata_refcount_create(tracker, &mk, 2, attrs) == SAI_STATUS_SUCCESS);
+    }
+
+    report("create", start, 2 * NEXT_HOP_COUNT);
+
+    printf("tracked %u objects, %u references\n", tracker->tracked, tracker->references);
+
+    CHECK(tracker->tracked == 1 + RIF_COUNT + GROUP_COUNT + 2 * NEXT_HOP_COUNT);
+    CHECK(tracker->references == RIF_COUNT + 3 * NEXT_HOP_COUNT);
+
+    size_t memory = ((size_t)tracker->mask + 1) * sizeof(sai_metadata_refcount_slot_t) +
+        (size_t)tracker->objects_size * sizeof(sai_metadata_refcount_object_t) +
+        (size_t)tracker->edges_size * sizeof(sai_metadata_refcount_edge_t);
+
+    printf("memory %zu MB, %u hash table slots\n", memory >> 20, tracker->mask + 1);
+}
+
+static void bench_query(
+        _Inout_ sai_metadata_refcount_t *tracker)
+{
+    uint64_t start = now_ns();
+
+    uint32_t removable = 0;
+
+    uint32_t idx;
+
+    for (idx = 0; idx < NEXT_HOP_COUNT; idx++)
+    {
+        sai_object_meta_key_t mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP, SCATTER(idx));
+
+        removable += sai_metadata_refcount_can_remove(tracker, &mk);
+    }
+
+    report("can remove next hop", start, NEXT_HOP_COUNT);
+
+    CHECK(removable == 0);
+
+    uint32_t size = 2 * NEXT_HOP_COUNT / GROUP_COUNT;
+
+    sai_metadata_refcount_dependent_t *dependents = calloc(size, sizeof(sai_metadata_refcount_dependent_t));
+
+    CHECK(dependents != NULL);
+
+    uint64_t total = 0;
+
+    start = now_ns();
+
+    for (idx = 0; idx < GROUP_COUNT; idx++)
+    {
+        uint32_t count = size;
+
+        CHECK(sai_metadata_refcount_get_dependents(tracker, OID(SAI_OBJECT_TYPE_NEXT_HOP_GROUP, idx), &count, dependents) == SAI_STATUS_SUCCESS);
+
+        total += count;
+    }
+
+    report("get dependents per object", start, total);
+
+    CHECK(total == NEXT_HOP_COUNT);
+
+    free(dependents);
+}
+
+static void bench_set(
+        _Inout_ sai_metadata_refcount_t *tracker)
+{
+    uint64_t start = now_ns();
+
+    uint32_t idx;
+
+    for (idx = 0; idx < NEXT_HOP_COUNT; idx++)
+    {
+        sai_object_meta_key_t mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, idx);
+
+        sai_attribute_t attr;
+
+        attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        attr.value.oid = OID(SAI_OBJECT_TYPE_NEXT_HOP, idx);
+
+        CHECK(sai_metadata_refcount_set(tracker, &mk, &attr) == SAI_STATUS_SUCCESS);
+    }
+
+    report("set member next hop", start, NEXT_HOP_COUNT);
+
+    CHECK(sai_metadata_refcount_get(tracker, OID(SAI_OBJECT_TYPE_NEXT_HOP, 7)) == 1);
+}
+
+static void bench_remove(
+        _Inout_ sai_metadata_refcount_t *tracker)
+{
+    sai_object_meta_key_t mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP, 0);
+
+    CHECK(sai_metadata_refcount_remove(tracker, &mk) == SAI_STATUS_OBJECT_IN_USE);
+
+    uint64_t start = now_ns();
+
+    uint32_t idx;
+
+    for (idx = 0; idx < NEXT_HOP_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, SCATTER(idx));
+
+        CHECK(sai_metadata_refcount_remove(tracker, &mk) == SAI_STATUS_SUCCESS);
+    }
+
+    for (idx = 0; idx < NEXT_HOP_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP, idx);
+
+        CHECK(sai_metadata_refcount_remove(tracker, &mk) == SAI_STATUS_SUCCESS);
+    }
+
+    report("remove", start, 2 * NEXT_HOP_COUNT);
+
+    for (idx = 0; idx < GROUP_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_NEXT_HOP_GROUP, idx);
+
+        CHECK(sai_metadata_refcount_remove(tracker, &mk) == SAI_STATUS_SUCCESS);
+    }
+
+    for (idx = 0; idx < RIF_COUNT; idx++)
+    {
+        mk = meta_key(SAI_OBJECT_TYPE_ROUTER_INTERFACE, idx);
+
+        CHECK(sai_metadata_refcount_remove(tracker, &mk) == SAI_STATUS_SUCCESS);
+    }
+
+    mk = meta_key(SAI_OBJECT_TYPE_VIRTUAL_ROUTER, 0);
+
+    CHECK(sai_metadata_refcount_remove(tracker, &mk) == SAI_STATUS_SUCCESS);
+
+    CHECK(tracker->tracked == 0 && tracker->references == 0);
+}
+
+int main(
+        _In_ int argc,
+        _In_ char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    sai_metadata_refcount_t tracker;
+
+    CHECK(sai_metadata_refcount_init(&tracker) == SAI_STATUS_SUCCESS);
+
+    bench_create(&tracker);
+
+    bench_query(&tracker);
+
+    bench_set(&tracker);
+
+    bench_remove(&tracker);
+
+    sai_metadata_refcount_release(&tracker);
+
+    return 0;
+}
@@ -0,0 +1,931 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatascheduler.c
+ *
+ * @brief   This module defines SAI Metadata Bulk Scheduler
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+/*
+ * Object ids of created (placeholders) and removed objects are put into open
+ * addressing hash tables, so each object id value found in attributes is
+ * resolved to operation in constant time. Slot index is entry index + 1, zero
+ * marks empty slot.
+ */
+
+typedef struct _sai_metadata_scheduler_slot_t
+{
+    sai_object_id_t oid;
+
+    uint32_t index;
+
+} sai_metadata_scheduler_slot_t;
+
+typedef struct _sai_metadata_scheduler_map_t
+{
+    sai_metadata_scheduler_slot_t *slots;
+
+    size_t mask;
+
+} sai_metadata_scheduler_map_t;
+
+typedef struct _sai_metadata_scheduler_edge_t
+{
+    uint32_t from;
+
+    uint32_t to;
+
+} sai_metadata_scheduler_edge_t;
+
+/*
+ * Operations sorted by layer, object type and switch id, so each group issued
+ * by single bulk call is continuous range.
+ */
+
+typedef struct _sai_metadata_scheduler_item_t
+{
+    uint32_t layer;
+
+    int32_t object_type;
+
+    sai_object_id_t switch_id;
+
+    uint32_t index;
+
+} sai_metadata_scheduler_item_t;
+
+typedef struct _sai_metadata_scheduler_t
+{
+    const sai_apis_t *apis;
+
+    sai_metadata_scheduler_entry_t *entries;
+
+    uint32_t count;
+
+    sai_metadata_scheduler_map_t created;
+
+    sai_metadata_scheduler_map_t removed;
+
+    sai_metadata_scheduler_edge_t *edges;
+
+    size_t edges_count;
+
+    size_t edges_size;
+
+    bool error;
+
+    /* successors of each operation in compressed form */
+
+    size_t *succ_start;
+
+    uint32_t *succ;
+
+    bool *blocked;
+
+    sai_metadata_scheduler_item_t *items;
+
+    /* groups of currently executed layer, as ranges of items */
+
+    size_t *groups;
+
+    size_t groups_count;
+
+    size_t next_group;
+
+} sai_metadata_scheduler_t;
+
+typedef sai_object_id_t (*sai_metadata_scheduler_oid_fn)(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ uint32_t index,
+        _In_ sai_object_id_t oid);
+
+static size_t sai_metadata_scheduler_hash(
+        _In_ const sai_metadata_scheduler_map_t *map,
+        _In_ sai_object_id_t oid)
+{
+    return (size_t)((oid * 0x9E3779B97F4A7C15ULL) >> 32) & map->mask;
+}
+
+static bool sai_metadata_scheduler_map_init(
+        _Out_ sai_metadata_scheduler_map_t *map,
+        _In_ uint32_t count)
+{
+    size_t size = 16;
+
+    while (size < 2 * (size_t)count)
+    {
+        size <<= 1;
+    }
+
+    map->slots = calloc(size, sizeof(sai_metadata_scheduler_slot_t));
+    map->mask = size - 1;
+
+    return map->slots != NULL;
+}
+
+static bool sai_metadata_scheduler_map_insert(
+        _Inout_ sai_metadata_scheduler_map_t *map,
+        _In_ sai_object_id_t oid,
+        _In_ uint32_t index)
+{
+    size_t idx = sai_metadata_scheduler_hash(map, oid);
+
+    for (; map->slots[idx].index != 0; idx = (idx + 1) & map->mask)
+    {
+        if (map->slots[idx].oid == oid)
+        {
+            return false;
+        }
+    }
+
+    map->slots[idx].oid = oid;
+    map->slots[idx].index = index + 1;
+
+    return true;
+}
+
+/*
+ * Returns entry index + 1, or zero if object id is not in map.
+ */
+static uint32_t sai_metadata_scheduler_map_find(
+        _In_ const sai_metadata_scheduler_map_t *map,
+        _In_ sai_object_id_t oid)
+{
+    if (map->slots == NULL || oid == SAI_NULL_OBJECT_ID)
+    {
+        return 0;
+    }
+
+    size_t idx = sai_metadata_scheduler_hash(map, oid);
+
+    for (; map->slots[idx].index != 0; idx = (idx + 1) & map->mask)
+    {
+        if (map->slots[idx].oid == oid)
+        {
+            return map->slots[idx].index;
+        }
+    }
+
+    return 0;
+}
+
+static void sai_metadata_scheduler_add_edge(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ uint32_t from,
+        _In_ uint32_t to)
+{
+    if (sch->edges_count == sch->edges_size)
+    {
+        size_t size = sch->edges_size ? 2 * sch->edges_size : 64;
+
+        sai_metadata_scheduler_edge_t *edges = realloc(sch->edges, size * sizeof(sai_metadata_scheduler_edge_t));
+
+        if (edges == NULL)
+        {
+            sch->error = true;
+            return;
+        }
+
+        sch->edges = edges;
+        sch->edges_size = size;
+    }
+
+    sch->edges[sch->edges_count].from = from;
+    sch->edges[sch->edges_count].to = to;
+
+    sch->edges_count++;
+}
+
+/*
+ * Object id value referenced by operation. For create, dependency is created
+ * object, for remove, dependency is operation which removes referencing
+ * object, since referenced object can be removed only after that.
+ */
+static sai_object_id_t sai_metadata_scheduler_oid_dependency(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ uint32_t index,
+        _In_ sai_object_id_t oid)
+{
+    if (sch->entries[index].op == SAI_METADATA_SCHEDULER_OP_CREATE)
+    {
+        uint32_t dep = sai_metadata_scheduler_map_find(&sch->created, oid);
+
+        if (dep != 0 && dep - 1 != index)
+        {
+            sai_metadata_scheduler_add_edge(sch, dep - 1, index);
+        }
+    }
+    else
+    {
+        uint32_t dep = sai_metadata_scheduler_map_find(&sch->removed, oid);
+
+        if (dep != 0 && dep - 1 != index)
+        {
+            sai_metadata_scheduler_add_edge(sch, index, dep - 1);
+        }
+    }
+
+    return oid;
+}
+
+/*
+ * Replaces placeholder by object id of created object, operation is only
+ * executed when all objects it depends on were created.
+ */
+static sai_object_id_t sai_metadata_scheduler_oid_translate(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ uint32_t index,
+        _In_ sai_object_id_t oid)
+{
+    uint32_t dep = sai_metadata_scheduler_map_find(&sch->created, oid);
+
+    if (dep == 0 || dep - 1 == index)
+    {
+        return oid;
+    }
+
+    return sch->entries[dep - 1].meta_key.objectkey.key.object_id;
+}
+
+static void sai_metadata_scheduler_oid_list(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ uint32_t index,
+        _Inout_ sai_object_list_t *list,
+        _In_ sai_metadata_scheduler_oid_fn fn)
+{
+    uint32_t idx = 0;
+
+    if (list->list == NULL)
+    {
+        return;
+    }
+
+    for (; idx < list->count; idx++)
+    {
+        sai_object_id_t oid = fn(sch, index, list->list[idx]);
+
+        if (oid != list->list[idx])
+        {
+            list->list[idx] = oid;
+        }
+    }
+}
+
+/*
+ * Calls function on each object id referenced by operation, in attributes,
+ * non object id key members and switch id of create, and replaces object id
+ * by returned value.
+ */
+static void sai_metadata_scheduler_for_each_oid(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ uint32_t index,
+        _In_ sai_metadata_scheduler_oid_fn fn)
+{
+    sai_metadata_scheduler_entry_t *entry = &sch->entries[index];
+
+    sai_object_type_t object_type = entry->meta_key.objecttype;
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(object_type);
+
+    if (entry->op == SAI_METADATA_SCHEDULER_OP_CREATE && object_type != SAI_OBJECT_TYPE_SWITCH)
+    {
+        entry->switch_id = fn(sch, index, entry->switch_id);
+    }
+
+    size_t mi = 0;
+
+    for (; info->isnonobjectid && mi < info->structmemberscount; mi++)
+    {
+        const sai_struct_member_info_t *m = info->structmembers[mi];
+
+        if (m->getoid == NULL || m->setoid == NULL)
+        {
+            continue;
+        }
+
+        sai_object_id_t current = m->getoid(&entry->meta_key);
+
+        sai_object_id_t oid = fn(sch, index, current);
+
+        if (oid != current)
+        {
+            m->setoid(&entry->meta_key, oid);
+        }
+    }
+
+    uint32_t idx = 0;
+
+    for (; entry->attr_list != NULL && idx < entry->attr_count; idx++)
+    {
+        const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(object_type, entry->attr_list[idx].id);
+
+        if (md == NULL || !md->isoidattribute)
+        {
+            continue;
+        }
+
+        sai_attribute_value_t *value = &entry->attr_list[idx].value;
+
+        switch (md->attrvaluetype)
+        {
+            case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+                value->oid = fn(sch, index, value->oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+                sai_metadata_scheduler_oid_list(sch, index, &value->objlist, fn);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+
+                if (value->aclfield.enable)
+                {
+                    value->aclfield.data.oid = fn(sch, index, value->aclfield.data.oid);
+                }
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+
+                if (value->aclfield.enable)
+                {
+                    sai_metadata_scheduler_oid_list(sch, index, &value->aclfield.data.objlist, fn);
+                }
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+
+                if (value->aclaction.enable)
+                {
+                    value->aclaction.parameter.oid = fn(sch, index, value->aclaction.parameter.oid);
+                }
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+
+                if (value->aclaction.enable)
+                {
+                    sai_metadata_scheduler_oid_list(sch, index, &value->aclaction.parameter.objlist, fn);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+static sai_status_t sai_metadata_scheduler_build_maps(
+        _Inout_ sai_metadata_scheduler_t *sch)
+{
+    if (!sai_metadata_scheduler_map_init(&sch->created, sch->count) ||
+            !sai_metadata_scheduler_map_init(&sch->removed, sch->count))
+    {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    uint32_t idx = 0;
+
+    for (; idx < sch->count; idx++)
+    {
+        sai_metadata_scheduler_entry_t *entry = &sch->entries[idx];
+
+        const sai_object_type_info_t *info = sai_metadata_get_object_type_info(entry->meta_key.objecttype);
+
+        if (info == NULL ||
+                (entry->op != SAI_METADATA_SCHEDULER_OP_CREATE && entry->op != SAI_METADATA_SCHEDULER_OP_REMOVE))
+        {
+            SAI_META_LOG_ERROR("entry %u has invalid object type %d or operation %d", idx, entry->meta_key.objecttype, entry->op);
+
+            entry->status = SAI_STATUS_INVALID_PARAMETER;
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        sai_object_id_t oid = entry->meta_key.objectkey.key.object_id;
+
+        if (!info->isobjectid || oid == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        sai_metadata_scheduler_map_t *map = (entry->op == SAI_METADATA_SCHEDULER_OP_CREATE) ? &sch->created : &sch->removed;
+
+        if (!sai_metadata_scheduler_map_insert(map, oid, idx))
+        {
+            SAI_META_LOG_ERROR("entry %u object id 0x%" PRIx64 " is not unique", idx, oid);
+
+            entry->status = SAI_STATUS_INVALID_PARAMETER;
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Assigns layers using Kahn's algorithm, each operation is placed one layer
+ * after the last of its dependencies. Layers of creates start after last
+ * layer of removes.
+ */
+static sai_status_t sai_metadata_scheduler_assign_layers(
+        _Inout_ sai_metadata_scheduler_t *sch)
+{
+    uint32_t *indegree = calloc(sch->count, sizeof(uint32_t));
+    uint32_t *queue = calloc(sch->count, sizeof(uint32_t));
+
+    sch->succ_start = calloc((size_t)sch->count + 1, sizeof(size_t));
+    sch->succ = calloc(sch->edges_count + 1, sizeof(uint32_t));
+
+    if (indegree == NULL || queue == NULL || sch->succ_start == NULL || sch->succ == NULL)
+    {
+        free(indegree);
+        free(queue);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    size_t idx = 0;
+
+    for (; idx < sch->edges_count; idx++)
+    {
+        sch->succ_start[sch->edges[idx].from + 1]++;
+
+        indegree[sch->edges[idx].to]++;
+    }
+
+    for (idx = 0; idx < sch->count; idx++)
+    {
+        sch->succ_start[idx + 1] += sch->succ_start[idx];
+    }
+
+    for (idx = 0; idx < sch->edges_count; idx++)
+    {
+        /* start is used as fill position, so starts are shifted back after loop */
+
+        sch->succ[sch->succ_start[sch->edges[idx].from]++] = sch->edges[idx].to;
+    }
+
+    for (idx = sch->count; idx > 0; idx--)
+    {
+        sch->succ_start[idx] = sch->succ_start[idx - 1];
+    }
+
+    sch->succ_start[0] = 0;
+
+    size_t head = 0;
+    size_t tail = 0;
+
+    uint32_t last_remove_layer = 0;
+
+    bool has_remove = false;
+
+    for (idx = 0; idx < sch->count; idx++)
+    {
+        sch->entries[idx].layer = 0;
+
+        if (indegree[idx] == 0)
+        {
+            queue[tail++] = (uint32_t)idx;
+        }
+    }
+
+    while (head < tail)
+    {
+        uint32_t from = queue[head++];
+
+        sai_metadata_scheduler_entry_t *entry = &sch->entries[from];
+
+        if (entry->op == SAI_METADATA_SCHEDULER_OP_REMOVE)
+        {
+            has_remove = true;
+
+            if (entry->layer > last_remove_layer)
+            {
+                last_remove_layer = entry->layer;
+            }
+        }
+
+        size_t si = sch->succ_start[from];
+
+        for (; si < sch->succ_start[from + 1]; si++)
+        {
+            uint32_t to = sch->succ[si];
+
+            if (sch->entries[to].layer < entry->layer + 1)
+            {
+                sch->entries[to].layer = entry->layer + 1;
+            }
+
+            if (--indegree[to] == 0)
+            {
+                queue[tail++] = to;
+            }
+        }
+    }
+
+    free(queue);
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    for (idx = 0; idx < sch->count; idx++)
+    {
+        if (indegree[idx] != 0)
+        {
+            SAI_META_LOG_ERROR("entry %zu is part of circular dependency", idx);
+
+            sch->entries[idx].status = SAI_STATUS_INVALID_PARAMETER;
+
+            status = SAI_STATUS_INVALID_PARAMETER;
+        }
+        else if (has_remove && sch->entries[idx].op == SAI_METADATA_SCHEDULER_OP_CREATE)
+        {
+            sch->entries[idx].layer += last_remove_layer + 1;
+        }
+    }
+
+    free(indegree);
+
+    return status;
+}
+
+static int sai_metadata_scheduler_item_cmp(
+        _In_ const void *a,
+        _In_ const void *b)
+{
+    const sai_metadata_scheduler_item_t *ia = a;
+    const sai_metadata_scheduler_item_t *ib = b;
+
+    if (ia->layer != ib->layer)
+    {
+        return (ia->layer < ib->layer) ? -1 : 1;
+    }
+
+    if (ia->object_type != ib->object_type)
+    {
+        return (ia->object_type < ib->object_type) ? -1 : 1;
+    }
+
+    if (ia->switch_id != ib->switch_id)
+    {
+        return (ia->switch_id < ib->switch_id) ? -1 : 1;
+    }
+
+    return (ia->index < ib->index) ? -1 : (ia->index > ib->index);
+}
+
+static void sai_metadata_scheduler_execute_group(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ size_t first,
+        _In_ size_t last)
+{
+    sai_object_meta_key_t *meta_key = calloc(last - first, sizeof(sai_object_meta_key_t));
+    uint32_t *attr_count = calloc(last - first, sizeof(uint32_t));
+    const sai_attribute_t **attr_list = calloc(last - first, sizeof(sai_attribute_t*));
+    sai_status_t *statuses = calloc(last - first, sizeof(sai_status_t));
+    uint32_t *indices = calloc(last - first, sizeof(uint32_t));
+
+    uint32_t object_count = 0;
+
+    size_t idx = first;
+
+    if (meta_key == NULL || attr_count == NULL || attr_list == NULL || statuses == NULL || indices == NULL)
+    {
+        for (; idx < last; idx++)
+        {
+            sch->entries[sch->items[idx].index].status = SAI_STATUS_NO_MEMORY;
+        }
+
+        goto out;
+    }
+
+    for (; idx < last; idx++)
+    {
+        uint32_t index = sch->items[idx].index;
+
+        sai_metadata_scheduler_entry_t *entry = &sch->entries[index];
+
+        if (sch->blocked[index])
+        {
+            entry->status = SAI_STATUS_NOT_EXECUTED;
+            continue;
+        }
+
+        if (entry->op == SAI_METADATA_SCHEDULER_OP_CREATE)
+        {
+            sai_metadata_scheduler_for_each_oid(sch, index, sai_metadata_scheduler_oid_translate);
+        }
+
+        meta_key[object_count] = entry->meta_key;
+        attr_count[object_count] = entry->attr_count;
+        attr_list[object_count] = entry->attr_list;
+        statuses[object_count] = SAI_STATUS_NOT_EXECUTED;
+        indices[object_count] = index;
+
+        object_count++;
+    }
+
+    if (object_count == 0)
+    {
+        goto out;
+    }
+
+    const sai_metadata_scheduler_entry_t *head = &sch->entries[indices[0]];
+
+    sai_status_t status = SAI_STATUS_NOT_SUPPORTED;
+
+    /* single object is not worth bulk call overhead */
+
+    if (object_count > 1)
+    {
+        if (head->op == SAI_METADATA_SCHEDULER_OP_CREATE)
+        {
+            status = sai_metadata_generic_bulk_create(sch->apis, head->switch_id, object_count, meta_key,
+                    attr_count, attr_list, SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses);
+        }
+        else
+        {
+            status = sai_metadata_generic_bulk_remove(sch->apis, object_count, meta_key,
+                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses);
+        }
+    }
+
+    uint32_t i = 0;
+
+    if (status == SAI_STATUS_NOT_SUPPORTED || status == SAI_STATUS_NOT_IMPLEMENTED)
+    {
+        for (; i < object_count; i++)
+        {
+            if (head->op == SAI_METADATA_SCHEDULER_OP_CREATE)
+            {
+                statuses[i] = sai_metadata_generic_create(sch->apis, &meta_key[i], head->switch_id, attr_count[i], attr_list[i]);
+            }
+            else
+            {
+                statuses[i] = sai_metadata_generic_remove(sch->apis, &meta_key[i]);
+            }
+        }
+    }
+    else
+    {
+        for (; i < object_count; i++)
+        {
+            if (statuses[i] == SAI_STATUS_NOT_EXECUTED)
+            {
+                statuses[i] = status;
+            }
+        }
+    }
+
+    for (i = 0; i < object_count; i++)
+    {
+        sai_metadata_scheduler_entry_t *entry = &sch->entries[indices[i]];
+
+        entry->status = statuses[i];
+
+        if (entry->op == SAI_METADATA_SCHEDULER_OP_CREATE && statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            entry->meta_key = meta_key[i];
+        }
+    }
+
+out:
+
+    free(meta_key);
+    free(attr_count);
+    free(attr_list);
+    free(statuses);
+    free(indices);
+}
+
+static void* sai_metadata_scheduler_worker(
+        _In_ void *context)
+{
+    sai_metadata_scheduler_t *sch = context;
+
+    while (true)
+    {
+        size_t group = __atomic_fetch_add(&sch->next_group, 1, __ATOMIC_RELAXED);
+
+        if (group >= sch->groups_count)
+        {
+            break;
+        }
+
+        sai_metadata_scheduler_execute_group(sch, sch->groups[group], sch->groups[group + 1]);
+    }
+
+    return NULL;
+}
+
+/*
+ * Groups of single layer are independent, so they are picked by worker
+ * threads from shared counter. Calling thread is one of the workers.
+ */
+static void sai_metadata_scheduler_execute_layer(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ size_t thread_count)
+{
+    pthread_t threads[64];
+
+    size_t started = 0;
+
+    sch->next_group = 0;
+
+    if (thread_count > sizeof(threads)/sizeof(threads[0]))
+    {
+        thread_count = sizeof(threads)/sizeof(threads[0]);
+    }
+
+    for (; started + 1 < thread_count && started + 1 < sch->groups_count; started++)
+    {
+        if (pthread_create(&threads[started], NULL, sai_metadata_scheduler_worker, sch) != 0)
+        {
+            break;
+        }
+    }
+
+    sai_metadata_scheduler_worker(sch);
+
+    size_t idx = 0;
+
+    for (; idx < started; idx++)
+    {
+        pthread_join(threads[idx], NULL);
+    }
+}
+
+static sai_status_t sai_metadata_scheduler_run(
+        _Inout_ sai_metadata_scheduler_t *sch,
+        _In_ size_t thread_count)
+{
+    sch->blocked = calloc(sch->count, sizeof(bool));
+    sch->items = calloc(sch->count, sizeof(sai_metadata_scheduler_item_t));
+    sch->groups = calloc((size_t)sch->count + 1, sizeof(size_t));
+
+    if (sch->blocked == NULL || sch->items == NULL || sch->groups == NULL)
+    {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    uint32_t idx = 0;
+
+    for (; idx < sch->count; idx++)
+    {
+        sch->items[idx].layer = sch->entries[idx].layer;
+        sch->items[idx].object_type = sch->entries[idx].meta_key.objecttype;
+        sch->items[idx].switch_id = (sch->entries[idx].op == SAI_METADATA_SCHEDULER_OP_CREATE) ? sch->entries[idx].switch_id : SAI_NULL_OBJECT_ID;
+        sch->items[idx].index = idx;
+    }
+
+    qsort(sch->items, sch->count, sizeof(sai_metadata_scheduler_item_t), sai_metadata_scheduler_item_cmp);
+
+    size_t first = 0;
+
+    while (first < sch->count)
+    {
+        uint32_t layer = sch->items[first].layer;
+
+        size_t last = first;
+
+        /*
+         * Switch id of create is compared before translation, placeholder of
+         * created switch is translated to the same object id for all objects.
+         */
+
+        sch->groups_count = 0;
+
+        for (; last < sch->count && sch->items[last].layer == layer; last++)
+        {
+            if (last == first ||
+                    sch->items[last].object_type != sch->items[last - 1].object_type ||
+                    sch->items[last].switch_id != sch->items[last - 1].switch_id)
+            {
+                sch->groups[sch->groups_count++] = last;
+            }
+        }
+
+        sch->groups[sch->groups_count] = last;
+
+        sai_metadata_scheduler_execute_layer(sch, thread_count);
+
+        /* block all operations depending on failed ones */
+
+        for (; first < last; first++)
+        {
+            uint32_t index = sch->items[first].index;
+
+            if (sch->entries[index].status == SAI_STATUS_SUCCESS)
+            {
+                continue;
+            }
+
+            size_t si = sch->succ_start[index];
+
+            for (; si < sch->succ_start[index + 1]; si++)
+            {
+                sch->blocked[sch->succ[si]] = true;
+            }
+        }
+    }
+
+    for (idx = 0; idx < sch->count; idx++)
+    {
+        if (sch->entries[idx].status != SAI_STATUS_SUCCESS)
+        {
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_metadata_scheduler_execute(
+        _In_ const sai_apis_t *apis,
+        _In_ uint32_t count,
+        _Inout_ sai_metadata_scheduler_entry_t *entries,
+        _In_ size_t thread_count)
+{
+    if (apis == NULL || (count != 0 && entries == NULL))
+    {
+        SAI_META_LOG_ERROR("apis or entries parameter is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (count == 0)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_metadata_scheduler_t sch;
+
+    memset(&sch, 0, sizeof(sch));
+
+    sch.apis = apis;
+    sch.entries = entries;
+    sch.count = count;
+
+    uint32_t idx = 0;
+
+    for (; idx < count; idx++)
+    {
+        entries[idx].status = SAI_STATUS_NOT_EXECUTED;
+        entries[idx].layer = 0;
+    }
+
+    sai_status_t status = sai_metadata_scheduler_build_maps(&sch);
+
+    for (idx = 0; status == SAI_STATUS_SUCCESS && idx < count; idx++)
+    {
+        sai_metadata_scheduler_for_each_oid(&sch, idx, sai_metadata_scheduler_oid_dependency);
+    }
+
+    if (status == SAI_STATUS_SUCCESS && sch.error)
+    {
+        status = SAI_STATUS_NO_MEMORY;
+    }
+
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        status = sai_metadata_scheduler_assign_layers(&sch);
+    }
+
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        status = sai_metadata_scheduler_run(&sch, thread_count);
+    }
+
+    free(sch.created.slots);
+    free(sch.removed.slots);
+    free(sch.edges);
+    free(sch.succ_start);
+    free(sch.succ);
+    free(sch.blocked);
+    free(sch.items);
+    free(sch.groups);
+
+    return status;
+}
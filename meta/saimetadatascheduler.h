@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saimetadatascheduler.h
+ *
+ * @brief   This module defines SAI Metadata Bulk Scheduler
+ */
+
+#ifndef __SAIMETADATASCHEDULER_H_
+#define __SAIMETADATASCHEDULER_H_
+
+/**
+ * @defgroup SAIMETADATASCHEDULER SAI - Metadata Bulk Scheduler Definitions
+ *
+ * Scheduler executes unordered batch of create and remove operations. Object
+ * level dependency graph is built from object id attributes and object id
+ * members of non object id keys, using attribute metadata. Graph is split
+ * into layers, where each operation is placed in first layer after all
+ * operations it depends on. Operations of each layer are grouped by object
+ * type and switch id, and each group is issued by single call of
+ * sai_metadata_generic_bulk_create() or sai_metadata_generic_bulk_remove().
+ * If object type has no bulk API, group falls back to generic create or
+ * remove of each object.
+ *
+ * Objects created in the same batch are referenced by placeholder object
+ * ids. Caller puts unique placeholder into object id of create operation and
+ * uses it in attributes (and keys) of other operations. Placeholder is
+ * replaced by real object id in object key once object is created, and in
+ * attributes and keys of dependent operations just before they are issued.
+ * Placeholders must not be equal to any existing object id used in batch.
+ * Since attributes are modified, entries should not share attribute lists.
+ *
+ * All removes are executed before all creates. Remove of object which is
+ * referenced by other removed object is executed after the referencing one,
+ * so for removes caller should provide attributes which reference other
+ * objects, if any, the same way as for create.
+ *
+ * Groups of the same layer don't depend on each other, so they can be
+ * optionally executed in parallel.
+ *
+ * @{
+ */
+
+/**
+ * @brief Scheduled operation
+ */
+typedef enum _sai_metadata_scheduler_op_t
+{
+    /**
+     * @brief Create object
+     */
+    SAI_METADATA_SCHEDULER_OP_CREATE,
+
+    /**
+     * @brief Remove object
+     */
+    SAI_METADATA_SCHEDULER_OP_REMOVE,
+
+} sai_metadata_scheduler_op_t;
+
+/**
+ * @brief Scheduled operation entry
+ */
+typedef struct _sai_metadata_scheduler_entry_t
+{
+    /**
+     * @brief Operation.
+     */
+    sai_metadata_scheduler_op_t op;
+
+    /**
+     * @brief Object type and key, for create of object id object this is placeholder on input and created object id on output.
+     */
+    sai_object_meta_key_t meta_key;
+
+    /**
+     * @brief Switch id passed to create, can be placeholder of switch created in the same batch.
+     */
+    sai_object_id_t switch_id;
+
+    /**
+     * @brief Number of attributes.
+     */
+    uint32_t attr_count;
+
+    /**
+     * @brief Attributes, placeholders are replaced by created object ids.
+     */
+    sai_attribute_t *attr_list;
+
+    /**
+     * @brief Status of operation, #SAI_STATUS_NOT_EXECUTED if operation it depends on failed.
+     */
+    sai_status_t status;
+
+    /**
+     * @brief Layer in which operation was issued.
+     */
+    uint32_t layer;
+
+} sai_metadata_scheduler_entry_t;
+
+/**
+ * @brief Execute batch of create and remove operations
+ *
+ * @param[in] apis SAI API method tables
+ * @param[in] count Number of operations
+ * @param[inout] entries Operations
+ * @param[in] thread_count Maximum number of groups executed in parallel, 0 or 1 to execute sequentially
+ *
+ * @return #SAI_STATUS_SUCCESS if all operations succeeded,
+ * #SAI_STATUS_INVALID_PARAMETER if batch contains duplicate placeholders or
+ * circular dependency (nothing is executed then), #SAI_STATUS_FAILURE if any
+ * operation failed
+ */
+extern sai_status_t sai_metadata_scheduler_execute(
+        _In_ const sai_apis_t *apis,
+        _In_ uint32_t count,
+        _Inout_ sai_metadata_scheduler_entry_t *entries,
+        _In_ size_t thread_count);
+
+/**
+ * @}
+ */
+#endif /** __SAIMETADATASCHEDULER_H_ */
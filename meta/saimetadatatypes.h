@@ -764,6 +764,21 @@ typedef struct _sai_attr_condition_t
 
 } sai_attr_condition_t;
 
+/**
+ * @brief Function definition for checking compiled attribute conditions.
+ *
+ * Function is generated for each attribute conditions and valid only
+ * conditions list and evaluates them directly, without interpreting list.
+ *
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Attribute list, if condition attribute is not on the list then default value is used
+ *
+ * @return True if conditions are met, false otherwise
+ */
+typedef bool (*sai_meta_attr_condition_fn)(
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
 /**
  * @brief Defines enum flags type, if enum contains flags.
  *
@@ -1285,6 +1300,20 @@ typedef struct _sai_attr_metadata_t
      */
     bool                                        isconditionrelaxed;
 
+    /**
+     * @brief Compiled conditions.
+     *
+     * Evaluates conditions list, NULL if attribute is not conditional.
+     */
+    const sai_meta_attr_condition_fn            conditionfn;
+
+    /**
+     * @brief Compiled valid only conditions.
+     *
+     * Evaluates valid only list, NULL if attribute is not valid only.
+     */
+    const sai_meta_attr_condition_fn            validonlyfn;
+
 } sai_attr_metadata_t;
 
 /*
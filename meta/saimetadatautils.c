@@ -110,76 +110,131 @@ const sai_attr_metadata_t* sai_metadata_get_attr_metadata(
     return NULL;
 }
 
-const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name(
-        _In_ const char *attr_id_name)
+/*
+ * Hash functions below must match AttrIdNameHash() and AttrIdNameHashMix()
+ * in parse.pl which generates perfect hash table of attribute id names.
+ */
+
+#define SAI_METADATA_ATTR_ID_NAME_HASH_SEED_BUCKET  1
+#define SAI_METADATA_ATTR_ID_NAME_HASH_SEED_F1      2
+#define SAI_METADATA_ATTR_ID_NAME_HASH_SEED_F2      3
+
+static uint32_t sai_metadata_attr_id_name_hash(
+        _In_ const char *attr_id_name,
+        _In_ size_t length)
 {
-    if (attr_id_name == NULL)
+    /* FNV-1a 32 bit, processing 4 bytes at a time */
+
+    const uint8_t *data = (const uint8_t*)attr_id_name;
+
+    uint32_t hash = 0x811C9DC5;
+
+    size_t idx = 0;
+
+    for (; idx + 4 <= length; idx += 4)
     {
-        return NULL;
+        uint32_t word = (uint32_t)data[idx] |
+            (uint32_t)data[idx + 1] << 8 |
+            (uint32_t)data[idx + 2] << 16 |
+            (uint32_t)data[idx + 3] << 24;
+
+        hash = (hash ^ word) * 0x01000193;
     }
 
-    /* use binary search */
+    for (; idx < length; idx++)
+    {
+        hash = (hash ^ data[idx]) * 0x01000193;
+    }
 
-    ssize_t first = 0;
-    ssize_t last = (ssize_t)(sai_metadata_attr_sorted_by_id_name_count - 1);
+    return hash;
+}
 
-    while (first <= last)
-    {
-        ssize_t middle = (first + last) / 2;
+static uint32_t sai_metadata_attr_id_name_hash_mix(
+        _In_ uint32_t hash,
+        _In_ uint32_t seed,
+        _In_ uint32_t range)
+{
+    hash ^= seed;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35;
+    hash ^= hash >> 16;
 
-        int res = strcmp(attr_id_name, sai_metadata_attr_sorted_by_id_name[middle]->attridname);
+    /* reduce to [0, range) without division */
 
-        if (res > 0)
-        {
-            first = middle + 1;
-        }
-        else if (res < 0)
-        {
-            last = middle - 1;
-        }
-        else
-        {
-            /* found */
+    return (uint32_t)(((uint64_t)hash * range) >> 32);
+}
 
-            return sai_metadata_attr_sorted_by_id_name[middle];
-        }
+static const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name_length(
+        _In_ const char *attr_id_name,
+        _In_ size_t length)
+{
+    uint32_t count = (uint32_t)sai_metadata_attr_sorted_by_id_name_count;
+
+    if (count == 0)
+    {
+        return NULL;
     }
 
-    /* not found */
+    uint32_t hash = sai_metadata_attr_id_name_hash(attr_id_name, length);
+
+    uint32_t bucket = sai_metadata_attr_id_name_hash_mix(hash, SAI_METADATA_ATTR_ID_NAME_HASH_SEED_BUCKET,
+            (uint32_t)sai_metadata_attr_id_name_hash_displacements_count);
+
+    uint32_t f1 = sai_metadata_attr_id_name_hash_mix(hash, SAI_METADATA_ATTR_ID_NAME_HASH_SEED_F1, count);
+    uint32_t f2 = sai_metadata_attr_id_name_hash_mix(hash, SAI_METADATA_ATTR_ID_NAME_HASH_SEED_F2, count);
+
+    /* displacement holds 2 components, each less than count which is less than 2^16 */
+
+    uint32_t disp = sai_metadata_attr_id_name_hash_displacements[bucket];
+
+    uint32_t slot = (f1 + (disp >> 16) * f2 + (disp & 0xFFFF)) % count;
+
+    const sai_attr_metadata_t* md = sai_metadata_attr_by_id_name_hash[slot];
+
+    /* hash is perfect only for attribute names, so name must be compared */
+
+    if (strncmp(md->attridname, attr_id_name, length) == 0 && md->attridname[length] == 0)
+    {
+        return md;
+    }
 
     return NULL;
 }
 
-static int sai_metadata_attr_id_name_cmp(
-        _In_ const char * str1,
-        _In_ const char * str2)
+const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name(
+        _In_ const char *attr_id_name)
 {
-    char c1 = 0;
-    char c2 = 0;
+    if (attr_id_name == NULL)
+    {
+        return NULL;
+    }
 
-    while (true)
+    return sai_metadata_get_attr_metadata_by_attr_id_name_length(attr_id_name, strlen(attr_id_name));
+}
+
+const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name_ext(
+        _In_ const char *attr_id_name)
+{
+    if (attr_id_name == NULL)
     {
-        c1 = *str1++;
-        c2 = *str2++;
+        return NULL;
+    }
 
-        if (sai_serialize_is_char_allowed(c1) || sai_serialize_is_char_allowed(c2) || c1 != c2)
-        {
-            if (sai_serialize_is_char_allowed(c1))
-            {
-                c1 = 0;
-            }
+    /* attribute id name ends on first character allowed after serialized value */
 
-            if (sai_serialize_is_char_allowed(c2))
-            {
-                c2 = 0;
-            }
+    size_t length = 0;
 
-            return c1 - c2;
-        }
+    while (!sai_serialize_is_char_allowed(attr_id_name[length]))
+    {
+        length++;
     }
+
+    return sai_metadata_get_attr_metadata_by_attr_id_name_length(attr_id_name, length);
 }
 
-const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name_ext(
+const sai_attr_metadata_t* sai_metadata_get_ignored_attr_metadata_by_attr_id_name(
         _In_ const char *attr_id_name)
 {
     if (attr_id_name == NULL)
@@ -190,13 +245,13 @@ const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name_ext(
     /* use binary search */
 
     ssize_t first = 0;
-    ssize_t last = (ssize_t)(sai_metadata_attr_sorted_by_id_name_count - 1);
+    ssize_t last = (ssize_t)(sai_metadata_ignored_attr_by_id_name_count - 1);
 
     while (first <= last)
     {
         ssize_t middle = (first + last) / 2;
 
-        int res = sai_metadata_attr_id_name_cmp(attr_id_name, sai_metadata_attr_sorted_by_id_name[middle]->attridname);
+        int res = strcmp(attr_id_name, sai_metadata_ignored_attr_id_names[middle]);
 
         if (res > 0)
         {
@@ -210,7 +265,7 @@ const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name_ext(
         {
             /* found */
 
-            return sai_metadata_attr_sorted_by_id_name[middle];
+            return sai_metadata_ignored_attr_by_id_name[middle];
         }
     }
 
@@ -219,49 +274,6 @@ const sai_attr_metadata_t* sai_metadata_get_attr_metadata_by_attr_id_name_ext(
     return NULL;
 }
 
-const sai_attr_metadata_t* sai_metadata_get_ignored_attr_metadata_by_attr_id_name(
-        _In_ const char *attr_id_name)
-{
-    if (attr_id_name == NULL)
-    {
-        return NULL;
-    }
-
-    sai_object_type_t ot;
-
-    /*
-     * Since we don't have list of ignored attributes, enumerate all objects
-     * and attribute enums to find ignored values.
-     */
-
-    for (ot = SAI_OBJECT_TYPE_NULL; ot < SAI_OBJECT_TYPE_EXTENSIONS_MAX; ot++)
-    {
-        const sai_object_type_info_t* oti = sai_metadata_get_object_type_info(ot);
-
-        if (oti == NULL)
-            continue;
-
-        const sai_enum_metadata_t* em = oti->enummetadata;
-
-        if (em->ignorevaluesnames)
-        {
-            size_t i;
-
-            for (i = 0; em->ignorevaluesnames[i] != NULL; i++)
-            {
-                if (strcmp(attr_id_name, em->ignorevaluesnames[i]) == 0)
-                {
-                    const char* name = sai_metadata_get_enum_value_name(em, em->ignorevalues[i]);
-
-                    return sai_metadata_get_attr_metadata_by_attr_id_name(name);
-                }
-            }
-        }
-    }
-
-    return NULL;
-}
-
 const char* sai_metadata_get_enum_value_name(
         _In_ const sai_enum_metadata_t* metadata,
         _In_ int value)
@@ -521,64 +533,95 @@ static bool sai_metadata_is_mixed_condition_list_met(
     return value;
 }
 
-bool sai_metadata_is_condition_met(
+static bool sai_metadata_is_condition_list_met(
         _In_ const sai_attr_metadata_t *md,
+        _In_ sai_attr_condition_type_t type,
+        _In_ size_t length,
+        _In_ const sai_attr_condition_t* const* list,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
 {
-    /* attr list can be NULL, condition could be based on default value */
-
-    if (md == NULL || !md->isconditional)
-    {
-        return false;
-    }
-
-    switch (md->conditiontype)
+    switch (type)
     {
         case SAI_ATTR_CONDITION_TYPE_AND:
-            return sai_metadata_is_and_condition_list_met(md, md->conditionslength, md->conditions, attr_count, attr_list);
+            return sai_metadata_is_and_condition_list_met(md, length, list, attr_count, attr_list);
 
         case SAI_ATTR_CONDITION_TYPE_OR:
-            return sai_metadata_is_or_condition_list_met(md, md->conditionslength, md->conditions, attr_count, attr_list);
+            return sai_metadata_is_or_condition_list_met(md, length, list, attr_count, attr_list);
 
         case SAI_ATTR_CONDITION_TYPE_MIXED:
-            return sai_metadata_is_mixed_condition_list_met(md, md->conditionslength, md->conditions, attr_count, attr_list);
+            return sai_metadata_is_mixed_condition_list_met(md, length, list, attr_count, attr_list);
 
         default:
-            SAI_META_LOG_ERROR("condition type %d on %s is not supported yet, FIXME", md->conditiontype, md->attridname);
+            SAI_META_LOG_ERROR("condition type %d on %s is not supported yet, FIXME", type, md->attridname);
             return false;
     }
 }
 
-bool sai_metadata_is_validonly_met(
+bool sai_metadata_interpret_condition(
         _In_ const sai_attr_metadata_t *md,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
 {
-    /* attr list can be NULL, condition could be based on default value */
+    if (md == NULL || !md->isconditional)
+    {
+        return false;
+    }
 
+    return sai_metadata_is_condition_list_met(md, md->conditiontype, md->conditionslength, md->conditions, attr_count, attr_list);
+}
+
+bool sai_metadata_interpret_validonly(
+        _In_ const sai_attr_metadata_t *md,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
     if (md == NULL || !md->isvalidonly)
     {
         return false;
     }
 
-    switch (md->validonlytype)
+    return sai_metadata_is_condition_list_met(md, md->validonlytype, md->validonlylength, md->validonly, attr_count, attr_list);
+}
+
+bool sai_metadata_is_condition_met(
+        _In_ const sai_attr_metadata_t *md,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    /* attr list can be NULL, condition could be based on default value */
+
+    if (md == NULL || !md->isconditional)
     {
-        case SAI_ATTR_CONDITION_TYPE_AND:
-            return sai_metadata_is_and_condition_list_met(md, md->validonlylength, md->validonly, attr_count, attr_list);
+        return false;
+    }
 
-        case SAI_ATTR_CONDITION_TYPE_OR:
-            return sai_metadata_is_or_condition_list_met(md, md->validonlylength, md->validonly, attr_count, attr_list);
+    if (md->conditionfn != NULL)
+    {
+        return md->conditionfn(attr_count, attr_list);
+    }
 
-        case SAI_ATTR_CONDITION_TYPE_MIXED:
-            return sai_metadata_is_mixed_condition_list_met(md, md->validonlylength, md->validonly, attr_count, attr_list);
+    return sai_metadata_interpret_condition(md, attr_count, attr_list);
+}
 
-        default:
-            SAI_META_LOG_ERROR("validonly type %d on %s is not supported yet, FIXME", md->validonlytype, md->attridname);
-            return false;
+bool sai_metadata_is_validonly_met(
+        _In_ const sai_attr_metadata_t *md,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    /* attr list can be NULL, condition could be based on default value */
+
+    if (md == NULL || !md->isvalidonly)
+    {
+        return false;
     }
 
-    return false;
+    if (md->validonlyfn != NULL)
+    {
+        return md->validonlyfn(attr_count, attr_list);
+    }
+
+    return sai_metadata_interpret_validonly(md, attr_count, attr_list);
 }
 
 sai_api_version_t sai_metadata_query_api_version(void)
@@ -72,6 +72,8 @@ extern const sai_attr_metadata_t* sai_metadata_get_attr_metadata(
 /**
  * @brief Gets attribute metadata based on attribute id name
  *
+ * Lookup uses auto generated minimal perfect hash of all attribute id names.
+ *
  * @param[in] attr_id_name Attribute id name
  *
  * @return Pointer to object metadata or NULL in case of failure
@@ -159,6 +161,44 @@ extern bool sai_metadata_is_object_type_valid(
 extern bool sai_metadata_is_object_type_oid(
         _In_ sai_object_type_t object_type);
 
+/**
+ * @brief Check if condition met using conditions list interpreter.
+ *
+ * Same as sai_metadata_is_condition_met, but instead of compiled conditions
+ * from attribute metadata, conditions list is interpreted. Used to cross
+ * check compiled conditions.
+ *
+ * @param[in] metadata Metadata of attribute that we need to check.
+ * @param[in] attr_count Number of attributes.
+ * @param[in] attr_list Attribute list to check. All attributes must
+ * belong to the same object type as metadata parameter.
+ *
+ * @return True if condition is in force, false otherwise.
+ */
+extern bool sai_metadata_interpret_condition(
+        _In_ const sai_attr_metadata_t *metadata,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
+/**
+ * @brief Check if valid only condition met using conditions list interpreter.
+ *
+ * Same as sai_metadata_is_validonly_met, but instead of compiled conditions
+ * from attribute metadata, valid only list is interpreted. Used to cross
+ * check compiled conditions.
+ *
+ * @param[in] metadata Metadata of attribute that we need to check.
+ * @param[in] attr_count Number of attributes.
+ * @param[in] attr_list Attribute list to check. All attributes must
+ * belong to the same object type as metadata parameter.
+ *
+ * @return True if valid only condition is in force, false otherwise.
+ */
+extern bool sai_metadata_interpret_validonly(
+        _In_ const sai_attr_metadata_t *metadata,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
 /**
  * @brief Check if condition met.
  *
@@ -0,0 +1,731 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saireplay.c
+ *
+ * @brief   Defines SAI API recorder log replay
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_nanosleep, getopt */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+/*
+ * Replays log created by API recorder through generic quad API of vendor
+ * library linked to this tool. Object ids created or returned by get during
+ * replay differ from recorded ones, so mapping from recorded to replayed
+ * object ids is kept and all object ids in keys and attributes are translated
+ * before each call.
+ */
+
+#define REPLAY_LOG_ERROR(format, ...)\
+    fprintf(stderr, "ERROR: " format "\n", ##__VA_ARGS__);
+
+#define REPLAY_LOG_WARN(format, ...)\
+    if (verbose) { fprintf(stderr, "WARN: " format "\n", ##__VA_ARGS__); }
+
+typedef struct _oid_map_t {
+
+    sai_object_id_t* keys;
+
+    sai_object_id_t* values;
+
+    size_t size;
+
+    size_t count;
+
+} oid_map_t;
+
+typedef struct _replay_stats_t {
+
+    uint64_t records;
+
+    uint64_t calls;
+
+    uint64_t skipped;
+
+    uint64_t mismatches;
+
+} replay_stats_t;
+
+bool verbose = false;
+
+bool preserve_timing = false;
+
+bool skip_get = false;
+
+oid_map_t oid_map = { NULL, NULL, 0, 0 };
+
+replay_stats_t replay_stats = { 0, 0, 0, 0 };
+
+uint64_t first_timestamp = 0;
+
+uint64_t start_time = 0;
+
+const char* const op_names[] = { "create", "remove", "set", "get" };
+
+uint64_t monotonic_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+size_t oid_map_slot(
+        _In_ sai_object_id_t oid)
+{
+    uint64_t hash = oid * 0x9E3779B97F4A7C15ULL;
+
+    return (size_t)(hash ^ (hash >> 32)) & (oid_map.size - 1);
+}
+
+void oid_map_insert(
+        _In_ sai_object_id_t old_oid,
+        _In_ sai_object_id_t new_oid)
+{
+    if (old_oid == SAI_NULL_OBJECT_ID || new_oid == SAI_NULL_OBJECT_ID)
+    {
+        return;
+    }
+
+    if (2 * (oid_map.count + 1) > oid_map.size)
+    {
+        oid_map_t prev = oid_map;
+
+        oid_map.size = prev.size ? 2 * prev.size : 1024;
+        oid_map.count = 0;
+        oid_map.keys = calloc(oid_map.size, sizeof(sai_object_id_t));
+        oid_map.values = calloc(oid_map.size, sizeof(sai_object_id_t));
+
+        if (oid_map.keys == NULL || oid_map.values == NULL)
+        {
+            REPLAY_LOG_ERROR("failed to allocate object id map");
+            exit(1);
+        }
+
+        size_t idx;
+
+        for (idx = 0; idx < prev.size; idx++)
+        {
+            if (prev.keys[idx] != SAI_NULL_OBJECT_ID)
+            {
+                oid_map_insert(prev.keys[idx], prev.values[idx]);
+            }
+        }
+
+        free(prev.keys);
+        free(prev.values);
+    }
+
+    size_t slot = oid_map_slot(old_oid);
+
+    while (oid_map.keys[slot] != SAI_NULL_OBJECT_ID && oid_map.keys[slot] != old_oid)
+    {
+        slot = (slot + 1) & (oid_map.size - 1);
+    }
+
+    if (oid_map.keys[slot] == SAI_NULL_OBJECT_ID)
+    {
+        oid_map.keys[slot] = old_oid;
+        oid_map.count++;
+    }
+
+    oid_map.values[slot] = new_oid;
+}
+
+sai_object_id_t oid_map_translate(
+        _In_ sai_object_id_t old_oid)
+{
+    if (old_oid == SAI_NULL_OBJECT_ID || oid_map.size == 0)
+    {
+        return old_oid;
+    }
+
+    size_t slot = oid_map_slot(old_oid);
+
+    while (oid_map.keys[slot] != SAI_NULL_OBJECT_ID)
+    {
+        if (oid_map.keys[slot] == old_oid)
+        {
+            return oid_map.values[slot];
+        }
+
+        slot = (slot + 1) & (oid_map.size - 1);
+    }
+
+    /* object was not created or discovered during replay, use it as is */
+
+    return old_oid;
+}
+
+void translate_list(
+        _Inout_ sai_object_list_t* list)
+{
+    uint32_t idx;
+
+    if (list->list == NULL)
+    {
+        return;
+    }
+
+    for (idx = 0; idx < list->count; idx++)
+    {
+        list->list[idx] = oid_map_translate(list->list[idx]);
+    }
+}
+
+void translate_attributes(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t* attr_list)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < attr_count; idx++)
+    {
+        const sai_attr_metadata_t* md = sai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+
+        if (md == NULL)
+        {
+            continue;
+        }
+
+        sai_attribute_value_t* value = &attr_list[idx].value;
+
+        switch (md->attrvaluetype)
+        {
+            case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+                value->oid = oid_map_translate(value->oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+                translate_list(&value->objlist);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+                value->aclfield.data.oid = oid_map_translate(value->aclfield.data.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+                translate_list(&value->aclfield.data.objlist);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+                value->aclaction.parameter.oid = oid_map_translate(value->aclaction.parameter.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+                translate_list(&value->aclaction.parameter.objlist);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_POINTER:
+
+                /* recorded pointers are not valid in this process */
+
+                value->ptr = NULL;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void translate_key(
+        _Inout_ sai_object_meta_key_t* meta_key)
+{
+    const sai_object_type_info_t* info = sai_metadata_get_object_type_info(meta_key->objecttype);
+
+    if (info->isobjectid)
+    {
+        meta_key->objectkey.key.object_id = oid_map_translate(meta_key->objectkey.key.object_id);
+        return;
+    }
+
+    size_t idx;
+
+    for (idx = 0; idx < info->structmemberscount; idx++)
+    {
+        const sai_struct_member_info_t* m = info->structmembers[idx];
+
+        if (m->membervaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID)
+        {
+            m->setoid(meta_key, oid_map_translate(m->getoid(meta_key)));
+        }
+    }
+}
+
+/*
+ * Get is used to discover objects created by switch, like ports or queues,
+ * so object ids returned by get are mapped to recorded ones.
+ */
+
+size_t get_object_ids(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t* attr_list,
+        _Out_ sai_object_id_t* oids)
+{
+    size_t count = 0;
+    uint32_t idx;
+
+    for (idx = 0; idx < attr_count; idx++)
+    {
+        const sai_attr_metadata_t* md = sai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+
+        if (md == NULL)
+        {
+            continue;
+        }
+
+        const sai_attribute_value_t* value = &attr_list[idx].value;
+
+        if (md->attrvaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID)
+        {
+            if (oids)
+            {
+                oids[count] = value->oid;
+            }
+
+            count++;
+        }
+        else if (md->attrvaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_LIST && value->objlist.list)
+        {
+            if (oids)
+            {
+                memcpy(oids + count, value->objlist.list, value->objlist.count * sizeof(sai_object_id_t));
+            }
+
+            count += value->objlist.count;
+        }
+    }
+
+    return count;
+}
+
+void replay_wait(
+        _In_ uint64_t timestamp)
+{
+    if (first_timestamp == 0)
+    {
+        first_timestamp = timestamp;
+    }
+
+    if (!preserve_timing || timestamp < first_timestamp)
+    {
+        return;
+    }
+
+    uint64_t deadline = start_time + (timestamp - first_timestamp);
+
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline % 1000000000ULL);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+    {
+        /* interrupted by signal, continue sleeping */
+    }
+}
+
+void replay_check_status(
+        _In_ const sai_metadata_recorder_record_t* record,
+        _In_ sai_status_t status)
+{
+    if (status == record->status)
+    {
+        return;
+    }
+
+    replay_stats.mismatches++;
+
+    REPLAY_LOG_WARN("%s %s: replayed status %d, recorded status %d",
+            (record->op <= SAI_METADATA_RECORDER_OP_GET) ? op_names[record->op] : "unknown",
+            sai_metadata_get_object_type_info(record->meta_key.objecttype)->objecttypename,
+            status, record->status);
+}
+
+void replay_get(
+        _Inout_ sai_metadata_recorder_record_t* record)
+{
+    sai_object_meta_key_t meta_key = record->meta_key;
+
+    translate_key(&meta_key);
+
+    size_t count = get_object_ids(meta_key.objecttype, record->attr_count, record->attr_list, NULL);
+
+    sai_object_id_t* old_oids = calloc(count + 1, sizeof(sai_object_id_t));
+    sai_object_id_t* new_oids = calloc(count + 1, sizeof(sai_object_id_t));
+
+    if (old_oids == NULL || new_oids == NULL)
+    {
+        REPLAY_LOG_ERROR("failed to allocate object ids");
+        exit(1);
+    }
+
+    get_object_ids(meta_key.objecttype, record->attr_count, record->attr_list, old_oids);
+
+    sai_status_t status = sai_metadata_generic_get(&sai_metadata_apis, &meta_key, record->attr_count, record->attr_list);
+
+    replay_check_status(record, status);
+
+    if (status == SAI_STATUS_SUCCESS && record->status == SAI_STATUS_SUCCESS &&
+            get_object_ids(meta_key.objecttype, record->attr_count, record->attr_list, NULL) == count)
+    {
+        size_t idx;
+
+        get_object_ids(meta_key.objecttype, record->attr_count, record->attr_list, new_oids);
+
+        for (idx = 0; idx < count; idx++)
+        {
+            oid_map_insert(old_oids[idx], new_oids[idx]);
+        }
+    }
+
+    free(old_oids);
+    free(new_oids);
+}
+
+void replay_single(
+        _Inout_ sai_metadata_recorder_record_t* record)
+{
+    sai_object_meta_key_t meta_key = record->meta_key;
+    sai_status_t status;
+
+    replay_wait(record->timestamp);
+
+    replay_stats.calls++;
+
+    switch (record->op)
+    {
+        case SAI_METADATA_RECORDER_OP_CREATE:
+
+            if (!sai_metadata_get_object_type_info(meta_key.objecttype)->isobjectid)
+            {
+                translate_key(&meta_key);
+            }
+
+            translate_attributes(meta_key.objecttype, record->attr_count, record->attr_list);
+
+            status = sai_metadata_generic_create(&sai_metadata_apis, &meta_key,
+                    oid_map_translate(record->switch_id), record->attr_count, record->attr_list);
+
+            if (status == SAI_STATUS_SUCCESS && sai_metadata_get_object_type_info(meta_key.objecttype)->isobjectid)
+            {
+                oid_map_insert(record->meta_key.objectkey.key.object_id, meta_key.objectkey.key.object_id);
+            }
+
+            break;
+
+        case SAI_METADATA_RECORDER_OP_REMOVE:
+
+            translate_key(&meta_key);
+
+            status = sai_metadata_generic_remove(&sai_metadata_apis, &meta_key);
+            break;
+
+        case SAI_METADATA_RECORDER_OP_SET:
+
+            if (record->attr_count != 1)
+            {
+                replay_stats.skipped++;
+                return;
+            }
+
+            translate_key(&meta_key);
+            translate_attributes(meta_key.objecttype, record->attr_count, record->attr_list);
+
+            status = sai_metadata_generic_set(&sai_metadata_apis, &meta_key, record->attr_list);
+            break;
+
+        case SAI_METADATA_RECORDER_OP_GET:
+
+            replay_get(record);
+            return;
+
+        default:
+
+            REPLAY_LOG_WARN("unknown operation %d", record->op);
+
+            replay_stats.skipped++;
+            return;
+    }
+
+    replay_check_status(record, status);
+}
+
+void replay_bulk(
+        _Inout_ sai_metadata_recorder_record_t* records,
+        _In_ uint32_t count)
+{
+    sai_object_meta_key_t* meta_keys = calloc(count, sizeof(sai_object_meta_key_t));
+    uint32_t* attr_counts = calloc(count, sizeof(uint32_t));
+    const sai_attribute_t** attr_lists = calloc(count, sizeof(sai_attribute_t*));
+    sai_attribute_t* attrs = calloc(count, sizeof(sai_attribute_t));
+    sai_status_t* statuses = calloc(count, sizeof(sai_status_t));
+
+    if (!meta_keys || !attr_counts || !attr_lists || !attrs || !statuses)
+    {
+        REPLAY_LOG_ERROR("failed to allocate bulk of %u objects", count);
+        exit(1);
+    }
+
+    sai_metadata_recorder_op_t op = records[0].op;
+    sai_object_type_t object_type = records[0].meta_key.objecttype;
+
+    bool isobjectid = sai_metadata_get_object_type_info(object_type)->isobjectid;
+
+    uint32_t idx;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        meta_keys[idx] = records[idx].meta_key;
+
+        if (op != SAI_METADATA_RECORDER_OP_CREATE || !isobjectid)
+        {
+            translate_key(&meta_keys[idx]);
+        }
+
+        translate_attributes(object_type, records[idx].attr_count, records[idx].attr_list);
+
+        attr_counts[idx] = records[idx].attr_count;
+        attr_lists[idx] = records[idx].attr_list;
+
+        if (records[idx].attr_count == 1)
+        {
+            attrs[idx] = records[idx].attr_list[0];
+        }
+    }
+
+    replay_wait(records[0].timestamp);
+
+    replay_stats.calls++;
+
+    switch (op)
+    {
+        case SAI_METADATA_RECORDER_OP_CREATE:
+
+            sai_metadata_generic_bulk_create(&sai_metadata_apis, oid_map_translate(records[0].switch_id),
+                    count, meta_keys, attr_counts, attr_lists, records[0].bulk_mode, statuses);
+
+            for (idx = 0; isobjectid && idx < count; idx++)
+            {
+                if (statuses[idx] == SAI_STATUS_SUCCESS)
+                {
+                    oid_map_insert(records[idx].meta_key.objectkey.key.object_id, meta_keys[idx].objectkey.key.object_id);
+                }
+            }
+
+            break;
+
+        case SAI_METADATA_RECORDER_OP_REMOVE:
+
+            sai_metadata_generic_bulk_remove(&sai_metadata_apis, count, meta_keys, records[0].bulk_mode, statuses);
+            break;
+
+        default:
+
+            sai_metadata_generic_bulk_set(&sai_metadata_apis, count, meta_keys, attrs, records[0].bulk_mode, statuses);
+            break;
+    }
+
+    for (idx = 0; idx < count; idx++)
+    {
+        replay_check_status(&records[idx], statuses[idx]);
+    }
+
+    free(meta_keys);
+    free(attr_counts);
+    free(attr_lists);
+    free(attrs);
+    free(statuses);
+}
+
+int replay(
+        _In_ const char* path)
+{
+    sai_metadata_recorder_reader_t reader;
+    sai_metadata_recorder_record_t record;
+
+    sai_status_t status = sai_metadata_recorder_reader_open(path, &reader);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        REPLAY_LOG_ERROR("failed to open log %s", path);
+        return 1;
+    }
+
+    start_time = monotonic_now();
+
+    while ((status = sai_metadata_recorder_reader_next(&reader, &record)) == SAI_STATUS_SUCCESS)
+    {
+        replay_stats.records++;
+
+        if (skip_get && record.op == SAI_METADATA_RECORDER_OP_GET)
+        {
+            replay_stats.skipped++;
+        }
+        else if (record.bulk_count > 1 && record.op != SAI_METADATA_RECORDER_OP_GET)
+        {
+            /* records of single bulk call are always stored together */
+
+            sai_metadata_recorder_record_t* records = calloc(record.bulk_count, sizeof(sai_metadata_recorder_record_t));
+
+            if (records == NULL)
+            {
+                REPLAY_LOG_ERROR("failed to allocate bulk of %u records", record.bulk_count);
+                exit(1);
+            }
+
+            uint32_t count = 1;
+
+            records[0] = record;
+
+            while (count < record.bulk_count &&
+                    (status = sai_metadata_recorder_reader_next(&reader, &records[count])) == SAI_STATUS_SUCCESS)
+            {
+                count++;
+            }
+
+            replay_stats.records += count - 1;
+
+            replay_bulk(records, count);
+
+            free(records);
+
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                break;
+            }
+        }
+        else
+        {
+            replay_single(&record);
+        }
+
+        sai_metadata_recorder_reader_release(&reader);
+    }
+
+    sai_metadata_recorder_reader_close(&reader);
+
+    uint64_t elapsed = monotonic_now() - start_time;
+
+    double seconds = (double)elapsed / 1e9;
+
+    printf("replayed %" PRIu64 " records in %" PRIu64 " calls, %" PRIu64 " skipped, %" PRIu64 " status mismatches\n",
+            replay_stats.records, replay_stats.calls, replay_stats.skipped, replay_stats.mismatches);
+
+    printf("elapsed %.3f s, %.0f records/s, %.0f calls/s\n",
+            seconds,
+            seconds > 0 ? (double)replay_stats.records / seconds : 0,
+            seconds > 0 ? (double)replay_stats.calls / seconds : 0);
+
+    return (status == SAI_STATUS_ITEM_NOT_FOUND) ? 0 : 1;
+}
+
+const char* profile_get_value(
+        _In_ sai_switch_profile_id_t profile_id,
+        _In_ const char* variable)
+{
+    return NULL;
+}
+
+int profile_get_next_value(
+        _In_ sai_switch_profile_id_t profile_id,
+        _Out_ const char** variable,
+        _Out_ const char** value)
+{
+    return -1;
+}
+
+void usage(
+        _In_ const char* name)
+{
+    fprintf(stderr, "usage: %s [-t] [-g] [-v] log\n", name);
+    fprintf(stderr, "    -t  preserve recorded timing, by default log is replayed at full speed\n");
+    fprintf(stderr, "    -g  skip get operations\n");
+    fprintf(stderr, "    -v  print status mismatches\n");
+}
+
+int main(int argc, char **argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "tgvh")) != -1)
+    {
+        switch (opt)
+        {
+            case 't':
+                preserve_timing = true;
+                break;
+
+            case 'g':
+                skip_get = true;
+                break;
+
+            case 'v':
+                verbose = true;
+                break;
+
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind + 1 != argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    sai_service_method_table_t services;
+
+    services.profile_get_value = profile_get_value;
+    services.profile_get_next_value = profile_get_next_value;
+
+    sai_status_t status = sai_api_initialize(0, &services);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        REPLAY_LOG_ERROR("failed to initialize sai api: %d", status);
+        return 1;
+    }
+
+    sai_metadata_apis_query(sai_api_query, &sai_metadata_apis);
+
+    int rc = replay(argv[optind]);
+
+    sai_api_uninitialize();
+
+    free(oid_map.keys);
+    free(oid_map.values);
+
+    return rc;
+}
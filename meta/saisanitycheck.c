@@ -3195,6 +3195,142 @@ void check_attr_validonly_met(
     free(attrs);
 }
 
+void check_attr_compiled_condition_list(
+        _In_ const sai_attr_metadata_t* md,
+        _In_ sai_meta_attr_condition_fn fn,
+        _In_ bool (*interpret)(const sai_attr_metadata_t*, uint32_t, const sai_attribute_t*),
+        _In_ size_t length,
+        _In_ const sai_attr_condition_t* const* list)
+{
+    META_LOG_ENTER();
+
+    /*
+     * Compare compiled conditions with interpreter for all combinations of
+     * condition attributes, where each attribute is either not passed (so
+     * default value is used), passed with one of its condition values, or
+     * passed with other value.
+     */
+
+    sai_attr_id_t ids[SAI_METADATA_MAX_CONDITIONS_LEN];
+    const sai_attribute_value_t *values[SAI_METADATA_MAX_CONDITIONS_LEN][SAI_METADATA_MAX_CONDITIONS_LEN];
+    size_t values_count[SAI_METADATA_MAX_CONDITIONS_LEN];
+    size_t choice[SAI_METADATA_MAX_CONDITIONS_LEN];
+    sai_attribute_t attrs[SAI_METADATA_MAX_CONDITIONS_LEN];
+
+    size_t ids_count = 0;
+    size_t idx;
+    size_t i;
+
+    for (idx = 0; idx < length; idx++)
+    {
+        const sai_attr_condition_t* c = list[idx];
+
+        if (c->type != SAI_ATTR_CONDITION_TYPE_NONE)
+        {
+            continue;
+        }
+
+        for (i = 0; i < ids_count && ids[i] != c->attrid; i++);
+
+        if (i == ids_count)
+        {
+            ids[ids_count] = c->attrid;
+            values_count[ids_count] = 0;
+            choice[ids_count] = 0;
+            ids_count++;
+        }
+
+        values[i][values_count[i]++] = &c->condition;
+    }
+
+    while (true)
+    {
+        uint32_t count = 0;
+
+        for (i = 0; i < ids_count; i++)
+        {
+            /* choice 0 is not passed attribute, last choice is other value */
+
+            if (choice[i] == 0)
+            {
+                continue;
+            }
+
+            attrs[count].id = ids[i];
+
+            if (choice[i] <= values_count[i])
+            {
+                attrs[count].value = *values[i][choice[i] - 1];
+            }
+            else
+            {
+                const sai_attr_metadata_t* cmd = sai_metadata_get_attr_metadata(md->objecttype, ids[i]);
+
+                attrs[count].value = *values[i][0];
+
+                if (cmd->attrvaluetype == SAI_ATTR_VALUE_TYPE_BOOL)
+                {
+                    attrs[count].value.booldata = !attrs[count].value.booldata;
+                }
+                else
+                {
+                    attrs[count].value.u64 ^= UINT64_MAX;
+                }
+            }
+
+            count++;
+        }
+
+        bool compiled = fn(count, attrs);
+        bool interpreted = interpret(md, count, attrs);
+
+        META_ASSERT_TRUE(compiled == interpreted, "compiled conditions don't match interpreted on %s", md->attridname);
+
+        for (i = 0; i < ids_count; i++)
+        {
+            if (++choice[i] <= values_count[i] + 1)
+            {
+                break;
+            }
+
+            choice[i] = 0;
+        }
+
+        if (i == ids_count)
+        {
+            break;
+        }
+    }
+}
+
+void check_attr_compiled_conditions(
+        _In_ const sai_attr_metadata_t* md)
+{
+    META_LOG_ENTER();
+
+    if (md->isconditional)
+    {
+        META_ASSERT_NOT_NULL(md->conditionfn);
+
+        check_attr_compiled_condition_list(md, md->conditionfn, sai_metadata_interpret_condition, md->conditionslength, md->conditions);
+    }
+    else
+    {
+        META_ASSERT_NULL(md->conditionfn);
+    }
+
+    if (md->isvalidonly)
+    {
+        META_ASSERT_NOT_NULL(md->validonlyfn);
+
+        check_attr_compiled_condition_list(md, md->validonlyfn, sai_metadata_interpret_validonly, md->validonlylength, md->validonly);
+    }
+    else
+    {
+        META_ASSERT_NULL(md->validonlyfn);
+    }
+}
+
 void check_attr_default_attrvalue(
         _In_ const sai_attr_metadata_t* md)
 {
@@ -3431,6 +3567,7 @@ void check_single_attribute(
     check_attr_is_primitive(md);
     check_attr_condition_met(md);
     check_attr_validonly_met(md);
+    check_attr_compiled_conditions(md);
     check_attr_default_attrvalue(md);
     check_attr_fdb_flush(md);
     check_attr_hostif_packet(md);
@@ -3885,6 +4022,51 @@ void check_attr_sorted_by_id_name()
     META_ASSERT_NULL(sai_metadata_get_attr_metadata_by_attr_id_name_ext("ZZZ"));    /* after all attr names */
 }
 
+void check_attr_id_name_hash()
+{
+    META_LOG_ENTER();
+
+    size_t i = 0;
+
+    for (; i < sai_metadata_attr_sorted_by_id_name_count; ++i)
+    {
+        const sai_attr_metadata_t *am = sai_metadata_attr_by_id_name_hash[i];
+
+        META_ASSERT_NOT_NULL(am);
+
+        /* each attribute must be in slot of its own hash */
+
+        META_ASSERT_TRUE(sai_metadata_get_attr_metadata_by_attr_id_name(am->attridname) == am,
+                "attribute is not in its own hash slot");
+
+        size_t len = strlen(am->attridname);
+
+        char *buf = (char*)alloca(len + 3);
+
+        memcpy(buf, am->attridname, len);
+
+        buf[len] = '"';
+        buf[len + 1] = ',';
+        buf[len + 2] = 0;
+
+        META_ASSERT_TRUE(sai_metadata_get_attr_metadata_by_attr_id_name_ext(buf) == am,
+                "search attr by id name ext with terminator failed to find");
+
+        META_ASSERT_NULL(sai_metadata_get_attr_metadata_by_attr_id_name(buf));
+
+        buf[len] = 'X';
+        buf[len + 1] = 0;
+
+        META_ASSERT_NULL(sai_metadata_get_attr_metadata_by_attr_id_name(buf));
+        META_ASSERT_NULL(sai_metadata_get_attr_metadata_by_attr_id_name_ext(buf));
+    }
+
+    META_ASSERT_NULL(sai_metadata_attr_by_id_name_hash[i]);
+
+    META_ASSERT_NULL(sai_metadata_get_attr_metadata_by_attr_id_name(""));
+    META_ASSERT_NULL(sai_metadata_get_attr_metadata_by_attr_id_name_ext("\""));
+}
+
 void list_loop(
         _In_ const sai_object_type_info_t* info,
         _In_ const sai_object_type_t *visited,
@@ -5268,6 +5450,34 @@ void check_ignored_attributes()
 
     META_ASSERT_TRUE(strcmp(meta->attridname, "SAI_BUFFER_PROFILE_ATTR_RESERVED_BUFFER_SIZE") == 0,
             "expected attribute was SAI_BUFFER_PROFILE_ATTR_RESERVED_BUFFER_SIZE");
+
+    size_t i = 0;
+
+    const char *last = "AAA";
+
+    for (; i < sai_metadata_ignored_attr_by_id_name_count; ++i)
+    {
+        const char *name = sai_metadata_ignored_attr_id_names[i];
+
+        META_ASSERT_NOT_NULL(name);
+
+        META_ASSERT_TRUE(strcmp(last, name) < 0, "ignored attribute id name in not sorted alphabetical");
+
+        META_ASSERT_NOT_NULL(sai_metadata_ignored_attr_by_id_name[i]);
+
+        META_ASSERT_NULL(sai_metadata_get_attr_metadata_by_attr_id_name(name));
+
+        META_ASSERT_TRUE(sai_metadata_get_ignored_attr_metadata_by_attr_id_name(name) == sai_metadata_ignored_attr_by_id_name[i],
+                "search ignored attr by id name failed to find");
+
+        last = name;
+    }
+
+    META_ASSERT_NULL(sai_metadata_ignored_attr_id_names[i]);
+    META_ASSERT_NULL(sai_metadata_ignored_attr_by_id_name[i]);
+
+    META_ASSERT_NULL(sai_metadata_get_ignored_attr_metadata_by_attr_id_name(NULL));
+    META_ASSERT_NULL(sai_metadata_get_ignored_attr_metadata_by_attr_id_name("SAI_BUFFER_PROFILE_ATTR_RESERVED_BUFFER_SIZE"));
 }
 
 #define RANGE_BASE 0x1000
@@ -5710,6 +5920,927 @@ void check_json_type_size()
     META_ASSERT_TRUE(sizeof(sai_s8_list_t) == sizeof(sai_json_t), "json type is expected to have same size as s8 list");
 }
 
+void check_scheduler_layers()
+{
+    META_LOG_ENTER();
+
+    /*
+     * Batch is given in reverse order, dependencies are only known from
+     * attribute and struct member metadata. No APIs are provided, so virtual
+     * router create fails and all operations depending on it are not
+     * executed.
+     */
+
+    sai_apis_t apis;
+
+    memset(&apis, 0, sizeof(apis));
+
+    sai_attribute_t route_attr = { .id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID, .value = { .oid = 0x3 } };
+    sai_attribute_t nh_attr = { .id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID, .value = { .oid = 0x2 } };
+    sai_attribute_t rif_attr = { .id = SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID, .value = { .oid = 0x1 } };
+
+    sai_metadata_scheduler_entry_t entries[4];
+
+    memset(entries, 0, sizeof(entries));
+
+    entries[0].op = SAI_METADATA_SCHEDULER_OP_CREATE;
+    entries[0].meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+    entries[0].meta_key.objectkey.key.route_entry.vr_id = 0x1;
+    entries[0].attr_count = 1;
+    entries[0].attr_list = &route_attr;
+
+    entries[1].op = SAI_METADATA_SCHEDULER_OP_CREATE;
+    entries[1].meta_key.objecttype = SAI_OBJECT_TYPE_NEXT_HOP;
+    entries[1].meta_key.objectkey.key.object_id = 0x3;
+    entries[1].attr_count = 1;
+    entries[1].attr_list = &nh_attr;
+
+    entries[2].op = SAI_METADATA_SCHEDULER_OP_CREATE;
+    entries[2].meta_key.objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE;
+    entries[2].meta_key.objectkey.key.object_id = 0x2;
+    entries[2].attr_count = 1;
+    entries[2].attr_list = &rif_attr;
+
+    entries[3].op = SAI_METADATA_SCHEDULER_OP_CREATE;
+    entries[3].meta_key.objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER;
+    entries[3].meta_key.objectkey.key.object_id = 0x1;
+
+    sai_status_t status = sai_metadata_scheduler_execute(&apis, 4, entries, 2);
+
+    META_ASSERT_TRUE(status == SAI_STATUS_FAILURE, "expected failure, got %d", status);
+
+    uint32_t idx = 0;
+
+    for (; idx < 4; idx++)
+    {
+        META_ASSERT_TRUE(entries[idx].layer == 3 - idx, "entry %u expected in layer %u, got %u", idx, 3 - idx, entries[idx].layer);
+
+        sai_status_t expected = (idx == 3) ? SAI_STATUS_NOT_IMPLEMENTED : SAI_STATUS_NOT_EXECUTED;
+
+        META_ASSERT_TRUE(entries[idx].status == expected, "entry %u expected status %d, got %d", idx, expected, entries[idx].status);
+    }
+
+    /* router interface uses the same placeholder as virtual router */
+
+    entries[2].meta_key.objectkey.key.object_id = 0x1;
+
+    status = sai_metadata_scheduler_execute(&apis, 4, entries, 1);
+
+    META_ASSERT_TRUE(status == SAI_STATUS_INVALID_PARAMETER, "duplicate placeholder should be rejected, got %d", status);
+}
+
+/*
+ * Stub APIs used by scheduler check. Object ids are allocated from counter
+ * and every call is logged, so order of layers can be verified. Only route
+ * has bulk API, other object types fall back to create of each object. Next
+ * hop referencing SCHEDULER_STUB_FAIL_OID router interface fails to create.
+ */
+
+#define SCHEDULER_PLACEHOLDER(x) (0xff00000000000000ULL | (x))
+
+#define SCHEDULER_STUB_FAIL_OID 0xbad
+
+#define SCHEDULER_STUB_MAX_CALLS 32
+
+typedef struct _scheduler_stub_call_t
+{
+    bool create;
+
+    sai_object_type_t objecttype;
+
+    uint32_t count;
+
+} scheduler_stub_call_t;
+
+static scheduler_stub_call_t scheduler_stub_calls[SCHEDULER_STUB_MAX_CALLS];
+
+static uint32_t scheduler_stub_calls_count = 0;
+
+static sai_object_id_t scheduler_stub_next_oid = 0x1000;
+
+static void scheduler_stub_log(
+        _In_ bool create,
+        _In_ sai_object_type_t objecttype,
+        _In_ uint32_t count)
+{
+    uint32_t idx = __atomic_fetch_add(&scheduler_stub_calls_count, 1, __ATOMIC_RELAXED);
+
+    META_ASSERT_TRUE(idx < SCHEDULER_STUB_MAX_CALLS, "too many stub calls");
+
+    scheduler_stub_calls[idx].create = create;
+    scheduler_stub_calls[idx].objecttype = objecttype;
+    scheduler_stub_calls[idx].count = count;
+}
+
+static bool scheduler_is_placeholder(
+        _In_ sai_object_id_t oid)
+{
+    return (oid & SCHEDULER_PLACEHOLDER(0)) == SCHEDULER_PLACEHOLDER(0);
+}
+
+static void scheduler_stub_check_attrs(
+        _In_ sai_object_type_t objecttype,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    uint32_t idx = 0;
+
+    for (; idx < attr_count; idx++)
+    {
+        const sai_attr_metadata_t *md = sai_metadata_get_attr_metadata(objecttype, attr_list[idx].id);
+
+        META_ASSERT_NOT_NULL(md);
+
+        if (md->attrvaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID)
+        {
+            META_ASSERT_FALSE(scheduler_is_placeholder(attr_list[idx].value.oid), "%s placeholder was not translated", md->attridname);
+        }
+    }
+}
+
+static sai_status_t scheduler_stub_create(
+        _In_ sai_object_type_t objecttype,
+        _Out_ sai_object_id_t *object_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    META_ASSERT_FALSE(scheduler_is_placeholder(switch_id), "switch placeholder was not translated");
+
+    scheduler_stub_check_attrs(objecttype, attr_count, attr_list);
+
+    scheduler_stub_log(true, objecttype, 1);
+
+    uint32_t idx = 0;
+
+    for (; idx < attr_count; idx++)
+    {
+        if (attr_list[idx].value.oid == SCHEDULER_STUB_FAIL_OID)
+        {
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    *object_id = __atomic_add_fetch(&scheduler_stub_next_oid, 1, __ATOMIC_RELAXED);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t scheduler_stub_create_virtual_router(
+        _Out_ sai_object_id_t *virtual_router_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    return scheduler_stub_create(SAI_OBJECT_TYPE_VIRTUAL_ROUTER, virtual_router_id, switch_id, attr_count, attr_list);
+}
+
+static sai_status_t scheduler_stub_create_router_interface(
+        _Out_ sai_object_id_t *router_interface_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    return scheduler_stub_create(SAI_OBJECT_TYPE_ROUTER_INTERFACE, router_interface_id, switch_id, attr_count, attr_list);
+}
+
+static sai_status_t scheduler_stub_create_next_hop(
+        _Out_ sai_object_id_t *next_hop_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    return scheduler_stub_create(SAI_OBJECT_TYPE_NEXT_HOP, next_hop_id, switch_id, attr_count, attr_list);
+}
+
+static sai_status_t scheduler_stub_remove_next_hop(
+        _In_ sai_object_id_t next_hop_id)
+{
+    scheduler_stub_log(false, SAI_OBJECT_TYPE_NEXT_HOP, 1);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t scheduler_stub_remove_route_entry(
+        _In_ const sai_route_entry_t *route_entry)
+{
+    scheduler_stub_log(false, SAI_OBJECT_TYPE_ROUTE_ENTRY, 1);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t scheduler_stub_create_route_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    scheduler_stub_log(true, SAI_OBJECT_TYPE_ROUTE_ENTRY, object_count);
+
+    uint32_t idx = 0;
+
+    for (; idx < object_count; idx++)
+    {
+        META_ASSERT_FALSE(scheduler_is_placeholder(route_entry[idx].vr_id), "route vr_id placeholder was not translated");
+
+        META_ASSERT_TRUE(route_entry[idx].switch_id == route_entry[0].switch_id, "bulk group must have single switch");
+
+        scheduler_stub_check_attrs(SAI_OBJECT_TYPE_ROUTE_ENTRY, attr_count[idx], attr_list[idx]);
+
+        object_statuses[idx] = SAI_STATUS_SUCCESS;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Returns index of first (or last) logged call of given operation and object
+ * type.
+ */
+static uint32_t scheduler_stub_find_call(
+        _In_ bool create,
+        _In_ sai_object_type_t objecttype,
+        _In_ bool last)
+{
+    uint32_t found = SCHEDULER_STUB_MAX_CALLS;
+
+    uint32_t idx = 0;
+
+    for (; idx < scheduler_stub_calls_count; idx++)
+    {
+        if (scheduler_stub_calls[idx].create == create && scheduler_stub_calls[idx].objecttype == objecttype)
+        {
+            found = idx;
+
+            if (!last)
+            {
+                break;
+            }
+        }
+    }
+
+    META_ASSERT_TRUE(found < SCHEDULER_STUB_MAX_CALLS, "no %s call for object type %d", create ? "create" : "remove", objecttype);
+
+    return found;
+}
+
+static void scheduler_set_route_entry(
+        _Out_ sai_metadata_scheduler_entry_t *entry,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t dst,
+        _In_ sai_attribute_t *attr,
+        _In_ sai_object_id_t next_hop_id)
+{
+    entry->op = SAI_METADATA_SCHEDULER_OP_CREATE;
+    entry->switch_id = switch_id;
+    entry->meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+    entry->meta_key.objectkey.key.route_entry.switch_id = switch_id;
+    entry->meta_key.objectkey.key.route_entry.vr_id = SCHEDULER_PLACEHOLDER(1);
+    entry->meta_key.objectkey.key.route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    entry->meta_key.objectkey.key.route_entry.destination.addr.ip4 = dst;
+    entry->meta_key.objectkey.key.route_entry.destination.mask.ip4 = 0xffffffff;
+
+    attr->id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attr->value.oid = next_hop_id;
+
+    entry->attr_count = 1;
+    entry->attr_list = attr;
+}
+
+static void scheduler_set_oid_entry(
+        _Out_ sai_metadata_scheduler_entry_t *entry,
+        _In_ sai_metadata_scheduler_op_t op,
+        _In_ sai_object_type_t objecttype,
+        _In_ sai_object_id_t object_id,
+        _In_ sai_attribute_t *attr,
+        _In_ sai_attr_id_t attr_id,
+        _In_ sai_object_id_t attr_oid)
+{
+    entry->op = op;
+    entry->switch_id = 0x21;
+    entry->meta_key.objecttype = objecttype;
+    entry->meta_key.objectkey.key.object_id = object_id;
+
+    attr->id = attr_id;
+    attr->value.oid = attr_oid;
+
+    entry->attr_count = 1;
+    entry->attr_list = attr;
+}
+
+void check_scheduler_execute()
+{
+    META_LOG_ENTER();
+
+    /*
+     * Existing route and next hop are removed, and virtual router with two
+     * router interfaces, next hops and routes on two switches are created in
+     * their place, in the same multi threaded batch. One next hop fails, so
+     * route using it must not be executed.
+     */
+
+    sai_virtual_router_api_t vr_api;
+    sai_router_interface_api_t rif_api;
+    sai_next_hop_api_t nh_api;
+    sai_route_api_t route_api;
+
+    memset(&vr_api, 0, sizeof(vr_api));
+    memset(&rif_api, 0, sizeof(rif_api));
+    memset(&nh_api, 0, sizeof(nh_api));
+    memset(&route_api, 0, sizeof(route_api));
+
+    vr_api.create_virtual_router = scheduler_stub_create_virtual_router;
+    rif_api.create_router_interface = scheduler_stub_create_router_interface;
+    nh_api.create_next_hop = scheduler_stub_create_next_hop;
+    nh_api.remove_next_hop = scheduler_stub_remove_next_hop;
+    route_api.remove_route_entry = scheduler_stub_remove_route_entry;
+    route_api.create_route_entries = scheduler_stub_create_route_entries;
+
+    sai_apis_t apis;
+
+    memset(&apis, 0, sizeof(apis));
+
+    apis.virtual_router_api = &vr_api;
+    apis.router_interface_api = &rif_api;
+    apis.next_hop_api = &nh_api;
+    apis.route_api = &route_api;
+
+    sai_attribute_t attrs[13];
+    sai_metadata_scheduler_entry_t entries[13];
+
+    memset(attrs, 0, sizeof(attrs));
+    memset(entries, 0, sizeof(entries));
+
+    scheduler_set_route_entry(&entries[0], 0x21, 0x0100000a, &attrs[0], SCHEDULER_PLACEHOLDER(4));
+    scheduler_set_route_entry(&entries[1], 0x21, 0x0200000a, &attrs[1], SCHEDULER_PLACEHOLDER(5));
+    scheduler_set_route_entry(&entries[2], 0x22, 0x0300000a, &attrs[2], SCHEDULER_PLACEHOLDER(4));
+    scheduler_set_route_entry(&entries[3], 0x22, 0x0400000a, &attrs[3], SCHEDULER_PLACEHOLDER(5));
+    scheduler_set_route_entry(&entries[4], 0x21, 0x0500000a, &attrs[4], SCHEDULER_PLACEHOLDER(6));
+
+    scheduler_set_oid_entry(&entries[5], SAI_METADATA_SCHEDULER_OP_CREATE, SAI_OBJECT_TYPE_NEXT_HOP, SCHEDULER_PLACEHOLDER(4),
+            &attrs[5], SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID, SCHEDULER_PLACEHOLDER(2));
+    scheduler_set_oid_entry(&entries[6], SAI_METADATA_SCHEDULER_OP_CREATE, SAI_OBJECT_TYPE_NEXT_HOP, SCHEDULER_PLACEHOLDER(5),
+            &attrs[6], SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID, SCHEDULER_PLACEHOLDER(3));
+    scheduler_set_oid_entry(&entries[7], SAI_METADATA_SCHEDULER_OP_CREATE, SAI_OBJECT_TYPE_NEXT_HOP, SCHEDULER_PLACEHOLDER(6),
+            &attrs[7], SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID, SCHEDULER_STUB_FAIL_OID);
+    scheduler_set_oid_entry(&entries[8], SAI_METADATA_SCHEDULER_OP_CREATE, SAI_OBJECT_TYPE_ROUTER_INTERFACE, SCHEDULER_PLACEHOLDER(2),
+            &attrs[8], SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID, SCHEDULER_PLACEHOLDER(1));
+    scheduler_set_oid_entry(&entries[9], SAI_METADATA_SCHEDULER_OP_CREATE, SAI_OBJECT_TYPE_ROUTER_INTERFACE, SCHEDULER_PLACEHOLDER(3),
+            &attrs[9], SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID, SCHEDULER_PLACEHOLDER(1));
+
+    entries[10].op = SAI_METADATA_SCHEDULER_OP_CREATE;
+    entries[10].switch_id = 0x21;
+    entries[10].meta_key.objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER;
+    entries[10].meta_key.objectkey.key.object_id = SCHEDULER_PLACEHOLDER(1);
+
+    /* removed route references removed next hop, so it goes first */
+
+    scheduler_set_oid_entry(&entries[11], SAI_METADATA_SCHEDULER_OP_REMOVE, SAI_OBJECT_TYPE_NEXT_HOP, 0x31,
+            &attrs[11], SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID, 0x32);
+
+    entries[12].op = SAI_METADATA_SCHEDULER_OP_REMOVE;
+    entries[12].meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+    entries[12].meta_key.objectkey.key.route_entry.switch_id = 0x21;
+    entries[12].meta_key.objectkey.key.route_entry.vr_id = 0x30;
+    entries[12].attr_count = 1;
+    entries[12].attr_list = &attrs[12];
+
+    attrs[12].id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attrs[12].value.oid = 0x31;
+
+    sai_status_t status = sai_metadata_scheduler_execute(&apis, 13, entries, 4);
+
+    META_ASSERT_TRUE(status == SAI_STATUS_FAILURE, "expected failure, got %d", status);
+
+    uint32_t idx = 0;
+
+    for (; idx < 13; idx++)
+    {
+        sai_status_t expected = (idx == 7) ? SAI_STATUS_FAILURE : (idx == 4) ? SAI_STATUS_NOT_EXECUTED : SAI_STATUS_SUCCESS;
+
+        META_ASSERT_TRUE(entries[idx].status == expected, "entry %u expected status %d, got %d", idx, expected, entries[idx].status);
+    }
+
+    /* removes are in layers 0 and 1, creates follow */
+
+    META_ASSERT_TRUE(entries[12].layer == 0 && entries[11].layer == 1, "unexpected remove layers");
+    META_ASSERT_TRUE(entries[10].layer == 2 && entries[7].layer == 2, "unexpected virtual router layer");
+    META_ASSERT_TRUE(entries[8].layer == 3 && entries[9].layer == 3 && entries[4].layer == 3, "unexpected router interface layer");
+    META_ASSERT_TRUE(entries[5].layer == 4 && entries[6].layer == 4, "unexpected next hop layer");
+    META_ASSERT_TRUE(entries[0].layer == 5 && entries[3].layer == 5, "unexpected route layer");
+
+    /* placeholders are replaced by created object ids */
+
+    sai_object_id_t vr_id = entries[10].meta_key.objectkey.key.object_id;
+
+    META_ASSERT_FALSE(scheduler_is_placeholder(vr_id), "virtual router id was not set");
+
+    for (idx = 0; idx < 4; idx++)
+    {
+        META_ASSERT_TRUE(entries[idx].meta_key.objectkey.key.route_entry.vr_id == vr_id, "route %u vr_id not translated", idx);
+        META_ASSERT_TRUE(attrs[idx].value.oid == entries[5 + (idx & 1)].meta_key.objectkey.key.object_id, "route %u next hop not translated", idx);
+    }
+
+    META_ASSERT_TRUE(attrs[5].value.oid == entries[8].meta_key.objectkey.key.object_id, "next hop router interface not translated");
+    META_ASSERT_TRUE(attrs[6].value.oid == entries[9].meta_key.objectkey.key.object_id, "next hop router interface not translated");
+    META_ASSERT_TRUE(attrs[8].value.oid == vr_id && attrs[9].value.oid == vr_id, "router interface virtual router not translated");
+
+    /*
+     * Call order follows layers. Routes are created by one bulk call per
+     * switch, router interfaces and next hops without bulk API fall back to
+     * create of each object, and blocked route is never issued.
+     */
+
+    META_ASSERT_TRUE(scheduler_stub_calls_count == 10, "expected 10 calls, got %u", scheduler_stub_calls_count);
+
+    META_ASSERT_TRUE(scheduler_stub_find_call(false, SAI_OBJECT_TYPE_ROUTE_ENTRY, true) < scheduler_stub_find_call(false, SAI_OBJECT_TYPE_NEXT_HOP, false), "route must be removed before next hop");
+    META_ASSERT_TRUE(scheduler_stub_find_call(false, SAI_OBJECT_TYPE_NEXT_HOP, true) < scheduler_stub_find_call(true, SAI_OBJECT_TYPE_VIRTUAL_ROUTER, false), "removes must be executed before creates");
+    META_ASSERT_TRUE(scheduler_stub_find_call(true, SAI_OBJECT_TYPE_VIRTUAL_ROUTER, true) < scheduler_stub_find_call(true, SAI_OBJECT_TYPE_ROUTER_INTERFACE, false), "virtual router must be created before router interface");
+    META_ASSERT_TRUE(scheduler_stub_find_call(true, SAI_OBJECT_TYPE_ROUTER_INTERFACE, true) < scheduler_stub_find_call(true, SAI_OBJECT_TYPE_ROUTE_ENTRY, false), "router interface must be created before route");
+
+    uint32_t counts[SAI_OBJECT_TYPE_MAX];
+    uint32_t calls[SAI_OBJECT_TYPE_MAX];
+
+    memset(counts, 0, sizeof(counts));
+    memset(calls, 0, sizeof(calls));
+
+    for (idx = 0; idx < scheduler_stub_calls_count; idx++)
+    {
+        if (scheduler_stub_calls[idx].create)
+        {
+            counts[scheduler_stub_calls[idx].objecttype] += scheduler_stub_calls[idx].count;
+            calls[scheduler_stub_calls[idx].objecttype]++;
+        }
+    }
+
+    META_ASSERT_TRUE(calls[SAI_OBJECT_TYPE_ROUTE_ENTRY] == 2 && counts[SAI_OBJECT_TYPE_ROUTE_ENTRY] == 4, "expected 2 bulk route calls of 2 routes");
+    META_ASSERT_TRUE(calls[SAI_OBJECT_TYPE_ROUTER_INTERFACE] == 2 && counts[SAI_OBJECT_TYPE_ROUTER_INTERFACE] == 2, "expected router interface fallback");
+    META_ASSERT_TRUE(calls[SAI_OBJECT_TYPE_NEXT_HOP] == 3 && counts[SAI_OBJECT_TYPE_NEXT_HOP] == 3, "expected next hop fallback");
+    META_ASSERT_TRUE(calls[SAI_OBJECT_TYPE_VIRTUAL_ROUTER] == 1, "expected single virtual router create");
+}
+
+void check_object_type_rank_dependency(
+        _In_ sai_object_type_t dep,
+        _In_ sai_object_type_t ot)
+{
+    if (dep == SAI_OBJECT_TYPE_SWITCH || ot == SAI_OBJECT_TYPE_SWITCH)
+    {
+        return;
+    }
+
+    META_ASSERT_TRUE(sai_metadata_object_type_create_rank[dep] <= sai_metadata_object_type_create_rank[ot],
+            "%s must not be created before %s", sai_metadata_all_object_type_infos[ot]->objecttypename,
+            sai_metadata_all_object_type_infos[dep]->objecttypename);
+
+    META_ASSERT_TRUE(sai_metadata_object_type_remove_rank[dep] >= sai_metadata_object_type_remove_rank[ot],
+            "%s must not be removed before %s", sai_metadata_all_object_type_infos[dep]->objecttypename,
+            sai_metadata_all_object_type_infos[ot]->objecttypename);
+}
+
+void check_object_type_ranks()
+{
+    META_LOG_ENTER();
+
+    /*
+     * Generated ranks must agree with current attributes, object types can
+     * have the same rank only if they are in dependency cycle.
+     */
+
+    META_ASSERT_TRUE(sai_metadata_object_type_create_rank[SAI_OBJECT_TYPE_SWITCH] == 0, "switch must be created first");
+
+    META_ASSERT_TRUE(sai_metadata_object_type_remove_rank[SAI_OBJECT_TYPE_SWITCH] == sai_metadata_object_type_remove_rank_max,
+            "switch must be removed last");
+
+    size_t i = SAI_OBJECT_TYPE_NULL;
+
+    for (; i < SAI_OBJECT_TYPE_EXTENSIONS_MAX; ++i)
+    {
+        const sai_object_type_info_t* info = sai_metadata_all_object_type_infos[i];
+
+        if (info == NULL)
+        {
+            continue;
+        }
+
+        META_ASSERT_TRUE(sai_metadata_object_type_create_rank[i] <= sai_metadata_object_type_create_rank_max, "create rank out of range");
+        META_ASSERT_TRUE(sai_metadata_object_type_remove_rank[i] <= sai_metadata_object_type_remove_rank_max, "remove rank out of range");
+
+        size_t idx = 0;
+
+        for (; info->attrmetadata[idx] != NULL; ++idx)
+        {
+            const sai_attr_metadata_t* md = info->attrmetadata[idx];
+
+            if (SAI_HAS_FLAG_READ_ONLY(md->flags))
+            {
+                continue;
+            }
+
+            size_t j = 0;
+
+            for (; j < md->allowedobjecttypeslength; ++j)
+            {
+                check_object_type_rank_dependency(md->allowedobjecttypes[j], info->objecttype);
+            }
+        }
+
+        for (idx = 0; info->isnonobjectid && idx < info->structmemberscount; ++idx)
+        {
+            const sai_struct_member_info_t *m = info->structmembers[idx];
+
+            size_t j = 0;
+
+            for (; m->membervaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID && j < m->allowedobjecttypeslength; ++j)
+            {
+                check_object_type_rank_dependency(m->allowedobjecttypes[j], info->objecttype);
+            }
+        }
+    }
+}
+
+void check_refcount_tracker()
+{
+    META_LOG_ENTER();
+
+    /*
+     * Route entry references virtual router by key member and next hop by
+     * attribute, next hop references router interface. Router interface was
+     * not created by tracked call, so it is tracked implicitly.
+     */
+
+    sai_metadata_refcount_t tracker;
+
+    META_ASSERT_TRUE(sai_metadata_refcount_init(&tracker) == SAI_STATUS_SUCCESS, "failed to init tracker");
+
+    sai_object_meta_key_t vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = 0x1 } } };
+    sai_object_meta_key_t nh = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = 0x3 } } };
+
+    sai_object_meta_key_t route;
+
+    memset(&route, 0, sizeof(route));
+
+    route.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+    route.objectkey.key.route_entry.switch_id = 0x21;
+    route.objectkey.key.route_entry.vr_id = 0x1;
+    route.objectkey.key.route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+
+    sai_attribute_t route_attr = { .id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID, .value = { .oid = 0x3 } };
+    sai_attribute_t nh_attr = { .id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID, .value = { .oid = 0x2 } };
+
+    META_ASSERT_TRUE(sai_metadata_refcount_create(&tracker, &vr, 0, NULL) == SAI_STATUS_SUCCESS, "create failed");
+    META_ASSERT_TRUE(sai_metadata_refcount_create(&tracker, &nh, 1, &nh_attr) == SAI_STATUS_SUCCESS, "create failed");
+    META_ASSERT_TRUE(sai_metadata_refcount_create(&tracker, &route, 1, &route_attr) == SAI_STATUS_SUCCESS, "create failed");
+
+    META_ASSERT_TRUE(sai_metadata_refcount_get(&tracker, 0x1) == 1, "virtual router should be referenced by route key");
+    META_ASSERT_TRUE(sai_metadata_refcount_get(&tracker, 0x2) == 1, "router interface should be tracked implicitly");
+    META_ASSERT_TRUE(sai_metadata_refcount_get(&tracker, 0x21) == 0, "switch references should not be counted");
+
+    sai_metadata_refcount_dependent_t dependent;
+
+    uint32_t count = 1;
+
+    META_ASSERT_TRUE(sai_metadata_refcount_get_dependents(&tracker, 0x3, &count, &dependent) == SAI_STATUS_SUCCESS, "get dependents failed");
+    META_ASSERT_TRUE(count == 1 && dependent.meta_key.objecttype == SAI_OBJECT_TYPE_ROUTE_ENTRY, "route should depend on next hop");
+    META_ASSERT_TRUE(dependent.attr_id == SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID, "wrong dependent attribute %u", dependent.attr_id);
+
+    META_ASSERT_FALSE(sai_metadata_refcount_can_remove(&tracker, &nh), "next hop is in use");
+    META_ASSERT_TRUE(sai_metadata_refcount_remove(&tracker, &vr) == SAI_STATUS_OBJECT_IN_USE, "virtual router is in use");
+
+    route_attr.value.oid = SAI_NULL_OBJECT_ID;
+
+    META_ASSERT_TRUE(sai_metadata_refcount_set(&tracker, &route, &route_attr) == SAI_STATUS_SUCCESS, "set failed");
+    META_ASSERT_TRUE(sai_metadata_refcount_can_remove(&tracker, &nh), "next hop is not used after set");
+
+    META_ASSERT_TRUE(sai_metadata_refcount_remove(&tracker, &route) == SAI_STATUS_SUCCESS, "remove failed");
+    META_ASSERT_TRUE(sai_metadata_refcount_remove(&tracker, &nh) == SAI_STATUS_SUCCESS, "remove failed");
+    META_ASSERT_TRUE(sai_metadata_refcount_remove(&tracker, &vr) == SAI_STATUS_SUCCESS, "remove failed");
+
+    META_ASSERT_TRUE(tracker.tracked == 0 && tracker.references == 0, "tracker should be empty");
+
+    sai_metadata_refcount_release(&tracker);
+}
+
+void check_attr_value_helpers()
+{
+    META_LOG_ENTER();
+
+    /*
+     * Every attribute gets value with all lists filled with pattern, copy
+     * must be equal to original, have the same hash and own its lists.
+     */
+
+    uint64_t buffers[SAI_METADATA_ATTR_VALUE_LISTS_MAX][16];
+
+    memset(buffers, 0x5a, sizeof(buffers));
+
+    size_t i = 0;
+
+    for (; i < sai_metadata_attr_sorted_by_id_name_count; ++i)
+    {
+        const sai_attr_metadata_t *md = sai_metadata_attr_sorted_by_id_name[i];
+
+        sai_metadata_attr_value_list_t lists[SAI_METADATA_ATTR_VALUE_LISTS_MAX];
+
+        uint32_t count = sai_metadata_attr_value_lists(md->attrvaluetype, lists);
+
+        sai_attribute_t attr;
+
+        memset(&attr, 0, sizeof(attr));
+
+        attr.id = md->attrid;
+
+        if (md->isaclfield)
+        {
+            attr.value.aclfield.enable = true;
+        }
+        else if (md->isaclaction)
+        {
+            attr.value.aclaction.enable = true;
+        }
+
+        uint32_t idx;
+
+        for (idx = 0; idx < count; idx++)
+        {
+            META_ASSERT_TRUE(2 * lists[idx].element_size <= sizeof(buffers[idx]), "list element of %s is too big", md->attridname);
+
+            uint32_t list_count = 2;
+            void *list = buffers[idx];
+
+            memcpy((uint8_t*)&attr.value + lists[idx].count_offset, &list_count, sizeof(list_count));
+            memcpy((uint8_t*)&attr.value + lists[idx].list_offset, &list, sizeof(list));
+        }
+
+        sai_attribute_t copy;
+
+        META_ASSERT_TRUE(sai_metadata_attr_copy(md->objecttype, &attr, &copy) == SAI_STATUS_SUCCESS, "failed to copy %s", md->attridname);
+
+        META_ASSERT_TRUE(sai_metadata_attr_equal(md->objecttype, &attr, &copy), "copy of %s is not equal", md->attridname);
+        META_ASSERT_TRUE(sai_metadata_attr_hash(md->objecttype, &attr) == sai_metadata_attr_hash(md->objecttype, &copy), "hash of %s copy differs", md->attridname);
+
+        for (idx = 0; idx < count; idx++)
+        {
+            void *list;
+
+            memcpy(&list, (uint8_t*)&copy.value + lists[idx].list_offset, sizeof(list));
+
+            META_ASSERT_TRUE(list != NULL && list != buffers[idx], "list of %s was not copied", md->attridname);
+
+            uint32_t list_count = 1;
+
+            memcpy((uint8_t*)&copy.value + lists[idx].count_offset, &list_count, sizeof(list_count));
+
+            META_ASSERT_FALSE(sai_metadata_attr_equal(md->objecttype, &attr, &copy), "list count of %s is not compared", md->attridname);
+
+            list_count = 2;
+
+            memcpy((uint8_t*)&copy.value + lists[idx].count_offset, &list_count, sizeof(list_count));
+        }
+
+        sai_metadata_attr_free(md->objecttype, &copy);
+
+        sai_attribute_t *list_copy;
+
+        META_ASSERT_TRUE(sai_metadata_attr_list_copy(md->objecttype, 1, &attr, &list_copy) == SAI_STATUS_SUCCESS, "failed to copy %s", md->attridname);
+
+        META_ASSERT_TRUE(sai_metadata_attr_equal(md->objecttype, &attr, list_copy), "list copy of %s is not equal", md->attridname);
+
+        sai_metadata_attr_list_free(list_copy);
+    }
+
+    /* unused part of ip address union is not compared */
+
+    sai_attribute_t a;
+    sai_attribute_t b;
+
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0xff, sizeof(b));
+
+    a.id = b.id = SAI_NEXT_HOP_ATTR_IP;
+    a.value.ipaddr.addr_family = b.value.ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    a.value.ipaddr.addr.ip4 = b.value.ipaddr.addr.ip4 = 0x0100000a;
+
+    META_ASSERT_TRUE(sai_metadata_attr_equal(SAI_OBJECT_TYPE_NEXT_HOP, &a, &b), "IPv4 addresses should be equal");
+    META_ASSERT_TRUE(sai_metadata_attr_hash(SAI_OBJECT_TYPE_NEXT_HOP, &a) == sai_metadata_attr_hash(SAI_OBJECT_TYPE_NEXT_HOP, &b), "IPv4 address hash differs");
+
+    b.value.ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+
+    META_ASSERT_FALSE(sai_metadata_attr_equal(SAI_OBJECT_TYPE_NEXT_HOP, &a, &b), "address family should be compared");
+
+    /* data of disabled acl field is not compared */
+
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+
+    a.id = b.id = SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP;
+    a.value.aclfield.data.ip4 = 1;
+    b.value.aclfield.data.ip4 = 2;
+
+    META_ASSERT_TRUE(sai_metadata_attr_equal(SAI_OBJECT_TYPE_ACL_ENTRY, &a, &b), "disabled acl fields should be equal");
+
+    a.value.aclfield.enable = b.value.aclfield.enable = true;
+
+    META_ASSERT_FALSE(sai_metadata_attr_equal(SAI_OBJECT_TYPE_ACL_ENTRY, &a, &b), "enabled acl fields should differ");
+
+    /* lists of disabled acl field are not touched, data is not specified */
+
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+
+    a.id = SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS;
+    a.value.aclfield.data.objlist.count = 0xdeadbeef;
+    a.value.aclfield.data.objlist.list = (sai_object_id_t*)(uintptr_t)0xdeadbeef;
+
+    META_ASSERT_TRUE(sai_metadata_attr_copy(SAI_OBJECT_TYPE_ACL_ENTRY, &a, &b) == SAI_STATUS_SUCCESS, "disabled acl field copy failed");
+    META_ASSERT_TRUE(b.value.aclfield.data.objlist.list == a.value.aclfield.data.objlist.list, "disabled acl field list should not be copied");
+
+    sai_metadata_attr_free(SAI_OBJECT_TYPE_ACL_ENTRY, &b);
+
+    sai_attribute_t *disabled = NULL;
+
+    META_ASSERT_TRUE(sai_metadata_attr_list_copy(SAI_OBJECT_TYPE_ACL_ENTRY, 1, &a, &disabled) == SAI_STATUS_SUCCESS, "disabled acl field list copy failed");
+    META_ASSERT_TRUE(disabled->value.aclfield.data.objlist.list == a.value.aclfield.data.objlist.list, "disabled acl field list should not be copied");
+
+    sai_metadata_attr_list_free(disabled);
+
+    sai_attribute_t *empty = &a;
+
+    META_ASSERT_TRUE(sai_metadata_attr_list_copy(SAI_OBJECT_TYPE_ACL_ENTRY, 0, &a, &empty) == SAI_STATUS_SUCCESS, "empty list copy failed");
+    META_ASSERT_NULL(empty);
+}
+
+void check_attr_cache()
+{
+    META_LOG_ENTER();
+
+    META_ASSERT_TRUE(sai_metadata_cache_enable(true) == SAI_STATUS_SUCCESS, "failed to enable cache");
+
+    sai_object_meta_key_t mk;
+
+    memset(&mk, 0, sizeof(mk));
+
+    mk.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+    mk.objectkey.key.route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    mk.objectkey.key.route_entry.destination.addr.ip4 = 0x0100000a;
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+    attr.value.s32 = SAI_PACKET_ACTION_DROP;
+
+    META_ASSERT_FALSE(sai_metadata_cache_set_lookup(&mk, &attr), "empty cache should miss");
+
+    sai_metadata_cache_update(&mk, SAI_STATUS_SUCCESS, 1, &attr);
+
+    /* unused part of ip prefix is not part of the key */
+
+    mk.objectkey.key.route_entry.destination.addr.ip6[15] = 0xff;
+
+    META_ASSERT_TRUE(sai_metadata_cache_set_lookup(&mk, &attr), "identical set should hit");
+
+    attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    META_ASSERT_FALSE(sai_metadata_cache_set_lookup(&mk, &attr), "changed value should miss");
+
+    sai_attribute_t get;
+
+    get.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+
+    META_ASSERT_TRUE(sai_metadata_cache_get_lookup(&mk, 1, &get), "cached attribute get should hit");
+    META_ASSERT_TRUE(get.value.s32 == SAI_PACKET_ACTION_DROP, "wrong cached value");
+
+    /* failed set leaves hardware state unknown */
+
+    sai_metadata_cache_update(&mk, SAI_STATUS_FAILURE, 1, &attr);
+
+    META_ASSERT_FALSE(sai_metadata_cache_get_lookup(&mk, 1, &get), "failed set should forget attribute");
+
+    sai_metadata_cache_update(&mk, SAI_STATUS_SUCCESS, 1, &attr);
+
+    sai_metadata_cache_stats_t stats;
+
+    META_ASSERT_TRUE(sai_metadata_cache_get_stats(&stats) == SAI_STATUS_SUCCESS, "failed to get stats");
+    META_ASSERT_TRUE(stats.objects == 1 && stats.attributes == 1, "wrong cache size");
+
+    sai_metadata_cache_remove(&mk, SAI_STATUS_SUCCESS);
+
+    META_ASSERT_FALSE(sai_metadata_cache_set_lookup(&mk, &attr), "removed object should miss");
+
+    /* create only attributes are not cached */
+
+    memset(&mk, 0, sizeof(mk));
+
+    mk.objecttype = SAI_OBJECT_TYPE_NEXT_HOP;
+    mk.objectkey.key.object_id = 0x1234;
+
+    memset(&attr, 0, sizeof(attr));
+
+    attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+    attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+
+    sai_metadata_cache_update(&mk, SAI_STATUS_SUCCESS, 1, &attr);
+
+    META_ASSERT_FALSE(sai_metadata_cache_set_lookup(&mk, &attr), "create only attribute should not be cached");
+
+    META_ASSERT_TRUE(sai_metadata_cache_get_stats(&stats) == SAI_STATUS_SUCCESS, "failed to get stats");
+    META_ASSERT_TRUE(stats.objects == 0 && stats.set_hits == 1, "wrong cache stats");
+
+    sai_metadata_cache_disable();
+}
+
+static uint32_t cache_stub_set_calls = 0;
+
+static sai_status_t cache_stub_set_switch_attribute(
+        _In_ sai_object_id_t switch_id,
+        _In_ const sai_attribute_t *attr)
+{
+    cache_stub_set_calls++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t cache_stub_set_router_interface_attribute(
+        _In_ sai_object_id_t router_interface_id,
+        _In_ const sai_attribute_t *attr)
+{
+    cache_stub_set_calls++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void check_attr_cache_trigger_set()
+{
+    META_LOG_ENTER();
+
+    /*
+     * Repeated set of action attributes (and any switch attribute) must
+     * reach vendor each time, while repeated set of regular attribute is
+     * suppressed by wrapper.
+     */
+
+    sai_switch_api_t switch_api;
+    sai_router_interface_api_t rif_api;
+
+    memset(&switch_api, 0, sizeof(switch_api));
+    memset(&rif_api, 0, sizeof(rif_api));
+
+    switch_api.set_switch_attribute = cache_stub_set_switch_attribute;
+    rif_api.set_router_interface_attribute = cache_stub_set_router_interface_attribute;
+
+    void *switch_table = &switch_api;
+    void *rif_table = &rif_api;
+
+    META_ASSERT_TRUE(sai_metadata_cache_api_wrap(SAI_API_SWITCH, &switch_table) == SAI_STATUS_SUCCESS, "failed to wrap switch api");
+    META_ASSERT_TRUE(sai_metadata_cache_api_wrap(SAI_API_ROUTER_INTERFACE, &rif_table) == SAI_STATUS_SUCCESS, "failed to wrap router interface api");
+
+    sai_switch_api_t *wrapped_switch_api = switch_table;
+    sai_router_interface_api_t *wrapped_rif_api = rif_table;
+
+    META_ASSERT_TRUE(sai_metadata_cache_enable(false) == SAI_STATUS_SUCCESS, "failed to enable cache");
+
+    sai_attr_id_t triggers[] = {
+        SAI_SWITCH_ATTR_SWITCH_SHELL_ENABLE,
+        SAI_SWITCH_ATTR_RESTART_WARM,
+        SAI_SWITCH_ATTR_PRE_SHUTDOWN,
+        SAI_SWITCH_ATTR_FIRMWARE_DOWNLOAD_EXECUTE,
+    };
+
+    sai_attribute_t attr;
+
+    size_t idx = 0;
+
+    for (; idx < sizeof(triggers)/sizeof(triggers[0]); idx++)
+    {
+        memset(&attr, 0, sizeof(attr));
+
+        attr.id = triggers[idx];
+        attr.value.booldata = true;
+
+        cache_stub_set_calls = 0;
+
+        META_ASSERT_TRUE(wrapped_switch_api->set_switch_attribute(0x21, &attr) == SAI_STATUS_SUCCESS, "set failed");
+        META_ASSERT_TRUE(wrapped_switch_api->set_switch_attribute(0x21, &attr) == SAI_STATUS_SUCCESS, "set failed");
+
+        META_ASSERT_TRUE(cache_stub_set_calls == 2, "repeated set of switch attribute %d was suppressed", attr.id);
+    }
+
+    memset(&attr, 0, sizeof(attr));
+
+    attr.id = SAI_ROUTER_INTERFACE_ATTR_MTU;
+    attr.value.u32 = 9100;
+
+    cache_stub_set_calls = 0;
+
+    META_ASSERT_TRUE(wrapped_rif_api->set_router_interface_attribute(0x1234, &attr) == SAI_STATUS_SUCCESS, "set failed");
+    META_ASSERT_TRUE(wrapped_rif_api->set_router_interface_attribute(0x1234, &attr) == SAI_STATUS_SUCCESS, "set failed");
+
+    META_ASSERT_TRUE(cache_stub_set_calls == 1, "repeated set of router interface mtu was not suppressed");
+
+    sai_metadata_cache_disable();
+}
+
 int main(int argc, char **argv)
 {
     debug = (argc > 1);
@@ -5726,6 +6857,7 @@ int main(int argc, char **argv)
     check_object_infos();
     check_stat_enums();
     check_attr_sorted_by_id_name();
+    check_attr_id_name_hash();
     check_non_object_id_object_types();
     check_non_object_id_object_attrs();
     check_objects_for_loops();
@@ -5757,6 +6889,13 @@ int main(int argc, char **argv)
     check_struct_and_union_size();
     check_declare_entry_macro();
     check_json_type_size();
+    check_scheduler_layers();
+    check_scheduler_execute();
+    check_object_type_ranks();
+    check_refcount_tracker();
+    check_attr_value_helpers();
+    check_attr_cache();
+    check_attr_cache_trigger_set();
 
     SAI_META_LOG_DEBUG("log test");
 
@@ -36,6 +36,10 @@
 #include "saimetadata.h"
 #include "saiserialize.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #define PRIMITIVE_BUFFER_SIZE 128
 #define MAX_CHARS_PRINT 25
 
@@ -74,6 +78,31 @@ bool sai_serialize_is_char_allowed(
     return c == 0 || c == '"' || c == ',' || c == ']' || c == '}';
 }
 
+#define SAI_SERIALIZE_NOT_DIGIT 0xff
+
+static const uint8_t sai_serialize_hex_digits[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+    ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
+static uint8_t sai_serialize_digit_value(
+        _In_ char c,
+        _In_ bool hex)
+{
+    /* table holds value + 1, so zero marks not digit */
+
+    uint8_t value = sai_serialize_hex_digits[(unsigned char)c];
+
+    if (value == 0 || (!hex && value > 10))
+    {
+        return SAI_SERIALIZE_NOT_DIGIT;
+    }
+
+    return (uint8_t)(value - 1);
+}
+
 int sai_serialize_bool(
         _Out_ char *buffer,
         _In_ bool flag)
@@ -717,37 +746,230 @@ int sai_deserialize_enum(
     return sai_deserialize_int32(buffer, value);
 }
 
-static int sai_deserialize_ip(
+/*
+ * IP addresses are parsed in place in single pass, without copying them to
+ * zero terminated local buffer for inet_pton, since after address there may
+ * be '"' (quote) or '/' (prefix mask) and not only '\0'. Syntax accepted is
+ * the same as inet_pton accepts.
+ */
+
+#define SAI_IP4_OCTET_MAX_DIGITS 3
+#define SAI_IP6_GROUP_MAX_DIGITS 4
+#define SAI_IP6_GROUP_SIZE 2
+
+static int sai_deserialize_ip4_octets(
         _In_ const char *buffer,
-        _In_ int inet,
         _Out_ uint8_t *ip)
 {
-    /*
-     * Since we want relaxed version of deserialize, after ip address there
-     * may be '"' (quote), but inet_pton expects '\0' at the end, so copy at
-     * most INET6 characters to local buffer.
-     */
+    uint8_t octets[sizeof(sai_ip4_t)];
+
+    int idx = 0;
+    size_t octet;
+
+    for (octet = 0; octet < sizeof(sai_ip4_t); octet++)
+    {
+        if (octet != 0 && buffer[idx++] != '.')
+        {
+            return SAI_SERIALIZE_ERROR;
+        }
 
-    char local[INET6_ADDRSTRLEN + 1];
+        uint32_t value = 0;
+        int digits;
 
-    int idx;
+        for (digits = 0; digits <= SAI_IP4_OCTET_MAX_DIGITS; digits++)
+        {
+            uint8_t digit = sai_serialize_digit_value(buffer[idx + digits], false);
+
+            if (digit == SAI_SERIALIZE_NOT_DIGIT)
+            {
+                break;
+            }
+
+            value = value * SAI_BASE_10 + digit;
+        }
+
+        /* leading zeros are not allowed, same as in inet_pton */
+
+        if (digits == 0 || digits > SAI_IP4_OCTET_MAX_DIGITS || value > UCHAR_MAX ||
+                (digits > 1 && buffer[idx] == '0'))
+        {
+            return SAI_SERIALIZE_ERROR;
+        }
 
-    for (idx = 0; idx < INET6_ADDRSTRLEN; idx++)
+        octets[octet] = (uint8_t)value;
+
+        idx += digits;
+    }
+
+    memcpy(ip, octets, sizeof(octets));
+
+    return idx;
+}
+
+static int sai_deserialize_ip6_groups(
+        _In_ const char *buffer,
+        _Out_ uint8_t *ip)
+{
+    uint8_t groups[sizeof(sai_ip6_t)] = { 0 };
+
+    int idx = 0;
+    int group_start = 0;
+    int digits = 0;
+    uint32_t value = 0;
+    size_t pos = 0;
+    size_t compressed = 0;
+    bool is_compressed = false;
+
+    if (buffer[0] == ':' && buffer[1] != ':')
+    {
+        return SAI_SERIALIZE_ERROR;
+    }
+
+    if (buffer[0] == ':')
+    {
+        idx = 1;
+    }
+
+    while (true)
     {
         char c = buffer[idx];
 
-        if (isxdigit(c) || c == ':' || c == '.')
+        uint8_t digit = sai_serialize_digit_value(c, true);
+
+        if (digit != SAI_SERIALIZE_NOT_DIGIT)
         {
-            local[idx] = c;
+            if (digits == SAI_IP6_GROUP_MAX_DIGITS)
+            {
+                return SAI_SERIALIZE_ERROR;
+            }
+
+            value = (value << 4) | digit;
+            digits++;
+            idx++;
             continue;
         }
 
+        if (c == ':')
+        {
+            idx++;
+
+            if (digits == 0)
+            {
+                if (is_compressed)
+                {
+                    return SAI_SERIALIZE_ERROR;
+                }
+
+                is_compressed = true;
+                compressed = pos;
+                group_start = idx;
+                continue;
+            }
+
+            /* single colon must be followed by next group or by "::" */
+
+            if (pos + SAI_IP6_GROUP_SIZE > sizeof(sai_ip6_t) ||
+                    (buffer[idx] != ':' &&
+                     sai_serialize_digit_value(buffer[idx], true) == SAI_SERIALIZE_NOT_DIGIT))
+            {
+                return SAI_SERIALIZE_ERROR;
+            }
+
+            groups[pos++] = (uint8_t)(value >> 8);
+            groups[pos++] = (uint8_t)value;
+
+            group_start = idx;
+            digits = 0;
+            value = 0;
+            continue;
+        }
+
+        if (c == '.' && pos + sizeof(sai_ip4_t) <= sizeof(sai_ip6_t))
+        {
+            /* ipv4 address in last 32 bits, last group is its first octet */
+
+            int n = sai_deserialize_ip4_octets(buffer + group_start, groups + pos);
+
+            if (n < 0)
+            {
+                return SAI_SERIALIZE_ERROR;
+            }
+
+            pos += sizeof(sai_ip4_t);
+            idx = group_start + n;
+            digits = 0;
+        }
+
         break;
     }
 
-    local[idx] = 0;
+    if (digits != 0)
+    {
+        if (pos + SAI_IP6_GROUP_SIZE > sizeof(sai_ip6_t))
+        {
+            return SAI_SERIALIZE_ERROR;
+        }
+
+        groups[pos++] = (uint8_t)(value >> 8);
+        groups[pos++] = (uint8_t)value;
+    }
+
+    if (is_compressed)
+    {
+        /* "::" must replace at least one group, move groups after it to the end */
+
+        size_t tail = pos - compressed;
+
+        if (pos == sizeof(sai_ip6_t))
+        {
+            return SAI_SERIALIZE_ERROR;
+        }
+
+        memmove(groups + sizeof(sai_ip6_t) - tail, groups + compressed, tail);
+        memset(groups + compressed, 0, sizeof(sai_ip6_t) - tail - compressed);
+
+        pos = sizeof(sai_ip6_t);
+    }
+
+    if (pos != sizeof(sai_ip6_t))
+    {
+        return SAI_SERIALIZE_ERROR;
+    }
+
+    memcpy(ip, groups, sizeof(groups));
+
+    return idx;
+}
+
+static int sai_deserialize_ip_inet(
+        _In_ const char *buffer)
+{
+    /*
+     * Address family is known from first separator, ipv4 octets are
+     * separated by '.', and ipv6 address contains ':' before any '.'.
+     */
+
+    int idx = 0;
+
+    while (idx <= SAI_IP6_GROUP_MAX_DIGITS &&
+            sai_serialize_digit_value(buffer[idx], true) != SAI_SERIALIZE_NOT_DIGIT)
+    {
+        idx++;
+    }
+
+    return (buffer[idx] == '.') ? AF_INET : AF_INET6;
+}
 
-    if (inet_pton(inet, local, ip) != 1)
+static int sai_deserialize_ip(
+        _In_ const char *buffer,
+        _In_ int inet,
+        _Out_ uint8_t *ip)
+{
+    int idx = (inet == AF_INET)
+        ? sai_deserialize_ip4_octets(buffer, ip)
+        : sai_deserialize_ip6_groups(buffer, ip);
+
+    if (idx < 0)
     {
         /*
          * We should not warn here, since we will use this method to
@@ -833,22 +1055,25 @@ int sai_deserialize_ip_address(
 {
     int res;
 
-    /* try first deserialize ip4 then ip6 */
-
-    res = sai_deserialize_ip(buffer, AF_INET, (uint8_t*)&ip_address->addr.ip4);
-
-    if (res > 0)
+    if (sai_deserialize_ip_inet(buffer) == AF_INET)
     {
-        ip_address->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
-        return res;
-    }
-
-    res = sai_deserialize_ip(buffer, AF_INET6, ip_address->addr.ip6);
+        res = sai_deserialize_ip(buffer, AF_INET, (uint8_t*)&ip_address->addr.ip4);
 
-    if (res > 0)
+        if (res > 0)
+        {
+            ip_address->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+            return res;
+        }
+    }
+    else
     {
-        ip_address->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
-        return res;
+        res = sai_deserialize_ip(buffer, AF_INET6, ip_address->addr.ip6);
+
+        if (res > 0)
+        {
+            ip_address->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+            return res;
+        }
     }
 
     SAI_META_LOG_WARN("failed to deserialize '%.*s' as ip address",
@@ -907,53 +1132,37 @@ int sai_deserialize_ip_prefix(
     _In_ const char *buffer,
     _Out_ sai_ip_prefix_t *ip_prefix)
 {
-    /* try first deserialize ip4 then ip6 */
-
     int res, n;
 
-    while (true)
+    if (sai_deserialize_ip_inet(buffer) == AF_INET)
     {
         res = sai_deserialize_ip(buffer, AF_INET, (uint8_t*)&ip_prefix->addr.ip4);
 
-        if (res > 0)
+        if (res > 0 && buffer[res++] == '/')
         {
-            ip_prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
-
-            if (buffer[res++] != '/')
-            {
-                break;
-            }
-
             n = sai_deserialize_ip4_mask(buffer + res, &ip_prefix->mask.ip4);
 
             if (n > 0)
             {
+                ip_prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
                 return res + n;
             }
-
-            break;
         }
-
+    }
+    else
+    {
         res = sai_deserialize_ip(buffer, AF_INET6, ip_prefix->addr.ip6);
 
-        if (res > 0)
+        if (res > 0 && buffer[res++] == '/')
         {
-            if (buffer[res++] != '/')
-            {
-                break;
-            }
-
-            ip_prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
-
             n = sai_deserialize_ip6_mask(buffer + res, (uint8_t*)&ip_prefix->mask.ip6);
 
             if (n > 0)
             {
+                ip_prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
                 return res + n;
             }
         }
-
-        break;
     }
 
     SAI_META_LOG_WARN("failed to deserialize '%.*s' as ip prefix", MAX_CHARS_PRINT, buffer);
@@ -1238,6 +1447,249 @@ int sai_deserialize_enum_list(
     return (int)(buf - buffer);
 }
 
+/*
+ * Array scanners
+ *
+ * Generated deserializers of numeric and object id arrays call those instead
+ * of deserializing item by item. Number of digits of each item is found in
+ * single step by comparing 16 chars at once when SSE2 is available (it is
+ * part of x86_64 base instruction set, so no run time dispatch is needed),
+ * and then value is accumulated using lookup table.
+ */
+
+#define SAI_SERIALIZE_VECTOR_SIZE 16
+
+/*
+ * Arrays shorter than this are scanned without vector instructions, since
+ * getting remaining length of input buffer would cost more than it saves.
+ */
+
+#define SAI_SERIALIZE_VECTOR_MIN_COUNT 16
+
+#define SAI_OID_PREFIX "\"oid:0x"
+#define SAI_OID_PREFIX_LENGTH 7
+
+/*
+ * Longest serialized array item with separator, which is comma, quoted oid
+ * prefix, 16 hex digits and closing quote. Decimal items have at most 20
+ * digits (leading zeros only make item fall back to scalar scan).
+ */
+
+#define SAI_SERIALIZE_ARRAY_ITEM_MAX_LENGTH (1 + SAI_OID_PREFIX_LENGTH + 16 + 1)
+
+static size_t sai_serialize_scan_digits(
+        _In_ const char *buf,
+        _In_ size_t length,
+        _In_ bool hex)
+{
+    size_t count = 0;
+
+#if defined(__SSE2__)
+
+    /* length is number of chars which can be read after buf */
+
+    while (length - count >= SAI_SERIALIZE_VECTOR_SIZE)
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i*)(const void*)(buf + count));
+
+        /* chars above 0x7f are negative and are never digits */
+
+        __m128i digit = _mm_and_si128(
+                _mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+
+        if (hex)
+        {
+            __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+            digit = _mm_or_si128(digit, _mm_and_si128(
+                        _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                        _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1))));
+        }
+
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(digit) ^ 0xffffu;
+
+        if (mask != 0)
+        {
+            return count + (size_t)__builtin_ctz(mask);
+        }
+
+        count += SAI_SERIALIZE_VECTOR_SIZE;
+    }
+
+#endif /* __SSE2__ */
+
+    while (sai_serialize_digit_value(buf[count], hex) != SAI_SERIALIZE_NOT_DIGIT)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+static int sai_deserialize_number_item(
+        _In_ const char *buf,
+        _In_ size_t length,
+        _In_ bool hex,
+        _In_ uint64_t max,
+        _Out_ uint64_t *value)
+{
+    size_t count = sai_serialize_scan_digits(buf, length, hex);
+    size_t idx;
+    uint64_t result = 0;
+
+    /* oid is limited to 16 digits, same as in sai_deserialize_object_id */
+
+    if (count == 0 || (hex && count > 16) || !sai_serialize_is_char_allowed(buf[count]))
+    {
+        return SAI_SERIALIZE_ERROR;
+    }
+
+    for (idx = 0; idx < count; idx++)
+    {
+        uint64_t digit = sai_serialize_digit_value(buf[idx], hex);
+
+        if (hex)
+        {
+            result = (result << 4) | digit;
+            continue;
+        }
+
+        if (result > (max - digit) / SAI_BASE_10)
+        {
+            return SAI_SERIALIZE_ERROR;
+        }
+
+        result = result * SAI_BASE_10 + digit;
+    }
+
+    if (result > max)
+    {
+        return SAI_SERIALIZE_ERROR;
+    }
+
+    *value = result;
+
+    return (int)count;
+}
+
+static int sai_deserialize_number_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _In_ bool oid,
+        _In_ uint64_t max,
+        _In_ size_t size,
+        _Out_ void *list)
+{
+    const char *buf = buffer;
+    size_t length = 0;
+    uint32_t idx;
+    uint64_t value;
+    int ret;
+
+    if (count >= SAI_SERIALIZE_VECTOR_MIN_COUNT)
+    {
+        /*
+         * Buffer usually holds much more than this array, so its length is
+         * only looked up to longest possible array end, otherwise
+         * deserializing many arrays from one buffer would be quadratic.
+         */
+
+        length = strnlen(buffer, (size_t)count * SAI_SERIALIZE_ARRAY_ITEM_MAX_LENGTH + SAI_SERIALIZE_VECTOR_SIZE);
+    }
+
+    for (idx = 0; idx < count; idx++)
+    {
+        if (idx != 0)
+        {
+            EXPECT(",");
+        }
+
+        if (oid)
+        {
+            EXPECT(SAI_OID_PREFIX);
+        }
+
+        size_t offset = (size_t)(buf - buffer);
+
+        ret = sai_deserialize_number_item(buf, (offset < length) ? length - offset : 0, oid, max, &value);
+
+        if (ret < 0)
+        {
+            SAI_META_LOG_WARN("failed to deserialize '%.*s...' as array item %u", MAX_CHARS_PRINT, buf, idx);
+            return SAI_SERIALIZE_ERROR;
+        }
+
+        buf += ret;
+
+        if (oid)
+        {
+            EXPECT("\"");
+        }
+
+        switch (size)
+        {
+            case sizeof(uint8_t):
+                ((uint8_t*)list)[idx] = (uint8_t)value;
+                break;
+
+            case sizeof(uint16_t):
+                ((uint16_t*)list)[idx] = (uint16_t)value;
+                break;
+
+            case sizeof(uint32_t):
+                ((uint32_t*)list)[idx] = (uint32_t)value;
+                break;
+
+            default:
+                ((uint64_t*)list)[idx] = value;
+                break;
+        }
+    }
+
+    return (int)(buf - buffer);
+}
+
+int sai_deserialize_uint8_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint8_t *u8)
+{
+    return sai_deserialize_number_array(buffer, count, false, UCHAR_MAX, sizeof(uint8_t), u8);
+}
+
+int sai_deserialize_uint16_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint16_t *u16)
+{
+    return sai_deserialize_number_array(buffer, count, false, USHRT_MAX, sizeof(uint16_t), u16);
+}
+
+int sai_deserialize_uint32_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint32_t *u32)
+{
+    return sai_deserialize_number_array(buffer, count, false, UINT_MAX, sizeof(uint32_t), u32);
+}
+
+int sai_deserialize_uint64_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint64_t *u64)
+{
+    return sai_deserialize_number_array(buffer, count, false, UINT64_MAX, sizeof(uint64_t), u64);
+}
+
+int sai_deserialize_object_id_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ sai_object_id_t *object_id)
+{
+    return sai_deserialize_number_array(buffer, count, true, UINT64_MAX, sizeof(sai_object_id_t), object_id);
+}
+
 int sai_serialize_attr_id(
         _Out_ char *buf,
         _In_ const sai_attr_metadata_t *meta,
@@ -805,6 +805,97 @@ int sai_deserialize_enum_list(
         _In_ const sai_enum_metadata_t *meta,
         _Out_ sai_s32_list_t *s32_list);
 
+/**
+ * @brief Deserialize array of 8 bit unsigned integer items.
+ *
+ * Deserializes comma separated items between square brackets of json
+ * array, brackets are not consumed.
+ *
+ * @param[in] buffer Input buffer to be examined.
+ * @param[in] count Number of items in array.
+ * @param[out] u8 Deserialized items, count items long.
+ *
+ * @return Number of characters consumed from the buffer,
+ * or #SAI_SERIALIZE_ERROR on error.
+ */
+int sai_deserialize_uint8_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint8_t *u8);
+
+/**
+ * @brief Deserialize array of 16 bit unsigned integer items.
+ *
+ * Deserializes comma separated items between square brackets of json
+ * array, brackets are not consumed.
+ *
+ * @param[in] buffer Input buffer to be examined.
+ * @param[in] count Number of items in array.
+ * @param[out] u16 Deserialized items, count items long.
+ *
+ * @return Number of characters consumed from the buffer,
+ * or #SAI_SERIALIZE_ERROR on error.
+ */
+int sai_deserialize_uint16_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint16_t *u16);
+
+/**
+ * @brief Deserialize array of 32 bit unsigned integer items.
+ *
+ * Deserializes comma separated items between square brackets of json
+ * array, brackets are not consumed.
+ *
+ * @param[in] buffer Input buffer to be examined.
+ * @param[in] count Number of items in array.
+ * @param[out] u32 Deserialized items, count items long.
+ *
+ * @return Number of characters consumed from the buffer,
+ * or #SAI_SERIALIZE_ERROR on error.
+ */
+int sai_deserialize_uint32_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint32_t *u32);
+
+/**
+ * @brief Deserialize array of 64 bit unsigned integer items.
+ *
+ * Deserializes comma separated items between square brackets of json
+ * array, brackets are not consumed.
+ *
+ * @param[in] buffer Input buffer to be examined.
+ * @param[in] count Number of items in array.
+ * @param[out] u64 Deserialized items, count items long.
+ *
+ * @return Number of characters consumed from the buffer,
+ * or #SAI_SERIALIZE_ERROR on error.
+ */
+int sai_deserialize_uint64_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ uint64_t *u64);
+
+/**
+ * @brief Deserialize array of object Id items.
+ *
+ * Deserializes comma separated items between square brackets of json
+ * array, brackets are not consumed.
+ * Each item is quoted, same as in serialized object list.
+ *
+ * @param[in] buffer Input buffer to be examined.
+ * @param[in] count Number of items in array.
+ * @param[out] object_id Deserialized items, count items long.
+ *
+ * @return Number of characters consumed from the buffer,
+ * or #SAI_SERIALIZE_ERROR on error.
+ */
+int sai_deserialize_object_id_array(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ sai_object_id_t *object_id);
+
 /**
  * @brief Serialize attribute id.
  *
@@ -0,0 +1,299 @@
+/**
+ * Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *    not use this file except in compliance with the License. You may obtain
+ *    a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *    CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *    LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *    FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *    See the Apache Version 2.0 License for specific language governing
+ *    permissions and limitations under the License.
+ *
+ *    Microsoft would like to thank the following companies for their review and
+ *    assistance with these files: Intel Corporation, Mellanox Technologies Ltd,
+ *    Dell Products, L.P., Facebook, Inc., Marvell International Ltd.
+ *
+ * @file    saiserializebench.c
+ *
+ * @brief   This module measures SAI Serialize
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <sai.h>
+#include "saimetadata.h"
+
+#define ARRAY_COUNT 512
+#define ARRAY_ITERATIONS 2000
+
+/*
+ * Many short arrays back to back in one buffer, like object list attributes
+ * of a long serialized batch.
+ */
+
+#define BATCH_ARRAYS 4096
+#define BATCH_ARRAY_COUNT 32
+#define BATCH_ITERATIONS 20
+
+#define IP_PREFIX_ITERATIONS 200000
+
+#define OID(idx) (0x1000000000000ULL | (sai_object_id_t)(idx))
+
+#define CHECK(cond)                                                         \
+    if (!(cond)) {                                                          \
+        fprintf(stderr, "FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+        exit(1);                                                            \
+    }
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int serialize_object_id_items(
+        _Out_ char *buffer,
+        _In_ uint32_t count,
+        _In_ const sai_object_id_t *list)
+{
+    char *buf = buffer;
+    uint32_t idx;
+
+    *buf = 0;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        buf += sprintf(buf, (idx == 0) ? "\"" : ",\"");
+        buf += sai_serialize_object_id(buf, list[idx]);
+        buf += sprintf(buf, "\"");
+    }
+
+    return (int)(buf - buffer);
+}
+
+static int deserialize_object_id_items(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ sai_object_id_t *list)
+{
+    const char *buf = buffer;
+    uint32_t idx;
+    int res;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        buf += (idx == 0) ? 1 : 2; /* skip quote or comma and quote */
+
+        res = sai_deserialize_object_id(buf, &list[idx]);
+
+        if (res < 0)
+        {
+            return res;
+        }
+
+        buf += res + 1;
+    }
+
+    return (int)(buf - buffer);
+}
+
+static void bench_object_id_array(void)
+{
+    char *buf = malloc((size_t)ARRAY_COUNT * 32);
+    sai_object_id_t list[ARRAY_COUNT];
+    uint32_t idx;
+
+    CHECK(buf != NULL);
+
+    for (idx = 0; idx < ARRAY_COUNT; idx++)
+    {
+        list[idx] = OID(idx);
+    }
+
+    int len = serialize_object_id_items(buf, ARRAY_COUNT, list);
+
+    uint64_t start = now_ns();
+
+    for (idx = 0; idx < ARRAY_ITERATIONS; idx++)
+    {
+        CHECK(deserialize_object_id_items(buf, ARRAY_COUNT, list) == len);
+    }
+
+    uint64_t items = now_ns() - start;
+
+    start = now_ns();
+
+    for (idx = 0; idx < ARRAY_ITERATIONS; idx++)
+    {
+        CHECK(sai_deserialize_object_id_array(buf, ARRAY_COUNT, list) == len);
+    }
+
+    uint64_t array = now_ns() - start;
+
+    printf("object id array of %d items: item by item %.1f MB/s, array %.1f MB/s\n", ARRAY_COUNT,
+            (double)len * ARRAY_ITERATIONS * 1e3 / (double)(items ? items : 1),
+            (double)len * ARRAY_ITERATIONS * 1e3 / (double)(array ? array : 1));
+
+    free(buf);
+}
+
+/*
+ * Time per item must not depend on how much of buffer follows the array.
+ */
+static void bench_object_id_array_batch(void)
+{
+    char *buffer = malloc((size_t)BATCH_ARRAYS * BATCH_ARRAY_COUNT * 32);
+    sai_object_id_t list[BATCH_ARRAY_COUNT];
+    uint32_t idx;
+
+    CHECK(buffer != NULL);
+
+    char *buf = buffer;
+
+    for (idx = 0; idx < BATCH_ARRAYS; idx++)
+    {
+        uint32_t item = 0;
+
+        for (; item < BATCH_ARRAY_COUNT; item++)
+        {
+            list[item] = OID(idx * BATCH_ARRAY_COUNT + item);
+        }
+
+        buf += serialize_object_id_items(buf, BATCH_ARRAY_COUNT, list);
+        buf += sprintf(buf, "],[");
+    }
+
+    size_t len = (size_t)(buf - buffer);
+
+    uint64_t start = now_ns();
+
+    int iteration = 0;
+
+    for (; iteration < BATCH_ITERATIONS; iteration++)
+    {
+        const char *ptr = buffer;
+
+        for (idx = 0; idx < BATCH_ARRAYS; idx++)
+        {
+            int res = sai_deserialize_object_id_array(ptr, BATCH_ARRAY_COUNT, list);
+
+            CHECK(res > 0 && list[0] == OID(idx * BATCH_ARRAY_COUNT));
+
+            ptr += res + 3;
+        }
+    }
+
+    uint64_t batch = now_ns() - start;
+
+    printf("%d object id arrays of %d items in %zu KB buffer: %.1f ns per item\n",
+            BATCH_ARRAYS, BATCH_ARRAY_COUNT, len / 1024,
+            (double)batch / (double)((uint64_t)BATCH_ITERATIONS * BATCH_ARRAYS * BATCH_ARRAY_COUNT));
+
+    free(buffer);
+}
+
+static int inet_pton_ip_prefix(
+        _In_ const char *buffer,
+        _Out_ sai_ip_prefix_t *prefix)
+{
+    /* reference parse with local copy for inet_pton */
+
+    char local[INET6_ADDRSTRLEN + 1];
+
+    const char *slash = strchr(buffer, '/');
+
+    size_t len = (size_t)(slash - buffer);
+
+    memcpy(local, buffer, len);
+    local[len] = 0;
+
+    if (inet_pton(AF_INET, local, &prefix->addr.ip4) == 1)
+    {
+        prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+
+        return (int)len + 1 + sai_deserialize_ip4_mask(slash + 1, &prefix->mask.ip4);
+    }
+
+    if (inet_pton(AF_INET6, local, prefix->addr.ip6) == 1)
+    {
+        prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+
+        return (int)len + 1 + sai_deserialize_ip6_mask(slash + 1, prefix->mask.ip6);
+    }
+
+    return -1;
+}
+
+static void bench_ip_prefix(void)
+{
+    const char *prefixes[] = {
+        "10.0.0.21/32",
+        "192.168.100.0/24",
+        "0.0.0.0/0",
+        "2001:db8:85a3::8a2e:370:7334/128",
+        "fc00:1:2:3::/64",
+        "::ffff:10.11.12.13/96",
+    };
+
+    size_t count = sizeof(prefixes)/sizeof(prefixes[0]);
+
+    sai_ip_prefix_t prefix;
+    size_t idx;
+    int iteration;
+
+    uint64_t start = now_ns();
+
+    for (iteration = 0; iteration < IP_PREFIX_ITERATIONS; iteration++)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            CHECK(inet_pton_ip_prefix(prefixes[idx], &prefix) > 0);
+        }
+    }
+
+    uint64_t reference = now_ns() - start;
+
+    start = now_ns();
+
+    for (iteration = 0; iteration < IP_PREFIX_ITERATIONS; iteration++)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            CHECK(sai_deserialize_ip_prefix(prefixes[idx], &prefix) > 0);
+        }
+    }
+
+    uint64_t parser = now_ns() - start;
+
+    printf("ip prefix: inet_pton %.1f ns, deserialize %.1f ns per prefix\n",
+            (double)reference / (double)((uint64_t)IP_PREFIX_ITERATIONS * count),
+            (double)parser / (double)((uint64_t)IP_PREFIX_ITERATIONS * count));
+}
+
+int main(
+        _In_ int argc,
+        _In_ char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    bench_object_id_array();
+
+    bench_object_id_array_batch();
+
+    bench_ip_prefix();
+
+    return 0;
+}
@@ -54,6 +54,7 @@
 
 #define PRIMITIVE_BUFFER_SIZE 128
 #define LONG_BUFFER_SIZE 0x10000
+#define ARRAY_TEST_COUNT 512
 
 void test_serialize_bool()
 {
@@ -619,6 +620,19 @@ void test_deserialize_ip4()
 
     res = sai_deserialize_ip4("1.1.256.1", &ip);
     ASSERT_TRUE(res < 0, "expected negative number");
+
+    res = sai_deserialize_ip4("0.0.0.0]", &ip);
+    ASSERT_TRUE(res == 7 && ip == 0, "expected true, res: %d", res);
+
+    const char *bad[] = { "", "1.2.3", "1.2.3.4.5", "01.2.3.4", "1.2.3.4a", "1..2.3", "1.2.3.1000", ".1.2.3" };
+
+    size_t idx;
+
+    for (idx = 0; idx < sizeof(bad)/sizeof(bad[0]); idx++)
+    {
+        res = sai_deserialize_ip4(bad[idx], &ip);
+        ASSERT_TRUE(res < 0, "expected negative number for '%s'", bad[idx]);
+    }
 }
 
 void test_serialize_ip6()
@@ -694,6 +708,52 @@ void test_deserialize_ip6()
     buf = "1::456::3";
     res = sai_deserialize_ip6(buf, ip);
     ASSERT_TRUE(res < 0, "expected negative number");
+
+    uint16_t ip6c[] = { 0, 0, 0, 0, 0, 0xffff, 0x0b0a, 0x0d0c };
+
+    buf = "::FFFF:10.11.12.13\"";
+    res = sai_deserialize_ip6(buf, ip);
+    ASSERT_TRUE(res == (int)strlen(buf) - 1, "expected true, res: %d", res);
+    ASSERT_TRUE(memcmp(ip, ip6c, 16) == 0, "expected true");
+
+    uint16_t ip6d[] = { 0x1111, 0x2222, 0x3333, 0x4444, 0x5555, 0x6666, 0x7777, 0 };
+
+    buf = "1111:2222:3333:4444:5555:6666:7777::";
+    res = sai_deserialize_ip6(buf, ip);
+    ASSERT_TRUE(res == (int)strlen(buf), "expected true, res: %d", res);
+    ASSERT_TRUE(memcmp(ip, ip6d, 16) == 0, "expected true");
+
+    memset(ip6d, 0, sizeof(ip6d));
+
+    buf = "::";
+    res = sai_deserialize_ip6(buf, ip);
+    ASSERT_TRUE(res == 2, "expected true, res: %d", res);
+    ASSERT_TRUE(memcmp(ip, ip6d, 16) == 0, "expected true");
+
+    const char *bad[] = {
+        "",
+        ":1::",
+        "1:",
+        "1::2:",
+        ":::",
+        "12345::",
+        "1:2:3:4:5:6:7",
+        "1:2:3:4:5:6:7:8:9",
+        "1:2:3:4:5:6:7:8::",
+        "1:2:3:4:5:6:7::8",
+        "::1.2.3",
+        "::1.2.3.04",
+        "1:2:3:4:5:6:7:1.2.3.4",
+        "::1g",
+    };
+
+    size_t idx;
+
+    for (idx = 0; idx < sizeof(bad)/sizeof(bad[0]); idx++)
+    {
+        res = sai_deserialize_ip6(bad[idx], ip);
+        ASSERT_TRUE(res < 0, "expected negative number for '%s'", bad[idx]);
+    }
 }
 
 void subtest_serialize_ip_addres_v4(
@@ -1379,6 +1439,292 @@ void test_deserialize_fdb_entry()
     }
 }
 
+void test_deserialize_object_key_cursor()
+{
+    char buf[PRIMITIVE_BUFFER_SIZE];
+    char buf2[PRIMITIVE_BUFFER_SIZE];
+    int res;
+
+    sai_object_key_cursor_t cursor;
+
+    cursor.position = 0x123456789abcULL;
+    cursor.done = true;
+
+    res = sai_serialize_object_key_cursor(buf, &cursor);
+
+    ASSERT_TRUE(res > 0, "failed to serialize cursor: %d", res);
+
+    sai_object_key_cursor_t decursor;
+
+    memset(&decursor, 0, sizeof(decursor));
+
+    res = sai_deserialize_object_key_cursor(buf, &decursor);
+
+    ASSERT_TRUE(res == (int)strlen(buf), "result length is not expected: %d", res);
+    ASSERT_TRUE(decursor.position == cursor.position, "deserialized position is not the same as serialized");
+    ASSERT_TRUE(decursor.done, "deserialized done is not the same as serialized");
+
+    res = sai_serialize_object_key_cursor(buf2, &decursor);
+
+    ASSERT_TRUE(strcmp(buf, buf2) == 0, "deserialized value is not the same as serialized");
+
+    res = sai_deserialize_object_key_cursor("{\"position\":1}", &decursor);
+
+    ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+}
+
+int test_serialize_object_id_items(
+        _Out_ char *buffer,
+        _In_ uint32_t count,
+        _In_ const sai_object_id_t *list)
+{
+    char *buf = buffer;
+    uint32_t idx;
+
+    *buf = 0;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        buf += sprintf(buf, (idx == 0) ? "\"" : ",\"");
+        buf += sai_serialize_object_id(buf, list[idx]);
+        buf += sprintf(buf, "\"");
+    }
+
+    return (int)(buf - buffer);
+}
+
+int test_deserialize_object_id_items(
+        _In_ const char *buffer,
+        _In_ uint32_t count,
+        _Out_ sai_object_id_t *list)
+{
+    const char *buf = buffer;
+    uint32_t idx;
+    int res;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        buf += (idx == 0) ? 1 : 2; /* skip quote or comma and quote */
+
+        res = sai_deserialize_object_id(buf, &list[idx]);
+
+        if (res < 0)
+        {
+            return res;
+        }
+
+        buf += res + 1;
+    }
+
+    return (int)(buf - buffer);
+}
+
+void test_deserialize_object_id_array()
+{
+    char *buf = malloc(LONG_BUFFER_SIZE);
+    sai_object_id_t list[ARRAY_TEST_COUNT];
+    sai_object_id_t delist[ARRAY_TEST_COUNT];
+    sai_object_id_t relist[ARRAY_TEST_COUNT];
+    uint32_t idx;
+    uint32_t count;
+    int res;
+
+    /* mix of short and long object ids, so digits cross vector boundary */
+
+    for (idx = 0; idx < ARRAY_TEST_COUNT; idx++)
+    {
+        list[idx] = ((uint64_t)rand() << 32 | (uint64_t)rand()) >> (idx % 64);
+    }
+
+    list[0] = 0;
+    list[1] = UINT64_MAX;
+
+    test_serialize_object_id_items(buf, ARRAY_TEST_COUNT, list);
+
+    /* short arrays are scanned without vector instructions */
+
+    for (count = 0; count <= ARRAY_TEST_COUNT; count += (count < 40) ? 1 : 59)
+    {
+        memset(delist, 0, sizeof(delist));
+
+        res = sai_deserialize_object_id_array(buf, count, delist);
+
+        ASSERT_TRUE(res == test_deserialize_object_id_items(buf, count, relist), "unexpected length for count %u: %d", count, res);
+
+        ASSERT_TRUE(memcmp(delist, relist, count * sizeof(sai_object_id_t)) == 0, "deserialized values are not the same for count %u", count);
+    }
+
+    ASSERT_TRUE(memcmp(delist, list, sizeof(list)) == 0, "deserialized values are not the same as serialized");
+
+    res = sai_deserialize_object_id_array("\"oid:0xABCdef\"]", 1, delist);
+
+    ASSERT_TRUE(res == 14 && delist[0] == 0xabcdef, "expected mixed case hex: %d", res);
+
+    /* negative cases, also at the end of long array */
+
+    const char* ncases[] = {
+        "\"oid:0x\"",
+        "\"oid:0x12345678901234567\"",
+        "\"oid:0xg\"",
+        "\"oid:0x1 \"",
+        "\"oid:0x-1\"",
+        "\"0x1\"",
+        "oid:0x1",
+    };
+
+    size_t i = 0;
+    for (; i < sizeof(ncases)/sizeof(const char*); ++i)
+    {
+        res = sai_deserialize_object_id_array(ncases[i], 1, delist);
+        ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+
+        count = 40;
+
+        res = test_serialize_object_id_items(buf, count, list);
+
+        sprintf(buf + res, ",%s", ncases[i]);
+
+        res = sai_deserialize_object_id_array(buf, count + 1, delist);
+        ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+    }
+
+    res = sai_deserialize_object_id_array("\"oid:0x1\"", 2, delist);
+    ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+
+    free(buf);
+}
+
+void test_deserialize_uint_array()
+{
+    char *buf = malloc(LONG_BUFFER_SIZE);
+    char *ptr = buf;
+    uint8_t u8[3];
+    uint16_t u16[2];
+    uint32_t u32[ARRAY_TEST_COUNT];
+    uint64_t u64[3];
+    uint32_t idx;
+    int res;
+
+    res = sai_deserialize_uint8_array("0,1,255]", 3, u8);
+    ASSERT_TRUE(res == 7 && u8[0] == 0 && u8[1] == 1 && u8[2] == 255, "unexpected result: %d", res);
+
+    res = sai_deserialize_uint8_array("256", 1, u8);
+    ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+
+    res = sai_deserialize_uint16_array("65535,0", 2, u16);
+    ASSERT_TRUE(res == 7 && u16[0] == 65535, "unexpected result: %d", res);
+
+    res = sai_deserialize_uint16_array("65536", 1, u16);
+    ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+
+    res = sai_deserialize_uint32_array("4294967296", 1, u32);
+    ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+
+    res = sai_deserialize_uint64_array("18446744073709551615,0000000000000000000000007,0}", 3, u64);
+    ASSERT_TRUE(res == 48 && u64[0] == UINT64_MAX && u64[1] == 7 && u64[2] == 0, "unexpected result: %d", res);
+
+    const char* ncases[] = {
+        "18446744073709551616",
+        "-1",
+        "1.5",
+        "1 ",
+        "",
+        ",1",
+        "1,,2",
+    };
+
+    size_t i = 0;
+    for (; i < sizeof(ncases)/sizeof(const char*); ++i)
+    {
+        res = sai_deserialize_uint64_array(ncases[i], 2, u64);
+        ASSERT_TRUE(res < 0, "expected negative result for '%s': %d", ncases[i], res);
+    }
+
+    /* long array is same as item by item */
+
+    for (idx = 0; idx < ARRAY_TEST_COUNT; idx++)
+    {
+        ptr += sprintf(ptr, (idx == 0) ? "%u" : ",%u", (uint32_t)rand() >> (idx % 32));
+    }
+
+    res = sai_deserialize_uint32_array(buf, ARRAY_TEST_COUNT, u32);
+    ASSERT_TRUE(res == (int)strlen(buf), "unexpected length: %d", res);
+
+    for (ptr = buf, idx = 0; idx < ARRAY_TEST_COUNT; idx++)
+    {
+        uint32_t value;
+
+        res = sai_deserialize_uint32(ptr, &value);
+        ASSERT_TRUE(res > 0 && value == u32[idx], "item %u is not the same", idx);
+
+        ptr += res + 1;
+    }
+
+    free(buf);
+}
+
+int test_inet_pton_ip_prefix(
+        _In_ const char *buffer,
+        _Out_ sai_ip_prefix_t *prefix)
+{
+    /* reference parse with local copy for inet_pton */
+
+    char local[INET6_ADDRSTRLEN + 1];
+
+    const char *slash = strchr(buffer, '/');
+
+    size_t len = (size_t)(slash - buffer);
+
+    memcpy(local, buffer, len);
+    local[len] = 0;
+
+    if (inet_pton(AF_INET, local, &prefix->addr.ip4) == 1)
+    {
+        prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+
+        return (int)len + 1 + sai_deserialize_ip4_mask(slash + 1, &prefix->mask.ip4);
+    }
+
+    if (inet_pton(AF_INET6, local, prefix->addr.ip6) == 1)
+    {
+        prefix->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+
+        return (int)len + 1 + sai_deserialize_ip6_mask(slash + 1, prefix->mask.ip6);
+    }
+
+    return -1;
+}
+
+void test_deserialize_ip_prefix_inet_pton()
+{
+    const char *prefixes[] = {
+        "10.0.0.21/32",
+        "192.168.100.0/24",
+        "0.0.0.0/0",
+        "2001:db8:85a3::8a2e:370:7334/128",
+        "fc00:1:2:3::/64",
+        "::ffff:10.11.12.13/96",
+    };
+
+    size_t count = sizeof(prefixes)/sizeof(prefixes[0]);
+
+    sai_ip_prefix_t prefix;
+    sai_ip_prefix_t expected;
+    size_t idx;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        memset(&prefix, 0, sizeof(prefix));
+        memset(&expected, 0, sizeof(expected));
+
+        int res = sai_deserialize_ip_prefix(prefixes[idx], &prefix);
+        int exp = test_inet_pton_ip_prefix(prefixes[idx], &expected);
+
+        ASSERT_TRUE(res == exp && memcmp(&prefix, &expected, sizeof(prefix)) == 0,
+                "expected same result as inet_pton for '%s'", prefixes[idx]);
+    }
+}
+
 void test_serialize_notifications()
 {
     char buf[0x100 * PRIMITIVE_BUFFER_SIZE];
@@ -1439,6 +1785,104 @@ void test_serialize_notifications()
     ASSERT_STR_EQ(buf, ret, res);
 }
 
+void test_deserialize_notifications()
+{
+    char buf[0x100 * PRIMITIVE_BUFFER_SIZE];
+    char buf2[0x100 * PRIMITIVE_BUFFER_SIZE];
+    int res;
+
+    /* batch of port state change events */
+
+    sai_port_oper_status_notification_t data[3];
+    memset(data, 0, sizeof(data));
+
+    data[0].port_id = 0x1;
+    data[0].port_state = SAI_PORT_OPER_STATUS_UP;
+    data[1].port_id = 0x2;
+    data[1].port_state = SAI_PORT_OPER_STATUS_DOWN;
+    data[2].port_id = 0x1;
+    data[2].port_state = SAI_PORT_OPER_STATUS_DOWN;
+
+    res = sai_serialize_port_state_change_notification(buf, 3, data);
+
+    ASSERT_TRUE(res == (int)strlen(buf), "result length is not expected: %d", res);
+
+    uint32_t count = 0;
+    sai_port_oper_status_notification_t *dedata = NULL;
+
+    res = sai_deserialize_port_state_change_notification(buf, &count, &dedata);
+
+    ASSERT_TRUE(res == (int)strlen(buf), "result length is not expected: %d", res);
+    ASSERT_TRUE(count == 3, "expected 3 events, got %u", count);
+    ASSERT_TRUE(dedata != NULL, "expected data to be allocated");
+    ASSERT_TRUE(dedata[2].port_id == 0x1, "wrong port id");
+    ASSERT_TRUE(dedata[2].port_state == SAI_PORT_OPER_STATUS_DOWN, "wrong port state");
+
+    res = sai_serialize_port_state_change_notification(buf2, count, dedata);
+
+    ASSERT_TRUE(strcmp(buf, buf2) == 0, "deserialized value is not the same as serialized");
+
+    free(dedata);
+
+    /* batch of fdb events */
+
+    sai_fdb_event_notification_data_t fdata[2];
+    memset(fdata, 0, sizeof(fdata));
+
+    fdata[0].event_type = SAI_FDB_EVENT_LEARNED;
+    fdata[0].fdb_entry.switch_id = 0x123;
+    fdata[0].fdb_entry.bv_id = 0xfab;
+    memcpy(fdata[0].fdb_entry.mac_address, "\x01\x23\x45\x67\x89\xab", 6);
+
+    fdata[1].event_type = SAI_FDB_EVENT_AGED;
+    fdata[1].fdb_entry.switch_id = 0x123;
+    fdata[1].fdb_entry.bv_id = 0xfab;
+    memcpy(fdata[1].fdb_entry.mac_address, "\x01\x23\x45\x67\x89\xac", 6);
+
+    res = sai_serialize_fdb_event_notification(buf, 2, fdata);
+
+    ASSERT_TRUE(res == (int)strlen(buf), "result length is not expected: %d", res);
+
+    sai_fdb_event_notification_data_t *defdata = NULL;
+
+    res = sai_deserialize_fdb_event_notification(buf, &count, &defdata);
+
+    ASSERT_TRUE(res == (int)strlen(buf), "result length is not expected: %d", res);
+    ASSERT_TRUE(count == 2, "expected 2 events, got %u", count);
+
+    res = sai_serialize_fdb_event_notification(buf2, count, defdata);
+
+    ASSERT_TRUE(strcmp(buf, buf2) == 0, "deserialized value is not the same as serialized");
+
+    free(defdata);
+
+    /* empty batch */
+
+    res = sai_deserialize_port_state_change_notification("{\"count\":0,\"data\":null}", &count, &dedata);
+
+    ASSERT_TRUE(res > 0, "expected positive result: %d", res);
+    ASSERT_TRUE(count == 0 && dedata == NULL, "expected empty batch");
+
+    /* negative cases */
+
+    const char* ncases[] = {
+        "{\"count\":1,\"data\":[{\"port_id\":\"oid:0x0\",\"port_state\":\"SAI_PORT_OPER_STATUS_UP\"}}",
+        "{\"count\":2,\"data\":[{\"port_id\":\"oid:0x0\",\"port_state\":\"SAI_PORT_OPER_STATUS_UP\"}]}",
+        "{\"cnt\":1,\"data\":[{\"port_id\":\"oid:0x0\",\"port_state\":\"SAI_PORT_OPER_STATUS_UP\"}]}",
+    };
+
+    size_t i = 0;
+    for (; i < sizeof(ncases)/sizeof(const char*); ++i)
+    {
+        dedata = NULL;
+
+        res = sai_deserialize_port_state_change_notification(ncases[i], &count, &dedata);
+        ASSERT_TRUE(res < 0, "expected negative result: %d", res);
+
+        free(dedata);
+    }
+}
+
 void sai_serialize_log(
         _In_ sai_log_level_t log_level,
         _In_ const char *file,
@@ -1778,8 +2222,14 @@ int main()
     test_deserialize_route_entry();
     test_deserialize_neighbor_entry();
     test_deserialize_fdb_entry();
+    test_deserialize_object_key_cursor();
+
+    test_deserialize_object_id_array();
+    test_deserialize_uint_array();
+    test_deserialize_ip_prefix_inet_pton();
 
     test_serialize_notifications();
+    test_deserialize_notifications();
 
     test_serialize_encrypt_key();
     test_deserialize_encrypt_key();
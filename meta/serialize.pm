@@ -383,6 +383,10 @@ sub GetTypeInfoForSerialize
 
     my $memberName = (defined $structInfoEx{ismethod}) ? $name : "$structBase\->$name";
 
+    # deserialize notification params are passed as pointers
+
+    $memberName = "(*$name)" if defined $structInfoEx{ismethod} and defined $structInfoEx{deserialize};
+
     $memberName = "($TypeInfo{castName}$memberName)" if $TypeInfo{castName} ne "";
 
     $TypeInfo{memberName} = $memberName;
@@ -429,6 +433,8 @@ sub GetCounterNameAndType
 
     $countMemberName = (defined $refStructInfoEx->{ismethod}) ? $countMemberName: "$structBase\->$countMemberName";
 
+    $countMemberName = "(*$countMemberName)" if defined $refStructInfoEx->{ismethod} and defined $refStructInfoEx->{deserialize};
+
     if (not $countType =~ /^(uint32_t|sai_size_t)$/)
     {
         LogWarning "count '$count' on '$structName' has invalid type '$countType', expected uint32_t";
@@ -944,10 +950,14 @@ sub EmitDeserializeFunctionHeader
             my $end = (defined $last) ? ")" : ",";
             my $endheader = (defined $last) ? ");" : ",";
 
-            # TODO pointers
+            # params are output, so const is dropped and pointer is added
+
+            $type = $1 if $type =~ /^const\s+(.+)$/;
+
+            my $ptr = ($type =~ s/\s*\*$//) ? "**" : "*";
 
-            WriteSource "_Out_ $type $name$end";
-            WriteHeader "_Out_ $type $name$endheader";
+            WriteSource "_Out_ $type $ptr$name$end";
+            WriteHeader "_Out_ $type $ptr$name$endheader";
         }
     }
     else
@@ -1142,6 +1152,20 @@ sub EmitDeserializeArray
     }
 
     WriteSource "EXPECT(\"[\");\n";
+
+    my $arraySuffix = $refTypeInfo->{suffix};
+
+    if ($arraySuffix =~ /^(uint(8|16|32|64)|object_id)$/ and $refTypeInfo->{castName} eq ""
+            and GetPassParamsForDeserialize($refStructInfoEx, $refTypeInfo) eq "")
+    {
+        # numeric and object id arrays are scanned at once instead of item by item
+
+        WriteSource "EXPECT_CHECK(sai_deserialize_${arraySuffix}_array(buf, $countMemberName, $refTypeInfo->{memberName}), ${arraySuffix}_array);\n";
+        WriteSource "EXPECT(\"]\");";
+        WriteSource "}";
+        return;
+    }
+
     WriteSource "$countType idx;\n";
     WriteSource "for (idx = 0; idx < $countMemberName; idx++)";
     WriteSource "{";
@@ -1300,6 +1324,50 @@ sub CreateDeserializeUnions
     }
 }
 
+sub IsBatchNotification
+{
+    my $refNtfInfoEx = shift;
+
+    my @keys = @{ $refNtfInfoEx->{keys} };
+
+    return 0 if scalar @keys != 2;
+
+    my $refMembersHash = $refNtfInfoEx->{membersHash};
+
+    my ($count, $data) = @keys;
+
+    return 0 if $refMembersHash->{$count}{type} ne "uint32_t";
+
+    return 0 if not $refMembersHash->{$data}{type} =~ /^const\s+sai_\w+_t\s*\*$/;
+
+    return 0 if not defined $refMembersHash->{$data}{count} or $refMembersHash->{$data}{count} ne $count;
+
+    return 1;
+}
+
+sub CreateDeserializeNotifications
+{
+    WriteSectionComment "Deserialize notifications";
+
+    #
+    # Only notifications which carry count and data array are deserialized,
+    # since those can be batched by adapter and entire batch is serialized as
+    # single json object. Data array is allocated with calloc and needs to be
+    # released by caller.
+    #
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        next if not IsBatchNotification($main::NOTIFICATIONS{$ntfName});
+
+        my %ntfInfoEx = %{ $main::NOTIFICATIONS{$ntfName} };
+
+        $ntfInfoEx{deserialize} = 1;
+
+        ProcessMembersForDeserialize(\%ntfInfoEx);
+    }
+}
+
 sub CreateSerializeMethods
 {
     CreateSerializeForEnums();
@@ -1320,7 +1388,7 @@ sub CreateSerializeMethods
 
     CreateDeserializeUnions();
 
-    # TODO deserialize notifications
+    CreateDeserializeNotifications();
 }
 
 BEGIN
@@ -448,6 +448,7 @@ sub CheckFunctionNaming
     recv_hostif_packet
     remove_all_neighbor_entries
     send_hostif_packet
+    send_hostif_packets
     switch_mdio_read
     switch_mdio_write
     switch_mdio_cl22_read
@@ -683,6 +684,9 @@ sub CheckMetadataSourceFiles
         next if $file eq "saimetadata.c";
         next if $file eq "saimetadatatest.c";
         next if $file eq "saimetadatasize.h";
+        next if $file eq "saimetadatacompactdata.c";
+        next if $file eq "saimetadatarankdata.c";
+        next if $file eq "saimetadatabuildertraits.h";
         next if $file eq "sai_rpc_server.cpp";
 
         next if $file =~ /swig|wrap/;
@@ -839,6 +843,8 @@ sub GetWordsFromSources
     {
         next if $src =~ /saimetadata.c/;
         next if $src =~ /saimetadatatest.c/;
+        next if $src =~ /saimetadatacompactdata.c/;
+        next if $src =~ /saimetadatarankdata.c/;
         next if $src =~ /saiswig/;
         next if $src =~ /sai_rpc_server.cpp/;
 
@@ -905,6 +911,8 @@ sub CheckHeadersStyle
     {
         next if $header eq "saimetadata.h"; # skip auto generated header
         next if $header eq "saimetadatasize.h"; # skip auto generated header
+        next if $header eq "saimetadatabuildertraits.h"; # skip auto generated header
+        next if $header eq "saimetadatabuilder.h"; # skip C++ header
 
         my $data = ReadHeaderFile($header);
 
@@ -638,6 +638,326 @@ sub CreateStructUnionSizeCheckTest
     WriteTest "#pragma GCC diagnostic pop";
 }
 
+sub CreateNotificationQueueTest
+{
+    #
+    # make sure that each notification can be enqueued and dispatched, and
+    # that payload is deep copied
+    #
+
+    WriteTest "sai_object_id_t notification_queue_port_id = SAI_NULL_OBJECT_ID;";
+    WriteTest "void notification_queue_on_port_state_change(";
+    WriteTest "        _In_ uint32_t count,";
+    WriteTest "        _In_ const sai_port_oper_status_notification_t *data)";
+    WriteTest "{";
+    WriteTest "    TEST_ASSERT_TRUE(count == 1 && data != NULL, \"expected single port state change\");";
+    WriteTest "    notification_queue_port_id = data[0].port_id;";
+    WriteTest "}";
+
+    DefineTestName "notification_queue_test";
+
+    WriteTest "{";
+    WriteTest "    sai_metadata_notification_queue_stats_t stats;";
+    WriteTest "    sai_switch_notifications_t ntf;";
+    WriteTest "    sai_port_oper_status_notification_t port_state;";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_init(3, 1024) == SAI_STATUS_INVALID_PARAMETER, \"slot count must be power of 2\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_init(64, 1024) == SAI_STATUS_SUCCESS, \"failed to init queue\");";
+    WriteTest "    sai_metadata_notification_queue_get_notifications(&ntf);";
+
+    my $count = 0;
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        next if not $ntfName =~ /^sai_(\w+)_notification_fn$/;
+
+        my $base = $1;
+
+        my $refNtf = $main::NOTIFICATIONS{$ntfName};
+
+        my @keys = @{ $refNtf->{keys} };
+
+        WriteTest "    {";
+
+        for my $name (@keys)
+        {
+            my $type = $refNtf->{membersHash}{$name}{type};
+
+            $type =~ s/^const\s+//;
+
+            my $decl = ($type =~ /\*$/) ? "$type$name" : "$type $name";
+
+            WriteTest "        $decl;";
+        }
+
+        for my $name (@keys)
+        {
+            WriteTest "        memset(&$name, 0, sizeof($name));";
+        }
+
+        my $args = join(", ", @keys);
+
+        WriteTest "        TEST_ASSERT_TRUE(ntf.on_$base != NULL, \"notification queue callback missing for $base\");";
+        WriteTest "        ntf.on_$base($args);";
+        WriteTest "    }";
+
+        $count++;
+    }
+
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_dispatch(NULL, 1000) == $count, \"all notifications should be dispatched\");";
+
+    for my $ntfName (sort keys %main::NOTIFICATIONS)
+    {
+        next if not $ntfName =~ /^sai_(\w+)_notification_fn$/;
+
+        my $ntfType = uc("SAI_SWITCH_NOTIFICATION_TYPE_$1");
+
+        WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_get_stats($ntfType, &stats) == SAI_STATUS_SUCCESS, \"failed to get stats\");";
+        WriteTest "    TEST_ASSERT_TRUE(stats.enqueued == 1 && stats.dispatched == 1, \"$ntfType should be enqueued and dispatched once\");";
+    }
+
+    # payload must be copied, since notification data is only valid during callback
+
+    WriteTest "    memset(&ntf, 0, sizeof(ntf));";
+    WriteTest "    ntf.on_port_state_change = notification_queue_on_port_state_change;";
+    WriteTest "    memset(&port_state, 0, sizeof(port_state));";
+    WriteTest "    port_state.port_id = 0x1;";
+    WriteTest "    sai_metadata_notification_queue_on_port_state_change(1, &port_state);";
+    WriteTest "    port_state.port_id = 0x2;";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_dispatch(&ntf, 1000) == 1, \"expected 1 notification\");";
+    WriteTest "    TEST_ASSERT_TRUE(notification_queue_port_id == 0x1, \"notification payload was not copied\");";
+    WriteTest "    sai_metadata_notification_queue_uninit();";
+
+    # drop accounting
+
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_init(2, 1024) == SAI_STATUS_SUCCESS, \"failed to init queue\");";
+    WriteTest "    sai_metadata_notification_queue_on_port_state_change(1, &port_state);";
+    WriteTest "    sai_metadata_notification_queue_on_port_state_change(1, &port_state);";
+    WriteTest "    sai_metadata_notification_queue_on_port_state_change(1, &port_state);";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_get_stats(SAI_SWITCH_NOTIFICATION_TYPE_PORT_STATE_CHANGE, &stats) == SAI_STATUS_SUCCESS, \"failed to get stats\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.enqueued == 2 && stats.dropped_full == 1, \"expected 1 notification dropped on full queue\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_dispatch(NULL, 1000) == 2, \"expected 2 notifications\");";
+    WriteTest "    sai_metadata_notification_queue_uninit();";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_init(2, 8) == SAI_STATUS_SUCCESS, \"failed to init queue\");";
+    WriteTest "    sai_metadata_notification_queue_on_port_state_change(1, &port_state);";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_get_stats(SAI_SWITCH_NOTIFICATION_TYPE_PORT_STATE_CHANGE, &stats) == SAI_STATUS_SUCCESS, \"failed to get stats\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.enqueued == 0 && stats.dropped_size == 1, \"expected 1 notification dropped on slot size\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_notification_queue_dispatch(NULL, 1000) == 0, \"dropped notification should not be dispatched\");";
+    WriteTest "    sai_metadata_notification_queue_uninit();";
+    WriteTest "}";
+}
+
+sub CreateApiLatencyTest
+{
+    #
+    # make sure that wrapped api calls original functions and that calls,
+    # errors and bulk batch sizes are recorded
+    #
+
+    WriteTest "sai_status_t api_latency_create_port(";
+    WriteTest "        _Out_ sai_object_id_t *port_id,";
+    WriteTest "        _In_ sai_object_id_t switch_id,";
+    WriteTest "        _In_ uint32_t attr_count,";
+    WriteTest "        _In_ const sai_attribute_t *attr_list)";
+    WriteTest "{";
+    WriteTest "    *port_id = 0x1;";
+    WriteTest "    return SAI_STATUS_SUCCESS;";
+    WriteTest "}";
+
+    WriteTest "sai_status_t api_latency_remove_port(";
+    WriteTest "        _In_ sai_object_id_t port_id)";
+    WriteTest "{";
+    WriteTest "    return SAI_STATUS_FAILURE;";
+    WriteTest "}";
+
+    WriteTest "sai_status_t api_latency_create_ports(";
+    WriteTest "        _In_ sai_object_id_t switch_id,";
+    WriteTest "        _In_ uint32_t object_count,";
+    WriteTest "        _In_ const uint32_t *attr_count,";
+    WriteTest "        _In_ const sai_attribute_t **attr_list,";
+    WriteTest "        _In_ sai_bulk_op_error_mode_t mode,";
+    WriteTest "        _Out_ sai_object_id_t *object_id,";
+    WriteTest "        _Out_ sai_status_t *object_statuses)";
+    WriteTest "{";
+    WriteTest "    return SAI_STATUS_SUCCESS;";
+    WriteTest "}";
+
+    WriteTest "size_t api_latency_get_fn_index(";
+    WriteTest "        _In_ const char *name)";
+    WriteTest "{";
+    WriteTest "    size_t idx;";
+    WriteTest "    for (idx = 0; idx < SAI_METADATA_LATENCY_FN_COUNT; idx++)";
+    WriteTest "    {";
+    WriteTest "        if (strcmp(sai_metadata_latency_fn_names[idx], name) == 0)";
+    WriteTest "        {";
+    WriteTest "            return idx;";
+    WriteTest "        }";
+    WriteTest "    }";
+    WriteTest "    TEST_ASSERT_TRUE_EXT(false, \"function %s not found\", name);";
+    WriteTest "    return SAI_METADATA_LATENCY_FN_COUNT;";
+    WriteTest "}";
+
+    DefineTestName "api_latency_test";
+
+    WriteTest "{";
+    WriteTest "    sai_port_api_t port_api;";
+    WriteTest "    sai_apis_t apis;";
+    WriteTest "    sai_metadata_latency_stats_t stats;";
+    WriteTest "    sai_object_id_t port_id = SAI_NULL_OBJECT_ID;";
+    WriteTest "    void *api = &port_api;";
+    WriteTest "    FILE *stream;";
+    WriteTest "    memset(&port_api, 0, sizeof(port_api));";
+    WriteTest "    memset(&apis, 0, sizeof(apis));";
+    WriteTest "    port_api.create_port = api_latency_create_port;";
+    WriteTest "    port_api.remove_port = api_latency_remove_port;";
+    WriteTest "    port_api.create_ports = api_latency_create_ports;";
+    WriteTest "    apis.port_api = &port_api;";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_latency_apis_wrap(&apis) == 1, \"expected single api to be wrapped\");";
+    WriteTest "    TEST_ASSERT_TRUE(apis.port_api != &port_api, \"port api should be wrapped\");";
+    WriteTest "    TEST_ASSERT_TRUE(apis.port_api->set_port_attribute == NULL, \"not implemented function should not be wrapped\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_latency_api_wrap(SAI_API_PORT, &api) == SAI_STATUS_SUCCESS, \"failed to wrap api\");";
+    WriteTest "    TEST_ASSERT_TRUE(api == apis.port_api, \"wrapped api should be reused\");";
+    WriteTest "    sai_metadata_latency_clear_stats();";
+    WriteTest "    TEST_ASSERT_TRUE(apis.port_api->create_port(&port_id, SAI_NULL_OBJECT_ID, 0, NULL) == SAI_STATUS_SUCCESS, \"create port failed\");";
+    WriteTest "    TEST_ASSERT_TRUE(port_id == 0x1, \"original create port was not called\");";
+    WriteTest "    TEST_ASSERT_TRUE(apis.port_api->remove_port(port_id) == SAI_STATUS_FAILURE, \"remove port should fail\");";
+    WriteTest "    apis.port_api->create_ports(SAI_NULL_OBJECT_ID, 5, NULL, NULL, SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, NULL, NULL);";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_latency_get_stats(api_latency_get_fn_index(\"port.create_port\"), &stats) == SAI_STATUS_SUCCESS, \"failed to get stats\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.count == 1 && stats.errors == 0, \"expected single successful create port\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.min <= stats.p50 && stats.p50 <= stats.p999 && stats.p999 <= stats.max, \"invalid percentiles\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_latency_get_stats(api_latency_get_fn_index(\"port.remove_port\"), &stats) == SAI_STATUS_SUCCESS, \"failed to get stats\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.count == 1 && stats.errors == 1, \"expected single failed remove port\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_latency_get_stats(api_latency_get_fn_index(\"port.create_ports\"), &stats) == SAI_STATUS_SUCCESS, \"failed to get stats\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.bulk_objects == 5 && stats.bulk_max == 5 && stats.batch[2] == 1, \"expected single bulk call with 5 objects\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_latency_get_stats(SAI_METADATA_LATENCY_FN_COUNT, &stats) == SAI_STATUS_INVALID_PARAMETER, \"expected invalid function index\");";
+    WriteTest "    stream = tmpfile();";
+    WriteTest "    TEST_ASSERT_TRUE(stream != NULL, \"failed to create temporary file\");";
+    WriteTest "    sai_metadata_latency_dump(SAI_METADATA_LATENCY_DUMP_FORMAT_TEXT, stream);";
+    WriteTest "    sai_metadata_latency_dump(SAI_METADATA_LATENCY_DUMP_FORMAT_JSON, stream);";
+    WriteTest "    TEST_ASSERT_TRUE(ftell(stream) > 0, \"dump should not be empty\");";
+    WriteTest "    fclose(stream);";
+    WriteTest "    sai_metadata_latency_clear_stats();";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_latency_get_stats(api_latency_get_fn_index(\"port.create_port\"), &stats) == SAI_STATUS_SUCCESS, \"failed to get stats\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.count == 0, \"stats should be cleared\");";
+    WriteTest "}";
+}
+
+sub CreateApiRecorderTest
+{
+    #
+    # make sure that wrapped api calls original functions and that calls
+    # are recorded to log file and can be decoded back
+    #
+
+    WriteTest "sai_status_t api_recorder_create_port(";
+    WriteTest "        _Out_ sai_object_id_t *port_id,";
+    WriteTest "        _In_ sai_object_id_t switch_id,";
+    WriteTest "        _In_ uint32_t attr_count,";
+    WriteTest "        _In_ const sai_attribute_t *attr_list)";
+    WriteTest "{";
+    WriteTest "    *port_id = 0x1;";
+    WriteTest "    return SAI_STATUS_SUCCESS;";
+    WriteTest "}";
+
+    WriteTest "sai_status_t api_recorder_remove_port(";
+    WriteTest "        _In_ sai_object_id_t port_id)";
+    WriteTest "{";
+    WriteTest "    return SAI_STATUS_FAILURE;";
+    WriteTest "}";
+
+    WriteTest "sai_status_t api_recorder_get_port_attribute(";
+    WriteTest "        _In_ sai_object_id_t port_id,";
+    WriteTest "        _In_ uint32_t attr_count,";
+    WriteTest "        _Inout_ sai_attribute_t *attr_list)";
+    WriteTest "{";
+    WriteTest "    attr_list[0].value.u32 = 100000;";
+    WriteTest "    attr_list[1].value.u32list.count = 2;";
+    WriteTest "    attr_list[1].value.u32list.list[0] = 1;";
+    WriteTest "    attr_list[1].value.u32list.list[1] = 2;";
+    WriteTest "    return SAI_STATUS_SUCCESS;";
+    WriteTest "}";
+
+    WriteTest "sai_status_t api_recorder_create_ports(";
+    WriteTest "        _In_ sai_object_id_t switch_id,";
+    WriteTest "        _In_ uint32_t object_count,";
+    WriteTest "        _In_ const uint32_t *attr_count,";
+    WriteTest "        _In_ const sai_attribute_t **attr_list,";
+    WriteTest "        _In_ sai_bulk_op_error_mode_t mode,";
+    WriteTest "        _Out_ sai_object_id_t *object_id,";
+    WriteTest "        _Out_ sai_status_t *object_statuses)";
+    WriteTest "{";
+    WriteTest "    uint32_t idx;";
+    WriteTest "    for (idx = 0; idx < object_count; idx++)";
+    WriteTest "    {";
+    WriteTest "        object_id[idx] = 0x10 + idx;";
+    WriteTest "        object_statuses[idx] = SAI_STATUS_SUCCESS;";
+    WriteTest "    }";
+    WriteTest "    return SAI_STATUS_SUCCESS;";
+    WriteTest "}";
+
+    DefineTestName "api_recorder_test";
+
+    WriteTest "{";
+    WriteTest "    const char *path = \"saimetadatatest.rec\";";
+    WriteTest "    sai_port_api_t port_api;";
+    WriteTest "    sai_port_api_t *wrapped;";
+    WriteTest "    sai_metadata_recorder_stats_t stats;";
+    WriteTest "    sai_metadata_recorder_reader_t reader;";
+    WriteTest "    sai_metadata_recorder_record_t records[6];";
+    WriteTest "    sai_object_id_t port_id = SAI_NULL_OBJECT_ID;";
+    WriteTest "    sai_object_id_t port_ids[3];";
+    WriteTest "    uint32_t idx;";
+    WriteTest "    sai_status_t statuses[3];";
+    WriteTest "    sai_attribute_t attrs[2];";
+    WriteTest "    uint32_t list[4];";
+    WriteTest "    uint32_t attr_count[3] = { 1, 1, 1 };";
+    WriteTest "    const sai_attribute_t *attr_list[3] = { attrs, attrs, attrs };";
+    WriteTest "    void *api = &port_api;";
+    WriteTest "    memset(&port_api, 0, sizeof(port_api));";
+    WriteTest "    port_api.create_port = api_recorder_create_port;";
+    WriteTest "    port_api.remove_port = api_recorder_remove_port;";
+    WriteTest "    port_api.get_port_attribute = api_recorder_get_port_attribute;";
+    WriteTest "    port_api.create_ports = api_recorder_create_ports;";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_recorder_api_wrap(SAI_API_PORT, &api) == SAI_STATUS_SUCCESS, \"failed to wrap api\");";
+    WriteTest "    wrapped = api;";
+    WriteTest "    TEST_ASSERT_TRUE(wrapped != &port_api, \"port api should be wrapped\");";
+    WriteTest "    TEST_ASSERT_TRUE(wrapped->set_port_attribute == NULL, \"not implemented function should not be wrapped\");";
+    WriteTest "    remove(path);";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_recorder_open(path, 1 << 20) == SAI_STATUS_SUCCESS, \"failed to open recorder\");";
+    WriteTest "    attrs[0].id = SAI_PORT_ATTR_SPEED;";
+    WriteTest "    attrs[0].value.u32 = 100000;";
+    WriteTest "    TEST_ASSERT_TRUE(wrapped->create_port(&port_id, 0x2, 1, attrs) == SAI_STATUS_SUCCESS, \"create port failed\");";
+    WriteTest "    TEST_ASSERT_TRUE(port_id == 0x1, \"original create port was not called\");";
+    WriteTest "    attrs[0].value.u32 = 0;";
+    WriteTest "    attrs[1].id = SAI_PORT_ATTR_HW_LANE_LIST;";
+    WriteTest "    attrs[1].value.u32list.count = 4;";
+    WriteTest "    attrs[1].value.u32list.list = list;";
+    WriteTest "    TEST_ASSERT_TRUE(wrapped->get_port_attribute(port_id, 2, attrs) == SAI_STATUS_SUCCESS, \"get port failed\");";
+    WriteTest "    TEST_ASSERT_TRUE(wrapped->remove_port(port_id) == SAI_STATUS_FAILURE, \"remove port should fail\");";
+    WriteTest "    TEST_ASSERT_TRUE(wrapped->create_ports(0x2, 3, attr_count, attr_list, SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, port_ids, statuses) == SAI_STATUS_SUCCESS, \"create ports failed\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_recorder_get_stats(&stats) == SAI_STATUS_SUCCESS, \"failed to get recorder stats\");";
+    WriteTest "    TEST_ASSERT_TRUE(stats.records == 6 && stats.dropped == 0 && stats.bytes > 0, \"expected 6 records\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_recorder_close() == SAI_STATUS_SUCCESS, \"failed to close recorder\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_recorder_close() != SAI_STATUS_SUCCESS, \"recorder should be closed\");";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_recorder_reader_open(path, &reader) == SAI_STATUS_SUCCESS, \"failed to open log\");";
+    WriteTest "    for (idx = 0; idx < 6; idx++)";
+    WriteTest "    {";
+    WriteTest "        TEST_ASSERT_TRUE(sai_metadata_recorder_reader_next(&reader, &records[idx]) == SAI_STATUS_SUCCESS, \"failed to read record\");";
+    WriteTest "    }";
+    WriteTest "    TEST_ASSERT_TRUE(sai_metadata_recorder_reader_next(&reader, &records[0]) == SAI_STATUS_ITEM_NOT_FOUND, \"expected end of log\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[0].op == SAI_METADATA_RECORDER_OP_CREATE && records[0].switch_id == 0x2, \"expected create\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[0].meta_key.objecttype == SAI_OBJECT_TYPE_PORT && records[0].meta_key.objectkey.key.object_id == 0x1, \"invalid key\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[0].attr_count == 1 && records[0].attr_list[0].value.u32 == 100000, \"invalid create attributes\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[1].op == SAI_METADATA_RECORDER_OP_GET && records[1].attr_count == 2, \"expected get\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[1].attr_list[0].value.u32 == 100000, \"expected returned value\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[1].attr_list[1].value.u32list.count == 2 && records[1].attr_list[1].value.u32list.list[1] == 2, \"expected returned list\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[2].op == SAI_METADATA_RECORDER_OP_REMOVE && records[2].status == SAI_STATUS_FAILURE, \"expected failed remove\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[3].bulk_count == 3 && records[5].bulk_count == 3, \"expected bulk records\");";
+    WriteTest "    TEST_ASSERT_TRUE(records[5].meta_key.objectkey.key.object_id == 0x12 && records[5].attr_list[0].id == SAI_PORT_ATTR_SPEED, \"invalid bulk record\");";
+    WriteTest "    sai_metadata_recorder_reader_close(&reader);";
+    WriteTest "    remove(path);";
+    WriteTest "}";
+}
+
 sub WriteTestHeader
 {
     #
@@ -722,6 +1042,12 @@ sub CreateTests
 
     # TODO tests for notifications
 
+    CreateNotificationQueueTest();
+
+    CreateApiLatencyTest();
+
+    CreateApiRecorderTest();
+
     CreateSerializeStructsTest();
 
     CreateSerializeUnionsTest();
@@ -41,6 +41,8 @@ our $HEADER_CONTENT = "";
 our $SOURCE_CONTENT = "";
 our $TEST_CONTENT = "";
 our $SWIG_CONTENT = "";
+our $COMPACT_CONTENT = "";
+our $BUILDER_CONTENT = "";
 
 my $identLevel = 0;
 
@@ -99,6 +101,32 @@ sub WriteSwig
     $SWIG_CONTENT .= $ident . $content . "\n";
 }
 
+sub WriteCompact
+{
+    my $content = shift;
+
+    my $ident = GetIdent($content);
+
+    my $line = $ident . $content . "\n";
+
+    $line = "\n" if $content eq "";
+
+    $COMPACT_CONTENT .= $line;
+}
+
+sub WriteBuilder
+{
+    my $content = shift;
+
+    my $ident = GetIdent($content);
+
+    my $line = $ident . $content . "\n";
+
+    $line = "\n" if $content eq "";
+
+    $BUILDER_CONTENT .= $line;
+}
+
 sub WriteSourceSectionComment
 {
     my $content = shift;
@@ -382,6 +410,9 @@ sub WriteMetaDataFiles
     WriteFile("saimetadata.c", $SOURCE_CONTENT);
     WriteFile("saimetadatatest.c", $TEST_CONTENT);
     WriteFile("saiswig.i", $SWIG_CONTENT);
+
+    WriteFile("saimetadatacompactdata.c", $COMPACT_CONTENT) if defined $main::optionCompactLayout;
+    WriteFile("saimetadatabuildertraits.h", $BUILDER_CONTENT);
 }
 
 sub GetStructKeysInOrder
@@ -616,7 +647,7 @@ BEGIN
     WriteFile GetHeaderFiles GetMetaHeaderFiles GetExperimentalHeaderFiles GetMetadataSourceFiles ReadHeaderFile GetMetaSourceFiles
     GetNonObjectIdStructNames GetNonObjectIdStructNamesWithBulkApi IsSpecialObject GetStructLists GetStructKeysInOrder
     Trim ExitOnErrors ExitOnErrorsOrWarnings ProcessEnumInitializers
-    WriteHeader WriteSource WriteTest WriteSwig WriteMetaDataFiles WriteSectionComment WriteSourceSectionComment
+    WriteHeader WriteSource WriteTest WriteSwig WriteCompact WriteBuilder WriteMetaDataFiles WriteSectionComment WriteSourceSectionComment
     $errors $warnings $NUMBER_REGEX
     $HEADER_CONTENT $SOURCE_CONTENT $TEST_CONTENT
     /;
@@ -21,6 +21,7 @@
 from sai_test_base import T0TestBase
 from sai_utils import *
 from time import sleep
+import time
 
 from data_module.device import Device, DeviceType
 from multiprocessing import Process
@@ -2573,3 +2574,111 @@ class SviMacrMoveStressV6Test(T0TestBase):
 
     def tearDown(self):
         super().tearDown()
+
+
+class RoutePipelineScaleTest(T0TestBase):
+    """
+    Verify routes created and removed by pipelined operations, and compare
+    route programming rate with one RPC call per route.
+    """
+
+    def setUp(self):
+        """
+        Test the basic setup process.
+        """
+        super().setUp()
+
+        self.route_count = 4096
+        self.nexthopv4 = self.dut.lag_list[0].nexthopv4_list[0].oid
+        self.routes = []
+        for i in range(self.route_count):
+            dst_ip = '172.16.{}.{}'.format(i // 256, i % 256)
+            self.routes.append(sai_thrift_route_entry_t(vr_id=self.dut.default_vrf,
+                                                        destination=sai_ipprefix(dst_ip + '/32')))
+
+    def createRoutes(self, client):
+        """
+        Create all routes with next-hop on lag1, returns routes per second
+        """
+        # pipelined results are checked by caller after flush
+        pipelined = isinstance(client, sai_thrift_pipeline)
+        start = time.time()
+        for route in self.routes:
+            status = sai_thrift_create_route_entry(client, route, next_hop_id=self.nexthopv4)
+            if not pipelined:
+                self.assertEqual(status, SAI_STATUS_SUCCESS)
+        if pipelined:
+            client.flush()
+        return self.route_count / (time.time() - start)
+
+    def removeRoutes(self, client):
+        """
+        Remove all routes, returns routes per second
+        """
+        # pipelined results are checked by caller after flush
+        pipelined = isinstance(client, sai_thrift_pipeline)
+        start = time.time()
+        for route in self.routes:
+            status = sai_thrift_remove_route_entry(client, route)
+            if not pipelined:
+                self.assertEqual(status, SAI_STATUS_SUCCESS)
+        if pipelined:
+            client.flush()
+        return self.route_count / (time.time() - start)
+
+    def runTest(self):
+        """
+        1. Create 4096 routes for DIP:172.16.0.0~172.16.15.255 through next-hop on LAG1, one RPC call per route
+        2. Remove all routes, one RPC call per route
+        3. Create all routes by pipelined operations, verify all operations succeeded
+        4. Send packet with DMAC: SWITCH_MAC and DIP:172.16.15.255 on port5
+        5. Verify packet received with SMAC: SWITCH_MAC and DIP:172.16.15.255 on one of LAG1 member
+        6. Remove all routes by pipelined operations, verify all operations succeeded
+        7. Print route programming rates of both modes
+        """
+        print("RoutePipelineScaleTest")
+
+        # routes can be left partially created when any step fails
+        routes_created = True
+        try:
+            sync_create_rate = self.createRoutes(self.client)
+            sync_remove_rate = self.removeRoutes(self.client)
+
+            pipeline = sai_thrift_pipeline(self.client)
+            pipeline_create_rate = self.createRoutes(pipeline)
+            self.assertEqual(len(pipeline.results), self.route_count)
+            for result in pipeline.results:
+                self.assertEqual(result.status, SAI_STATUS_SUCCESS)
+
+            self.recv_dev_port_idxs = self.get_dev_port_indexes(self.dut.lag_list[0].member_port_indexs)
+            dst_ip = '172.16.{}.{}'.format((self.route_count - 1) // 256, (self.route_count - 1) % 256)
+            pkt = simple_tcp_packet(eth_dst=ROUTER_MAC,
+                                    ip_dst=dst_ip,
+                                    ip_id=105,
+                                    ip_ttl=64)
+            exp_pkt = simple_tcp_packet(eth_src=ROUTER_MAC,
+                                        eth_dst=self.t1_list[1][100].mac,
+                                        ip_dst=dst_ip,
+                                        ip_id=105,
+                                        ip_ttl=63)
+            send_packet(self, self.dut.port_obj_list[5].dev_port_index, pkt)
+            verify_packet_any_port(self, exp_pkt, self.recv_dev_port_idxs)
+            print("receive packet with dst_ip:{} from one of lag1 member".format(dst_ip))
+
+            pipeline = sai_thrift_pipeline(self.client)
+            pipeline_remove_rate = self.removeRoutes(pipeline)
+            self.assertEqual(len(pipeline.results), self.route_count)
+            for result in pipeline.results:
+                self.assertEqual(result.status, SAI_STATUS_SUCCESS)
+            routes_created = False
+
+            print("create routes/sec: sync {:.0f}, pipelined {:.0f}".format(sync_create_rate, pipeline_create_rate))
+            print("remove routes/sec: sync {:.0f}, pipelined {:.0f}".format(sync_remove_rate, pipeline_remove_rate))
+        finally:
+            if routes_created:
+                # some routes may not exist, so status is not checked
+                for route in self.routes:
+                    sai_thrift_remove_route_entry(self.client, route)
+
+    def tearDown(self):
+        super().tearDown()